@@ -4,6 +4,7 @@
 #include <QCoreApplication>
 #include <QDataStream>
 #include <QTime>
+#include <QTimer>
 #include <QLocalServer>
 #include <QLocalSocket>
 #include <QDir>
@@ -46,15 +47,21 @@ public:
     QString m_id;
     QString m_socketName;
     QLocalServer *m_server;
+    QTimer m_batchTimer;
+    QList<QStringList> m_messages;
     TTKLockedPrivate::TTKLockedFile m_lockFile;
     static const char *m_ack;
+    static const QChar m_separator;
 };
 const char *TTKLocalPeerPrivate::m_ack = "ack";
+const QChar TTKLocalPeerPrivate::m_separator = QChar(0);
 
 TTKLocalPeerPrivate::TTKLocalPeerPrivate()
     : m_server(nullptr)
 {
-
+    // arrivals within the window are delivered as one batch
+    m_batchTimer.setInterval(150);
+    m_batchTimer.setSingleShot(true);
 }
 
 TTKLocalPeerPrivate::~TTKLocalPeerPrivate()
@@ -111,6 +118,7 @@ TTKLocalPeer::TTKLocalPeer(QObject *parent, const QString &id)
 #endif
 
     d->m_server = new QLocalServer(this);
+    connect(&d->m_batchTimer, SIGNAL(timeout()), SLOT(deliverMessages()));
     const QString &lockName = QDir(QDir::tempPath()).absolutePath() + QLatin1Char('/') + d->m_socketName + QLatin1String("-lockfile");
     d->m_lockFile.setFileName(lockName);
     d->m_lockFile.open(QIODevice::ReadWrite);
@@ -148,6 +156,11 @@ bool TTKLocalPeer::isClient() const
 }
 
 bool TTKLocalPeer::sendMessage(const QString &message, int timeout) const
+{
+    return sendMessage(QStringList(message), timeout);
+}
+
+bool TTKLocalPeer::sendMessage(const QStringList &messages, int timeout) const
 {
     TTK_D(TTKLocalPeer);
     if(!isClient())
@@ -180,7 +193,7 @@ bool TTKLocalPeer::sendMessage(const QString &message, int timeout) const
         return false;
     }
 
-    const QByteArray uMsg(message.toUtf8());
+    const QByteArray uMsg(messages.join(QString(d->m_separator)).toUtf8());
     QDataStream ds(&socket);
     ds.writeBytes(uMsg.constData(), uMsg.length());
 
@@ -205,55 +218,78 @@ QString TTKLocalPeer::applicationId() const
 void TTKLocalPeer::receiveConnection()
 {
     TTK_D(TTKLocalPeer);
-    QLocalSocket *socket = d->m_server->nextPendingConnection();
+    while(d->m_server->hasPendingConnections())
+    {
+        QLocalSocket *socket = d->m_server->nextPendingConnection();
+        if(!socket)
+        {
+            break;
+        }
+
+        connect(socket, SIGNAL(readyRead()), SLOT(readConnection()));
+        connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
+        // data may have arrived before the signal was connected
+        readConnection(socket);
+    }
+}
+
+void TTKLocalPeer::readConnection()
+{
+    readConnection(TTKObjectCast(QLocalSocket*, sender()));
+}
+
+void TTKLocalPeer::readConnection(QLocalSocket *socket)
+{
+    TTK_D(TTKLocalPeer);
     if(!socket)
     {
         return;
     }
 
-    while(true)
+    // readyRead is not emitted again for data already buffered, so every complete frame is taken now
+    bool received = false;
+    while(socket->bytesAvailable() >= qint64(sizeof(quint32)))
     {
-        if(socket->state() == QLocalSocket::UnconnectedState)
+        quint32 length = 0;
         {
-            TTK_WARN_STREAM("QtLocalPeer: Peer disconnected");
-            delete socket;
-            return;
+            QDataStream ds(socket->peek(sizeof(quint32)));
+            ds >> length;
         }
-        
-        if(socket->bytesAvailable() >= qint64(sizeof(quint32)))
+
+        if(socket->bytesAvailable() < qint64(sizeof(quint32)) + length)
         {
             break;
         }
-        socket->waitForReadyRead();
+
+        socket->read(sizeof(quint32));
+        const QByteArray &uMsg = socket->read(length);
+        socket->write(d->m_ack, qstrlen(d->m_ack));
+
+        d->m_messages << QString::fromUtf8(uMsg).split(d->m_separator);
+        received = true;
     }
 
-    QDataStream ds(socket);
-    QByteArray uMsg;
-    quint32 remaining;
-    ds >> remaining;
-    uMsg.resize(remaining);
+    if(!received)
+    {
+        return;
+    }
 
-    int got = 0;
-    char *uMsgBuf = uMsg.data();
-    do
+    socket->flush();
+    if(!d->m_batchTimer.isActive())
     {
-        got = ds.readRawData(uMsgBuf, remaining);
-        remaining -= got;
-        uMsgBuf += got;
-    } while(remaining && got >= 0 && socket->waitForReadyRead(2000));
+        d->m_batchTimer.start();
+    }
+}
 
-    if(got < 0)
+void TTKLocalPeer::deliverMessages()
+{
+    TTK_D(TTKLocalPeer);
+    if(d->m_messages.isEmpty())
     {
-        TTK_WARN_STREAM("TTKLocalPeer: Message reception failed " << socket->errorString().toLatin1().constData());
-        delete socket;
         return;
     }
 
-    const QString message(QString::fromUtf8(uMsg));
-    socket->write(d->m_ack, qstrlen(d->m_ack));
-    socket->waitForBytesWritten(1000);
-    socket->waitForDisconnected(1000); // make sure client reads ack
-    delete socket;
-
-    Q_EMIT messageReceived(message); //### (might take a long time to return)
+    QList<QStringList> messages;
+    messages.swap(d->m_messages);
+    Q_EMIT messagesReceived(messages);
 }
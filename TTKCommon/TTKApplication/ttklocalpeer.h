@@ -21,6 +21,7 @@
 
 #include "ttkprivate.h"
 
+class QLocalSocket;
 class TTKLocalPeerPrivate;
 
 /*! @brief The class of the ttk local peer.
@@ -44,6 +45,10 @@ public:
      * Send current message when the client in.
     */
     bool sendMessage(const QString &message, int timeout) const;
+    /*!
+     * Send current messages in one frame when the client in.
+    */
+    bool sendMessage(const QStringList &messages, int timeout) const;
 
     /*!
      * Get current server id.
@@ -52,15 +57,29 @@ public:
 
 Q_SIGNALS:
     /*!
-     * Emit when the current message received.
+     * Emit when the messages received in the coalesce window, one string list per message.
     */
-    void messageReceived(const QString &message);
+    void messagesReceived(const QList<QStringList> &messages);
 
 private Q_SLOTS:
     /*!
      * Current message received.
     */
     void receiveConnection();
+    /*!
+     * Current connection ready read.
+    */
+    void readConnection();
+    /*!
+     * Deliver coalesced messages.
+    */
+    void deliverMessages();
+
+private:
+    /*!
+     * Read all complete message frames from the connection.
+    */
+    void readConnection(QLocalSocket *socket);
 
 private:
     TTK_DECLARE_PRIVATE(TTKLocalPeer)
@@ -63,11 +63,11 @@ void TTKRunApplication::setActivationWindow(QWidget* aw, bool activateOnMessage)
 
     if(activateOnMessage)
     {
-        connect(d->m_peer, SIGNAL(messageReceived(QString)), this, SLOT(activateWindow()));
+        connect(d->m_peer, SIGNAL(messagesReceived(QList<QStringList>)), this, SLOT(activateWindow()));
     }
     else
     {
-        disconnect(d->m_peer, SIGNAL(messageReceived(QString)), this, SLOT(activateWindow()));
+        disconnect(d->m_peer, SIGNAL(messagesReceived(QList<QStringList>)), this, SLOT(activateWindow()));
     }
 }
 
@@ -83,6 +83,12 @@ bool TTKRunApplication::sendMessage(const QString &message, int timeout)
     return d->m_peer->sendMessage(message, timeout);
 }
 
+bool TTKRunApplication::sendMessage(const QStringList &messages, int timeout)
+{
+    TTK_D(TTKRunApplication);
+    return d->m_peer->sendMessage(messages, timeout);
+}
+
 void TTKRunApplication::activateWindow()
 {
     TTK_D(TTKRunApplication);
@@ -98,5 +104,5 @@ void TTKRunApplication::initialize(const QString &id)
 {
     TTK_D(TTKRunApplication);
     d->m_peer = new TTKLocalPeer(this, id);
-    connect(d->m_peer, SIGNAL(messageReceived(QString)), SIGNAL(messageReceived(QString)));
+    connect(d->m_peer, SIGNAL(messagesReceived(QList<QStringList>)), SIGNAL(messagesReceived(QList<QStringList>)));
 }
@@ -57,15 +57,19 @@ public:
 
 Q_SIGNALS:
     /*!
-     * Emit when the current message received.
+     * Emit when the messages received in the coalesce window, one string list per message.
     */
-    void messageReceived(const QString &message);
+    void messagesReceived(const QList<QStringList> &messages);
 
 public Q_SLOTS:
     /*!
      * Emit when the current message received.
     */
     bool sendMessage(const QString &message, int timeout = 5000);
+    /*!
+     * Send current messages in one frame.
+    */
+    bool sendMessage(const QStringList &messages, int timeout = 5000);
     /*!
      * Selected current active window.
     */
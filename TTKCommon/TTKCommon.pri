@@ -56,6 +56,7 @@ win32{
             $$PWD/TTKLibrary/ttksuperenum.h \
             $$PWD/TTKLibrary/ttktabbutton.h \
             $$PWD/TTKLibrary/ttkthemelinelabel.h \
+            $$PWD/TTKLibrary/ttkthreadpool.h \
             $$PWD/TTKLibrary/ttktime.h \
             $$PWD/TTKLibrary/ttktoastlabel.h \
             $$PWD/TTKLibrary/ttkunsortedmap.h
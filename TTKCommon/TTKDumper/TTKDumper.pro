@@ -28,6 +28,7 @@ TARGET = TTKDumper
 
 DEFINES += TTK_LIBRARY
 
+LIBS += -L$$DESTDIR -lTTKLibrary
 win32:LIBS += -lpsapi
 win32:msvc{
     CONFIG += c++11
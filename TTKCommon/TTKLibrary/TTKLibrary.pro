@@ -46,6 +46,7 @@ win32:msvc{
 INCLUDEPATH += $$PWD/../
 
 HEADERS += \
+    $$PWD/../ttkasynclogger.h \
     $$PWD/../ttkcompat.h \
     $$PWD/../ttkglobal.h \
     $$PWD/../ttklogger.h \
@@ -78,6 +79,7 @@ HEADERS += \
     $$PWD/ttkconcurrentqueue.h \
     $$PWD/ttkcryptographichash.h \
     $$PWD/ttkdefer.h \
+    $$PWD/ttkdeferredobject.h \
     $$PWD/ttkdesktopwrapper.h \
     $$PWD/ttkdispatchmanager.h \
     $$PWD/ttkfileassociation.h \
@@ -87,15 +89,19 @@ HEADERS += \
     $$PWD/ttklibrary.h \
     $$PWD/ttklibraryversion.h \
     $$PWD/ttkplatformsystem.h \
+    $$PWD/ttksavefile.h \
     $$PWD/ttksemaphoreloop.h \
     $$PWD/ttksuperenum.h \
     $$PWD/ttktabbutton.h \
     $$PWD/ttkthemelinelabel.h \
+    $$PWD/ttkthreadpool.h \
     $$PWD/ttktime.h \
+    $$PWD/ttktracer.h \
     $$PWD/ttktoastlabel.h \
     $$PWD/ttkunsortedmap.h
 
 SOURCES += \
+    $$PWD/ttkasynclogger.cpp \
     $$PWD/ttkabstractmovedialog.cpp \
     $$PWD/ttkabstractmoveresizewidget.cpp \
     $$PWD/ttkabstractmovewidget.cpp \
@@ -109,17 +115,21 @@ SOURCES += \
     $$PWD/ttkclickedslider.cpp \
     $$PWD/ttkcommandline.cpp \
     $$PWD/ttkcryptographichash.cpp \
+    $$PWD/ttkdeferredobject.cpp \
     $$PWD/ttkdesktopwrapper.cpp \
     $$PWD/ttkdispatchmanager.cpp \
     $$PWD/ttkfileassociation.cpp \
     $$PWD/ttkglobalhelper.cpp \
     $$PWD/ttkitemdelegate.cpp \
     $$PWD/ttkplatformsystem.cpp \
+    $$PWD/ttksavefile.cpp \
     $$PWD/ttksemaphoreloop.cpp \
     $$PWD/ttksuperenum.cpp \
     $$PWD/ttktabbutton.cpp \
     $$PWD/ttkthemelinelabel.cpp \
+    $$PWD/ttkthreadpool.cpp \
     $$PWD/ttktime.cpp \
+    $$PWD/ttktracer.cpp \
     $$PWD/ttktoastlabel.cpp
 
 RESOURCES += $$PWD/$${TARGET}.qrc
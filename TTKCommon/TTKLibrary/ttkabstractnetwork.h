@@ -69,6 +69,10 @@ public:
      * Get the current raw data.
      */
     inline const QVariant header(const QString &key) const { return m_rawData[key]; }
+    /*!
+     * Get the reply of the running request, null when idle.
+     */
+    inline QNetworkReply *reply() const { return m_reply; }
 
 Q_SIGNALS:
     /*!
@@ -1,26 +1,49 @@
 #include "ttkabstractthread.h"
 
 TTKAbstractThread::TTKAbstractThread(QObject *parent)
-    : QThread(parent),
-      m_running(true)
+    : QObject(parent),
+      m_running(false),
+      m_priority(TTKThreadPool::Priority::Normal)
 {
 
 }
 
+TTKAbstractThread::~TTKAbstractThread()
+{
+    // run is virtual and the derived members are gone here, subclasses stop in their own destructor
+    Q_ASSERT_X(!isRunning(), "TTKAbstractThread", "subclass destructor must call stop");
+    m_token.cancel();
+}
+
+bool TTKAbstractThread::isRunning() const
+{
+    return !m_future.isFinished();
+}
+
+void TTKAbstractThread::wait()
+{
+    m_future.waitForFinished();
+}
+
 void TTKAbstractThread::stop()
 {
     m_running = false;
-    if(isRunning())
-    {
-        quit();
-        wait();
-    }
+    // a queued task is dropped, a running one sees the flag
+    m_token.cancel();
+    wait();
 }
 
 void TTKAbstractThread::start()
 {
+    if(isRunning())
+    {
+        return;
+    }
+
     m_running = true;
-    QThread::start();
+    m_token = TTKCancelToken();
+    m_future = TTKThreadPool::instance()->runBlocking([this]() { run(); }, m_priority, m_token);
+    m_future.then(this, [this]() { Q_EMIT finished(); });
 }
 
 void TTKAbstractThread::run()
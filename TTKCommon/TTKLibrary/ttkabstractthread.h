@@ -19,14 +19,16 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
-#include <QThread>
+#include <QObject>
 #include <QStringList>
-#include "ttkmoduleexport.h"
+#include "ttkthreadpool.h"
 
 /*! @brief The class of the ttk abstract thread.
+ * Run is a blocking task of the shared thread pool instead of a thread of its own.
+ * Subclasses must call stop in their destructor, run may use their members until it returns.
  * @author Greedysky <greedysky@163.com>
  */
-class TTK_MODULE_EXPORT TTKAbstractThread : public QThread
+class TTK_MODULE_EXPORT TTKAbstractThread : public QObject
 {
     Q_OBJECT
     TTK_DECLARE_MODULE(TTKAbstractThread)
@@ -35,6 +37,29 @@ public:
      * Object constructor.
      */
     explicit TTKAbstractThread(QObject *parent = nullptr);
+    /*!
+     * Object destructor.
+     */
+    ~TTKAbstractThread();
+
+    /*!
+     * Set the priority of the task, used by the next start.
+     */
+    inline void setPriority(TTKThreadPool::Priority priority) { m_priority = priority; }
+    /*!
+     * Check the task is queued or running.
+     */
+    bool isRunning() const;
+    /*!
+     * Wait for the task to finish.
+     */
+    void wait();
+
+Q_SIGNALS:
+    /*!
+     * The task finished, emitted in the gui thread unless stopped.
+     */
+    void finished();
 
 public Q_SLOTS:
     /*!
@@ -50,10 +75,15 @@ protected:
     /*!
      * Thread run now.
      */
-    virtual void run() override;
+    virtual void run();
 
 protected:
-    bool m_running;
+    std::atomic<bool> m_running;
+
+private:
+    TTKThreadPool::Priority m_priority;
+    TTKCancelToken m_token;
+    TTKFuture<void> m_future;
 
 };
 
@@ -1,5 +1,8 @@
 #include "ttkabstractxml.h"
 
+#include "ttksavefile.h"
+
+#include <QFileInfo>
 #include <QStringList>
 
 TTKXmlHelper::TTKXmlHelper(const QDomNode &root)
@@ -95,21 +98,23 @@ bool TTKAbstractXml::load(const QString &name)
 {
     delete m_file;
     delete m_document;
+    clearIndex();
 
     m_file = new QFile(name);
     m_document = new QDomDocument;
-    return m_file->open(QIODevice::WriteOnly | QIODevice::Text);
+
+    const QFileInfo fin(name);
+    return fin.exists() ? fin.isWritable() : QFileInfo(fin.absolutePath()).isWritable();
 }
 
-void TTKAbstractXml::save() const
+bool TTKAbstractXml::save() const
 {
     if(!m_file || !m_document)
     {
-        return;
+        return false;
     }
 
-    QTextStream out(m_file);
-    m_document->save(out, 4);
+    return TTKSaveFile::writeFile(m_file->fileName(), m_document->toByteArray(4));
 }
 
 bool TTKAbstractXml::reset()
@@ -126,6 +131,7 @@ bool TTKAbstractXml::fromFile(const QString &name)
 {
     delete m_file;
     delete m_document;
+    clearIndex();
 
     m_file = new QFile(name);
     m_document = new QDomDocument;
@@ -149,6 +155,7 @@ bool TTKAbstractXml::fromString(const QString &data)
 {
     delete m_file;
     delete m_document;
+    clearIndex();
 
     m_file = nullptr;
     m_document = new QDomDocument;
@@ -163,6 +170,7 @@ bool TTKAbstractXml::fromByteArray(const QByteArray &data)
 {
     delete m_file;
     delete m_document;
+    clearIndex();
 
     m_file = nullptr;
     m_document = new QDomDocument;
@@ -178,9 +186,9 @@ QString TTKAbstractXml::toString() const
     return m_document ? m_document->toString() : QString();
 }
 
-QByteArray TTKAbstractXml::toByteArray() const
+QByteArray TTKAbstractXml::toByteArray(int indent) const
 {
-    return m_document ? m_document->toByteArray() : QByteArray();
+    return m_document ? m_document->toByteArray(indent) : QByteArray();
 }
 
 void TTKAbstractXml::createProcessingInstruction() const
@@ -189,28 +197,61 @@ void TTKAbstractXml::createProcessingInstruction() const
     m_document->appendChild(node);
 }
 
+QDomElement TTKAbstractXml::findElementByTagName(const QString &tagName) const
+{
+    if(!m_document)
+    {
+        return {};
+    }
+
+    if(m_elements.isEmpty())
+    {
+        // walk the document once and keep the first element of every tag name,
+        // instead of a full elementsByTagName scan for each lookup
+        QDomElement element = m_document->documentElement();
+        while(!element.isNull())
+        {
+            if(!m_elements.contains(element.tagName()))
+            {
+                m_elements.insert(element.tagName(), element);
+            }
+
+            QDomElement next = element.firstChildElement();
+            while(next.isNull() && !element.isNull())
+            {
+                next = element.nextSiblingElement();
+                element = element.parentNode().toElement();
+            }
+            element = next;
+        }
+    }
+    return m_elements.value(tagName);
+}
+
+void TTKAbstractXml::clearIndex() const
+{
+    m_elements.clear();
+}
+
 QString TTKAbstractXml::readAttributeByTagName(const QString &tagName, const QString &attrName) const
 {
-    const QDomNodeList &nodes = m_document->elementsByTagName(tagName);
-    return nodes.isEmpty() ? QString() : nodes.item(0).toElement().attribute(attrName);
+    return findElementByTagName(tagName).attribute(attrName);
 }
 
 QString TTKAbstractXml::readTextByTagName(const QString &tagName) const
 {
-    const QDomNodeList &nodes = m_document->elementsByTagName(tagName);
-    return nodes.isEmpty() ? QString() : nodes.item(0).toElement().text();
+    return findElementByTagName(tagName).text();
 }
 
 TTKXmlNode TTKAbstractXml::readNodeByTagName(const QString &tagName) const
 {
-    const QDomNodeList &nodes = m_document->elementsByTagName(tagName);
-    if(nodes.isEmpty())
+    const QDomElement &element = findElementByTagName(tagName);
+    if(element.isNull())
     {
         return {};
     }
 
     TTKXmlNode v;
-    const QDomElement &element = nodes.item(0).toElement();
     const QDomNamedNodeMap &nodeMap = element.attributes();
 
     for(int i = 0; i < nodeMap.count(); ++i)
@@ -286,6 +327,7 @@ QDomElement TTKAbstractXml::createRoot(const QString &node) const
 {
     const QDomElement &domElement = m_document->createElement(node);
     m_document->appendChild(domElement);
+    clearIndex();
     return domElement;
 }
 
@@ -294,6 +336,7 @@ QDomElement TTKAbstractXml::createRoot(const QString &node, const TTKXmlAttr &at
     QDomElement domElement = m_document->createElement(node);
     writeAttribute(domElement, attr);
     m_document->appendChild(domElement);
+    clearIndex();
     return domElement;
 }
 
@@ -302,6 +345,7 @@ QDomElement TTKAbstractXml::createRoot(const QString &node, const TTKXmlAttrList
     QDomElement domElement = m_document->createElement(node);
     writeAttribute(domElement, attrs);
     m_document->appendChild(domElement);
+    clearIndex();
     return domElement;
 }
 
@@ -309,6 +353,7 @@ QDomElement TTKAbstractXml::writeDomElement(QDomElement &element, const QString
 {
     const QDomElement &domElement = m_document->createElement(node);
     element.appendChild(domElement);
+    clearIndex();
     return domElement;
 }
 
@@ -117,12 +117,14 @@ public:
 
     /*!
      * Init document by given name.
+     * The file is not touched until the document is saved.
      */
     bool load(const QString &name);
     /*!
      * Save xml stream data to local.
+     * Written to a temporary file first and renamed over the target.
      */
-    void save() const;
+    bool save() const;
     /*!
      * Reset xml stream data.
      */
@@ -148,7 +150,7 @@ public:
     /*!
      * Xml stream data to byteArray.
      */
-    QByteArray toByteArray() const;
+    QByteArray toByteArray(int indent = 1) const;
 
     /*!
      * Create processing instruction in header.
@@ -238,8 +240,18 @@ public:
     void writeAttribute(QDomElement &element, const TTKXmlAttrList &attr) const;
 
 protected:
+    /*!
+     * Find the first element by tagName in document order.
+     */
+    QDomElement findElementByTagName(const QString &tagName) const;
+    /*!
+     * Drop the first element index of the current document.
+     */
+    void clearIndex() const;
+
     QFile *m_file;
     QDomDocument *m_document;
+    mutable QHash<QString, QDomElement> m_elements;
 
 };
 
@@ -0,0 +1,355 @@
+#include "ttkasynclogger.h"
+
+#include <chrono>
+#include <algorithm>
+#include <QCoreApplication>
+
+// per thread ring buffer capacity, must be power of two
+#ifndef TTK_LOG_BUFFER_SIZE
+#  define TTK_LOG_BUFFER_SIZE   1024
+#endif
+
+/*! @brief The class of the log record item.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct TTKLogRecord
+{
+    qint64 m_timestamp;
+    int m_level;
+    int m_line;
+    const char *m_file;
+    QString m_message;
+
+    TTKLogRecord() noexcept
+        : m_timestamp(0),
+          m_level(TTK_LOG_LEVEL_TRACE),
+          m_line(0),
+          m_file(nullptr)
+    {
+
+    }
+
+    inline bool operator<(const TTKLogRecord &other) const noexcept
+    {
+        return m_timestamp < other.m_timestamp;
+    }
+};
+
+
+/*! @brief The class of the single producer single consumer log ring buffer.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTKLogRingBuffer
+{
+public:
+    explicit TTKLogRingBuffer(size_t capacity)
+        : m_records(capacity),
+          m_mask(capacity - 1),
+          m_head(0),
+          m_tail(0)
+    {
+
+    }
+
+    inline bool push(TTKLogRecord &record) noexcept
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if(head - m_tail.load(std::memory_order_acquire) > m_mask)
+        {
+            return false;
+        }
+
+        std::swap(m_records[head & m_mask], record);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    inline bool pop(TTKLogRecord &record) noexcept
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if(tail == m_head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        std::swap(m_records[tail & m_mask], record);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    inline size_t size() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    inline size_t capacity() const noexcept
+    {
+        return m_mask + 1;
+    }
+
+private:
+    std::vector<TTKLogRecord> m_records;
+    const size_t m_mask;
+    alignas(64) std::atomic<size_t> m_head;
+    alignas(64) std::atomic<size_t> m_tail;
+
+};
+
+
+static void shutdownLogger()
+{
+    TTKAsyncLogger::instance()->shutdown();
+}
+
+TTKAsyncLogger *TTKAsyncLogger::instance()
+{
+    // never destroyed, joining a thread in a static destructor of a library deadlocks on the windows loader lock
+    static TTKAsyncLogger *logger = []()
+    {
+        TTKAsyncLogger *logger = new TTKAsyncLogger;
+        qAddPostRoutine(shutdownLogger);
+        return logger;
+    }();
+    return logger;
+}
+
+void TTKAsyncLogger::setOutputFile(const QString &path, qint64 maxSize, int maxFiles)
+{
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    if(m_file.isOpen())
+    {
+        m_file.close();
+    }
+
+    m_file.setFileName(path);
+    m_maxSize = maxSize;
+    m_maxFiles = qMax(1, maxFiles);
+
+    if(!path.isEmpty())
+    {
+        m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+    }
+}
+
+void TTKAsyncLogger::append(int level, const char *file, int line, QString &message)
+{
+    TTKLogRecord record;
+    record.m_timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    record.m_level = level;
+    record.m_line = line;
+    record.m_file = file;
+    record.m_message.swap(message);
+
+    // counted before the running check, shutdown waits for the pushes that saw it running
+    m_appending.fetch_add(1);
+    if(!m_running.load())
+    {
+        m_appending.fetch_sub(1);
+        // no consumer left after shutdown
+        std::lock_guard<std::mutex> lock(m_fileMutex);
+        write(record);
+        if(m_file.isOpen())
+        {
+            m_file.flush();
+        }
+        return;
+    }
+
+    TTKLogRingBuffer *buffer = localBuffer();
+    if(!buffer->push(record))
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_appending.fetch_sub(1);
+
+    if(level >= TTK_LOG_LEVEL_FATAL)
+    {
+        flush();
+    }
+    else if(buffer->size() > (buffer->capacity() >> 1))
+    {
+        m_condition.notify_one();
+    }
+}
+
+void TTKAsyncLogger::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const quint64 request = ++m_flushRequest;
+    m_condition.notify_all();
+    m_flushCondition.wait(lock, [&]() { return m_flushDone >= request || !m_running; });
+}
+
+void TTKAsyncLogger::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_running)
+        {
+            return;
+        }
+        m_running = false;
+    }
+    m_condition.notify_all();
+    m_flushCondition.notify_all();
+
+    if(m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    // records pushed while the consumer made its last round, drained once no push is in flight
+    while(m_appending.load() != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    std::vector<TTKLogRecord> records;
+    drain(records);
+}
+
+TTKAsyncLogger::TTKAsyncLogger()
+    : m_level(TTK_LOG_LEVEL),
+      m_console(true),
+      m_dropped(0),
+      m_running(true),
+      m_appending(0),
+      m_flushRequest(0),
+      m_flushDone(0),
+      m_maxSize(0),
+      m_maxFiles(5)
+{
+    m_thread = std::thread(&TTKAsyncLogger::run, this);
+}
+
+TTKLogRingBuffer *TTKAsyncLogger::localBuffer()
+{
+    thread_local std::shared_ptr<TTKLogRingBuffer> buffer = [this]()
+    {
+        std::shared_ptr<TTKLogRingBuffer> buffer(new TTKLogRingBuffer(TTK_LOG_BUFFER_SIZE));
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        m_buffers.push_back(buffer);
+        return buffer;
+    }();
+    return buffer.get();
+}
+
+void TTKAsyncLogger::run()
+{
+    std::vector<TTKLogRecord> records;
+    bool running = true;
+
+    while(running)
+    {
+        quint64 request = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait_for(lock, std::chrono::milliseconds(20), [&]() { return m_flushRequest != m_flushDone || !m_running; });
+            running = m_running;
+            request = m_flushRequest;
+        }
+
+        drain(records);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_flushDone = request;
+        }
+        m_flushCondition.notify_all();
+    }
+}
+
+void TTKAsyncLogger::drain(std::vector<TTKLogRecord> &records)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        for(auto it = m_buffers.begin(); it != m_buffers.end();)
+        {
+            TTKLogRingBuffer *buffer = it->get();
+            TTKLogRecord record;
+            while(buffer->pop(record))
+            {
+                records.push_back(std::move(record));
+                record = TTKLogRecord();
+            }
+
+            // owner thread has exited and nothing left to consume
+            if(it->use_count() == 1 && buffer->size() == 0)
+            {
+                it = m_buffers.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    if(records.empty())
+    {
+        return;
+    }
+
+    std::stable_sort(records.begin(), records.end());
+
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    for(const TTKLogRecord &record : records)
+    {
+        write(record);
+    }
+
+    if(m_file.isOpen())
+    {
+        m_file.flush();
+    }
+    records.clear();
+}
+
+void TTKAsyncLogger::write(const TTKLogRecord &record)
+{
+    static const char levels[] = "TDIWEF";
+    const QDateTime &dateTime = QDateTime::fromMSecsSinceEpoch(record.m_timestamp / 1000);
+    QString message = record.m_message;
+    if(message.endsWith(' '))
+    {
+        message.chop(1);
+    }
+
+    const QString &line = QString("[%1][%2][%3(%4)] %5").arg(dateTime.toString("yyyy-MM-dd hh:mm:ss:zzz"))
+                                                           .arg(QLatin1Char(levels[qBound(0, record.m_level, TTK_LOG_LEVEL_FATAL)]))
+                                                           .arg(record.m_file).arg(record.m_line).arg(message);
+    if(m_console.load(std::memory_order_relaxed))
+    {
+#if QT_VERSION < QT_VERSION_CHECK(5,4,0)
+        qDebug() << qPrintable(line);
+#else
+        qDebug().noquote() << line;
+#endif
+    }
+
+    if(m_file.isOpen())
+    {
+        m_file.write(line.toUtf8());
+        m_file.write("\n", 1);
+
+        if(m_maxSize > 0 && m_file.size() >= m_maxSize)
+        {
+            rotate();
+        }
+    }
+}
+
+void TTKAsyncLogger::rotate()
+{
+    const QString &path = m_file.fileName();
+    m_file.close();
+
+    QFile::remove(QString("%1.%2").arg(path).arg(m_maxFiles));
+    for(int i = m_maxFiles - 1; i >= 1; --i)
+    {
+        QFile::rename(QString("%1.%2").arg(path).arg(i), QString("%1.%2").arg(path).arg(i + 1));
+    }
+
+    QFile::rename(path, path + ".1");
+    m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+}
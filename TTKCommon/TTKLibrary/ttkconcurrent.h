@@ -20,15 +20,10 @@
  ***************************************************************************/
 
 #include "ttkqtglobal.h"
+#include "ttkthreadpool.h"
 
-#if TTK_QT_VERSION_CHECK(5,0,0)
-#  include <QtConcurrent/QtConcurrent>
-#else
-#  include <QtConcurrentRun>
-#endif
-
-// marco concurrent
-#define TTKConcurrent_1(data) const auto TTK_CAT(ext_status_, __LINE__) = QtConcurrent::run([&]() data );
+// marco concurrent, runs on the shared thread pool
+#define TTKConcurrent_1(data) const auto TTK_CAT(ext_status_, __LINE__) = TTKThreadPool::instance()->run([&]() data );
 
 #ifndef Q_CC_MSVC
 #  define TTKConcurrent(...) TTK_PP_OVERLOAD(TTKConcurrent_, __VA_ARGS__)(__VA_ARGS__)
@@ -8,12 +8,26 @@ namespace TTK
     static const char *base64_chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
     /*!
-     * Char is base64 or not.
+     * Base64 char to its six bits value, 0xFF is not a base64 char.
      */
-    inline static bool isBase64(unsigned char c)
-    {
-        return isalnum(c) || (c == '+') || (c == '/');
-    }
+    static const unsigned char base64_table[256] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+        0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+        0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+    };
 
     /*!
      * Bse64 encode.
@@ -29,110 +43,72 @@ namespace TTK
 TTKString TTK::base64Encode(const unsigned char *bytes, unsigned int length)
 {
     TTKString ret;
-    int i = 0, j = 0;
-    unsigned char char_array_3[3], char_array_4[4];
+    ret.resize((length + 2) / 3 * 4);
 
-    while(length--)
+    char *out = &ret[0];
+    const unsigned char *end = bytes + length - length % 3;
+    for(; bytes != end; bytes += 3)
     {
-        char_array_3[i++] = *(bytes++);
-        if(i == 3)
-        {
-            char_array_4[0] = (char_array_3[0] & 0xFC) >> 2;
-            char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xF0) >> 4);
-            char_array_4[2] = ((char_array_3[1] & 0x0F) << 2) + ((char_array_3[2] & 0xC0) >> 6);
-            char_array_4[3] = char_array_3[2] & 0x3F;
-
-            for(i = 0; i < 4; ++i)
-            {
-                ret += base64_chars[char_array_4[i]];
-            }
-            i = 0;
-        }
+        const unsigned int value = (bytes[0] << 16) | (bytes[1] << 8) | bytes[2];
+        *out++ = base64_chars[(value >> 18) & 0x3F];
+        *out++ = base64_chars[(value >> 12) & 0x3F];
+        *out++ = base64_chars[(value >> 6) & 0x3F];
+        *out++ = base64_chars[value & 0x3F];
     }
 
-    if(i)
+    const unsigned int rest = length % 3;
+    if(rest)
     {
-        for(j = i; j < 3; ++j)
-        {
-            char_array_3[j] = '\0';
-        }
-
-        char_array_4[0] = (char_array_3[0] & 0xFC) >> 2;
-        char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xF0) >> 4);
-        char_array_4[2] = ((char_array_3[1] & 0x0F) << 2) + ((char_array_3[2] & 0xC0) >> 6);
-        char_array_4[3] = char_array_3[2] & 0x3F;
-
-        for(j = 0; j < i + 1; ++j)
-        {
-            ret += base64_chars[char_array_4[j]];
-        }
-
-        while((i++ < 3))
-        {
-            ret += '=';
-        }
-
+        const unsigned int value = (bytes[0] << 16) | (rest == 2 ? bytes[1] << 8 : 0);
+        *out++ = base64_chars[(value >> 18) & 0x3F];
+        *out++ = base64_chars[(value >> 12) & 0x3F];
+        *out++ = rest == 2 ? base64_chars[(value >> 6) & 0x3F] : '=';
+        *out++ = '=';
     }
     return ret;
 }
 
 TTKString TTK::base64Decode(const TTKString &bytes)
 {
-    int length = bytes.length();
-    int i = 0, j = 0, in = 0;
-    unsigned char char_array_4[4], char_array_3[3];
+    // stops at the padding or at the first char out of the alphabet
+    const unsigned char *data = (const unsigned char *)bytes.data();
+    size_t length = 0;
+    while(length < bytes.length() && base64_table[data[length]] != 0xFF)
+    {
+        ++length;
+    }
 
     TTKString ret;
-    const TTKString container(base64_chars);
+    ret.resize(length / 4 * 3 + (length % 4 > 1 ? length % 4 - 1 : 0));
 
-    while(length-- && (bytes[in] != '=') && isBase64(bytes[in]))
+    char *out = &ret[0];
+    const unsigned char *end = data + length - length % 4;
+    for(; data != end; data += 4)
     {
-        char_array_4[i++] = bytes[in]; in++;
-        if(i ==4)
-        {
-            for(i = 0; i < 4; ++i)
-            {
-                char_array_4[i] = container.find(char_array_4[i]);
-            }
-
-            char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-            char_array_3[1] = ((char_array_4[1] & 0xF) << 4) + ((char_array_4[2] & 0x3C) >> 2);
-            char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-
-            for(i = 0; i < 3; ++i)
-            {
-                ret += char_array_3[i];
-            }
-            i = 0;
-        }
+        const unsigned int value = (base64_table[data[0]] << 18) | (base64_table[data[1]] << 12) | (base64_table[data[2]] << 6) | base64_table[data[3]];
+        *out++ = char(value >> 16);
+        *out++ = char(value >> 8);
+        *out++ = char(value);
     }
 
-    if(i)
+    const size_t rest = length % 4;
+    if(rest > 1)
     {
-        for(j = i; j < 4; ++j)
+        unsigned int value = (base64_table[data[0]] << 18) | (base64_table[data[1]] << 12);
+        if(rest == 3)
         {
-            char_array_4[j] = 0;
+            value |= base64_table[data[2]] << 6;
         }
 
-        for(j = 0; j < 4; ++j)
+        *out++ = char(value >> 16);
+        if(rest == 3)
         {
-            char_array_4[j] = container.find(char_array_4[j]);
-        }
-
-        char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-        char_array_3[1] = ((char_array_4[1] & 0xF) << 4) + ((char_array_4[2] & 0x3C) >> 2);
-        char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-
-        for(j = 0; j < i - 1; ++j)
-        {
-            ret += char_array_3[j];
+            *out++ = char(value >> 8);
         }
     }
-
     return ret;
 }
 
-
 TTKCryptographicHash::TTKCryptographicHash()
 {
 
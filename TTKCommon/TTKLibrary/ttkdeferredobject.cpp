@@ -0,0 +1,53 @@
+#include "ttkdeferredobject.h"
+#include "ttktracer.h"
+
+TTKIdleTaskQueue::TTKIdleTaskQueue(QObject *parent)
+    : QObject(parent),
+      m_started(false)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, SIGNAL(timeout()), SLOT(runNext()));
+}
+
+TTKIdleTaskQueue *TTKIdleTaskQueue::instance()
+{
+    static TTKIdleTaskQueue queue;
+    return &queue;
+}
+
+void TTKIdleTaskQueue::append(const char *name, const std::function<void()> &task)
+{
+    Task item;
+    item.m_name = name;
+    item.m_task = task;
+    m_tasks << item;
+
+    if(m_started && !m_timer.isActive())
+    {
+        m_timer.start(0);
+    }
+}
+
+void TTKIdleTaskQueue::start(int delay)
+{
+    m_started = true;
+    m_timer.start(delay);
+}
+
+void TTKIdleTaskQueue::runNext()
+{
+    if(m_tasks.isEmpty())
+    {
+        Q_EMIT finished();
+        return;
+    }
+
+    const Task task = m_tasks.takeFirst();
+    {
+        const TTKTraceScope scope(task.m_name);
+        task.m_task();
+    }
+
+    // zero timer lets pending paint and input events run before the next task
+    m_timer.start(0);
+}
@@ -0,0 +1,152 @@
+#ifndef TTKDEFERREDOBJECT_H
+#define TTKDEFERREDOBJECT_H
+
+/***************************************************************************
+ * This file is part of the TTK Library Module project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QTimer>
+#include <functional>
+#include "ttkmoduleexport.h"
+
+/*! @brief The class of the ttk deferred object.
+ * The object is built by the factory on first use, which keeps heavy and
+ * rarely used widgets off the startup path.
+ * @author Greedysky <greedysky@163.com>
+ */
+template <typename T>
+class TTKDeferredObject
+{
+public:
+    using Factory = std::function<T*()>;
+
+    /*!
+     * Object constructor.
+     */
+    TTKDeferredObject()
+        : m_object(nullptr)
+    {
+
+    }
+
+    /*!
+     * Object destructor.
+     */
+    ~TTKDeferredObject()
+    {
+        reset();
+    }
+
+    /*!
+     * Set the factory of the object.
+     */
+    inline void setFactory(const Factory &factory) { m_factory = factory; }
+
+    /*!
+     * Get the object, build it when it does not exist.
+     */
+    T *get()
+    {
+        if(!m_object && m_factory)
+        {
+            m_object = m_factory();
+        }
+        return m_object;
+    }
+    /*!
+     * Get the object without building it.
+     */
+    inline T *data() const { return m_object; }
+    /*!
+     * Check the object is built.
+     */
+    inline bool isCreated() const { return m_object != nullptr; }
+    /*!
+     * Delete the object, the next use builds it again.
+     */
+    void reset()
+    {
+        delete m_object;
+        m_object = nullptr;
+    }
+
+    inline T *operator->() { return get(); }
+
+    TTK_DISABLE_COPY(TTKDeferredObject)
+
+private:
+    T *m_object;
+    Factory m_factory;
+
+};
+
+
+/*! @brief The class of the ttk idle task queue.
+ * Tasks run one by one on the event loop once started, so the first paint
+ * happens before them and input is handled between them.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT TTKIdleTaskQueue : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(TTKIdleTaskQueue)
+public:
+    /*!
+     * Get the global idle task queue.
+     */
+    static TTKIdleTaskQueue *instance();
+
+    /*!
+     * Append the task by name, name must be a string literal.
+     */
+    void append(const char *name, const std::function<void()> &task);
+    /*!
+     * Start to run tasks after delay msec.
+     */
+    void start(int delay = 0);
+
+Q_SIGNALS:
+    /*!
+     * All tasks are finished.
+     */
+    void finished();
+
+private Q_SLOTS:
+    /*!
+     * Run the next task.
+     */
+    void runNext();
+
+private:
+    /*!
+     * Object constructor.
+     */
+    explicit TTKIdleTaskQueue(QObject *parent = nullptr);
+
+    struct Task
+    {
+        const char *m_name;
+        std::function<void()> m_task;
+    };
+
+    bool m_started;
+    QTimer m_timer;
+    QList<Task> m_tasks;
+
+};
+
+#endif // TTKDEFERREDOBJECT_H
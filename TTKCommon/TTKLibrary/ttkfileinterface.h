@@ -19,8 +19,7 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
-#include <QFile>
-#include "ttkmoduleexport.h"
+#include "ttksavefile.h"
 
 /*! @brief The class of the ttk file interface.
  * @author Greedysky <greedysky@163.com>
@@ -39,6 +38,7 @@ public:
 
     /*!
      * Write datas from file by given name.
+     * The target is replaced only when the file is closed without errors.
      */
     inline bool load(const QString &name)
     {
@@ -56,7 +56,7 @@ public:
     }
 
 protected:
-    QFile m_file;
+    TTKSaveFile m_file;
 
 };
 
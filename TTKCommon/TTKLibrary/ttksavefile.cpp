@@ -0,0 +1,167 @@
+#include "ttksavefile.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QCoreApplication>
+#if TTK_QT_VERSION_CHECK(5,1,0)
+#  include <QSaveFile>
+#endif
+
+#ifdef Q_OS_WIN
+#  include <qt_windows.h>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <stdio.h>
+#endif
+
+static QString temporaryName(const QString &target)
+{
+    // unique per process and session, writers of the same target do not share the temporary file
+    static QAtomicInt count;
+    return QString("%1.%2.%3.tmp").arg(target).arg(QCoreApplication::applicationPid()).arg(count.fetchAndAddRelaxed(1));
+}
+
+static bool syncFile(QFile *file)
+{
+#ifdef Q_OS_WIN
+    // handle() is -1 for files opened by name, the data is flushed through a handle of its own
+    const HANDLE handle = CreateFileW(TTKReinterpretCast(const wchar_t*, QDir::toNativeSeparators(file->fileName()).utf16()), GENERIC_WRITE,
+                                      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    const bool v = FlushFileBuffers(handle);
+    CloseHandle(handle);
+    return v;
+#else
+    return fsync(file->handle()) == 0;
+#endif
+}
+
+static bool replaceFile(const QString &source, const QString &target)
+{
+#ifdef Q_OS_WIN
+    return MoveFileExW(TTKReinterpretCast(const wchar_t*, source.utf16()), TTKReinterpretCast(const wchar_t*, target.utf16()), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+    // rename over an existing file is atomic on posix file systems
+    if(::rename(QFile::encodeName(source).constData(), QFile::encodeName(target).constData()) != 0)
+    {
+        return false;
+    }
+
+    // the new directory entry is durable only once the directory is synced
+    const int fd = ::open(QFile::encodeName(QFileInfo(target).absolutePath()).constData(), O_RDONLY);
+    if(fd >= 0)
+    {
+        fsync(fd);
+        ::close(fd);
+    }
+    return true;
+#endif
+}
+
+
+TTKSaveFile::TTKSaveFile()
+    : QFile(),
+      m_committed(false),
+      m_canceled(false)
+{
+
+}
+
+TTKSaveFile::TTKSaveFile(const QString &name)
+    : QFile(name),
+      m_committed(false),
+      m_canceled(false)
+{
+
+}
+
+TTKSaveFile::~TTKSaveFile()
+{
+    // the base destructor can not reach the override
+    close();
+}
+
+bool TTKSaveFile::open(OpenMode mode)
+{
+    if(!(mode & QIODevice::WriteOnly) || (mode & (QIODevice::ReadOnly | QIODevice::Append)))
+    {
+        return QFile::open(mode);
+    }
+
+    m_committed = false;
+    m_canceled = false;
+    m_target = fileName();
+    setFileName(temporaryName(m_target));
+
+    if(!QFile::open(mode | QIODevice::Truncate))
+    {
+        setFileName(m_target);
+        m_target.clear();
+        return false;
+    }
+    return true;
+}
+
+void TTKSaveFile::close()
+{
+    if(m_target.isEmpty())
+    {
+        QFile::close();
+        return;
+    }
+
+    const bool ok = !m_canceled && isOpen() && flush() && syncFile(this) && error() == QFile::NoError;
+    QFile::close();
+
+    const QString temp = fileName();
+    setFileName(m_target);
+    m_target.clear();
+
+    m_committed = ok && replaceFile(QDir::toNativeSeparators(temp), QDir::toNativeSeparators(fileName()));
+    if(!m_committed)
+    {
+        QFile::remove(temp);
+        if(!m_canceled)
+        {
+            TTK_ERROR_STREAM("Save file error:" << fileName());
+        }
+    }
+}
+
+void TTKSaveFile::cancelWriting()
+{
+    if(!m_target.isEmpty())
+    {
+        m_canceled = true;
+        close();
+    }
+}
+
+bool TTKSaveFile::writeFile(const QString &name, const QByteArray &data)
+{
+#if TTK_QT_VERSION_CHECK(5,1,0)
+    QSaveFile file(name);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size() && file.commit();
+#else
+    TTKSaveFile file(name);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    if(file.write(data) != data.size())
+    {
+        // an unfinished write must not replace the target
+        file.cancelWriting();
+        return false;
+    }
+
+    file.close();
+    return file.isCommitted();
+#endif
+}
@@ -0,0 +1,78 @@
+#ifndef TTKSAVEFILE_H
+#define TTKSAVEFILE_H
+
+/***************************************************************************
+ * This file is part of the TTK Library Module project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QFile>
+#include "ttkmoduleexport.h"
+
+/*! @brief The class of the ttk atomic save file.
+ * Write only mode goes to a temporary file beside the target, which is
+ * synced to disk and renamed over the target on close, so a crash while
+ * writing leaves the previous file untouched.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT TTKSaveFile : public QFile
+{
+    TTK_DECLARE_MODULE(TTKSaveFile)
+public:
+    /*!
+     * Object constructor.
+     */
+    TTKSaveFile();
+    /*!
+     * Object constructor by given name.
+     */
+    explicit TTKSaveFile(const QString &name);
+    /*!
+     * Object destructor.
+     */
+    ~TTKSaveFile();
+
+    using QFile::open;
+    /*!
+     * Open the file, write only mode is redirected to the temporary file.
+     */
+    virtual bool open(OpenMode mode) override;
+    /*!
+     * Close the file, the temporary file is committed when nothing failed.
+     */
+    virtual void close() override;
+
+    /*!
+     * Drop the temporary file, the target keeps the previous content.
+     */
+    void cancelWriting();
+    /*!
+     * Check the last write only session replaced the target.
+     */
+    inline bool isCommitted() const { return m_committed; }
+
+    /*!
+     * Write data into the file by given name atomically.
+     */
+    static bool writeFile(const QString &name, const QByteArray &data);
+
+private:
+    QString m_target;
+    bool m_committed, m_canceled;
+
+};
+
+#endif // TTKSAVEFILE_H
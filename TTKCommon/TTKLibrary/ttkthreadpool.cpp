@@ -0,0 +1,455 @@
+#include "ttkthreadpool.h"
+
+#include <QThread>
+#include <QCoreApplication>
+
+static constexpr int PRIORITY_COUNT = 3;
+// short tasks keep at least two workers while long jobs run
+static constexpr int MIN_THREAD_COUNT = 4;
+
+static thread_local TTKThreadPool *t_pool = nullptr;
+static thread_local int t_worker = -1;
+
+/*! @brief The class of the ttk task continuation event.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTKTaskEvent : public QEvent
+{
+public:
+    explicit TTKTaskEvent(const std::function<void()> &function)
+        : QEvent(type()),
+          m_function(function)
+    {
+
+    }
+
+    static QEvent::Type type()
+    {
+        static const QEvent::Type type = TTKStaticCast(QEvent::Type, QEvent::registerEventType());
+        return type;
+    }
+
+    std::function<void()> m_function;
+
+};
+
+/*! @brief The class of the ttk task continuation dispatcher, lives in the gui thread.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTKTaskDispatcher : public QObject
+{
+public:
+    static TTKTaskDispatcher *instance()
+    {
+        static std::mutex mutex;
+        static QPointer<TTKTaskDispatcher> dispatcher;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!dispatcher)
+        {
+            dispatcher = create();
+        }
+        return dispatcher;
+    }
+
+protected:
+    virtual void customEvent(QEvent *event) override final
+    {
+        if(event->type() == TTKTaskEvent::type())
+        {
+            static_cast<TTKTaskEvent*>(event)->m_function();
+        }
+    }
+
+private:
+    static TTKTaskDispatcher *create()
+    {
+        QCoreApplication *app = QCoreApplication::instance();
+        if(!app)
+        {
+            return nullptr;
+        }
+
+        TTKTaskDispatcher *dispatcher = new TTKTaskDispatcher;
+        dispatcher->moveToThread(app->thread());
+        dispatcher->setParent(app);
+        return dispatcher;
+    }
+
+};
+
+
+TTKTaskState::TTKTaskState(const TTKCancelToken &token)
+    : m_token(token),
+      m_finished(false),
+      m_ran(false)
+{
+
+}
+
+void TTKTaskState::finish(bool ran)
+{
+    std::vector<Continuation> continuations;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finished = true;
+        m_ran = ran;
+        continuations.swap(m_continuations);
+    }
+    m_condition.notify_all();
+
+    if(!ran || isCanceled())
+    {
+        return;
+    }
+
+    for(const Continuation &continuation : continuations)
+    {
+        dispatch(continuation);
+    }
+}
+
+bool TTKTaskState::isFinished() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_finished;
+}
+
+void TTKTaskState::wait()
+{
+    TTKThreadPool *pool = TTKThreadPool::instance();
+    if(pool->isWorkerThread())
+    {
+        // a waiting worker helps, so tasks waiting for their child tasks can not starve the pool
+        while(!isFinished())
+        {
+            if(!pool->runPendingTask())
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait_for(lock, std::chrono::milliseconds(1), [this]() { return m_finished; });
+            }
+        }
+        return;
+    }
+
+    if(isCanceled())
+    {
+        // a canceled blocking task may still wait for the budget in the queue
+        pool->sweep();
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]() { return m_finished; });
+}
+
+void TTKTaskState::then(QObject *context, const std::function<void()> &function)
+{
+    Continuation continuation;
+    continuation.m_guarded = context != nullptr;
+    continuation.m_context = context;
+    continuation.m_function = function;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_finished)
+        {
+            m_continuations.push_back(continuation);
+            return;
+        }
+
+        if(!m_ran)
+        {
+            return;
+        }
+    }
+
+    if(!isCanceled())
+    {
+        dispatch(continuation);
+    }
+}
+
+void TTKTaskState::dispatch(const Continuation &continuation)
+{
+    const std::function<void()> function = [continuation]()
+    {
+        if(!continuation.m_guarded || continuation.m_context)
+        {
+            continuation.m_function();
+        }
+    };
+
+    TTKTaskDispatcher *dispatcher = TTKTaskDispatcher::instance();
+    if(dispatcher)
+    {
+        QCoreApplication::postEvent(dispatcher, new TTKTaskEvent(function));
+    }
+    else
+    {
+        // no event loop to marshal to, run in place
+        function();
+    }
+}
+
+
+TTKThreadPool::TTKThreadPool()
+    : m_running(true),
+      m_sweep(false),
+      m_closed(false),
+      m_pending(0),
+      m_active(0),
+      m_blocking(0),
+      m_pendingBlocking(0),
+      m_next(0)
+{
+    const int count = qMax(MIN_THREAD_COUNT, QThread::idealThreadCount());
+    m_maxBlocking = count / 2;
+    for(int i = 0; i < count; ++i)
+    {
+        m_workers.emplace_back(new Worker);
+    }
+
+    for(int i = 0; i < count; ++i)
+    {
+        m_workers[i]->m_thread = std::thread(&TTKThreadPool::workerLoop, this, i);
+    }
+}
+
+TTKThreadPool::~TTKThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_condition.notify_all();
+
+    for(const std::unique_ptr<Worker> &worker : m_workers)
+    {
+        worker->m_thread.join();
+    }
+}
+
+TTKThreadPool *TTKThreadPool::instance()
+{
+    static TTKThreadPool pool;
+    return &pool;
+}
+
+bool TTKThreadPool::isWorkerThread() const
+{
+    return t_pool == this && t_worker >= 0;
+}
+
+void TTKThreadPool::waitForDone()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idleCondition.wait(lock, [this]() { return m_pending == 0 && m_active == 0; });
+}
+
+void TTKThreadPool::shutdown()
+{
+    m_closed = true;
+    for(const std::unique_ptr<Worker> &worker : m_workers)
+    {
+        std::lock_guard<std::mutex> lock(worker->m_mutex);
+        for(std::deque<Task> &queue : worker->m_queues)
+        {
+            for(const Task &task : queue)
+            {
+                task.m_state->cancel();
+            }
+        }
+    }
+
+    sweep();
+    waitForDone();
+}
+
+void TTKThreadPool::post(const std::shared_ptr<TTKTaskState> &state, const std::function<void()> &function, Priority priority, bool blocking)
+{
+    Task task;
+    task.m_blocking = blocking;
+    task.m_counted = false;
+    task.m_state = state;
+    task.m_function = function;
+
+    if(m_closed)
+    {
+        // only finishes its state, the objects it uses may be gone
+        state->cancel();
+    }
+
+    {
+        // counted before it can be taken, so the count never drops below zero
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pending;
+        if(blocking)
+        {
+            ++m_pendingBlocking;
+        }
+    }
+
+    // the others are spread round robin, stealing evens them out later
+    const int index = isWorkerThread() ? t_worker : TTKStaticCast(int, m_next++ % m_workers.size());
+    Worker *worker = m_workers[index].get();
+    {
+        std::lock_guard<std::mutex> lock(worker->m_mutex);
+        worker->m_queues[TTKStaticCast(int, priority)].push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+bool TTKThreadPool::take(int index, Task *task)
+{
+    const int count = threadCount();
+    for(int priority = 0; priority < PRIORITY_COUNT; ++priority)
+    {
+        if(index >= 0)
+        {
+            // the newest task of its own is the one still hot in cache
+            Worker *worker = m_workers[index].get();
+            std::lock_guard<std::mutex> lock(worker->m_mutex);
+
+            if(take(worker->m_queues[priority], true, task))
+            {
+                return true;
+            }
+        }
+
+        for(int i = 1; i <= count; ++i)
+        {
+            const int victim = (qMax(index, 0) + i) % count;
+            if(victim == index)
+            {
+                continue;
+            }
+
+            Worker *worker = m_workers[victim].get();
+            std::lock_guard<std::mutex> lock(worker->m_mutex);
+
+            if(take(worker->m_queues[priority], false, task))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool TTKThreadPool::take(std::deque<Task> &queue, bool newest, Task *task)
+{
+    const int size = TTKStaticCast(int, queue.size());
+    for(int i = 0; i < size; ++i)
+    {
+        const std::deque<Task>::iterator it = queue.begin() + (newest ? size - 1 - i : i);
+        bool counted = false;
+        // a canceled task only finishes its state, it never waits for the budget
+        if(it->m_blocking && !it->m_state->isCanceled())
+        {
+            int blocking = m_blocking;
+            while(blocking < m_maxBlocking && !m_blocking.compare_exchange_weak(blocking, blocking + 1));
+
+            if(blocking >= m_maxBlocking)
+            {
+                continue;
+            }
+            counted = true;
+        }
+
+        *task = std::move(*it);
+        task->m_counted = counted;
+        queue.erase(it);
+
+        ++m_active;
+        --m_pending;
+        if(task->m_blocking)
+        {
+            --m_pendingBlocking;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool TTKThreadPool::hasRunnableTask() const
+{
+    return m_pending > m_pendingBlocking || (m_pendingBlocking > 0 && m_blocking < m_maxBlocking);
+}
+
+void TTKThreadPool::sweep()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sweep = true;
+    }
+    m_condition.notify_all();
+}
+
+void TTKThreadPool::execute(Task &task)
+{
+    const bool ran = !task.m_state->isCanceled();
+    if(ran)
+    {
+        task.m_function();
+    }
+    task.m_state->finish(ran);
+
+    if(task.m_counted)
+    {
+        // the queued blocking tasks may be taken now
+        --m_blocking;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_condition.notify_all();
+    }
+
+    if(--m_active == 0 && m_pending == 0)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_idleCondition.notify_all();
+    }
+}
+
+bool TTKThreadPool::runPendingTask()
+{
+    Task task;
+    if(!take(t_worker, &task))
+    {
+        return false;
+    }
+
+    execute(task);
+    return true;
+}
+
+void TTKThreadPool::workerLoop(int index)
+{
+    t_pool = this;
+    t_worker = index;
+
+    while(true)
+    {
+        Task task;
+        if(take(index, &task))
+        {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if(m_pendingBlocking > 0)
+        {
+            // blocking tasks canceled while waiting for the budget and never waited for are swept on the next round
+            m_condition.wait_for(lock, std::chrono::milliseconds(10), [this]() { return !m_running || m_sweep || hasRunnableTask(); });
+        }
+        else
+        {
+            m_condition.wait(lock, [this]() { return !m_running || m_sweep || hasRunnableTask(); });
+        }
+        m_sweep = false;
+
+        if(!m_running)
+        {
+            break;
+        }
+    }
+}
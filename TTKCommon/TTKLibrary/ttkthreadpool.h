@@ -0,0 +1,400 @@
+#ifndef TTKTHREADPOOL_H
+#define TTKTHREADPOOL_H
+
+/***************************************************************************
+ * This file is part of the TTK Library Module project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+#include <QPointer>
+#include "ttkmoduleexport.h"
+
+/*! @brief The class of the ttk cancel token.
+ * Copies share one flag, queued tasks of a canceled token are skipped and
+ * running tasks can check it to stop early.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT TTKCancelToken
+{
+public:
+    /*!
+     * Object constructor.
+     */
+    TTKCancelToken()
+        : m_canceled(std::make_shared<std::atomic<bool>>(false))
+    {
+
+    }
+
+    /*!
+     * Cancel all tasks of the token.
+     */
+    inline void cancel() { *m_canceled = true; }
+    /*!
+     * Check the token is canceled or not.
+     */
+    inline bool isCanceled() const { return *m_canceled; }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_canceled;
+
+};
+
+
+/*! @brief The class of the ttk task state shared by the pool and futures.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT TTKTaskState
+{
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit TTKTaskState(const TTKCancelToken &token);
+
+    /*!
+     * Mark the task finished and dispatch the continuations.
+     */
+    void finish(bool ran);
+    /*!
+     * Check the task is finished or not.
+     */
+    bool isFinished() const;
+    /*!
+     * Wait for the task, a pool worker runs other tasks meanwhile.
+     */
+    void wait();
+    /*!
+     * Cancel the task.
+     */
+    inline void cancel() { m_token.cancel(); }
+    /*!
+     * Check the task is canceled or not.
+     */
+    inline bool isCanceled() const { return m_token.isCanceled(); }
+    /*!
+     * Call the function on the gui thread when the task has run.
+     * It is skipped when the task is canceled or the context is destroyed.
+     */
+    void then(QObject *context, const std::function<void()> &function);
+
+private:
+    struct Continuation
+    {
+        bool m_guarded;
+        QPointer<QObject> m_context;
+        std::function<void()> m_function;
+    };
+
+    /*!
+     * Post the continuation to the gui thread.
+     */
+    static void dispatch(const Continuation &continuation);
+
+    TTKCancelToken m_token;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_finished, m_ran;
+    std::vector<Continuation> m_continuations;
+
+};
+
+
+/*! @brief The class of the ttk future base.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT TTKFutureBase
+{
+public:
+    /*!
+     * Check the future has a task or not.
+     */
+    inline bool isValid() const { return m_state != nullptr; }
+    /*!
+     * Check the task is finished or not, an invalid future is finished.
+     */
+    inline bool isFinished() const { return !m_state || m_state->isFinished(); }
+    /*!
+     * Check the task is canceled or not.
+     */
+    inline bool isCanceled() const { return m_state && m_state->isCanceled(); }
+    /*!
+     * Cancel the task.
+     */
+    inline void cancel() const { if(m_state) m_state->cancel(); }
+    /*!
+     * Wait for the task to finish.
+     */
+    inline void waitForFinished() const { if(m_state) m_state->wait(); }
+
+protected:
+    std::shared_ptr<TTKTaskState> m_state;
+
+};
+
+
+/*! @brief The class of the ttk future of the task result.
+ * @author Greedysky <greedysky@163.com>
+ */
+template <typename T>
+class TTKFuture : public TTKFutureBase
+{
+public:
+    /*!
+     * Object constructor.
+     */
+    TTKFuture() = default;
+    /*!
+     * Object constructor by state and result.
+     */
+    TTKFuture(const std::shared_ptr<TTKTaskState> &state, const std::shared_ptr<T> &result)
+        : m_result(result)
+    {
+        m_state = state;
+    }
+
+    /*!
+     * Wait for the task and get the result.
+     */
+    inline T result() const
+    {
+        waitForFinished();
+        return m_result ? *m_result : T();
+    }
+    /*!
+     * Call the function with the result on the gui thread.
+     */
+    inline const TTKFuture &then(QObject *context, const std::function<void(const T&)> &function) const
+    {
+        const std::shared_ptr<T> result = m_result;
+        m_state->then(context, [result, function]() { function(*result); });
+        return *this;
+    }
+
+private:
+    std::shared_ptr<T> m_result;
+
+};
+
+
+/*! @brief The class of the ttk future of the task without result.
+ * @author Greedysky <greedysky@163.com>
+ */
+template <>
+class TTKFuture<void> : public TTKFutureBase
+{
+public:
+    /*!
+     * Object constructor.
+     */
+    TTKFuture() = default;
+    /*!
+     * Object constructor by state.
+     */
+    explicit TTKFuture(const std::shared_ptr<TTKTaskState> &state)
+    {
+        m_state = state;
+    }
+
+    /*!
+     * Call the function on the gui thread.
+     */
+    inline const TTKFuture &then(QObject *context, const std::function<void()> &function) const
+    {
+        m_state->then(context, function);
+        return *this;
+    }
+
+};
+
+
+/*! @brief The class of the ttk work stealing thread pool.
+ * Every worker owns a deque per priority, it runs its newest task first and
+ * steals the oldest task of the others when its own deques are empty.
+ * Blocking tasks may hold a worker for minutes, at most half of the workers run them at once.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT TTKThreadPool
+{
+    TTK_DECLARE_MODULE(TTKThreadPool)
+public:
+    enum class Priority
+    {
+        High,
+        Normal,
+        Low
+    };
+
+    /*!
+     * Get the process wide thread pool.
+     */
+    static TTKThreadPool *instance();
+
+    /*!
+     * Get the count of workers.
+     */
+    inline int threadCount() const { return TTKStaticCast(int, m_workers.size()); }
+    /*!
+     * Get the count of workers that may run blocking tasks at once.
+     */
+    inline int blockingThreadCount() const { return m_maxBlocking; }
+    /*!
+     * Check the current thread is a worker of the pool or not.
+     */
+    bool isWorkerThread() const;
+
+    /*!
+     * Run the function by priority, the result type must be default constructible.
+     */
+    template <typename Function>
+    auto run(Function function, Priority priority = Priority::Normal, const TTKCancelToken &token = TTKCancelToken()) -> TTKFuture<decltype(function())>;
+    /*!
+     * Run the long function by priority, it waits in the queue while the blocking workers are busy.
+     */
+    template <typename Function>
+    auto runBlocking(Function function, Priority priority = Priority::Normal, const TTKCancelToken &token = TTKCancelToken()) -> TTKFuture<decltype(function())>;
+
+    /*!
+     * Wait until all tasks are finished, must not be called by a task.
+     */
+    void waitForDone();
+    /*!
+     * Cancel the queued tasks and wait for the running ones, later tasks are canceled at once.
+     * Call it before the objects the tasks use are destroyed, must not be called by a task.
+     */
+    void shutdown();
+
+private:
+    /*!
+     * Object constructor.
+     */
+    TTKThreadPool();
+    /*!
+     * Object destructor.
+     */
+    ~TTKThreadPool();
+
+    friend class TTKTaskState;
+
+    struct Task
+    {
+        bool m_blocking, m_counted;
+        std::shared_ptr<TTKTaskState> m_state;
+        std::function<void()> m_function;
+    };
+
+    struct Worker
+    {
+        std::mutex m_mutex;
+        std::deque<Task> m_queues[3];
+        std::thread m_thread;
+    };
+
+    template <typename T>
+    struct Runner;
+
+    /*!
+     * Queue the task, tasks posted by a worker stay on its own deques.
+     */
+    void post(const std::shared_ptr<TTKTaskState> &state, const std::function<void()> &function, Priority priority, bool blocking);
+    /*!
+     * Take the next task for the worker by index, -1 means a non worker thread.
+     */
+    bool take(int index, Task *task);
+    /*!
+     * Take the first task of the queue the blocking budget admits.
+     */
+    bool take(std::deque<Task> &queue, bool newest, Task *task);
+    /*!
+     * Check a worker has a task it may take.
+     */
+    bool hasRunnableTask() const;
+    /*!
+     * Wake the workers to finish the canceled tasks still queued.
+     */
+    void sweep();
+    /*!
+     * Run the task and finish its state.
+     */
+    void execute(Task &task);
+    /*!
+     * Run one queued task on the current worker.
+     */
+    bool runPendingTask();
+    /*!
+     * The loop of the worker by index.
+     */
+    void workerLoop(int index);
+
+    bool m_running, m_sweep;
+    int m_maxBlocking;
+    std::atomic<bool> m_closed;
+    std::atomic<int> m_pending, m_active;
+    std::atomic<int> m_blocking, m_pendingBlocking;
+    std::atomic<unsigned int> m_next;
+    std::mutex m_mutex;
+    std::condition_variable m_condition, m_idleCondition;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+};
+
+
+template <typename T>
+struct TTKThreadPool::Runner
+{
+    template <typename Function>
+    static TTKFuture<T> run(TTKThreadPool *pool, Function function, Priority priority, const TTKCancelToken &token, bool blocking)
+    {
+        const std::shared_ptr<TTKTaskState> state = std::make_shared<TTKTaskState>(token);
+        const std::shared_ptr<T> result = std::make_shared<T>();
+        pool->post(state, [function, result]() mutable { *result = function(); }, priority, blocking);
+        return TTKFuture<T>(state, result);
+    }
+};
+
+template <>
+struct TTKThreadPool::Runner<void>
+{
+    template <typename Function>
+    static TTKFuture<void> run(TTKThreadPool *pool, Function function, Priority priority, const TTKCancelToken &token, bool blocking)
+    {
+        const std::shared_ptr<TTKTaskState> state = std::make_shared<TTKTaskState>(token);
+        pool->post(state, function, priority, blocking);
+        return TTKFuture<void>(state);
+    }
+};
+
+template <typename Function>
+auto TTKThreadPool::run(Function function, Priority priority, const TTKCancelToken &token) -> TTKFuture<decltype(function())>
+{
+    return Runner<decltype(function())>::run(this, function, priority, token, false);
+}
+
+template <typename Function>
+auto TTKThreadPool::runBlocking(Function function, Priority priority, const TTKCancelToken &token) -> TTKFuture<decltype(function())>
+{
+    return Runner<decltype(function())>::run(this, function, priority, token, true);
+}
+
+#endif // TTKTHREADPOOL_H
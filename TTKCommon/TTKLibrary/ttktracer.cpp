@@ -0,0 +1,168 @@
+#include "ttktracer.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+#include <atomic>
+
+namespace
+{
+struct TraceEvent
+{
+    const char *m_name;
+    char m_phase;
+    qint64 m_start;
+    qint64 m_duration;
+    int m_thread;
+};
+
+struct TraceData
+{
+    // read without the lock by now() and isEnabled(), the clock is set before it is raised
+    std::atomic<bool> m_enabled{false};
+    QString m_path;
+    QMutex m_mutex;
+    QElapsedTimer m_clock;
+    QVector<TraceEvent> m_events;
+    QList<Qt::HANDLE> m_threads;
+};
+}
+
+static TraceData *traceData()
+{
+    static TraceData data;
+    return &data;
+}
+
+/*!
+ * Small thread id in order of the first event, the main thread is zero.
+ */
+static int threadIndex(TraceData *data)
+{
+    const Qt::HANDLE thread = QThread::currentThreadId();
+    int index = data->m_threads.indexOf(thread);
+    if(index == -1)
+    {
+        index = data->m_threads.count();
+        data->m_threads << thread;
+    }
+    return index;
+}
+
+static void appendEvent(const char *name, char phase, qint64 start, qint64 duration)
+{
+    TraceData *data = traceData();
+    QMutexLocker locker(&data->m_mutex);
+    if(!data->m_enabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    TraceEvent event;
+    event.m_name = name;
+    event.m_phase = phase;
+    event.m_start = start;
+    event.m_duration = duration;
+    event.m_thread = threadIndex(data);
+    data->m_events << event;
+}
+
+static QByteArray escapeName(const char *name)
+{
+    QByteArray value(name);
+    value.replace('\\', "\\\\");
+    value.replace('"', "\\\"");
+    return value;
+}
+
+
+void TTKTracer::start(const QString &path)
+{
+    TraceData *data = traceData();
+    QMutexLocker locker(&data->m_mutex);
+    data->m_path = path;
+    data->m_events.clear();
+    data->m_events.reserve(1024);
+    data->m_threads.clear();
+    data->m_threads << QThread::currentThreadId();
+    data->m_clock.start();
+    data->m_enabled.store(true, std::memory_order_release);
+}
+
+bool TTKTracer::isEnabled()
+{
+    return traceData()->m_enabled.load(std::memory_order_acquire);
+}
+
+qint64 TTKTracer::now()
+{
+    const TraceData *data = traceData();
+    if(!data->m_enabled.load(std::memory_order_acquire))
+    {
+        return 0;
+    }
+#if TTK_QT_VERSION_CHECK(4,8,0)
+    return data->m_clock.nsecsElapsed() / 1000;
+#else
+    return data->m_clock.elapsed() * 1000;
+#endif
+}
+
+void TTKTracer::complete(const char *name, qint64 start, qint64 end)
+{
+    appendEvent(name, 'X', start, end - start);
+}
+
+void TTKTracer::instant(const char *name)
+{
+    appendEvent(name, 'i', now(), 0);
+}
+
+bool TTKTracer::save()
+{
+    TraceData *data = traceData();
+    QMutexLocker locker(&data->m_mutex);
+    if(!data->m_enabled.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    data->m_enabled.store(false, std::memory_order_relaxed);
+
+    QFile file(data->m_path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        TTK_ERROR_STREAM("Trace file open error:" << data->m_path);
+        return false;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    for(int i = 0; i < data->m_events.count(); ++i)
+    {
+        const TraceEvent &event = data->m_events[i];
+        QByteArray line = "{\"name\":\"" + escapeName(event.m_name) + "\",\"cat\":\"startup\",\"ph\":\"" + event.m_phase +
+                          "\",\"ts\":" + QByteArray::number(event.m_start) + ",\"pid\":" + QByteArray::number(pid) +
+                          ",\"tid\":" + QByteArray::number(event.m_thread);
+        if(event.m_phase == 'X')
+        {
+            line += ",\"dur\":" + QByteArray::number(event.m_duration);
+        }
+        else
+        {
+            line += ",\"s\":\"g\"";
+        }
+
+        line += (i + 1 < data->m_events.count()) ? "},\n" : "}\n";
+        file.write(line);
+    }
+
+    file.write("]}\n");
+    data->m_events.clear();
+    TTK_INFO_STREAM("Trace saved to:" << data->m_path);
+    return true;
+}
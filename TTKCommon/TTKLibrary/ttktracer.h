@@ -0,0 +1,100 @@
+#ifndef TTKTRACER_H
+#define TTKTRACER_H
+
+/***************************************************************************
+ * This file is part of the TTK Library Module project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QString>
+#include "ttkmoduleexport.h"
+
+/*! @brief The class of the ttk phase tracer.
+ * Complete events are collected while enabled and saved in the chrome trace
+ * json format, which chrome://tracing and perfetto load directly.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT TTKTracer
+{
+public:
+    /*!
+     * Start to collect events, the trace is saved to path.
+     */
+    static void start(const QString &path);
+    /*!
+     * Check the tracer is collecting events.
+     */
+    static bool isEnabled();
+
+    /*!
+     * Get microseconds since the tracer started.
+     */
+    static qint64 now();
+    /*!
+     * Add a complete event by the start and end time.
+     */
+    static void complete(const char *name, qint64 start, qint64 end);
+    /*!
+     * Add an instant event.
+     */
+    static void instant(const char *name);
+
+    /*!
+     * Save the collected events and stop the tracer.
+     */
+    static bool save();
+
+};
+
+
+/*! @brief The class of the ttk trace scope.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT TTKTraceScope
+{
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit TTKTraceScope(const char *name)
+        : m_name(name),
+          m_start(TTKTracer::isEnabled() ? TTKTracer::now() : -1)
+    {
+
+    }
+
+    /*!
+     * Object destructor.
+     */
+    ~TTKTraceScope()
+    {
+        if(m_start >= 0)
+        {
+            TTKTracer::complete(m_name, m_start, TTKTracer::now());
+        }
+    }
+
+private:
+    const char *m_name;
+    qint64 m_start;
+
+};
+
+// Helper macro, name must be a string literal
+#define TTK_TRACE_SCOPE(name) const TTKTraceScope TTK_PP_CAT(ttk_trace_scope_, __LINE__)(name)
+#define TTK_TRACE_INSTANT(name) if(TTKTracer::isEnabled()) TTKTracer::instant(name)
+
+#endif // TTKTRACER_H
@@ -0,0 +1,182 @@
+#ifndef TTKASYNCLOGGER_H
+#define TTKASYNCLOGGER_H
+
+/***************************************************************************
+ * This file is part of the TTK Library Module project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QFile>
+#include <QDebug>
+#include <QDateTime>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+// log level define
+#define TTK_LOG_LEVEL_TRACE     0
+#define TTK_LOG_LEVEL_DEBUG     1
+#define TTK_LOG_LEVEL_INFO      2
+#define TTK_LOG_LEVEL_WARN      3
+#define TTK_LOG_LEVEL_ERROR     4
+#define TTK_LOG_LEVEL_FATAL     5
+#define TTK_LOG_LEVEL_OFF       6
+
+// log records below this level are stripped at compile time
+#ifndef TTK_LOG_LEVEL
+#  define TTK_LOG_LEVEL TTK_LOG_LEVEL_TRACE
+#endif
+
+// ttkmoduleexport.h reaches this header through ttkqtglobal.h, so the export is spelled out here
+#ifdef TTK_LIBRARY
+#  define TTK_LOGGER_EXPORT Q_DECL_EXPORT
+#else
+#  define TTK_LOGGER_EXPORT Q_DECL_IMPORT
+#endif
+
+struct TTKLogRecord;
+class TTKLogRingBuffer;
+
+/*! @brief The class of the asynchronous logger backend.
+ * Producers only capture timestamp and message into a per thread lock free
+ * ring buffer, a background thread formats and writes them out.
+ * The backend lives in TTKLibrary, so every module shares one instance. It is
+ * never destroyed, shutdown stops the thread before the modules are unloaded
+ * and records appended afterwards are written in place.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_LOGGER_EXPORT TTKAsyncLogger
+{
+public:
+    /*!
+     * Get logger instance.
+     */
+    static TTKAsyncLogger *instance();
+
+    /*!
+     * Set runtime output level.
+     */
+    inline void setLevel(int level) noexcept
+    {
+        m_level.store(level, std::memory_order_relaxed);
+    }
+    /*!
+     * Get runtime output level.
+     */
+    inline int level() const noexcept
+    {
+        return m_level.load(std::memory_order_relaxed);
+    }
+    /*!
+     * Check the level is enabled at runtime.
+     */
+    inline bool isEnabled(int level) const noexcept
+    {
+        return level >= m_level.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * Set console output enabled or not.
+     */
+    inline void setConsoleEnabled(bool enabled) noexcept
+    {
+        m_console.store(enabled, std::memory_order_relaxed);
+    }
+
+    /*!
+     * Set output log file, empty path to disable file output.
+     * When max size is greater than zero the file is rotated as path.1 ... path.N.
+     */
+    void setOutputFile(const QString &path, qint64 maxSize = 0, int maxFiles = 5);
+
+    /*!
+     * Get dropped record count since ring buffer is full.
+     */
+    inline quint64 droppedCount() const noexcept
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * Append record into current thread buffer.
+     */
+    void append(int level, const char *file, int line, QString &message);
+    /*!
+     * Block until all pending records are written.
+     */
+    void flush();
+    /*!
+     * Write the pending records and stop the background thread.
+     * Called by the application before exit, also registered as a post routine of the core application.
+     */
+    void shutdown();
+
+private:
+    /*!
+     * Object constructor.
+     */
+    TTKAsyncLogger();
+
+    /*!
+     * Get current thread ring buffer.
+     */
+    TTKLogRingBuffer *localBuffer();
+    /*!
+     * Background consumer loop.
+     */
+    void run();
+    /*!
+     * Drain all thread buffers and write them in timestamp order.
+     */
+    void drain(std::vector<TTKLogRecord> &records);
+    /*!
+     * Format and write record to outputs.
+     */
+    void write(const TTKLogRecord &record);
+    /*!
+     * Rotate current output file.
+     */
+    void rotate();
+
+private:
+    std::atomic<int> m_level;
+    std::atomic<bool> m_console;
+    std::atomic<quint64> m_dropped;
+
+    std::atomic<bool> m_running;
+    std::atomic<int> m_appending;
+    quint64 m_flushRequest;
+    quint64 m_flushDone;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::condition_variable m_flushCondition;
+
+    std::mutex m_bufferMutex;
+    std::vector<std::shared_ptr<TTKLogRingBuffer>> m_buffers;
+
+    std::mutex m_fileMutex;
+    QFile m_file;
+    qint64 m_maxSize;
+    int m_maxFiles;
+
+    std::thread m_thread;
+
+};
+
+#endif // TTKASYNCLOGGER_H
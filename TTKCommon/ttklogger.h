@@ -19,20 +19,28 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
-#include <QDebug>
-#include <QDateTime>
+#include "ttkasynclogger.h"
 
 #if QT_VERSION < QT_VERSION_CHECK(5,4,0)
 #  define __TTK_LOG_OUTPUT__ qDebug()
+#  define __TTK_LOG_STRING__(s) QDebug(&s)
 #else
 #  define __TTK_LOG_OUTPUT__ qDebug().noquote()
+#  define __TTK_LOG_STRING__(s) QDebug(&s).noquote()
 #endif
 
-#define __TTK_DATE__ QDate::currentDate().toString("yyyy-MM-dd")
-#define __TTK_TIME__ QTime::currentTime().toString("hh:mm:ss:zzz")
-
-// log stream base macro
-#define __TTK_BASE_STREAM__(level, msg) __TTK_LOG_OUTPUT__ << QString("[%1 %2][%3][%4(%5)] ").arg(__TTK_DATE__, __TTK_TIME__, level, __FILE__, QString::number(__LINE__)) << msg
+// log stream base macro, stripped at compile time below TTK_LOG_LEVEL and filtered by runtime level
+// one statement as a whole, so it never takes the else branch of an if around it
+#define __TTK_BASE_STREAM__(level, msg) \
+  do \
+  { \
+    if(level >= TTK_LOG_LEVEL && TTKAsyncLogger::instance()->isEnabled(level)) \
+    { \
+      QString __message__; \
+      __TTK_LOG_STRING__(__message__) << msg; \
+      TTKAsyncLogger::instance()->append(level, __FILE__, __LINE__, __message__); \
+    } \
+  } while(0)
 // log stream once base macro
 #define __TTK_ONCE_STREAM__(level, msg) \
   static bool __hit__ = false; \
@@ -43,7 +51,7 @@
   }
 // log stream count base macro
 #define __TTK_COUNT_STREAM__(count, level, msg) \
-  static  __last__ = 1; \
+  static int __last__ = 1; \
   if(count > 0 && ++__last__ > count) \
   { \
     __last__ = 1; \
@@ -62,32 +70,32 @@
 
 #define TTK_LOG_STREAM(msg) __TTK_LOG_OUTPUT__ << msg
 
-#define TTK_TRACE_STREAM(msg) { __TTK_BASE_STREAM__("I", msg); }
-#define TTK_DEBUG_STREAM(msg) { __TTK_BASE_STREAM__("D", msg); }
-#define TTK_INFO_STREAM(msg)  { __TTK_BASE_STREAM__("W", msg); }
-#define TTK_WARN_STREAM(msg)  { __TTK_BASE_STREAM__("T", msg); }
-#define TTK_ERROR_STREAM(msg) { __TTK_BASE_STREAM__("E", msg); }
-#define TTK_FATAL_STREAM(msg) { __TTK_BASE_STREAM__("F", msg); }
+#define TTK_TRACE_STREAM(msg) __TTK_BASE_STREAM__(TTK_LOG_LEVEL_TRACE, msg)
+#define TTK_DEBUG_STREAM(msg) __TTK_BASE_STREAM__(TTK_LOG_LEVEL_DEBUG, msg)
+#define TTK_INFO_STREAM(msg)  __TTK_BASE_STREAM__(TTK_LOG_LEVEL_INFO, msg)
+#define TTK_WARN_STREAM(msg)  __TTK_BASE_STREAM__(TTK_LOG_LEVEL_WARN, msg)
+#define TTK_ERROR_STREAM(msg) __TTK_BASE_STREAM__(TTK_LOG_LEVEL_ERROR, msg)
+#define TTK_FATAL_STREAM(msg) __TTK_BASE_STREAM__(TTK_LOG_LEVEL_FATAL, msg)
 
-#define TTK_TRACE_STREAM_ONCE(msg) { __TTK_ONCE_STREAM__("I", msg) }
-#define TTK_DEBUG_STREAM_ONCE(msg) { __TTK_ONCE_STREAM__("D", msg) }
-#define TTK_INFO_STREAM_ONCE(msg)  { __TTK_ONCE_STREAM__("W", msg) }
-#define TTK_WARN_STREAM_ONCE(msg)  { __TTK_ONCE_STREAM__("T", msg) }
-#define TTK_ERROR_STREAM_ONCE(msg) { __TTK_ONCE_STREAM__("E", msg) }
-#define TTK_FATAL_STREAM_ONCE(msg) { __TTK_ONCE_STREAM__("F", msg) }
+#define TTK_TRACE_STREAM_ONCE(msg) do { __TTK_ONCE_STREAM__(TTK_LOG_LEVEL_TRACE, msg) } while(0)
+#define TTK_DEBUG_STREAM_ONCE(msg) do { __TTK_ONCE_STREAM__(TTK_LOG_LEVEL_DEBUG, msg) } while(0)
+#define TTK_INFO_STREAM_ONCE(msg)  do { __TTK_ONCE_STREAM__(TTK_LOG_LEVEL_INFO, msg) } while(0)
+#define TTK_WARN_STREAM_ONCE(msg)  do { __TTK_ONCE_STREAM__(TTK_LOG_LEVEL_WARN, msg) } while(0)
+#define TTK_ERROR_STREAM_ONCE(msg) do { __TTK_ONCE_STREAM__(TTK_LOG_LEVEL_ERROR, msg) } while(0)
+#define TTK_FATAL_STREAM_ONCE(msg) do { __TTK_ONCE_STREAM__(TTK_LOG_LEVEL_FATAL, msg) } while(0)
 
-#define TTK_TRACE_STREAM_COUNT(count, msg) { __TTK_COUNT_STREAM__(count, "I", msg) }
-#define TTK_DEBUG_STREAM_COUNT(count, msg) { __TTK_COUNT_STREAM__(count, "D", msg) }
-#define TTK_INFO_STREAM_COUNT(count, msg)  { __TTK_COUNT_STREAM__(count, "W", msg) }
-#define TTK_WARN_STREAM_COUNT(count, msg)  { __TTK_COUNT_STREAM__(count, "T", msg) }
-#define TTK_ERROR_STREAM_COUNT(count, msg) { __TTK_COUNT_STREAM__(count, "E", msg) }
-#define TTK_FATAL_STREAM_COUNT(count, msg) { __TTK_COUNT_STREAM__(count, "F", msg) }
+#define TTK_TRACE_STREAM_COUNT(count, msg) do { __TTK_COUNT_STREAM__(count, TTK_LOG_LEVEL_TRACE, msg) } while(0)
+#define TTK_DEBUG_STREAM_COUNT(count, msg) do { __TTK_COUNT_STREAM__(count, TTK_LOG_LEVEL_DEBUG, msg) } while(0)
+#define TTK_INFO_STREAM_COUNT(count, msg)  do { __TTK_COUNT_STREAM__(count, TTK_LOG_LEVEL_INFO, msg) } while(0)
+#define TTK_WARN_STREAM_COUNT(count, msg)  do { __TTK_COUNT_STREAM__(count, TTK_LOG_LEVEL_WARN, msg) } while(0)
+#define TTK_ERROR_STREAM_COUNT(count, msg) do { __TTK_COUNT_STREAM__(count, TTK_LOG_LEVEL_ERROR, msg) } while(0)
+#define TTK_FATAL_STREAM_COUNT(count, msg) do { __TTK_COUNT_STREAM__(count, TTK_LOG_LEVEL_FATAL, msg) } while(0)
 
-#define TTK_TRACE_STREAM_PERIOD(period, msg) { __TTK_PERIOD_STREAM__(period, "I", msg) }
-#define TTK_DEBUG_STREAM_PERIOD(period, msg) { __TTK_PERIOD_STREAM__(period, "D", msg) }
-#define TTK_INFO_STREAM_PERIOD(period, msg)  { __TTK_PERIOD_STREAM__(period, "W", msg) }
-#define TTK_WARN_STREAM_PERIOD(period, msg)  { __TTK_PERIOD_STREAM__(period, "T", msg) }
-#define TTK_ERROR_STREAM_PERIOD(period, msg) { __TTK_PERIOD_STREAM__(period, "E", msg) }
-#define TTK_FATAL_STREAM_PERIOD(period, msg) { __TTK_PERIOD_STREAM__(period, "F", msg) }
+#define TTK_TRACE_STREAM_PERIOD(period, msg) do { __TTK_PERIOD_STREAM__(period, TTK_LOG_LEVEL_TRACE, msg) } while(0)
+#define TTK_DEBUG_STREAM_PERIOD(period, msg) do { __TTK_PERIOD_STREAM__(period, TTK_LOG_LEVEL_DEBUG, msg) } while(0)
+#define TTK_INFO_STREAM_PERIOD(period, msg)  do { __TTK_PERIOD_STREAM__(period, TTK_LOG_LEVEL_INFO, msg) } while(0)
+#define TTK_WARN_STREAM_PERIOD(period, msg)  do { __TTK_PERIOD_STREAM__(period, TTK_LOG_LEVEL_WARN, msg) } while(0)
+#define TTK_ERROR_STREAM_PERIOD(period, msg) do { __TTK_PERIOD_STREAM__(period, TTK_LOG_LEVEL_ERROR, msg) } while(0)
+#define TTK_FATAL_STREAM_PERIOD(period, msg) do { __TTK_PERIOD_STREAM__(period, TTK_LOG_LEVEL_FATAL, msg) } while(0)
 
 #endif // TTKLOGGER_H
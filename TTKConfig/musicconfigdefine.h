@@ -29,6 +29,7 @@
 #define TTK_BACKGROUND_DIR_FULL    BACKGROUND_DIR_FULL
 #define TTK_CACHE_DIR_FULL         CACHE_DIR_FULL
 #define TTK_RESOURCE_DIR_FULL      RESOURCE_DIR_FULL
+#define TTK_THUMBNAIL_DIR_FULL     THUMBNAIL_DIR_FULL
 //
 #define TTK_COFIG_PATH_FULL        COFIG_PATH_FULL
 #define TTK_PLAYLIST_PATH_FULL     PLAYLIST_PATH_FULL
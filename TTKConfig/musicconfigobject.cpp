@@ -48,6 +48,7 @@ void MusicConfigObject::checkDirectoryExist() const
     directoryExist(TTK_CACHE_DIR_FULL);
     directoryExist(TTK_ART_DIR_FULL);
     directoryExist(TTK_BACKGROUND_DIR_FULL);
+    directoryExist(TTK_THUMBNAIL_DIR_FULL);
 
     directoryExist(TTK_USER_THEME_DIR_FULL);
 
@@ -39,8 +39,10 @@ HEADERS += \
     $$PWD/musicruntimemanager.h \
     $$PWD/musicdispatchmanager.h \
     $$PWD/musicextractwrapper.h \
+    $$PWD/musicskinthumbnailloader.h \
     $$PWD/musicbackgroundconfigmanager.h \
     $$PWD/musicconfigmanager.h \
+    $$PWD/musicpersistservice.h \
     $$PWD/musicimagerenderer.h
 
 SOURCES += \
@@ -59,8 +61,10 @@ SOURCES += \
     $$PWD/musichotkeymanager.cpp \
     $$PWD/musicruntimemanager.cpp \
     $$PWD/musicextractwrapper.cpp \
+    $$PWD/musicskinthumbnailloader.cpp \
     $$PWD/musicbackgroundconfigmanager.cpp \
     $$PWD/musicconfigmanager.cpp \
+    $$PWD/musicpersistservice.cpp \
     $$PWD/musicimagerenderer.cpp
 
 #dbus mpris support for linux
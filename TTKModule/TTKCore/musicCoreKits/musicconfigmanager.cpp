@@ -368,8 +368,6 @@ bool MusicConfigManager::writeBuffer(const int &items)
     writeDomElement(downloadSettingDom, "downloadServerIndex", {"value", downloadServerIndex});
     writeDomElement(downloadSettingDom, "downloadDownloadLimitSize", {"value", downloadDownloadLimitSize});
     writeDomElement(downloadSettingDom, "downloadUploadLimitSize", {"value", downloadUploadLimitSize});
-
-    save();
     return true;
 }
 
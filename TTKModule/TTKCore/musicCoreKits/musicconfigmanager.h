@@ -41,6 +41,7 @@ public:
     bool readBuffer();
     /*!
      * Write datas into buffer.
+     * The document is not saved, see toByteArray.
      */
     bool writeBuffer();
 
@@ -21,6 +21,7 @@
 #include "musicsongdlnatransferwidget.h"
 #include "musicsongitemselectedareawidget.h"
 #include "musicplaylistbackupwidget.h"
+#include "musicidentifysongwidget.h"
 
 MusicConnectionPool::MusicConnectionPool()
 {
@@ -93,7 +94,8 @@ void MusicConnectionPool::connect(const QString &from, const QString &to)
     }
     else if((from == MusicConnectTransferWidget::className() && to == MusicSongsContainerWidget::className()) ||
             (from == MusicSongItemSelectedAreaWidget::className() && to == MusicSongsContainerWidget::className()) ||
-            (from == MusicSongDlnaTransferWidget::className() && to == MusicSongsContainerWidget::className()))
+            (from == MusicSongDlnaTransferWidget::className() && to == MusicSongsContainerWidget::className()) ||
+            (from == MusicIdentifySongWidget::className() && to == MusicSongsContainerWidget::className()))
     {
         QObject::connect(first, SIGNAL(queryMusicItemList(MusicSongItemList&)), second, SLOT(queryMusicItemList(MusicSongItemList&)));
     }
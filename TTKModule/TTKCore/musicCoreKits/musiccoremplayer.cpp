@@ -1,20 +1,121 @@
 #include "musiccoremplayer.h"
 #include "musicabstractnetwork.h"
-#include "miniprocess.h"
 
 #include <QProcess>
+#include <QCoreApplication>
+
+static QList<QProcess*> &idleProcesses()
+{
+    static QList<QProcess*> processes;
+    return processes;
+}
+
+static void releaseIdleProcesses()
+{
+    for(QProcess *process : qAsConst(idleProcesses()))
+    {
+        process->kill();
+        process->waitForFinished(TTK_DN_S2MS);
+        delete process;
+    }
+    idleProcesses().clear();
+}
+
+static QStringList moduleArguments(MusicCoreMPlayer::Module type, int winId)
+{
+    // no -quiet, the status line is the position source
+    QStringList arguments;
+    arguments << "-slave" << "-idle" << "-identify" << "-msglevel" << "global=6" << "-softvol";
+
+    switch(type)
+    {
+        case MusicCoreMPlayer::Module::Radio:
+        {
+            arguments << "-vo" << "directx:noaccel";
+            break;
+        }
+        case MusicCoreMPlayer::Module::Music:
+        {
+            arguments << "-cache" << "5000" << "-vo" << "directx:noaccel";
+            break;
+        }
+        case MusicCoreMPlayer::Module::Video:
+        {
+            arguments << "-cache" << "5000" << "-zoom" << "-wid" << QString::number(winId);
+#ifdef Q_OS_WIN
+            arguments << "-vo" << "direct3d";
+#else
+            arguments << "-vo" << "x11";
+#endif
+            break;
+        }
+        default: break;
+    }
+    return arguments;
+}
+
+static QProcess *startProcess(const QStringList &arguments)
+{
+    QProcess *process = new QProcess;
+    // the arguments are the key to find a reusable process
+    process->setObjectName(arguments.join(" "));
+    process->setProcessChannelMode(QProcess::MergedChannels);
+    process->start(MAKE_PLAYER_PATH_FULL, arguments);
+    return process;
+}
+
+static QProcess *takeProcess(const QStringList &arguments)
+{
+    const QString &key = arguments.join(" ");
+    QList<QProcess*> &processes = idleProcesses();
+
+    for(int i = 0; i < processes.count(); ++i)
+    {
+        QProcess *process = processes[i];
+        if(process->objectName() == key && process->state() != QProcess::NotRunning)
+        {
+            processes.removeAt(i);
+            // drop the output left by the previous owner
+            process->readAll();
+            return process;
+        }
+    }
+    return startProcess(arguments);
+}
+
+static bool hasIdleProcess(const QString &key)
+{
+    for(QProcess *process : qAsConst(idleProcesses()))
+    {
+        if(process->objectName() == key && process->state() != QProcess::NotRunning)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parseSeconds(const QByteArray &data, qint64 *seconds)
+{
+    bool ok = false;
+    const float value = data.trimmed().toFloat(&ok);
+    if(ok)
+    {
+        *seconds = value;
+    }
+    return ok;
+}
+
 
 MusicCoreMPlayer::MusicCoreMPlayer(QObject *parent)
     : QObject(parent),
       m_process(nullptr),
       m_playState(TTK::PlayState::Stopped),
-      m_category(Module::Null)
+      m_category(Module::Null),
+      m_position(-1),
+      m_switchLatency(-1)
 {
-    m_timer.setInterval(TTK_DN_S2MS);
-    connect(&m_timer, SIGNAL(timeout()), SLOT(timeout()));
 
-    m_checkTimer.setInterval(10 * TTK_DN_S2MS);
-    connect(&m_checkTimer, SIGNAL(timeout()), SLOT(checkTimerout()));
 }
 
 MusicCoreMPlayer::~MusicCoreMPlayer()
@@ -22,85 +123,93 @@ MusicCoreMPlayer::~MusicCoreMPlayer()
     closeModule();
 }
 
-void MusicCoreMPlayer::setMedia(Module type, const QString &data, int winId)
+void MusicCoreMPlayer::prepare()
 {
-    closeModule();
     if(!QFile::exists(MAKE_PLAYER_PATH_FULL))
     {
-        TTK_ERROR_STREAM("Lack of plugin file");
         return;
     }
 
-    m_category = type;
-    m_playState = TTK::PlayState::Stopped;
-    m_process = new QProcess(this);
-    connect(m_process, SIGNAL(finished(int)), SIGNAL(finished(int)));
-
-    QString url = data;
-    if(url.startsWith(HTTPS_PROTOCOL))
+    static bool registered = false;
+    if(!registered)
     {
-        url.replace(HTTPS_PROTOCOL, HTTP_PROTOCOL);
+        registered = true;
+        qAddPostRoutine(releaseIdleProcesses);
     }
 
-    switch(m_category)
+    // video processes are bound to the window id, so they can not be started ahead
+    const QList<Module> modules{Module::Radio, Module::Music};
+    for(const Module module : qAsConst(modules))
     {
-        case Module::Radio: setRadioMedia(url); break;
-        case Module::Music: setMusicMedia(url); break;
-        case Module::Video: setVideoMedia(url, winId); break;
-        case Module::Null: break;
-        default: break;
+        const QStringList &arguments = moduleArguments(module, -1);
+        if(!hasIdleProcess(arguments.join(" ")))
+        {
+            idleProcesses() << startProcess(arguments);
+        }
     }
 }
 
-void MusicCoreMPlayer::closeModule()
+void MusicCoreMPlayer::setMedia(Module type, const QString &data, int winId)
 {
-    m_timer.stop();
-    m_checkTimer.stop();
+    if(!QFile::exists(MAKE_PLAYER_PATH_FULL))
+    {
+        TTK_ERROR_STREAM("Lack of plugin file");
+        return;
+    }
 
-    if(m_process)
+    const QStringList &arguments = moduleArguments(type, winId);
+    if(!m_process || m_process->state() == QProcess::NotRunning || m_process->objectName() != arguments.join(" "))
     {
-        m_process->kill();
-        delete m_process;
-        m_process = nullptr;
-        TTK::killProcessByName(MAKE_PLAYER_NAME);
+        closeModule();
+        m_process = takeProcess(arguments);
+        m_process->setParent(this);
+        connect(m_process, SIGNAL(readyReadStandardOutput()), SLOT(dataRecieve()));
+        connect(m_process, SIGNAL(finished(int)), SLOT(processFinished()));
     }
-}
 
-void MusicCoreMPlayer::setRadioMedia(const QString &data)
-{
-    Q_EMIT mediaChanged(data);
+    m_category = type;
+    m_playState = TTK::PlayState::Stopped;
+    m_buffer.clear();
+    m_position = -1;
+    m_switchLatency = -1;
 
-    QStringList arguments;
-    arguments << "-softvol" << "-slave" << "-quiet" << "-vo" << "directx:noaccel" << data;
-    connect(m_process, SIGNAL(readyReadStandardOutput()), SLOT(dataRecieve()));
-    m_process->start(MAKE_PLAYER_PATH_FULL, arguments);
-}
+    QString url = data;
+    if(url.startsWith(HTTPS_PROTOCOL))
+    {
+        url.replace(HTTPS_PROTOCOL, HTTP_PROTOCOL);
+    }
 
-void MusicCoreMPlayer::setMusicMedia(const QString &data)
-{
-    Q_EMIT mediaChanged(data);
+    Q_EMIT mediaChanged(url);
 
-    QStringList arguments;
-    arguments << "-cache" << "5000" << "-softvol" << "-slave" << "-quiet" << "-vo" << "directx:noaccel" << data;
-    connect(m_process, SIGNAL(readyReadStandardOutput()), SLOT(dataRecieve()));
-    m_process->start(MAKE_PLAYER_PATH_FULL, arguments);
+    m_switchTimer.start();
+    url.replace("\"", "\\\"");
+    m_process->write(QString("loadfile \"%1\"\n").arg(url).toUtf8());
 }
 
-void MusicCoreMPlayer::setVideoMedia(const QString &data, int winId)
+void MusicCoreMPlayer::closeModule()
 {
-    QStringList arguments;
-    arguments << "-cache" << "5000" << "-softvol" << "-slave" << "-quiet" << "-zoom" << "-wid" << QString::number(winId);
-#ifdef Q_OS_WIN
-    arguments << "-vo" << "direct3d";
-#else
-    arguments << "-vo" << "x11";
-#endif
-    arguments << data;
-    Q_EMIT mediaChanged(data);
+    if(!m_process)
+    {
+        return;
+    }
+
+    disconnect(m_process, nullptr, this, nullptr);
+    m_process->setParent(nullptr);
 
-    m_process->setProcessChannelMode(QProcess::MergedChannels);
-    connect(m_process, SIGNAL(readyReadStandardOutput()), SLOT(durationRecieve()));
-    m_process->start(MAKE_PLAYER_PATH_FULL, arguments);
+    if(m_category != Module::Video && m_process->state() != QProcess::NotRunning && !hasIdleProcess(m_process->objectName()))
+    {
+        // reset the per media state, the next owner gets a clean player
+        m_process->write("stop\nmute 0\nvolume 100 1\n");
+        idleProcesses() << m_process;
+    }
+    else
+    {
+        m_process->kill();
+        m_process->waitForFinished(TTK_DN_S2MS);
+        // may be called from the process signal handlers
+        m_process->deleteLater();
+    }
+    m_process = nullptr;
 }
 
 void MusicCoreMPlayer::setPosition(qint64 pos)
@@ -170,9 +279,6 @@ bool MusicCoreMPlayer::isPlaying() const
 
 void MusicCoreMPlayer::play()
 {
-    m_timer.stop();
-    m_checkTimer.start();
-
     if(!m_process)
     {
         return;
@@ -182,101 +288,111 @@ void MusicCoreMPlayer::play()
     if(m_playState == TTK::PlayState::Stopped || m_playState == TTK::PlayState::Paused)
     {
         m_playState = TTK::PlayState::Playing;
-        connect(m_process, SIGNAL(readyReadStandardOutput()), this, SLOT(positionRecieve()));
-        m_process->write("get_time_pos\n");
     }
     else
     {
         m_playState = TTK::PlayState::Paused;
-        disconnect(m_process, SIGNAL(readyReadStandardOutput()), this, SLOT(positionRecieve()));
     }
 }
 
 void MusicCoreMPlayer::stop()
 {
     m_playState = TTK::PlayState::Stopped;
-    m_timer.stop();
-    m_checkTimer.stop();
 
     if(!m_process)
     {
         return;
     }
 
-    m_process->write("quit\n");
+    // keep the slave idle for the next media
+    m_process->write("stop\n");
 }
 
-void MusicCoreMPlayer::durationRecieve()
+void MusicCoreMPlayer::dataRecieve()
 {
-    while(m_process->canReadLine())
+    // the handlers of the emitted events may set a new media, so parse a local copy
+    QProcess *process = m_process;
+    const QByteArray data = m_buffer + process->readAllStandardOutput();
+    m_buffer.clear();
+
+    // status lines end with '\r' only, other lines with '\n' or "\r\n"
+    int from = 0;
+    for(int i = 0; i < data.size(); ++i)
     {
-        QString message(m_process->readLine());
-        if(message.startsWith("ANS_LENGTH"))
+        const char c = data[i];
+        if(c == '\r' || c == '\n')
         {
-            message.remove("\r\n");
-            disconnect(m_process, SIGNAL(readyReadStandardOutput()), this, SLOT(durationRecieve()));
-            Q_EMIT durationChanged(message.mid(11).toFloat());
-            return;
+            if(i > from)
+            {
+                parseLine(QByteArray::fromRawData(data.constData() + from, i - from));
+            }
+            from = i + 1;
         }
     }
-}
 
-void MusicCoreMPlayer::dataRecieve()
-{
-    switch(m_category)
+    if(m_process == process)
     {
-        case Module::Radio: positionRecieve(); break;
-        case Module::Music: standardRecieve(); break;
-        case Module::Video: positionRecieve(); break;
-        case Module::Null: break;
-        default: break;
+        m_buffer = data.mid(from);
     }
 }
 
-void MusicCoreMPlayer::positionRecieve()
+void MusicCoreMPlayer::processFinished()
 {
-    m_timer.start();
-    while(m_process->canReadLine())
+    TTK_ERROR_STREAM("Player process exited unexpectedly");
+    m_playState = TTK::PlayState::Stopped;
+    m_process->deleteLater();
+    m_process = nullptr;
+    Q_EMIT finished(TTK_LOW_LEVEL);
+}
+
+void MusicCoreMPlayer::parseLine(const QByteArray &line)
+{
+    qint64 value = 0;
+    if(line.startsWith("A:") || line.startsWith("V:"))
     {
-        QString message(m_process->readLine());
-        if(message.startsWith("ANS_TIME_POSITION"))
+        // "A:  12.3 (12.3) of 200.0 (03:20.0)" or "A:  12.3 V:  12.3 A-V: ..."
+        const QByteArray &data = line.mid(2).trimmed();
+        const int index = data.indexOf(' ');
+        if(parseSeconds(index == -1 ? data : data.left(index), &value) && value != m_position)
         {
-            message.remove("\r\n");
-            Q_EMIT positionChanged(message.mid(18).toFloat());
+            m_position = value;
+            Q_EMIT positionChanged(value);
         }
     }
-}
-
-void MusicCoreMPlayer::standardRecieve()
-{
-    while(m_process->canReadLine())
+    else if(line.startsWith("ID_LENGTH="))
     {
-        QString message(m_process->readLine());
-        if(message.startsWith("ANS_LENGTH"))
+        if(parseSeconds(line.mid(10), &value))
         {
-            message.remove("\r\n");
-            Q_EMIT durationChanged(message.mid(11).toFloat());
+            Q_EMIT durationChanged(value);
         }
-
-        if(message.startsWith("ANS_TIME_POSITION"))
+    }
+    else if(line.startsWith("ANS_LENGTH="))
+    {
+        if(parseSeconds(line.mid(11), &value))
         {
-            message.remove("\r\n");
-            Q_EMIT positionChanged(message.mid(18).toFloat());
+            Q_EMIT durationChanged(value);
         }
     }
-}
-
-void MusicCoreMPlayer::timeout()
-{
-    m_process->write("get_time_length\n");
-    m_process->write("get_time_pos\n");
-}
-
-void MusicCoreMPlayer::checkTimerout()
-{
-    if(m_process && m_process->state() == QProcess::NotRunning)
+    else if(line.startsWith("ANS_TIME_POSITION="))
     {
-        m_checkTimer.stop();
-        Q_EMIT finished(TTK_LOW_LEVEL);
+        if(parseSeconds(line.mid(18), &value) && value != m_position)
+        {
+            m_position = value;
+            Q_EMIT positionChanged(value);
+        }
+    }
+    else if(line.startsWith("Starting playback"))
+    {
+        m_switchLatency = m_switchTimer.elapsed();
+        TTK_INFO_STREAM("Player media started in" << m_switchLatency << "ms");
+    }
+    else if(line.startsWith("EOF code:"))
+    {
+        // code 1 is the end of file, the others come from loadfile or stop
+        if(line.mid(9).trimmed().toInt() == 1)
+        {
+            m_playState = TTK::PlayState::Stopped;
+            Q_EMIT finished(0);
+        }
     }
 }
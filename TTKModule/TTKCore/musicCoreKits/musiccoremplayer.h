@@ -19,7 +19,7 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
-#include <QTimer>
+#include <QElapsedTimer>
 #include "musicglobaldefine.h"
 
 class QProcess;
@@ -49,8 +49,14 @@ public:
      */
     ~MusicCoreMPlayer();
 
+    /*!
+     * Start idle player processes ahead, so the first media does not pay the process start.
+     */
+    static void prepare();
+
     /*!
      * Set media by type and data path.
+     * The running player process is reused when the module arguments do not change.
      */
     void setMedia(Module type, const QString &data, int winId = -1);
 
@@ -91,6 +97,10 @@ public:
      * Get current player category.
      */
     inline Module category() const { return m_category; }
+    /*!
+     * Get the time in ms from the last set media to its playback start, -1 when not started yet.
+     */
+    inline qint64 switchLatency() const { return m_switchLatency; }
 
 Q_SIGNALS:
     /*!
@@ -126,48 +136,26 @@ private Q_SLOTS:
      */
     void dataRecieve();
     /*!
-     * Player position data has recieved.
-     */
-    void positionRecieve();
-    /*!
-     * Player duration data has recieved.
-     */
-    void durationRecieve();
-    /*!
-     * Player music data has recieved.
+     * Player process has exited.
      */
-    void standardRecieve();
-    /*!
-     * Player one second time out.
-     */
-    void timeout();
-    /*!
-     * Check thread time out.
-     */
-    void checkTimerout();
+    void processFinished();
 
 private:
     /*!
-     * Close output media module.
+     * Close output media module, the process goes back to the idle pool when reusable.
      */
     void closeModule();
     /*!
-     * Set player to radio media data.
-     */
-    void setRadioMedia(const QString &data);
-    /*!
-     * Set player to music media data.
-     */
-    void setMusicMedia(const QString &data);
-    /*!
-     * Set player to video media data.
+     * Parse one player output line into state events.
      */
-    void setVideoMedia(const QString &data, int winId);
+    void parseLine(const QByteArray &line);
 
     QProcess *m_process;
     TTK::PlayState m_playState;
     Module m_category;
-    QTimer m_timer, m_checkTimer;
+    QByteArray m_buffer;
+    qint64 m_position, m_switchLatency;
+    QElapsedTimer m_switchTimer;
 
 };
 
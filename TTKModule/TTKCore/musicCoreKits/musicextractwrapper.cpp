@@ -6,6 +6,8 @@
 #include "ttkzip/unzip.h"
 
 #include <QFile>
+#include <QBuffer>
+#include <QImageReader>
 
 #define WIN_NAME_MAX_LENGTH TTK_LOW_BUFFER
 #ifndef FILE_ATTRIBUTE_DIRECTORY
@@ -15,6 +17,64 @@
 #define FILE_ATTRIBUTE_ARCHIVE 0x00000020
 #endif
 
+/*!
+ * Read the first skin zip entry matched by suffix, the other entries are never inflated.
+ */
+static bool readSkinEntry(QByteArray &buffer, const QString &input, const QString &suffix)
+{
+    const unzFile &zFile = unzOpen64(qPrintable(input));
+    if(!zFile)
+    {
+        return false;
+    }
+
+    unz_file_info64 fInfo;
+    unz_global_info64 gInfo;
+    if(unzGetGlobalInfo64(zFile, &gInfo) != UNZ_OK)
+    {
+        unzClose(zFile);
+        return false;
+    }
+
+    bool found = false;
+    for(ZPOS64_T i = 0; i < gInfo.number_entry; ++i)
+    {
+        char name[WIN_NAME_MAX_LENGTH] = {0};
+        if(unzGetCurrentFileInfo64(zFile, &fInfo, name, sizeof(name), nullptr, 0, nullptr, 0) != UNZ_OK)
+        {
+            break;
+        }
+
+        const QString &module = name;
+        if(module.toLower().contains(suffix))
+        {
+            if(unzOpenCurrentFile(zFile) != UNZ_OK)
+            {
+                break;
+            }
+
+            int length = 0;
+            char dt[TTK_HIGH_BUFFER] = {0};
+            while((length = unzReadCurrentFile(zFile, dt, sizeof(dt))) > 0)
+            {
+                buffer.append(dt, length);
+            }
+
+            unzCloseCurrentFile(zFile);
+            found = length == 0;
+            break;
+        }
+
+        if(i < gInfo.number_entry - 1 && unzGoToNextFile(zFile) != UNZ_OK)
+        {
+            break;
+        }
+    }
+
+    unzClose(zFile);
+    return found;
+}
+
 bool MusicExtractWrapper::outputThunderSkin(QPixmap &image, const QString &input)
 {
     const unzFile &zFile = unzOpen64(qPrintable(input));
@@ -229,6 +289,40 @@ bool MusicExtractWrapper::outputSkin(MusicBackgroundImage *image, const QString
     return true;
 }
 
+bool MusicExtractWrapper::outputSkin(QImage &image, const QString &input, const QSize &size)
+{
+    QByteArray buffer;
+    if(!readSkinEntry(buffer, input, SKN_FILE))
+    {
+        return false;
+    }
+
+    // let the decoder skip the full resolution image, jpeg is scaled while decoding
+    QBuffer device(&buffer);
+    QImageReader reader(&device);
+    reader.setScaledSize(size);
+    image = reader.read();
+    return !image.isNull();
+}
+
+bool MusicExtractWrapper::outputSkin(MusicSkinItem &item, const QString &input)
+{
+    QByteArray buffer;
+    if(!readSkinEntry(buffer, input, XML_FILE))
+    {
+        return false;
+    }
+
+    MusicSkinConfigManager manager;
+    if(!manager.fromByteArray(buffer))
+    {
+        return false;
+    }
+
+    manager.readBuffer(item);
+    return item.isValid();
+}
+
 bool MusicExtractWrapper::inputSkin(MusicBackgroundImage *image, const QString &output)
 {
     const zipFile &zFile = zipOpen64(qPrintable(output), 0);
@@ -21,6 +21,7 @@
 
 #include "musicglobaldefine.h"
 
+struct MusicSkinItem;
 class MusicBackgroundImage;
 
 /*! @brief The class of the extract data wrapper.
@@ -44,6 +45,14 @@ public:
      * Transfer file to image data.
      */
     static bool outputSkin(MusicBackgroundImage *image, const QString &input);
+    /*!
+     * Transfer file to image data decoded at the given size, safe to call out of gui thread.
+     */
+    static bool outputSkin(QImage &image, const QString &input, const QSize &size);
+    /*!
+     * Transfer file to skin config only, the image entry is not inflated.
+     */
+    static bool outputSkin(MusicSkinItem &item, const QString &input);
     /*!
      * Transfer image data to file.
      */
@@ -30,6 +30,7 @@
 //
 #define SKN_FILE_SUFFIX          "skn"
 #define JPG_FILE_SUFFIX          "jpg"
+#define PNG_FILE_SUFFIX          "png"
 #define LRC_FILE_SUFFIX          "lrc"
 #define KRC_FILE_SUFFIX          "krc"
 #define XML_FILE_SUFFIX          "xml"
@@ -46,6 +47,7 @@
 #define TXT_FILE_SUFFIX          "txt"
 #define FPL_FILE_SUFFIX          "fpl"
 #define DBPL_FILE_SUFFIX         "dbpl"
+#define TPS_FILE_SUFFIX          "tkps"
 // file ext
 #define MP3_FILE_SUFFIX          "mp3"
 #define APE_FILE_SUFFIX          "ape"
@@ -60,10 +62,12 @@
 //
 #define SKN_FILE                 TTK_STR_CAT(TTK_DOT, SKN_FILE_SUFFIX)
 #define JPG_FILE                 TTK_STR_CAT(TTK_DOT, JPG_FILE_SUFFIX)
+#define PNG_FILE                 TTK_STR_CAT(TTK_DOT, PNG_FILE_SUFFIX)
 #define LRC_FILE                 TTK_STR_CAT(TTK_DOT, LRC_FILE_SUFFIX)
 #define KRC_FILE                 TTK_STR_CAT(TTK_DOT, KRC_FILE_SUFFIX)
 #define MP3_FILE                 TTK_STR_CAT(TTK_DOT, MP3_FILE_SUFFIX)
 #define TPL_FILE                 TTK_STR_CAT(TTK_DOT, TPL_FILE_SUFFIX)
+#define TPS_FILE                 TTK_STR_CAT(TTK_DOT, TPS_FILE_SUFFIX)
 #define XML_FILE                 TTK_STR_CAT(TTK_DOT, XML_FILE_SUFFIX)
 // file ext
 #define MP3_FILE                 TTK_STR_CAT(TTK_DOT, MP3_FILE_SUFFIX)
@@ -90,6 +94,7 @@
 #define BACKGROUND_DIR           TTK_STR_CAT("Background", TTK_SEPARATOR)
 #define CACHE_DIR                TTK_STR_CAT("Cache", TTK_SEPARATOR)
 #define RESOURCE_DIR             TTK_STR_CAT("resource", TTK_SEPARATOR)
+#define THUMBNAIL_DIR            TTK_STR_CAT("Thumbnail", TTK_SEPARATOR)
 //
 #define CONFIG_DIR               TTK_STR_CAT("config", TTK_SEPARATOR)
 #define USER_THEME_DIR           TTK_STR_CAT("theme", TTK_SEPARATOR)
@@ -108,11 +113,16 @@
 
 #define COFIG_PATH               TTK_STR_CAT("config", XML_FILE)
 #define PLAYLIST_PATH            TTK_STR_CAT("playlist", TPL_FILE)
+#define PLAYLIST_SNAPSHOT_PATH   TTK_STR_CAT("playlist", TPS_FILE)
 #define NORMAL_DOWN_PATH         TTK_STR_CAT("download", TKF_FILE)
 #define CLOUD_DOWN_PATH          TTK_STR_CAT("cdownload", TKF_FILE)
 #define CLOUD_UP_PATH            TTK_STR_CAT("cupload", TKF_FILE)
 #define SEARCH_PATH              TTK_STR_CAT("search", TKF_FILE)
 #define FMRADIO_PATH             TTK_STR_CAT("fmradio", TKF_FILE)
+#define VALIDATOR_PATH           TTK_STR_CAT("validator", TKF_FILE)
+#define DOWNLOAD_QUEUE_PATH      TTK_STR_CAT("dqueue", TKF_FILE)
+#define LRC_MISS_PATH            TTK_STR_CAT("lrcmiss", TKF_FILE)
+#define FINGERPRINT_PATH         TTK_STR_CAT("fingerprint", TKF_FILE)
 
 
 #define MAIN_DIR_FULL            TTK::applicationPath() + TTK_PARENT_DIR
@@ -130,14 +140,20 @@
 #define BACKGROUND_DIR_FULL      APPCACHE_DIR_FULL + BACKGROUND_DIR
 #define CACHE_DIR_FULL           APPCACHE_DIR_FULL + CACHE_DIR
 #define RESOURCE_DIR_FULL        APPCACHE_DIR_FULL + RESOURCE_DIR
+#define THUMBNAIL_DIR_FULL       APPCACHE_DIR_FULL + THUMBNAIL_DIR
 //
 #define COFIG_PATH_FULL          APPDATA_DIR_FULL + COFIG_PATH
 #define PLAYLIST_PATH_FULL       APPDATA_DIR_FULL + PLAYLIST_PATH
+#define PLAYLIST_SNAPSHOT_PATH_FULL APPDATA_DIR_FULL + PLAYLIST_SNAPSHOT_PATH
 #define NORMAL_DOWN_PATH_FULL    APPDATA_DIR_FULL + NORMAL_DOWN_PATH
 #define CLOUD_DOWN_PATH_FULL     APPDATA_DIR_FULL + CLOUD_DOWN_PATH
 #define CLOUD_UP_PATH_FULL       APPDATA_DIR_FULL + CLOUD_UP_PATH
 #define SEARCH_PATH_FULL         APPDATA_DIR_FULL + SEARCH_PATH
 #define FMRADIO_PATH_FULL        APPDATA_DIR_FULL + FMRADIO_PATH
+#define VALIDATOR_PATH_FULL      APPCACHE_DIR_FULL + VALIDATOR_PATH
+#define DOWNLOAD_QUEUE_PATH_FULL APPDATA_DIR_FULL + DOWNLOAD_QUEUE_PATH
+#define LRC_MISS_PATH_FULL       APPCACHE_DIR_FULL + LRC_MISS_PATH
+#define FINGERPRINT_PATH_FULL    APPCACHE_DIR_FULL + FINGERPRINT_PATH
 #define USER_THEME_DIR_FULL      APPDATA_DIR_FULL + USER_THEME_DIR
 
 
@@ -0,0 +1,91 @@
+#include "musicpersistservice.h"
+#include "ttksavefile.h"
+#include "ttkconcurrent.h"
+
+#include <algorithm>
+
+static constexpr int SAVE_DELAY = 2 * TTK_DN_S2MS;
+
+MusicPersistService::MusicPersistService()
+    : QObject(nullptr)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(SAVE_DELAY);
+    connect(&m_timer, SIGNAL(timeout()), SLOT(startToSave()));
+}
+
+MusicPersistService::~MusicPersistService()
+{
+    flush();
+}
+
+void MusicPersistService::save(const QString &path, const QByteArray &data, bool delay)
+{
+    save(path, [data]() { return data; }, delay);
+}
+
+void MusicPersistService::save(const QString &path, const Serializer &serializer, bool delay)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = std::find_if(m_pending.begin(), m_pending.end(), [&path](const QPair<QString, Serializer> &v) { return v.first == path; });
+        if(it != m_pending.end())
+        {
+            it->second = serializer;
+        }
+        else
+        {
+            m_pending << qMakePair(path, serializer);
+        }
+    }
+
+    if(delay)
+    {
+        m_timer.start();
+    }
+    else
+    {
+        m_timer.stop();
+        startToSave();
+    }
+}
+
+void MusicPersistService::flush()
+{
+    m_timer.stop();
+    // waits for the running writer, then writes what is left
+    writeAll();
+}
+
+void MusicPersistService::startToSave()
+{
+    TTKConcurrent(
+    {
+        writeAll();
+    });
+}
+
+void MusicPersistService::writeAll()
+{
+    QMutexLocker writeLocker(&m_writeMutex);
+
+    QList<QPair<QString, Serializer>> pending;
+    {
+        QMutexLocker locker(&m_mutex);
+        pending.swap(m_pending);
+    }
+
+    for(const QPair<QString, Serializer> &v : qAsConst(pending))
+    {
+        const QByteArray &data = v.second();
+        if(data.isEmpty())
+        {
+            continue;
+        }
+
+        if(!TTKSaveFile::writeFile(v.first, data))
+        {
+            TTK_ERROR_STREAM("Persist file error:" << v.first);
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef MUSICPERSISTSERVICE_H
+#define MUSICPERSISTSERVICE_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QTimer>
+#include <QMutex>
+#include <functional>
+#include "ttksingleton.h"
+
+/*! @brief The class of the config and playlist persist service.
+ * Saves are coalesced per file, then written atomically on a worker thread.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicPersistService : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicPersistService)
+public:
+    using Serializer = std::function<QByteArray()>;
+
+    /*!
+     * Save data into the file by given path.
+     * Delayed saves of the same path are merged, the last data wins.
+     */
+    void save(const QString &path, const QByteArray &data, bool delay = true);
+    /*!
+     * Save the data made by serializer into the file by given path.
+     * The serializer runs on the worker thread, empty data is not written.
+     */
+    void save(const QString &path, const Serializer &serializer, bool delay = true);
+    /*!
+     * Write all pending data and wait for the running writes.
+     */
+    void flush();
+
+private Q_SLOTS:
+    /*!
+     * Start to write the pending data in background.
+     */
+    void startToSave();
+
+private:
+    /*!
+     * Object constructor.
+     */
+    MusicPersistService();
+    /*!
+     * Object destructor.
+     */
+    ~MusicPersistService();
+
+    /*!
+     * Write the pending data, one writer at a time.
+     */
+    void writeAll();
+
+    QTimer m_timer;
+    QMutex m_mutex, m_writeMutex;
+    // written in the order of the first save
+    QList<QPair<QString, Serializer>> m_pending;
+
+    TTK_DECLARE_SINGLETON_CLASS(MusicPersistService)
+
+};
+
+#define G_PERSIST_PTR makeMusicPersistService()
+TTK_MODULE_EXPORT MusicPersistService* makeMusicPersistService();
+
+#endif // MUSICPERSISTSERVICE_H
@@ -5,6 +5,8 @@
 #include "musicsinglemanager.h"
 #include "musicdownloadmanager.h"
 #include "musicdownloadqueryfactory.h"
+#include "musicsongsuggestservice.h"
+#include "musicpersistservice.h"
 
 TTKDispatchManager* makeMusicDispatchManager()
 {
@@ -50,3 +52,13 @@ MusicNetworkThread* makeMusicNetworkThread()
 {
     return TTKSingleton<MusicNetworkThread>::createInstance();
 }
+
+MusicSongSuggestService* makeMusicSongSuggestService()
+{
+    return TTKSingleton<MusicSongSuggestService>::createInstance();
+}
+
+MusicPersistService* makeMusicPersistService()
+{
+    return TTKSingleton<MusicPersistService>::createInstance();
+}
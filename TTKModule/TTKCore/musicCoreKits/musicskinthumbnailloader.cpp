@@ -0,0 +1,175 @@
+#include "musicskinthumbnailloader.h"
+#include "musicextractwrapper.h"
+#include "musicalgorithmutils.h"
+
+#include <QDir>
+#include <QThread>
+#include <QDateTime>
+#include <QImageReader>
+#include <QImageWriter>
+
+static constexpr const char *CACHE_PATH_KEY = "path";
+static constexpr const char *CACHE_STAMP_KEY = "stamp";
+static constexpr const char *CACHE_NAME_KEY = "name";
+static constexpr const char *CACHE_COUNT_KEY = "count";
+
+/*!
+ * Cache file of the skin thumbnail, one entry per skin path and size.
+ */
+static QString cacheFilePath(const QString &path, const QSize &size)
+{
+    const QString &key = QString("%1|%2x%3").arg(QFileInfo(path).absoluteFilePath()).arg(size.width()).arg(size.height());
+    return THUMBNAIL_DIR_FULL + TTK::Algorithm::md5(key.toUtf8()) + PNG_FILE;
+}
+
+/*! @brief The class of the skin thumbnail task.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicSkinThumbnailTask : public QRunnable
+{
+public:
+    MusicSkinThumbnailTask(MusicSkinThumbnailLoader *loader, const QString &path, const QSize &size)
+        : m_loader(loader),
+          m_path(path),
+          m_size(size)
+    {
+
+    }
+
+    virtual void run() override final
+    {
+        QImage image;
+        MusicSkinItem item;
+        if(!load(image, item))
+        {
+            return;
+        }
+
+        // loader waits for the pool on destruction, queued call is dropped if it has gone
+        QMetaObject::invokeMethod(m_loader, "thumbnailFinished", Qt::QueuedConnection, Q_ARG(QString, m_path), Q_ARG(QImage, image),
+                                                                                       Q_ARG(QString, item.m_name), Q_ARG(int, item.m_useCount));
+    }
+
+private:
+    bool load(QImage &image, MusicSkinItem &item) const
+    {
+        const QFileInfo fin(m_path);
+        const QString &stamp = QString("%1|%2").arg(fin.lastModified().toMSecsSinceEpoch()).arg(fin.size());
+        const QString &cache = cacheFilePath(m_path, m_size);
+
+        // text chunks are written ahead of the image data, the stamp is known before decoding
+        QImageReader reader(cache);
+        if(reader.canRead() && reader.text(CACHE_STAMP_KEY) == stamp && !reader.text(CACHE_COUNT_KEY).isEmpty())
+        {
+            item.m_name = reader.text(CACHE_NAME_KEY);
+            item.m_useCount = reader.text(CACHE_COUNT_KEY).toInt();
+            image = reader.read();
+            if(!image.isNull())
+            {
+                return true;
+            }
+        }
+
+        // the skin config is kept with the thumbnail, a cached skin is never opened
+        if(!MusicExtractWrapper::outputSkin(item, m_path) || !MusicExtractWrapper::outputSkin(image, m_path, m_size))
+        {
+            return false;
+        }
+
+        // overwrite the entry of the previous skin revision
+        QImageWriter writer(cache, PNG_FILE_SUFFIX);
+        writer.setText(CACHE_PATH_KEY, fin.absoluteFilePath());
+        writer.setText(CACHE_STAMP_KEY, stamp);
+        writer.setText(CACHE_NAME_KEY, item.m_name);
+        writer.setText(CACHE_COUNT_KEY, QString::number(item.m_useCount));
+        writer.write(image);
+        return true;
+    }
+
+    MusicSkinThumbnailLoader *m_loader;
+    QString m_path;
+    QSize m_size;
+
+};
+
+
+/*! @brief The class of the skin thumbnail prune task.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicSkinThumbnailPruneTask : public QRunnable
+{
+public:
+    MusicSkinThumbnailPruneTask()
+        : m_time(QDateTime::currentDateTime())
+    {
+
+    }
+
+    virtual void run() override final
+    {
+        const QFileInfoList &files = QDir(THUMBNAIL_DIR_FULL).entryInfoList(QStringList() << "*" + QString(PNG_FILE), QDir::Files);
+        for(const QFileInfo &fin : qAsConst(files))
+        {
+            // entries written by this session are fresh, they may still be in progress
+            if(fin.lastModified() >= m_time)
+            {
+                continue;
+            }
+
+            const QString &path = QImageReader(fin.absoluteFilePath()).text(CACHE_PATH_KEY);
+            if(path.isEmpty() || !QFile::exists(path))
+            {
+                QFile::remove(fin.absoluteFilePath());
+            }
+        }
+    }
+
+private:
+    QDateTime m_time;
+
+};
+
+
+MusicSkinThumbnailLoader::MusicSkinThumbnailLoader(QObject *parent)
+    : QObject(parent)
+{
+    // keep gui responsive, decoding is memory bound anyway
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+
+    // entries of skins removed out of the player are found once per session
+    static bool pruned = false;
+    if(!pruned)
+    {
+        pruned = true;
+        m_pool.start(new MusicSkinThumbnailPruneTask);
+    }
+}
+
+MusicSkinThumbnailLoader::~MusicSkinThumbnailLoader()
+{
+    abort();
+}
+
+void MusicSkinThumbnailLoader::load(const QString &path, const QSize &size)
+{
+    m_pool.start(new MusicSkinThumbnailTask(this, path, size));
+}
+
+void MusicSkinThumbnailLoader::abort()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void MusicSkinThumbnailLoader::remove(const QString &path, const QSize &size)
+{
+    QFile::remove(cacheFilePath(path, size));
+}
+
+void MusicSkinThumbnailLoader::thumbnailFinished(const QString &path, const QImage &image, const QString &name, int count)
+{
+    MusicSkinItem item;
+    item.m_name = name;
+    item.m_useCount = count;
+    Q_EMIT finished(path, QPixmap::fromImage(image), item);
+}
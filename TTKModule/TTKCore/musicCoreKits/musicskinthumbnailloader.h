@@ -0,0 +1,77 @@
+#ifndef MUSICSKINTHUMBNAILLOADER_H
+#define MUSICSKINTHUMBNAILLOADER_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QSize>
+#include <QThreadPool>
+#include "musicbackgroundconfigmanager.h"
+
+/*! @brief The class of the skin thumbnail loader.
+ * Thumbnails and skin configs are read on a private thread pool at the requested size
+ * and kept in the thumbnail cache dir, keyed by skin path and size.
+ * Entries of changed skins are rewritten in place, entries of removed skins are pruned.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicSkinThumbnailLoader : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicSkinThumbnailLoader)
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicSkinThumbnailLoader(QObject *parent = nullptr);
+    /*!
+     * Object destructor.
+     */
+    ~MusicSkinThumbnailLoader();
+
+    /*!
+     * Request skin thumbnail by path, result is sent by finished signal.
+     */
+    void load(const QString &path, const QSize &size);
+    /*!
+     * Abort all requests not started yet and wait for running ones.
+     */
+    void abort();
+
+    /*!
+     * Remove the cached thumbnail of the skin path.
+     */
+    static void remove(const QString &path, const QSize &size);
+
+Q_SIGNALS:
+    /*!
+     * Skin thumbnail and config are ready.
+     */
+    void finished(const QString &path, const QPixmap &pixmap, const MusicSkinItem &item);
+
+private Q_SLOTS:
+    /*!
+     * Thumbnail decoded and config read from worker thread.
+     */
+    void thumbnailFinished(const QString &path, const QImage &image, const QString &name, int count);
+
+private:
+    QThreadPool m_pool;
+
+};
+
+#endif // MUSICSKINTHUMBNAILLOADER_H
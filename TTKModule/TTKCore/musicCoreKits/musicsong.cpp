@@ -5,10 +5,13 @@
 #include "musicextractwrapper.h"
 #include "musicsettingmanager.h"
 
+#include <thread>
 #include <qmmp/regularexpression.h>
 
 MusicSong::MusicSong() noexcept
     : m_sort(Sort::ByFileName),
+      m_track(false),
+      m_state(StatReady),
       m_size(0),
       m_addTime(-1),
       m_sizeStr(TTK_DEFAULT_STR),
@@ -37,12 +40,41 @@ MusicSong::MusicSong(const QString &path, const QString &duration, const QString
     const QFileInfo fin(!track ? m_path : TTK::trackRelatedPath(m_path));
 
     m_name = name.isEmpty() ? fin.completeBaseName() : name;
-    m_size = fin.size();
     m_format = TTK_FILE_SUFFIX(fin);
-    m_addTime = fin.lastModified().toMSecsSinceEpoch();
     m_duration = duration;
-    m_addTimeStr = QString::number(m_addTime);
-    m_sizeStr = TTK::Number::sizeByteToLabel(m_size);
+    // large playlists are imported without touching every file
+    m_track = track;
+    m_state = StatPending;
+}
+
+MusicSong::MusicSong(const MusicSong &other) noexcept
+    : m_state(StatReady)
+{
+    copy(other);
+}
+
+MusicSong::MusicSong(MusicSong &&other) noexcept
+    : m_state(StatReady)
+{
+    move(other);
+}
+
+MusicSong& MusicSong::operator= (const MusicSong &other) noexcept
+{
+    if(this != &other)
+    {
+        copy(other);
+    }
+    return *this;
+}
+
+MusicSong& MusicSong::operator= (MusicSong &&other) noexcept
+{
+    if(this != &other)
+    {
+        move(other);
+    }
+    return *this;
 }
 
 QString MusicSong::title() const noexcept
@@ -66,8 +98,8 @@ bool MusicSong::operator< (const MusicSong &other) const noexcept
     {
         case Sort::ByFileName: return m_name < other.m_name;
         case Sort::BySinger: return artist() < other.artist();
-        case Sort::ByFileSize: return m_size < other.m_size;
-        case Sort::ByAddTime: return m_addTime < other.m_addTime;
+        case Sort::ByFileSize: return size() < other.size();
+        case Sort::ByAddTime: stat(); other.stat(); return m_addTime < other.m_addTime;
         case Sort::ByDuration: return m_duration < other.m_duration;
         case Sort::ByPlayCount: return m_playCount < other.m_playCount;
         default: break;
@@ -81,8 +113,8 @@ bool MusicSong::operator> (const MusicSong &other) const noexcept
     {
         case Sort::ByFileName: return m_name > other.m_name;
         case Sort::BySinger: return artist() > other.artist();
-        case Sort::ByFileSize: return m_size > other.m_size;
-        case Sort::ByAddTime: return m_addTime > other.m_addTime;
+        case Sort::ByFileSize: return size() > other.size();
+        case Sort::ByAddTime: stat(); other.stat(); return m_addTime > other.m_addTime;
         case Sort::ByDuration: return m_duration > other.m_duration;
         case Sort::ByPlayCount: return m_playCount > other.m_playCount;
         default: break;
@@ -90,6 +122,97 @@ bool MusicSong::operator> (const MusicSong &other) const noexcept
     return false;
 }
 
+void MusicSong::statFile() const noexcept
+{
+    // songs are shared with background tasks, the first caller reads the file and the others wait for it
+    int state = StatPending;
+    if(!m_state.compare_exchange_strong(state, StatRunning, std::memory_order_acquire))
+    {
+        while(m_state.load(std::memory_order_acquire) != StatReady)
+        {
+            std::this_thread::yield();
+        }
+        return;
+    }
+
+    const QFileInfo fin(!m_track ? m_path : TTK::trackRelatedPath(m_path));
+    m_size = fin.size();
+    m_addTime = fin.lastModified().toMSecsSinceEpoch();
+    m_addTimeStr = QString::number(m_addTime);
+    m_sizeStr = TTK::Number::sizeByteToLabel(m_size);
+    m_state.store(StatReady, std::memory_order_release);
+}
+
+int MusicSong::waitState() const noexcept
+{
+    int state = m_state.load(std::memory_order_acquire);
+    while(state == StatRunning)
+    {
+        std::this_thread::yield();
+        state = m_state.load(std::memory_order_acquire);
+    }
+    return state;
+}
+
+void MusicSong::copy(const MusicSong &other) noexcept
+{
+    const int state = other.waitState();
+    m_sort = other.m_sort;
+    m_track = other.m_track;
+    m_playCount = other.m_playCount;
+    m_name = other.m_name;
+    m_path = other.m_path;
+    m_format = other.m_format;
+    m_duration = other.m_duration;
+
+    // a pending song may be stated by another thread meanwhile, its file info is never read here
+    if(state == StatReady)
+    {
+        m_size = other.m_size;
+        m_addTime = other.m_addTime;
+        m_sizeStr = other.m_sizeStr;
+        m_addTimeStr = other.m_addTimeStr;
+    }
+    else
+    {
+        m_size = 0;
+        m_addTime = -1;
+        m_sizeStr = TTK_DEFAULT_STR;
+        m_addTimeStr = TTK_DEFAULT_STR;
+    }
+    m_state.store(state, std::memory_order_release);
+}
+
+void MusicSong::move(MusicSong &other) noexcept
+{
+    const int state = other.waitState();
+    m_sort = other.m_sort;
+    m_track = other.m_track;
+    m_playCount = other.m_playCount;
+    m_name = std::move(other.m_name);
+    m_path = std::move(other.m_path);
+    m_format = std::move(other.m_format);
+    m_duration = std::move(other.m_duration);
+
+    if(state == StatReady)
+    {
+        m_size = other.m_size;
+        m_addTime = other.m_addTime;
+        m_sizeStr = std::move(other.m_sizeStr);
+        m_addTimeStr = std::move(other.m_addTimeStr);
+    }
+    else
+    {
+        m_size = 0;
+        m_addTime = -1;
+        m_sizeStr = TTK_DEFAULT_STR;
+        m_addTimeStr = TTK_DEFAULT_STR;
+    }
+    m_state.store(state, std::memory_order_release);
+    // the moved from song reads its own file info again when asked
+    other.m_state.store(StatPending, std::memory_order_release);
+}
+
 
 bool TTK::playlistRowValid(int index)
 {
@@ -19,6 +19,7 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
+#include <atomic>
 #include "ttktime.h"
 #include "musicstringutils.h"
 
@@ -45,6 +46,8 @@ public:
     MusicSong() noexcept;
     explicit MusicSong(const QString &path, bool track = false) noexcept;
     MusicSong(const QString &path, const QString &duration, const QString &name = {}, bool track = false) noexcept;
+    MusicSong(const MusicSong &other) noexcept;
+    MusicSong(MusicSong &&other) noexcept;
 
     /*!
      * Get music title name.
@@ -58,19 +61,19 @@ public:
     /*!
      * Set music add time string.
      */
-    inline void setAddTimeStr(const QString &t) noexcept { m_addTimeStr = t; }
+    inline void setAddTimeStr(const QString &t) noexcept { stat(); m_addTimeStr = t; }
     /*!
      * Get music add time string.
      */
-    inline QString addTimeStr() const noexcept { return m_addTimeStr; }
+    inline QString addTimeStr() const noexcept { stat(); return m_addTimeStr; }
     /*!
      * Set music size string.
      */
-    inline void setSizeStr(const QString &s) noexcept { m_sizeStr = s; }
+    inline void setSizeStr(const QString &s) noexcept { stat(); m_sizeStr = s; }
     /*!
      * Get music size string.
      */
-    inline QString sizeStr() const noexcept { return m_sizeStr; }
+    inline QString sizeStr() const noexcept { stat(); return m_sizeStr; }
 
     /*!
      * Set music name.
@@ -107,7 +110,7 @@ public:
     /*!
      * Get music size.
      */
-    inline qint64 size() const noexcept { return m_size; }
+    inline qint64 size() const noexcept { stat(); return m_size; }
     /*!
      * Set music play count.
      */
@@ -116,11 +119,20 @@ public:
      * Get music play count.
      */
     inline int playCount() const noexcept { return m_playCount; }
+    /*!
+     * Get music is cue sheet track or not.
+     */
+    inline bool isTrack() const noexcept { return m_track; }
     /*!
      * Set music sort type.
      */
     inline void setSort(const Sort s) noexcept { m_sort = s; }
 
+    /*!
+     * Operator = function.
+     */
+    MusicSong& operator= (const MusicSong &other) noexcept;
+    MusicSong& operator= (MusicSong &&other) noexcept;
     /*!
      * Operator == function.
      */
@@ -135,9 +147,39 @@ public:
     bool operator> (const MusicSong &other) const noexcept;
 
 private:
+    enum StatState
+    {
+        StatPending,     /*!< File not read yet*/
+        StatRunning,     /*!< File being read*/
+        StatReady        /*!< File info ready*/
+    };
+
+    /*!
+     * Read file size and modified time on first use.
+     */
+    inline void stat() const noexcept { if(m_state.load(std::memory_order_acquire) != StatReady) statFile(); }
+    /*!
+     * Read file size and modified time, only once across threads.
+     */
+    void statFile() const noexcept;
+    /*!
+     * Wait for the file info being read by another thread, return the state.
+     */
+    int waitState() const noexcept;
+    /*!
+     * Copy the song from other, the file info only once it is ready.
+     */
+    void copy(const MusicSong &other) noexcept;
+    /*!
+     * Move the song from other, the file info only once it is ready.
+     */
+    void move(MusicSong &other) noexcept;
+
     Sort m_sort;
-    qint64 m_size, m_addTime;
-    QString m_sizeStr, m_addTimeStr;
+    bool m_track;
+    mutable std::atomic<int> m_state;
+    mutable qint64 m_size, m_addTime;
+    mutable QString m_sizeStr, m_addTimeStr;
     int m_playCount;
     QString m_name, m_path, m_format, m_duration;
 
@@ -118,6 +118,7 @@ HEADERS += \
     $$PWD/tools/musicresourcerequest.h \
     $$PWD/tools/musicpvcounterrequest.h \
     $$PWD/tools/musicdownloadmanager.h \
+    $$PWD/tools/musiclrcbatchrequest.h \
     $$PWD/translation/musicabstracttranslationrequest.h \
     $$PWD/translation/musictranslationrequest.h \
     $$PWD/translation/musicbdtranslationrequest.h \
@@ -212,6 +213,7 @@ SOURCES += \
     $$PWD/tools/musicresourcerequest.cpp \
     $$PWD/tools/musicpvcounterrequest.cpp \
     $$PWD/tools/musicdownloadmanager.cpp \
+    $$PWD/tools/musiclrcbatchrequest.cpp \
     $$PWD/translation/musicabstracttranslationrequest.cpp \
     $$PWD/translation/musictranslationrequest.cpp \
     $$PWD/translation/musicbdtranslationrequest.cpp \
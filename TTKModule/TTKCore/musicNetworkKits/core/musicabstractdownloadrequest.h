@@ -51,6 +51,11 @@ public:
      */
     virtual void startToRequest() = 0;
 
+    /*!
+     * Get the received size of the current download.
+     */
+    inline qint64 receivedSize() const { return m_currentReceived; }
+
 public Q_SLOTS:
     /*!
      * Download data from net finished.
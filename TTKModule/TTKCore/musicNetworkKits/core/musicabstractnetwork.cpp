@@ -1,16 +1,25 @@
 #include "musicabstractnetwork.h"
 
 MusicAbstractNetwork::MusicAbstractNetwork(QObject *parent)
-    : TTKAbstractNetwork(parent)
+    : TTKAbstractNetwork(parent),
+      m_replyError(false)
 {
 
 }
 
+void MusicAbstractNetwork::deleteAll()
+{
+    // every request starts by releasing the previous one
+    m_replyError = false;
+    TTKAbstractNetwork::deleteAll();
+}
+
 void MusicAbstractNetwork::replyError(QNetworkReply::NetworkError)
 {
     TTK_ERROR_STREAM("Abnormal network connection");
 //    Q_EMIT downLoadDataChanged({});
     deleteAll();
+    m_replyError = true;
 }
 
 #ifndef QT_NO_SSL
@@ -19,5 +28,6 @@ void MusicAbstractNetwork::sslErrors(QNetworkReply* reply, const QList<QSslError
     sslErrorsString(reply, errors);
 //    Q_EMIT downLoadDataChanged({});
     deleteAll();
+    m_replyError = true;
 }
 #endif
@@ -42,6 +42,15 @@ public:
      */
     explicit MusicAbstractNetwork(QObject *parent = nullptr);
 
+    /*!
+     * Release the network object.
+     */
+    virtual void deleteAll() override;
+    /*!
+     * Check the reply of the current request failed, cleared when the next request starts.
+     */
+    inline bool hasReplyError() const { return m_replyError; }
+
 public Q_SLOTS:
     /*!
      * Download reply error.
@@ -54,6 +63,9 @@ public Q_SLOTS:
     virtual void sslErrors(QNetworkReply *reply, const QList<QSslError> &errors) override;
 #endif
 
+protected:
+    bool m_replyError;
+
 };
 
 #endif // MUSICABSTRACTNETWORK_H
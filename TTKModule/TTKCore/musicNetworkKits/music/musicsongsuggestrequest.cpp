@@ -13,7 +13,7 @@ void MusicSongSuggestRequest::startToSearch(const QString &value)
 {
     TTK_INFO_STREAM(className() << "startToSearch" << value);
 
-    deleteAll();
+    abort();
 
     QNetworkRequest request;
     request.setUrl(TTK::Algorithm::mdII(QUERY_URL, false).arg(value));
@@ -24,6 +24,16 @@ void MusicSongSuggestRequest::startToSearch(const QString &value)
     QtNetworkErrorConnect(m_reply, this, replyError, TTK_SLOT);
 }
 
+void MusicSongSuggestRequest::abort()
+{
+    if(m_reply)
+    {
+        disconnect(m_reply, nullptr, this, nullptr);
+        m_reply->abort();
+    }
+    deleteAll();
+}
+
 void MusicSongSuggestRequest::downLoadFinished()
 {
     TTK_INFO_STREAM(className() << "downLoadFinished");
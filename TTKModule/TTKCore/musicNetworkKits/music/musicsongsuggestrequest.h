@@ -38,6 +38,10 @@ public:
      * Start to search data by input data.
      */
     virtual void startToSearch(const QString &value);
+    /*!
+     * Abort the running request, no finished signal is emitted for it.
+     */
+    void abort();
 
     /*!
      * Get suggest list items.
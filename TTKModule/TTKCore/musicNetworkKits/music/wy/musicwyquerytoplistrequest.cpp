@@ -50,7 +50,8 @@ void MusicWYQueryToplistRequest::downLoadFinished()
     {
         QJson::Parser json;
         bool ok = false;
-        const QVariant &data = json.parse(m_reply->readAll(), &ok);
+        // the large privileges list beside the playlist is never used, skip it
+        const QVariant &data = json.parse(m_reply->readAll(), {"code", "playlist"}, &ok);
         if(ok)
         {
             QVariantMap value = data.toMap();
@@ -3,10 +3,37 @@
 #include "musicdownloadstatusmodule.h"
 #include "musicdownloadrecordwidget.h"
 #include "musiccloudtablewidget.h"
+#include "musicdownloadmetadatarequest.h"
+#include "musicpersistservice.h"
+#include "qjson/parser.h"
+#include "qjson/serializer.h"
+
+static constexpr int MAX_REQUEST_COUNT = 3;
+static constexpr int MAX_HOST_REQUEST_COUNT = 2;
+
+static QString requestHost(const QString &url)
+{
+    return QUrl(url).host();
+}
+
+
+MusicDownLoadManager::MusicDownLoadManager()
+    : QObject(nullptr),
+      m_maxCount(MAX_REQUEST_COUNT),
+      m_maxHostCount(MAX_HOST_REQUEST_COUNT),
+      m_lastId(0),
+      m_finishedSize(0),
+      m_receivedSize(0),
+      m_throughput(0)
+{
+    m_speedTimer.setInterval(TTK_DN_S2MS);
+    connect(&m_speedTimer, SIGNAL(timeout()), SLOT(updateThroughput()));
+    connect(G_NETWORK_PTR, SIGNAL(networkConnectionStateChanged(bool)), SLOT(networkStateChanged(bool)));
+}
 
 void MusicDownLoadManager::connectNetworkMultiValue(QObject *object)
 {
-    m_queueList << object;
+    m_queueList.insert(object);
     const QObject *to = G_CONNECTION_PTR->value(MusicDownloadStatusModule::className());
     if(to)
     {
@@ -16,11 +43,7 @@ void MusicDownLoadManager::connectNetworkMultiValue(QObject *object)
 
 void MusicDownLoadManager::removeNetworkMultiValue(QObject *object)
 {
-    const int index = m_queueList.indexOf(object);
-    if(index != -1)
-    {
-        m_queueList.takeAt(index);
-    }
+    m_queueList.remove(object);
 }
 
 void MusicDownLoadManager::connectDownload(const MusicDownLoadPairData &pair)
@@ -42,15 +65,15 @@ void MusicDownLoadManager::connectDownload(const MusicDownLoadPairData &pair)
     }
 
     connect(pair.m_object, SIGNAL(downloadProgressChanged(float, QString, qint64)), SLOT(downloadProgressChanged(float, QString, qint64)));
-    m_pairList << pair;
+    m_pairList.insert(pair.m_timestamp, pair);
 }
 
 void MusicDownLoadManager::reconnectDownload(const MusicDownLoadPairData &pair)
 {
-    const int index = m_pairList.indexOf(pair);
-    if(index != -1)
+    const auto it = m_pairList.find(pair.m_timestamp);
+    if(it != m_pairList.end())
     {
-        MusicDownLoadPairData *p = &m_pairList[index];
+        const MusicDownLoadPairData *p = &it.value();
         disconnect(p->m_object, SIGNAL(createDownloadItem(QString, qint64)), pair.m_object, SLOT(createDownloadItem(QString, qint64)));
         disconnect(p->m_object, SIGNAL(downloadProgressChanged(float, QString, qint64)), pair.m_object, SLOT(downloadProgressChanged(float, QString, qint64)));
 
@@ -61,11 +84,101 @@ void MusicDownLoadManager::reconnectDownload(const MusicDownLoadPairData &pair)
 
 void MusicDownLoadManager::removeDownload(const MusicDownLoadPairData &pair)
 {
-    const int index = m_pairList.indexOf(pair);
-    if(index != -1)
+    m_pairList.remove(pair.m_timestamp);
+}
+
+void MusicDownLoadManager::setConcurrency(int total, int host)
+{
+    m_maxCount = qMax(1, total);
+    m_maxHostCount = qBound(1, host, m_maxCount);
+    startTasks();
+}
+
+qint64 MusicDownLoadManager::addTask(const MusicDownloadTaskData &data, QObject *receiver)
+{
+    MusicDownloadTaskData task(data);
+    task.m_id = ++m_lastId;
+
+    m_tasks.insert(task.m_id, task);
+    m_queue.insert(QueueKey(-task.m_priority, task.m_id), task.m_id);
+    if(receiver)
+    {
+        m_receivers.insert(task.m_id, receiver);
+    }
+
+    saveTasks();
+    startTasks();
+    return task.m_id;
+}
+
+void MusicDownLoadManager::removeTask(qint64 id)
+{
+    const auto it = m_tasks.find(id);
+    if(it == m_tasks.end())
+    {
+        return;
+    }
+
+    m_queue.remove(QueueKey(-it->m_priority, id));
+    MusicAbstractDownLoadRequest *request = m_running.value(id);
+    if(request)
+    {
+        // the destroyed handler releases the slot
+        request->deleteAll();
+    }
+    else
+    {
+        finishTask(id);
+    }
+}
+
+void MusicDownLoadManager::resumeTasks()
+{
+    QFile file(DOWNLOAD_QUEUE_PATH_FULL);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    bool ok = false;
+    QJson::Parser json;
+    const QVariantList &datas = json.parse(file.readAll(), &ok).toList();
+    file.close();
+
+    if(!ok)
     {
-        m_pairList.takeAt(index);
+        TTK_ERROR_STREAM("Download queue file is broken");
+        return;
+    }
+
+    // interrupted tasks start over, the request removes the incomplete file
+    // ids grow in file order, so tasks of the same priority keep their saved order
+    for(const QVariant &var : qAsConst(datas))
+    {
+        const QVariantMap &value = var.toMap();
+        MusicDownloadTaskData data;
+        data.m_priority = value["priority"].toInt();
+        data.m_url = value["url"].toString();
+        data.m_path = value["path"].toString();
+        data.m_type = TTKStaticCast(TTK::Download, value["type"].toInt());
+        data.m_title = value["title"].toString();
+        data.m_artist = value["artist"].toString();
+        data.m_album = value["album"].toString();
+        data.m_cover = value["cover"].toString();
+        data.m_trackNumber = value["trackNumber"].toString();
+        data.m_year = value["year"].toString();
+
+        if(data.m_url.isEmpty() || data.m_path.isEmpty())
+        {
+            continue;
+        }
+
+        data.m_id = ++m_lastId;
+        m_tasks.insert(data.m_id, data);
+        m_queue.insert(QueueKey(-data.m_priority, data.m_id), data.m_id);
     }
+
+    startTasks();
 }
 
 void MusicDownLoadManager::downloadProgressChanged(float percent, const QString &total, qint64 time)
@@ -76,3 +189,177 @@ void MusicDownLoadManager::downloadProgressChanged(float percent, const QString
         removeDownload(MusicDownLoadPairData(time));
     }
 }
+
+void MusicDownLoadManager::taskFinished()
+{
+    // sampled before the request deletes itself
+    MusicAbstractDownLoadRequest *request = TTKObjectCast(MusicAbstractDownLoadRequest*, sender());
+    if(request && m_requests.contains(request))
+    {
+        m_finishedSize += request->receivedSize();
+    }
+}
+
+void MusicDownLoadManager::taskDestroyed(QObject *object)
+{
+    const auto it = m_requests.find(object);
+    if(it == m_requests.end())
+    {
+        return;
+    }
+
+    const qint64 id = it.value();
+    m_requests.erase(it);
+    m_running.remove(id);
+
+    const QString &host = requestHost(m_tasks.value(id).m_url);
+    if(--m_hosts[host] <= 0)
+    {
+        m_hosts.remove(host);
+    }
+
+    finishTask(id);
+    startTasks();
+}
+
+void MusicDownLoadManager::updateThroughput()
+{
+    qint64 size = m_finishedSize;
+    for(MusicAbstractDownLoadRequest *request : qAsConst(m_running))
+    {
+        size += request->receivedSize();
+    }
+
+    m_throughput = qMax<qint64>(0, size - m_receivedSize);
+    m_receivedSize = size;
+
+    if(m_running.isEmpty())
+    {
+        m_speedTimer.stop();
+        m_throughput = 0;
+        m_finishedSize = m_receivedSize = 0;
+    }
+    Q_EMIT queueStatisticsChanged(queueCount(), runningCount(), m_throughput);
+}
+
+void MusicDownLoadManager::networkStateChanged(bool state)
+{
+    if(state)
+    {
+        startTasks();
+    }
+}
+
+void MusicDownLoadManager::startTasks()
+{
+    if(!G_NETWORK_PTR->isOnline())
+    {
+        return;
+    }
+
+    auto it = m_queue.begin();
+    while(it != m_queue.end() && m_running.count() < m_maxCount)
+    {
+        const MusicDownloadTaskData &data = m_tasks.value(it.value());
+        if(m_hosts.value(requestHost(data.m_url)) >= m_maxHostCount)
+        {
+            ++it;
+            continue;
+        }
+
+        it = m_queue.erase(it);
+        startTask(data);
+    }
+
+    if(!m_running.isEmpty() && !m_speedTimer.isActive())
+    {
+        m_speedTimer.start();
+    }
+    Q_EMIT queueStatisticsChanged(queueCount(), runningCount(), m_throughput);
+}
+
+void MusicDownLoadManager::startTask(const MusicDownloadTaskData &data)
+{
+    MusicAbstractDownLoadRequest *request = nullptr;
+    if(data.m_type == TTK::Download::Music)
+    {
+        MusicSongMeta meta;
+        meta.setComment(data.m_cover);
+        meta.setTitle(data.m_title);
+        meta.setArtist(data.m_artist);
+        meta.setAlbum(data.m_album);
+        meta.setTrackNum(data.m_trackNumber);
+        meta.setYear(data.m_year);
+
+        MusicDownloadMetaDataRequest *d = new MusicDownloadMetaDataRequest(data.m_url, data.m_path, this);
+        d->setSongMeta(meta);
+        request = d;
+    }
+    else
+    {
+        request = new MusicDownloadDataRequest(data.m_url, data.m_path, data.m_type, this);
+    }
+
+    ++m_hosts[requestHost(data.m_url)];
+    m_running.insert(data.m_id, request);
+    m_requests.insert(request, data.m_id);
+
+    connect(request, SIGNAL(downLoadDataChanged(QString)), SLOT(taskFinished()));
+    connect(request, SIGNAL(destroyed(QObject*)), SLOT(taskDestroyed(QObject*)));
+
+    QObject *receiver = m_receivers.value(data.m_id);
+    if(receiver)
+    {
+        connect(request, SIGNAL(downLoadDataChanged(QString)), receiver, SLOT(downloadFinished()));
+    }
+
+    request->startToRequest();
+}
+
+void MusicDownLoadManager::finishTask(qint64 id)
+{
+    m_tasks.remove(id);
+    m_receivers.remove(id);
+    saveTasks();
+}
+
+void MusicDownLoadManager::saveTasks() const
+{
+    // the waiting tasks in queue order then the running ones by id, read back in the same order
+    QList<qint64> ids = m_queue.values();
+    QList<qint64> running = m_running.keys();
+    std::sort(running.begin(), running.end());
+    ids << running;
+
+    QVariantList datas;
+    for(const qint64 id : qAsConst(ids))
+    {
+        const auto it = m_tasks.constFind(id);
+        if(it == m_tasks.constEnd())
+        {
+            continue;
+        }
+
+        const MusicDownloadTaskData &data = it.value();
+        QVariantMap value;
+        value["priority"] = data.m_priority;
+        value["url"] = data.m_url;
+        value["path"] = data.m_path;
+        value["type"] = TTKStaticCast(int, data.m_type);
+        value["title"] = data.m_title;
+        value["artist"] = data.m_artist;
+        value["album"] = data.m_album;
+        value["cover"] = data.m_cover;
+        value["trackNumber"] = data.m_trackNumber;
+        value["year"] = data.m_year;
+        datas << value;
+    }
+
+    bool ok = false;
+    QJson::Serializer json;
+    const QByteArray &data = json.serialize(datas, &ok);
+    if(ok)
+    {
+        G_PERSIST_PTR->save(DOWNLOAD_QUEUE_PATH_FULL, data);
+    }
+}
@@ -19,9 +19,39 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
+#include <QTimer>
+#include <QPointer>
 #include "ttksingleton.h"
 #include "musicnetworkdefines.h"
 
+class MusicAbstractDownLoadRequest;
+
+/*! @brief The class of the download task data.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct TTK_MODULE_EXPORT MusicDownloadTaskData
+{
+    qint64 m_id;
+    int m_priority;
+    QString m_url;
+    QString m_path;
+    TTK::Download m_type;
+    QString m_title;
+    QString m_artist;
+    QString m_album;
+    QString m_cover;
+    QString m_trackNumber;
+    QString m_year;
+
+    MusicDownloadTaskData()
+        : m_id(-1),
+          m_priority(0),
+          m_type(TTK::Download::Music)
+    {
+
+    }
+};
+
 /*! @brief The class of the download manager pair.
  * @author Greedysky <greedysky@163.com>
  */
@@ -94,15 +124,106 @@ public:
      */
     void removeDownload(const MusicDownLoadPairData &pair);
 
+    /*!
+     * Set the max running downloads in total and of one host.
+     */
+    void setConcurrency(int total, int host);
+    /*!
+     * Add download task into queue, higher priority starts first.
+     * The receiver downloadFinished slot is called when the task is done.
+     */
+    qint64 addTask(const MusicDownloadTaskData &data, QObject *receiver = nullptr);
+    /*!
+     * Remove download task by id, the running one is aborted.
+     */
+    void removeTask(qint64 id);
+    /*!
+     * Load the tasks left by last run and start them.
+     */
+    void resumeTasks();
+
+    /*!
+     * Get the waiting task count.
+     */
+    inline int queueCount() const { return m_queue.count(); }
+    /*!
+     * Get the running task count.
+     */
+    inline int runningCount() const { return m_running.count(); }
+    /*!
+     * Get received bytes per second of all running tasks.
+     */
+    inline qint64 throughput() const { return m_throughput; }
+
+Q_SIGNALS:
+    /*!
+     * Queue depth or throughput changed.
+     */
+    void queueStatisticsChanged(int queue, int running, qint64 throughput);
+
 private Q_SLOTS:
     /*!
      * Update download percent total time and current time progress.
      */
     void downloadProgressChanged(float percent, const QString &total, qint64 time);
+    /*!
+     * Running task data download finished.
+     */
+    void taskFinished();
+    /*!
+     * Running task request destroyed.
+     */
+    void taskDestroyed(QObject *object);
+    /*!
+     * Update the throughput of running tasks.
+     */
+    void updateThroughput();
+    /*!
+     * Network connection state changed.
+     */
+    void networkStateChanged(bool state);
 
 private:
-    QObjectList m_queueList;
-    QList<MusicDownLoadPairData> m_pairList;
+    /*!
+     * Object constructor.
+     */
+    MusicDownLoadManager();
+
+    /*!
+     * Key of the task in priority queue.
+     */
+    using QueueKey = QPair<int, qint64>;
+
+    /*!
+     * Start waiting tasks while slots are free.
+     */
+    void startTasks();
+    /*!
+     * Start the task download request.
+     */
+    void startTask(const MusicDownloadTaskData &data);
+    /*!
+     * Remove the finished or aborted task.
+     */
+    void finishTask(qint64 id);
+    /*!
+     * Save the tasks to local in background.
+     */
+    void saveTasks() const;
+
+    QSet<QObject*> m_queueList;
+    QHash<qint64, MusicDownLoadPairData> m_pairList;
+
+    int m_maxCount, m_maxHostCount;
+    qint64 m_lastId, m_finishedSize;
+    qint64 m_receivedSize, m_throughput;
+    QTimer m_speedTimer;
+    QHash<qint64, MusicDownloadTaskData> m_tasks;
+    QMap<QueueKey, qint64> m_queue;
+    QHash<qint64, MusicAbstractDownLoadRequest*> m_running;
+    QHash<QObject*, qint64> m_requests;
+    QHash<QString, int> m_hosts;
+    QHash<qint64, QPointer<QObject>> m_receivers;
 
     TTK_DECLARE_SINGLETON_CLASS(MusicDownLoadManager)
 
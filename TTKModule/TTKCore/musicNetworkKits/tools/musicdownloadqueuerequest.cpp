@@ -1,6 +1,50 @@
 #include "musicdownloadqueuerequest.h"
 
-#include <QStringList>
+#include <QSettings>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QLocale>
+#if TTK_QT_VERSION_CHECK(5,1,0)
+#  include <QSaveFile>
+#endif
+
+static constexpr int MAX_REQUEST_COUNT = 8;
+static constexpr int MAX_HOST_REQUEST_COUNT = 4;
+static constexpr int MAX_RETRY_COUNT = 3;
+static constexpr int RETRY_DELAY = TTK_DN_S2MS / 2;
+static constexpr int REVALIDATE_AGE = 24 * 60 * 60;
+// the time a cached file was last confirmed by a not modified reply
+static constexpr const char *VALIDATED_GROUP = "Validated/";
+
+static QString requestHost(const QString &url)
+{
+    return QUrl(url).host();
+}
+
+static QByteArray httpDate(const QDateTime &time)
+{
+    return QLocale::c().toString(time.toUTC(), "ddd, dd MMM yyyy hh:mm:ss 'GMT'").toLatin1();
+}
+
+static bool writeFile(const QString &path, const QByteArray &data)
+{
+#if TTK_QT_VERSION_CHECK(5,1,0)
+    // written once to a temporary file, synced to disk and renamed on commit
+    QSaveFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size() && file.commit();
+#else
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    const bool ok = file.write(data) == data.size();
+    file.close();
+    return ok;
+#endif
+}
+
 
 MusicDownloadQueueRequest::MusicDownloadQueueRequest(TTK::Download type, QObject *parent)
     : MusicDownloadQueueRequest(MusicDownloadQueueData(), type, parent)
@@ -10,12 +54,17 @@ MusicDownloadQueueRequest::MusicDownloadQueueRequest(TTK::Download type, QObject
 
 MusicDownloadQueueRequest::MusicDownloadQueueRequest(const MusicDownloadQueueData &data, TTK::Download type, QObject *parent)
     : MusicAbstractDownLoadRequest(data.m_url, data.m_path, type, parent),
-      m_isDownload(false),
-      m_isAbort(false)
+      m_isAbort(false),
+      m_order(0),
+      m_validators(nullptr)
 {
     m_request = new QNetworkRequest;
     TTK::setSslConfiguration(m_request);
     TTK::makeContentTypeHeader(m_request);
+
+    m_clock.start();
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, SIGNAL(timeout()), SLOT(startOrderImageQueue()));
 }
 
 MusicDownloadQueueRequest::MusicDownloadQueueRequest(const MusicDownloadQueueDataList &datas, TTK::Download type, QObject *parent)
@@ -26,135 +75,254 @@ MusicDownloadQueueRequest::MusicDownloadQueueRequest(const MusicDownloadQueueDat
 
 MusicDownloadQueueRequest::~MusicDownloadQueueRequest()
 {
+    abort();
     delete m_request;
     m_request = nullptr;
-    deleteAll();
+    delete m_validators;
 }
 
 void MusicDownloadQueueRequest::startToRequest()
 {
-    if(!m_imageQueue.isEmpty())
-    {
-        startOrderImageQueue();
-    }
+    startOrderImageQueue();
 }
 
 void MusicDownloadQueueRequest::abort()
 {
     clear();
-    if(m_isDownload && m_reply)
+
+    m_isAbort = true;
+    const QList<QNetworkReply*> replies(m_replies.keys());
+    m_replies.clear();
+    m_hosts.clear();
+
+    for(QNetworkReply *reply : qAsConst(replies))
     {
-        m_isAbort = true;
-        m_reply->abort();
-        m_file->close();
-        m_file->remove();
-        delete m_reply;
-        m_reply = nullptr;
-        m_isAbort = false;
+        reply->abort();
+        reply->deleteLater();
     }
+    m_isAbort = false;
 }
 
 void MusicDownloadQueueRequest::clear()
 {
+    m_retryTimer.stop();
     m_imageQueue.clear();
 }
 
 void MusicDownloadQueueRequest::addImageQueue(const MusicDownloadQueueDataList &datas)
 {
-    m_imageQueue = datas;
+    clear();
+    for(const MusicDownloadQueueData &data : qAsConst(datas))
+    {
+        Task task;
+        task.m_data = data;
+        task.m_retry = 0;
+        task.m_ready = 0;
+        task.m_order = m_order++;
+        m_imageQueue << task;
+    }
 }
 
-void MusicDownloadQueueRequest::startOrderImageQueue()
+void MusicDownloadQueueRequest::setPriority(const QString &path, int priority)
 {
-    if(m_imageQueue.isEmpty())
+    for(Task &task : m_imageQueue)
     {
-        return;
+        if(task.m_data.m_path == path)
+        {
+            task.m_data.m_priority = priority;
+            break;
+        }
     }
+}
 
-    if(QFile::exists(m_imageQueue.front().m_path))
-    {
-        Q_EMIT downLoadDataChanged(m_imageQueue.takeFirst().m_path);
-        startOrderImageQueue();
-    }
-    else if(G_NETWORK_PTR->isOnline())
+void MusicDownloadQueueRequest::startOrderImageQueue()
+{
+    while(m_replies.count() < MAX_REQUEST_COUNT)
     {
-        startDownload(m_imageQueue.front().m_url);
+        const qint64 now = m_clock.elapsed();
+        qint64 wait = -1;
+        int index = -1;
+
+        for(int i = 0; i < m_imageQueue.count(); ++i)
+        {
+            const Task &task = m_imageQueue[i];
+            if(task.m_ready > now)
+            {
+                wait = (wait == -1) ? task.m_ready - now : qMin(wait, task.m_ready - now);
+                continue;
+            }
+
+            if(m_hosts.value(requestHost(task.m_data.m_url)) >= MAX_HOST_REQUEST_COUNT)
+            {
+                continue;
+            }
+
+            if(index == -1)
+            {
+                index = i;
+                continue;
+            }
+
+            // higher priority first, then the earlier added
+            const Task &best = m_imageQueue[index];
+            if(task.m_data.m_priority > best.m_data.m_priority || (task.m_data.m_priority == best.m_data.m_priority && task.m_order < best.m_order))
+            {
+                index = i;
+            }
+        }
+
+        if(index == -1)
+        {
+            if(wait != -1)
+            {
+                m_retryTimer.start(wait);
+            }
+            break;
+        }
+
+        startDownload(m_imageQueue.takeAt(index));
     }
 }
 
-void MusicDownloadQueueRequest::startDownload(const QString &url)
+void MusicDownloadQueueRequest::startDownload(const Task &task)
 {
-    m_isDownload = true;
-    delete m_file;
-    m_file = new QFile(m_imageQueue.front().m_path, this);
+    const QString &path = task.m_data.m_path;
+    const QFileInfo fin(path);
+    const bool cached = fin.exists() && fin.size() > 0;
+    const QString &key = TTK::Algorithm::md5(path.toUtf8());
 
-    if(!m_file->open(QIODevice::WriteOnly))
+    QDateTime validated = fin.lastModified();
+    if(cached)
     {
-        m_file->close();
-        delete m_file;
-        m_file = nullptr;
-        return;
+        const QDateTime &time = validators()->value(VALIDATED_GROUP + key).toDateTime();
+        if(time.isValid() && time > validated)
+        {
+            validated = time;
+        }
     }
 
-    if(!m_request || url.isEmpty())
+    if(cached && (validated.secsTo(QDateTime::currentDateTime()) < REVALIDATE_AGE || !G_NETWORK_PTR->isOnline()))
     {
+        Q_EMIT downLoadDataChanged(path);
         return;
     }
 
-    m_speedTimer.start();
-    m_request->setUrl(url);
-    m_reply = m_manager.get(*m_request);
-    connect(m_reply, SIGNAL(finished()), SLOT(downLoadFinished()));
-    connect(m_reply, SIGNAL(readyRead()), SLOT(handleReadyRead()));
-    QtNetworkErrorConnect(m_reply, this, handleError, TTK_SLOT);
-}
-
-void MusicDownloadQueueRequest::downLoadFinished()
-{
-    if(m_isAbort || !m_request || !m_reply || !m_file)
+    if(!m_request || task.m_data.m_url.isEmpty() || !G_NETWORK_PTR->isOnline())
     {
         return;
     }
 
-    MusicAbstractDownLoadRequest::downLoadFinished();
-    m_file->flush();
-    m_file->close();
-    m_isDownload = false;
+    QNetworkRequest request(*m_request);
+    request.setUrl(task.m_data.m_url);
 
-    MusicAbstractNetwork::deleteAll();
-    Q_EMIT downLoadDataChanged(m_imageQueue.takeFirst().m_path);
+    if(cached)
+    {
+        // ask the server whether the cached file is still valid, an unchanged one costs no body
+        const QByteArray &tag = validators()->value(key).toByteArray();
+        if(!tag.isEmpty())
+        {
+            request.setRawHeader("If-None-Match", tag);
+        }
+        request.setRawHeader("If-Modified-Since", httpDate(fin.lastModified()));
+    }
 
-    startOrderImageQueue();
+    QNetworkReply *reply = m_manager.get(request);
+    connect(reply, SIGNAL(finished()), SLOT(downLoadFinished()));
+    connect(reply, SIGNAL(readyRead()), SLOT(handleReadyRead()));
+
+    ++m_hosts[requestHost(task.m_data.m_url)];
+    m_replies.insert(reply, task);
 }
 
-void MusicDownloadQueueRequest::handleReadyRead()
+QSettings *MusicDownloadQueueRequest::validators()
 {
-    if(!m_file || !m_reply)
+    if(!m_validators)
     {
-        return;
+        m_validators = new QSettings(VALIDATOR_PATH_FULL, QSettings::IniFormat);
     }
-
-    m_file->write(m_reply->readAll());
-    m_file->flush();
+    return m_validators;
 }
 
-void MusicDownloadQueueRequest::handleError(QNetworkReply::NetworkError code)
+void MusicDownloadQueueRequest::downLoadFinished()
 {
-    if(!m_file || !m_reply)
+    QNetworkReply *reply = TTKObjectCast(QNetworkReply*, sender());
+    if(m_isAbort || !reply || !m_replies.contains(reply))
     {
         return;
     }
 
-#ifndef TTK_DEBUG
-    Q_UNUSED(code);
-#endif
-    TTK_ERROR_STREAM("QNetworkReply::NetworkError:" << code << m_reply->errorString());
-    m_file->flush();
+    Task task = m_replies.take(reply);
+    reply->deleteLater();
+
+    const QString &host = requestHost(task.m_data.m_url);
+    if(--m_hosts[host] <= 0)
+    {
+        m_hosts.remove(host);
+    }
+
+    const QString &path = task.m_data.m_path;
+    const QString &key = TTK::Algorithm::md5(path.toUtf8());
+    if(reply->error() == QNetworkReply::NoError)
+    {
+        const int code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if(code == 304)
+        {
+            // the file is fresh again, it is not asked for until the age passes once more
+            validators()->setValue(VALIDATED_GROUP + key, QDateTime::currentDateTime());
+            Q_EMIT downLoadDataChanged(path);
+        }
+        else
+        {
+            task.m_buffer.append(reply->readAll());
+            if(writeFile(path, task.m_buffer))
+            {
+                const QByteArray &tag = reply->rawHeader("ETag");
+                // the new file time is the validation time now
+                validators()->remove(VALIDATED_GROUP + key);
+                if(tag.isEmpty())
+                {
+                    validators()->remove(key);
+                }
+                else
+                {
+                    validators()->setValue(key, tag);
+                }
+                Q_EMIT downLoadDataChanged(path);
+            }
+            else
+            {
+                TTK_ERROR_STREAM("Write download file error:" << path);
+            }
+        }
+    }
+    else if(reply->error() != QNetworkReply::OperationCanceledError)
+    {
+        TTK_ERROR_STREAM("QNetworkReply::NetworkError:" << reply->error() << reply->errorString());
+        if(task.m_retry < MAX_RETRY_COUNT)
+        {
+            // back off 0.5s, 1s, 2s before the next try
+            task.m_buffer.clear();
+            task.m_ready = m_clock.elapsed() + (RETRY_DELAY << task.m_retry);
+            ++task.m_retry;
+            m_imageQueue << task;
+        }
+        else if(QFile::exists(path))
+        {
+            Q_EMIT downLoadDataChanged(path);
+        }
+    }
+
+    startOrderImageQueue();
+}
 
-    if(!m_isAbort)
+void MusicDownloadQueueRequest::handleReadyRead()
+{
+    QNetworkReply *reply = TTKObjectCast(QNetworkReply*, sender());
+    if(!reply || !m_replies.contains(reply))
     {
-        MusicAbstractNetwork::deleteAll();
+        return;
     }
 
-    startToRequest();
+    // kept in memory and written once when finished
+    m_replies[reply].m_buffer.append(reply->readAll());
 }
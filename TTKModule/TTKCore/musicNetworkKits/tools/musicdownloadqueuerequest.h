@@ -19,8 +19,11 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
+#include <QElapsedTimer>
 #include "musicabstractdownloadrequest.h"
 
+class QSettings;
+
 /*! @brief The class of the download queue data.
  * @author Greedysky <greedysky@163.com>
  */
@@ -28,6 +31,13 @@ struct TTK_MODULE_EXPORT MusicDownloadQueueData
 {
     QString m_url;    ///*download url*/
     QString m_path;   ///*save local path*/
+    int m_priority;   ///*download priority, the higher the earlier*/
+
+    MusicDownloadQueueData()
+        : m_priority(0)
+    {
+
+    }
 };
 TTK_DECLARE_LIST(MusicDownloadQueueData);
 
@@ -53,8 +63,13 @@ public:
 
     /*!
      * Add image download url and save path to download queue.
+     * The waiting items are replaced, the running ones go on.
      */
     void addImageQueue(const MusicDownloadQueueDataList &datas);
+    /*!
+     * Set the priority of the waiting item by save path, such as the items shown on screen.
+     */
+    void setPriority(const QString &path, int priority);
     /*!
      * Start to download queue data.
      */
@@ -78,23 +93,40 @@ public Q_SLOTS:
      * Download received data ready.
      */
     void handleReadyRead();
+
+private Q_SLOTS:
     /*!
-     * Download reply error.
+     * Start the waiting items while the request limits allow.
      */
-    void handleError(QNetworkReply::NetworkError code);
+    void startOrderImageQueue();
 
 private:
+    struct Task
+    {
+        MusicDownloadQueueData m_data;
+        QByteArray m_buffer;
+        int m_retry;
+        qint64 m_ready;
+        qint64 m_order;
+    };
+
     /*!
-     * Start to download data from net.
+     * Start to download data from net, a fresh cached file is used directly.
      */
-    void startDownload(const QString &url);
+    void startDownload(const Task &task);
     /*!
-     * Start to download data in order.
+     * Get the validators settings of cached files.
      */
-    void startOrderImageQueue();
+    QSettings *validators();
 
-    bool m_isDownload, m_isAbort;
-    MusicDownloadQueueDataList m_imageQueue;
+    bool m_isAbort;
+    qint64 m_order;
+    QList<Task> m_imageQueue;
+    QHash<QNetworkReply*, Task> m_replies;
+    QHash<QString, int> m_hosts;
+    QElapsedTimer m_clock;
+    QTimer m_retryTimer;
+    QSettings *m_validators;
     QNetworkRequest *m_request;
 
 };
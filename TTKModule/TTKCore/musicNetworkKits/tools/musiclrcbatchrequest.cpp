@@ -0,0 +1,325 @@
+#include "musiclrcbatchrequest.h"
+#include "musicabstractqueryrequest.h"
+#include "musicdownloadqueryfactory.h"
+#include "musicpersistservice.h"
+#include "qjson/parser.h"
+#include "qjson/serializer.h"
+
+static constexpr int MAX_REQUEST_COUNT = 6;
+static constexpr qint64 MISS_EXPIRY = 7 * 24 * 60 * 60;
+static constexpr qint64 REQUEST_TIMEOUT = 10 * TTK_DN_S2MS;
+
+static QString taskKey(const QString &name)
+{
+    return name.simplified().toLower();
+}
+
+MusicLrcBatchRequest::MusicLrcBatchRequest(QObject *parent)
+    : QObject(parent),
+      m_maxCount(MAX_REQUEST_COUNT),
+      m_missExpiry(MISS_EXPIRY),
+      m_missLoaded(false)
+{
+    m_timer.setInterval(TTK_DN_S2MS);
+    connect(&m_timer, SIGNAL(timeout()), SLOT(requestTimeout()));
+}
+
+MusicLrcBatchRequest::~MusicLrcBatchRequest()
+{
+    abort();
+}
+
+void MusicLrcBatchRequest::setMaxCount(int count)
+{
+    m_maxCount = qMax(1, count);
+}
+
+void MusicLrcBatchRequest::setMissExpiry(qint64 seconds)
+{
+    m_missExpiry = qMax<qint64>(0, seconds);
+}
+
+void MusicLrcBatchRequest::addTask(int index, const QString &name, const QString &path)
+{
+    const QString &key = taskKey(name);
+    if(key.isEmpty())
+    {
+        Q_EMIT downloadStateChanged(index, false, false);
+        return;
+    }
+
+    if(!m_tasks.contains(key))
+    {
+        m_keys << key;
+    }
+
+    Task task;
+    task.m_index = index;
+    task.m_name = name;
+    task.m_path = path;
+    m_tasks[key] << task;
+}
+
+void MusicLrcBatchRequest::startToRequest()
+{
+    readMisses();
+
+    // names known without lrc finish at once
+    const qint64 now = TTKDateTime::currentTimestamp() / TTK_DN_S2MS;
+    for(int i = m_keys.count() - 1; i >= 0; --i)
+    {
+        const QString &key = m_keys[i];
+        if(m_misses.value(key, -1) > now)
+        {
+            for(const Task &task : m_tasks.take(key))
+            {
+                Q_EMIT downloadStateChanged(task.m_index, false, true);
+            }
+            m_keys.removeAt(i);
+        }
+    }
+
+    startTasks();
+}
+
+void MusicLrcBatchRequest::abort()
+{
+    m_timer.stop();
+    // requests destroyed meanwhile have been dropped already, the rest are alive
+    const QObjectList requests(m_requests.keys());
+    m_requests.clear();
+    m_tasks.clear();
+    m_keys.clear();
+
+    for(QObject *request : qAsConst(requests))
+    {
+        request->disconnect(this);
+        request->deleteLater();
+    }
+}
+
+void MusicLrcBatchRequest::queryFinished()
+{
+    MusicAbstractQueryRequest *d = TTKObjectCast(MusicAbstractQueryRequest*, sender());
+    if(!d || !m_requests.contains(d))
+    {
+        return;
+    }
+
+    const QString key = m_requests.take(d).m_key;
+    const bool empty = d->isEmpty() && !d->hasReplyError();
+    const QString lrcUrl = d->isEmpty() ? QString() : d->items().front().m_lrcUrl;
+    d->disconnect(this);
+    d->deleteLater();
+
+    const QList<Task> &tasks = m_tasks.value(key);
+    if(lrcUrl.isEmpty() || tasks.isEmpty())
+    {
+        // only a search answered without any song is remembered, failed ones are tried again next time
+        if(empty)
+        {
+            m_misses.insert(key, TTKDateTime::currentTimestamp() / TTK_DN_S2MS + m_missExpiry);
+        }
+        finishTasks(key, {});
+        return;
+    }
+
+    // one download per name, the other paths get a copy
+    MusicAbstractDownLoadRequest *request = G_DOWNLOAD_QUERY_PTR->makeLrcRequest(lrcUrl, tasks.front().m_path, this);
+    connect(request, SIGNAL(downLoadDataChanged(QString)), SLOT(downloadFinished()));
+    addRequest(request, key);
+    request->startToRequest();
+}
+
+void MusicLrcBatchRequest::downloadFinished()
+{
+    QObject *d = sender();
+    if(!d || !m_requests.contains(d))
+    {
+        return;
+    }
+
+    const QString key = m_requests.take(d).m_key;
+    d->disconnect(this);
+
+    const QList<Task> &tasks = m_tasks.value(key);
+    const QString &path = tasks.isEmpty() ? QString() : tasks.front().m_path;
+    finishTasks(key, QFile::exists(path) ? path : QString());
+}
+
+void MusicLrcBatchRequest::requestDestroyed(QObject *object)
+{
+    // download requests delete themselves on network errors without any signal
+    if(m_requests.contains(object))
+    {
+        finishTasks(m_requests.take(object).m_key, {});
+    }
+}
+
+void MusicLrcBatchRequest::requestProgress()
+{
+    const QObject *reply = sender();
+    for(auto it = m_requests.begin(); it != m_requests.end(); ++it)
+    {
+        if(it.value().m_reply == reply)
+        {
+            it.value().m_active = TTKDateTime::currentTimestamp();
+            break;
+        }
+    }
+}
+
+void MusicLrcBatchRequest::requestTimeout()
+{
+    const qint64 now = TTKDateTime::currentTimestamp();
+
+    QStringList keys;
+    for(auto it = m_requests.begin(); it != m_requests.end();)
+    {
+        // a new reply of a request in several steps is activity too, its data is watched from now on
+        Request &v = it.value();
+        const MusicAbstractNetwork *network = TTKObjectCast(MusicAbstractNetwork*, it.key());
+        QNetworkReply *reply = network ? network->reply() : nullptr;
+        if(reply != v.m_reply)
+        {
+            v.m_reply = reply;
+            v.m_active = now;
+            if(reply)
+            {
+                connect(reply, SIGNAL(downloadProgress(qint64,qint64)), SLOT(requestProgress()));
+            }
+        }
+
+        // query requests stay silent on network errors, they are only caught here
+        const bool failed = network && network->hasReplyError();
+        if(!failed && now - v.m_active < REQUEST_TIMEOUT)
+        {
+            ++it;
+            continue;
+        }
+
+        QObject *request = it.key();
+        keys << it.value().m_key;
+        it = m_requests.erase(it);
+
+        request->disconnect(this);
+        request->deleteLater();
+    }
+
+    for(const QString &key : qAsConst(keys))
+    {
+        finishTasks(key, {});
+    }
+}
+
+void MusicLrcBatchRequest::startTasks()
+{
+    while(m_requests.count() < m_maxCount && !m_keys.isEmpty())
+    {
+        // coalesced by the key, searched by the name as the first task wrote it
+        const QString key = m_keys.takeFirst();
+        const QString name = m_tasks.value(key).front().m_name;
+
+        MusicAbstractQueryRequest *d = G_DOWNLOAD_QUERY_PTR->makeQueryRequest(this);
+        connect(d, SIGNAL(downLoadDataChanged(QString)), SLOT(queryFinished()));
+        addRequest(d, key);
+
+        d->setQueryMode(MusicAbstractQueryRequest::QueryMode::Meta);
+        d->setQueryType(MusicAbstractQueryRequest::QueryType::Music);
+        d->startToSearch(name.simplified());
+    }
+
+    if(m_requests.isEmpty())
+    {
+        m_timer.stop();
+    }
+
+    if(m_requests.isEmpty() && m_keys.isEmpty())
+    {
+        saveMisses();
+        Q_EMIT finished();
+    }
+}
+
+void MusicLrcBatchRequest::finishTasks(const QString &key, const QString &path)
+{
+    for(const Task &task : m_tasks.take(key))
+    {
+        bool success = !path.isEmpty();
+        if(success && task.m_path != path)
+        {
+            QFile::remove(task.m_path);
+            success = QFile::copy(path, task.m_path);
+        }
+        Q_EMIT downloadStateChanged(task.m_index, success, false);
+    }
+
+    startTasks();
+}
+
+void MusicLrcBatchRequest::addRequest(QObject *request, const QString &key)
+{
+    connect(request, SIGNAL(destroyed(QObject*)), SLOT(requestDestroyed(QObject*)));
+
+    Request v;
+    v.m_key = key;
+    v.m_active = TTKDateTime::currentTimestamp();
+    m_requests.insert(request, v);
+
+    if(!m_timer.isActive())
+    {
+        m_timer.start();
+    }
+}
+
+void MusicLrcBatchRequest::readMisses()
+{
+    if(m_missLoaded)
+    {
+        return;
+    }
+
+    m_missLoaded = true;
+    QFile file(LRC_MISS_PATH_FULL);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    bool ok = false;
+    QJson::Parser json;
+    const QVariantMap &datas = json.parse(file.readAll(), &ok).toMap();
+    file.close();
+
+    const qint64 now = TTKDateTime::currentTimestamp() / TTK_DN_S2MS;
+    for(auto it = datas.constBegin(); it != datas.constEnd(); ++it)
+    {
+        const qint64 expiry = it.value().toLongLong();
+        if(expiry > now)
+        {
+            m_misses.insert(it.key(), expiry);
+        }
+    }
+}
+
+void MusicLrcBatchRequest::saveMisses() const
+{
+    const qint64 now = TTKDateTime::currentTimestamp() / TTK_DN_S2MS;
+
+    QVariantMap datas;
+    for(auto it = m_misses.constBegin(); it != m_misses.constEnd(); ++it)
+    {
+        if(it.value() > now)
+        {
+            datas.insert(it.key(), it.value());
+        }
+    }
+
+    bool ok = false;
+    QJson::Serializer json;
+    const QByteArray &data = json.serialize(datas, &ok);
+    if(ok)
+    {
+        G_PERSIST_PTR->save(LRC_MISS_PATH_FULL, data);
+    }
+}
@@ -0,0 +1,143 @@
+#ifndef MUSICLRCBATCHREQUEST_H
+#define MUSICLRCBATCHREQUEST_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QTimer>
+#include <QPointer>
+#include "musicnetworkdefines.h"
+
+/*! @brief The class of the lrc batch download request.
+ * Lookups run in parallel, the same song name is searched only once and
+ * names without any lrc are remembered for a while.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicLrcBatchRequest : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicLrcBatchRequest)
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicLrcBatchRequest(QObject *parent = nullptr);
+    /*!
+     * Object destructor.
+     */
+    ~MusicLrcBatchRequest();
+
+    /*!
+     * Set the max running lookups.
+     */
+    void setMaxCount(int count);
+    /*!
+     * Set seconds to remember the name without any lrc.
+     */
+    void setMissExpiry(qint64 seconds);
+
+    /*!
+     * Add lrc task by index, search name and save path.
+     */
+    void addTask(int index, const QString &name, const QString &path);
+    /*!
+     * Start to download all tasks.
+     */
+    void startToRequest();
+    /*!
+     * Abort the waiting and running tasks.
+     */
+    void abort();
+
+Q_SIGNALS:
+    /*!
+     * The lrc task of index finished, skip means the name is known without lrc.
+     */
+    void downloadStateChanged(int index, bool success, bool skip);
+    /*!
+     * All tasks finished.
+     */
+    void finished();
+
+private Q_SLOTS:
+    /*!
+     * Search request finished.
+     */
+    void queryFinished();
+    /*!
+     * Lrc download finished.
+     */
+    void downloadFinished();
+    /*!
+     * Request destroyed before it finished, as on network errors.
+     */
+    void requestDestroyed(QObject *object);
+    /*!
+     * Data of the request arrived, it is still alive.
+     */
+    void requestProgress();
+    /*!
+     * Drop the requests idle for too long.
+     */
+    void requestTimeout();
+
+private:
+    struct Task
+    {
+        int m_index;
+        QString m_name;
+        QString m_path;
+    };
+
+    struct Request
+    {
+        QString m_key;
+        qint64 m_active;
+        QPointer<QNetworkReply> m_reply;
+    };
+
+    /*!
+     * Start waiting lookups while slots are free.
+     */
+    void startTasks();
+    /*!
+     * Finish all tasks of the key.
+     */
+    void finishTasks(const QString &key, const QString &path);
+    /*!
+     * Track the running request of the key.
+     */
+    void addRequest(QObject *request, const QString &key);
+    /*!
+     * Read and save the expiry of the names without lrc.
+     */
+    void readMisses();
+    void saveMisses() const;
+
+    int m_maxCount;
+    qint64 m_missExpiry;
+    bool m_missLoaded;
+    QStringList m_keys;
+    QHash<QString, QList<Task>> m_tasks;
+    QHash<QObject*, Request> m_requests;
+    QHash<QString, qint64> m_misses;
+    QTimer m_timer;
+
+};
+
+#endif // MUSICLRCBATCHREQUEST_H
@@ -1,7 +1,7 @@
 #include "musicnetworkthread.h"
 #include "musicconnectionpool.h"
 #include "musicsettingmanager.h"
-#include "ttkconcurrent.h"
+#include "ttkthreadpool.h"
 
 #include <QHostInfo>
 
@@ -36,7 +36,8 @@ void MusicNetworkThread::setBlockNetwork(bool block)
 
 void MusicNetworkThread::networkStateChanged()
 {
-    TTKConcurrent(
+    // the host lookup may hang for the whole resolver timeout
+    TTKThreadPool::instance()->runBlocking([this]()
     {
         const bool block = G_SETTING_PTR->value(MusicSettingManager::CloseNetWorkMode).toBool();
         const QHostInfo &info = QHostInfo::fromName(NETWORK_REQUEST_ADDRESS);
@@ -20,6 +20,8 @@ INCLUDEPATH += $$PWD
 
 HEADERS += \
     $$PWD/musicplaylistinterface.h \
+    $$PWD/musicplayliststream.h \
+    $$PWD/musicplaylistsnapshot.h \
     $$PWD/musicdbplconfigmanager.h \
     $$PWD/musicfplconfigmanager.h \
     $$PWD/musicasxconfigmanager.h \
@@ -37,6 +39,8 @@ SOURCES += \
     $$PWD/musicdbplconfigmanager.cpp \
     $$PWD/musicfplconfigmanager.cpp \
     $$PWD/musicm3uconfigmanager.cpp \
+    $$PWD/musicplayliststream.cpp \
+    $$PWD/musicplaylistsnapshot.cpp \
     $$PWD/musicplsconfigmanager.cpp \
     $$PWD/musictkplconfigmanager.cpp \
     $$PWD/musicwplconfigmanager.cpp \
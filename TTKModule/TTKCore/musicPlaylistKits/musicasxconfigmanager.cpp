@@ -1,7 +1,10 @@
 #include "musicasxconfigmanager.h"
 
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
 MusicASXConfigManager::MusicASXConfigManager()
-    : TTKAbstractXml()
+    : MusicPlaylistRenderer()
     , MusicPlaylistInterface()
 {
 
@@ -10,40 +13,47 @@ MusicASXConfigManager::MusicASXConfigManager()
 bool MusicASXConfigManager::readBuffer(MusicSongItemList &items)
 {
     MusicSongItem item;
-    item.m_itemName = QFileInfo(m_file->fileName()).baseName();
+    item.m_itemName = QFileInfo(m_file.fileName()).baseName();
 
-    TTKXmlHelper helper(m_document->documentElement());
-    helper.load();
+    QXmlStreamReader reader(&m_file);
 
-    const QDomNodeList &nodes = m_document->elementsByTagName(helper.nodeName("Entry"));
-    for(int i = 0; i < nodes.count(); ++i)
+    bool entry = false;
+    QString duration, path;
+    while(!reader.atEnd())
     {
-        const QDomNodeList &paramNodes = nodes.item(i).childNodes();
+        reader.readNext();
 
-        QString duration, path;
-        for(int j = 0; j < paramNodes.count(); ++j)
+        if(reader.isStartElement())
         {
-            const QDomNode &paramNode = paramNodes.item(j);
-            const QDomElement &element = paramNode.toElement();
-            const QString &name = paramNode.nodeName().toLower();
-
-            if(name == "duration" || name == "length")
+            const QString &name = reader.name().toString().toLower();
+            if(name == "entry")
+            {
+                entry = true;
+                duration.clear();
+                path.clear();
+            }
+            else if(entry && (name == "duration" || name == "length"))
             {
-                duration = element.attribute("value");
+                duration = reader.attributes().value("value").toString();
                 duration = duration.mid(3, 5);
             }
-            else if(name == "ref")
+            else if(entry && name == "ref")
             {
-                path = element.attribute("href");
+                path = reader.attributes().value("href").toString();
             }
         }
-
-        if(!path.isEmpty())
+        else if(reader.isEndElement() && entry && reader.name().toString().toLower() == "entry")
         {
-            item.m_songs << MusicSong(path, duration);
+            entry = false;
+            if(!path.isEmpty())
+            {
+                item.m_songs << MusicSong(path, duration);
+            }
         }
     }
 
+    m_file.close();
+
     if(!item.m_songs.isEmpty())
     {
         items << item;
@@ -58,24 +68,34 @@ bool MusicASXConfigManager::writeBuffer(const MusicSongItemList &items)
         return false;
     }
 
-    QDomElement rootDom = createRoot("Asx", TTKXmlAttr("version ", "3.0"));
+    QXmlStreamWriter writer(&m_file);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(4);
+
+    writer.writeStartElement("Asx");
+    writer.writeAttribute("version", "3.0");
 
     for(int i = 0; i < items.count(); ++i)
     {
         const MusicSongItem &item = items[i];
-        writeDomElement(rootDom, "Title", item.m_itemName);
+        writer.writeTextElement("Title", item.m_itemName);
 
         for(const MusicSong &song : qAsConst(items[i].m_songs))
         {
-            QDomElement trackDom = writeDomElement(rootDom, "Entry");
-
-            writeDomElement(trackDom, "Title", song.title());
-            writeDomElement(trackDom, "Ref", {"href", song.path()});
-            writeDomElement(trackDom, "Duration", {"value", "00:" + song.duration() + ".000"});
-            writeDomElement(trackDom, "Author", TTK_APP_NAME);
+            writer.writeStartElement("Entry");
+            writer.writeTextElement("Title", song.title());
+            writer.writeStartElement("Ref");
+            writer.writeAttribute("href", song.path());
+            writer.writeEndElement();
+            writer.writeStartElement("Duration");
+            writer.writeAttribute("value", "00:" + song.duration() + ".000");
+            writer.writeEndElement();
+            writer.writeTextElement("Author", TTK_APP_NAME);
+            writer.writeEndElement();
         }
     }
 
-    save();
-    return true;
+    writer.writeEndElement();
+    m_file.close();
+    return !writer.hasError();
 }
@@ -19,13 +19,12 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
-#include "ttkabstractxml.h"
 #include "musicplaylistinterface.h"
 
 /*! @brief The class of the asx playlist config manager.
  * @author Greedysky <greedysky@163.com>
  */
-class TTK_MODULE_EXPORT MusicASXConfigManager : public TTKAbstractXml, public MusicPlaylistInterface
+class TTK_MODULE_EXPORT MusicASXConfigManager : public MusicPlaylistRenderer, public MusicPlaylistInterface
 {
     TTK_DECLARE_MODULE(MusicASXConfigManager)
 public:
@@ -12,13 +12,10 @@ bool MusicCSVConfigManager::readBuffer(MusicSongItemList &items)
     MusicSongItem item;
     item.m_itemName = QFileInfo(m_file.fileName()).baseName();
 
-    const QStringList data(QString(m_file.readAll()).split("\n"));
-    if(data.isEmpty())
-    {
-        return false;
-    }
+    QString line;
+    MusicPlaylistLineReader reader(&m_file);
 
-    for(const QString &line : qAsConst(data))
+    while(reader.readLine(line))
     {
         const QStringList &songInfo = line.split(",");
         if(songInfo.count() > 2)
@@ -43,17 +40,17 @@ bool MusicCSVConfigManager::writeBuffer(const MusicSongItemList &items)
         return false;
     }
 
-    QStringList data;
+    MusicPlaylistLineWriter writer(&m_file);
     for(int i = 0; i < items.count(); ++i)
     {
         const MusicSongItem &item = items[i];
         for(const MusicSong &song : qAsConst(item.m_songs))
         {
-            data << song.name() + "," + song.duration() + "," + song.path();
+            writer.writeLine(song.name() + "," + song.duration() + "," + song.path());
         }
     }
 
-    m_file.write(data.join("\n").toUtf8());
+    const bool ok = writer.flush();
     m_file.close();
-    return true;
+    return ok;
 }
@@ -39,15 +39,20 @@ bool MusicFPLConfigManager::readBuffer(MusicSongItemList &items)
     m_file.read(magic, 16);
 
     // load primary data string into memory
-    uint dataSize;
-    m_file.read((char*)&dataSize, 4);
+    uint dataSize = 0;
+    if(m_file.read((char*)&dataSize, 4) != 4 || dataSize > m_file.size() - m_file.pos())
+    {
+        m_file.close();
+        return false;
+    }
 
-    char *dataPrime = new char[dataSize]{0};
+    // one more zero, so the last string is terminated
+    char *dataPrime = new char[dataSize + 1]{0};
     // read in primary string to memory
     m_file.read(dataPrime, dataSize);
 
     // read playlist count integer
-    uint plSize;
+    uint plSize = 0;
     m_file.read((char*)&plSize, 4);
 
     uint keyRunner[512];
@@ -57,8 +62,8 @@ bool MusicFPLConfigManager::readBuffer(MusicSongItemList &items)
     for(size_t i = 0; i < plSize && !m_file.atEnd(); ++i)
     {
         m_file.read((char*)&chunkRunner, sizeof(FPLTrackChunk));
-        // keys_dex sanity check
-        if(chunkRunner.keys_dex > 512)
+        // keys_dex sanity check, three keys are counted by the chunk itself
+        if(chunkRunner.keys_dex < 3 || chunkRunner.keys_dex > 512)
         {
             delete[] dataPrime;
             m_file.close();
@@ -68,6 +73,11 @@ bool MusicFPLConfigManager::readBuffer(MusicSongItemList &items)
         m_file.read((char*)&keyRunner, sizeof(uint) * (chunkRunner.keys_dex - 3));
         memcpy((void*)&duration, chunkRunner.duration_dbl, 8);
 
+        if(chunkRunner.file_ofz >= dataSize)
+        {
+            continue;
+        }
+
         QString path = dataPrime + chunkRunner.file_ofz;
         path.remove("file://");
         path = fin.absolutePath() + TTK_SEPARATOR + path;
@@ -15,9 +15,10 @@ bool MusicJSPFConfigManager::readBuffer(MusicSongItemList &items)
     MusicSongItem item;
     item.m_itemName = QFileInfo(m_file.fileName()).baseName();
 
+    // only the fields below are built, the other members are skipped
     QJson::Parser json;
     bool ok = false;
-    const QVariant &data = json.parse(m_file.readAll(), &ok);
+    const QVariant &data = json.parse(m_file.readAll(), {"trackList.track.location", "trackList.track.duration"}, &ok);
     if(!ok)
     {
         return false;
@@ -58,10 +59,14 @@ bool MusicJSPFConfigManager::writeBuffer(const MusicSongItemList &items)
         return false;
     }
 
-    QVariantMap datas;
-    for(int i = 0; i < items.count(); ++i)
+    // tracks are serialized and written one by one
+    QJson::Serializer json;
+    bool ok = true;
+    bool first = true;
+    m_file.write("{ \"trackList\" : [ ");
+
+    for(int i = 0; i < items.count() && ok; ++i)
     {
-        QVariantList tracks;
         const MusicSongItem &item = items[i];
         for(const MusicSong &song : qAsConst(item.m_songs))
         {
@@ -76,24 +81,24 @@ bool MusicJSPFConfigManager::writeBuffer(const MusicSongItemList &items)
 
             QVariantMap track;
             track["track"] = meta;
-            tracks.push_back(track);
-        }
 
-        if(!tracks.isEmpty())
-        {
-            datas["trackList"] = tracks;
-        }
-    }
+            const QByteArray &output = json.serialize(track, &ok);
+            if(!ok)
+            {
+                break;
+            }
 
-    QJson::Serializer json;
-    bool ok = false;
-    const QByteArray &output = json.serialize(datas, &ok);
-    if(!ok)
-    {
-        return false;
+            if(!first)
+            {
+                m_file.write(", ");
+            }
+
+            first = false;
+            m_file.write(output);
+        }
     }
 
-    m_file.write(output);
+    m_file.write(" ] }");
     m_file.close();
-    return true;
+    return ok;
 }
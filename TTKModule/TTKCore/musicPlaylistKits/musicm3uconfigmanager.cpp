@@ -12,17 +12,12 @@ bool MusicM3UConfigManager::readBuffer(MusicSongItemList &items)
     MusicSongItem item;
     item.m_itemName = QFileInfo(m_file.fileName()).baseName();
 
-    const QStringList data(QString(m_file.readAll()).split("\n"));
-    if(data.isEmpty())
-    {
-        return false;
-    }
-
     int length = 0;
     bool valid = false;
-    const QRegExp regx("#EXTINF:(-{0,1}\\d+),(.*)");
+    QString str;
+    MusicPlaylistLineReader reader(&m_file);
 
-    for(QString str : qAsConst(data))
+    while(reader.readLine(str))
     {
         str = str.trimmed();
         if(str.startsWith("#EXTM3U") || str.isEmpty())
@@ -30,10 +25,17 @@ bool MusicM3UConfigManager::readBuffer(MusicSongItemList &items)
             continue;
         }
 
-        if(regx.indexIn(str) > -1)
+        if(str.startsWith("#EXTINF:"))
         {
-            length = regx.cap(1).toInt();
-            valid = true;
+            // #EXTINF:length,title
+            const int index = str.indexOf(',', 8);
+            bool ok = false;
+            const int value = str.mid(8, index == -1 ? -1 : index - 8).trimmed().toInt(&ok);
+            if(ok && index != -1)
+            {
+                length = value;
+                valid = true;
+            }
         }
 
         if(str.startsWith("#"))
@@ -63,20 +65,20 @@ bool MusicM3UConfigManager::writeBuffer(const MusicSongItemList &items)
         return false;
     }
 
-    QStringList data;
-    data << QString("#EXTM3U");
+    MusicPlaylistLineWriter writer(&m_file);
+    writer.writeLine("#EXTM3U");
 
     for(int i = 0; i < items.count(); ++i)
     {
         const MusicSongItem &item = items[i];
         for(const MusicSong &song : qAsConst(item.m_songs))
         {
-            data.append(QString("#EXTINF:%1,%2 - %3").arg(TTKTime::formatDuration(song.duration()) / TTK_DN_S2MS).arg(song.artist(), song.title()));
-            data.append(song.path());
+            writer.writeLine(QString("#EXTINF:%1,%2 - %3").arg(TTKTime::formatDuration(song.duration()) / TTK_DN_S2MS).arg(song.artist(), song.title()));
+            writer.writeLine(song.path());
         }
     }
 
-    m_file.write(data.join("\n").toUtf8());
+    const bool ok = writer.flush();
     m_file.close();
-    return true;
+    return ok;
 }
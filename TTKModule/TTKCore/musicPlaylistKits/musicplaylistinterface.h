@@ -20,6 +20,7 @@
  ***************************************************************************/
 
 #include "musicsong.h"
+#include "musicplayliststream.h"
 #include "ttkfileinterface.h"
 #include "ttkabstractbufferinterface.h"
 
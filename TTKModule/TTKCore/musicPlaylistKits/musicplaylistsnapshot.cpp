@@ -0,0 +1,229 @@
+#include "musicplaylistsnapshot.h"
+#include "musicformats.h"
+
+#include <QtEndian>
+
+static constexpr char SNAPSHOT_MAGIC[] = "TKPS";
+static constexpr int SNAPSHOT_MAGIC_SIZE = 4;
+static constexpr quint32 SNAPSHOT_VERSION = 1;
+// magic, version, item count, checksum, payload size
+static constexpr int SNAPSHOT_HEADER_SIZE = 24;
+
+/*!
+ * Crc32 of the data, the table is built on first use.
+ */
+static quint32 checksum(const uchar *data, qint64 size)
+{
+    static const QVector<quint32> table = []()
+    {
+        QVector<quint32> v(256);
+        for(quint32 i = 0; i < 256; ++i)
+        {
+            quint32 c = i;
+            for(int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+            }
+            v[i] = c;
+        }
+        return v;
+    }();
+
+    quint32 crc = 0xFFFFFFFFU;
+    for(qint64 i = 0; i < size; ++i)
+    {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+template <typename T>
+static void writeValue(QByteArray &data, T value)
+{
+    uchar buffer[sizeof(T)];
+    qToLittleEndian<T>(value, buffer);
+    data.append(TTKReinterpretCast(const char*, buffer), sizeof(T));
+}
+
+/*!
+ * Strings are the length and the little endian utf16 units, so they are copied as is on read.
+ */
+static void writeString(QByteArray &data, const QString &value)
+{
+    writeValue<qint32>(data, value.length());
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    data.append(TTKReinterpretCast(const char*, value.constData()), value.length() * 2);
+#else
+    for(const QChar &c : value)
+    {
+        writeValue<quint16>(data, c.unicode());
+    }
+#endif
+}
+
+/*! @brief The class of the bounds checked snapshot reader.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct MusicSnapshotReader
+{
+    const uchar *m_data;
+    qint64 m_size;
+    qint64 m_pos;
+
+    bool readInt(qint32 &value)
+    {
+        if(m_size - m_pos < 4)
+        {
+            return false;
+        }
+
+        value = qFromLittleEndian<qint32>(m_data + m_pos);
+        m_pos += 4;
+        return true;
+    }
+
+    bool readString(QString &value)
+    {
+        qint32 length = 0;
+        if(!readInt(length) || length < 0 || (m_size - m_pos) / 2 < length)
+        {
+            return false;
+        }
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        value = QString(TTKReinterpretCast(const QChar*, m_data + m_pos), length);
+#else
+        value.resize(length);
+        for(int i = 0; i < length; ++i)
+        {
+            value[i] = QChar(qFromLittleEndian<quint16>(m_data + m_pos + i * 2));
+        }
+#endif
+        m_pos += length * 2;
+        return true;
+    }
+};
+
+
+bool MusicPlaylistSnapshot::read(const QString &path, MusicSongItemList &items)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly) || file.size() < SNAPSHOT_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    const qint64 size = file.size();
+    QByteArray buffer;
+    const uchar *data = file.map(0, size);
+    if(!data)
+    {
+        // some file systems can not be mapped
+        buffer = file.readAll();
+        if(buffer.size() != size)
+        {
+            return false;
+        }
+        data = TTKReinterpretCast(const uchar*, buffer.constData());
+    }
+
+    const quint32 version = qFromLittleEndian<quint32>(data + 4);
+    const qint32 count = qFromLittleEndian<qint32>(data + 8);
+    const quint32 crc = qFromLittleEndian<quint32>(data + 12);
+    const qint64 payloadSize = qFromLittleEndian<qint64>(data + 16);
+
+    if(memcmp(data, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0 || version != SNAPSHOT_VERSION || count < 0)
+    {
+        TTK_ERROR_STREAM("Playlist snapshot header error:" << path);
+        return false;
+    }
+
+    if(payloadSize != size - SNAPSHOT_HEADER_SIZE || checksum(data + SNAPSHOT_HEADER_SIZE, payloadSize) != crc)
+    {
+        TTK_ERROR_STREAM("Playlist snapshot checksum error:" << path);
+        return false;
+    }
+
+    MusicSnapshotReader reader;
+    reader.m_data = data + SNAPSHOT_HEADER_SIZE;
+    reader.m_size = payloadSize;
+    reader.m_pos = 0;
+
+    MusicSongItemList list;
+    for(int i = 0; i < count; ++i)
+    {
+        MusicSongItem item;
+        qint32 order = 0, songCount = 0;
+        if(!reader.readInt(item.m_itemIndex) || !reader.readInt(item.m_sort.m_type) || !reader.readInt(order) ||
+           !reader.readString(item.m_itemName) || !reader.readInt(songCount) || songCount < 0)
+        {
+            TTK_ERROR_STREAM("Playlist snapshot item error:" << path);
+            return false;
+        }
+
+        item.m_sort.m_order = TTKStaticCast(Qt::SortOrder, order);
+        item.m_songs.reserve(songCount);
+
+        for(int j = 0; j < songCount; ++j)
+        {
+            qint32 playCount = 0;
+            QString name, duration, songPath;
+            if(!reader.readInt(playCount) || !reader.readString(name) || !reader.readString(duration) || !reader.readString(songPath))
+            {
+                TTK_ERROR_STREAM("Playlist snapshot song error:" << path);
+                return false;
+            }
+
+            MusicSong song(songPath, duration, name, MusicFormats::isTrack(songPath));
+            song.setPlayCount(playCount);
+            item.m_songs << song;
+        }
+        list << item;
+    }
+
+    items << list;
+    return true;
+}
+
+QByteArray MusicPlaylistSnapshot::toByteArray(const MusicSongItemList &items)
+{
+    QByteArray payload;
+    if(items.isEmpty())
+    {
+        return payload;
+    }
+
+    for(int i = 0; i < items.count(); ++i)
+    {
+        const MusicSongItem &item = items[i];
+        writeValue<qint32>(payload, i);
+        writeValue<qint32>(payload, item.m_sort.m_type);
+        writeValue<qint32>(payload, item.m_sort.m_order);
+        writeString(payload, item.m_itemName);
+        writeValue<qint32>(payload, item.m_songs.count());
+
+        for(const MusicSong &song : qAsConst(item.m_songs))
+        {
+            QString duration = song.duration();
+            if(item.m_itemIndex == MUSIC_NETWORK_LIST && duration == TTK_DEFAULT_STR)
+            {
+                duration = TTK::generateNetworkSongTime(song.path());
+            }
+
+            writeValue<qint32>(payload, song.playCount());
+            writeString(payload, song.name());
+            writeString(payload, duration);
+            writeString(payload, song.path());
+        }
+    }
+
+    QByteArray data;
+    data.reserve(SNAPSHOT_HEADER_SIZE + payload.size());
+    data.append(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+    writeValue<quint32>(data, SNAPSHOT_VERSION);
+    writeValue<qint32>(data, items.count());
+    writeValue<quint32>(data, checksum(TTKReinterpretCast(const uchar*, payload.constData()), payload.size()));
+    writeValue<qint64>(data, payload.size());
+    data.append(payload);
+    return data;
+}
@@ -0,0 +1,46 @@
+#ifndef MUSICPLAYLISTSNAPSHOT_H
+#define MUSICPLAYLISTSNAPSHOT_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include "musicsong.h"
+
+/*! @brief The class of the binary playlist snapshot.
+ * The snapshot is a versioned and checksummed image of the song items, it is
+ * mapped into memory on read. Tkpl stays the import, export and fallback format.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicPlaylistSnapshot
+{
+    TTK_DECLARE_MODULE(MusicPlaylistSnapshot)
+public:
+    /*!
+     * Read the song items from the snapshot file by path.
+     * Return false when the file is missing, truncated or corrupted.
+     */
+    static bool read(const QString &path, MusicSongItemList &items);
+    /*!
+     * Serialize the song items into the snapshot data.
+     * Only reads the items, so a shared copy can be serialized in background.
+     */
+    static QByteArray toByteArray(const MusicSongItemList &items);
+
+};
+
+#endif // MUSICPLAYLISTSNAPSHOT_H
@@ -0,0 +1,82 @@
+#include "musicplayliststream.h"
+
+static constexpr int WRITE_CHUNK_SIZE = 64 * 1024;
+
+MusicPlaylistLineReader::MusicPlaylistLineReader(QIODevice *device)
+    : m_device(device)
+{
+
+}
+
+bool MusicPlaylistLineReader::readLine(QString &line)
+{
+    if(!m_device || m_device->atEnd())
+    {
+        return false;
+    }
+
+    QByteArray data = m_device->readLine();
+    int size = data.size();
+    while(size > 0 && (data[size - 1] == '\n' || data[size - 1] == '\r'))
+    {
+        --size;
+    }
+
+    data.truncate(size);
+    line = QString::fromUtf8(data);
+    return true;
+}
+
+
+MusicPlaylistLineWriter::MusicPlaylistLineWriter(QIODevice *device)
+    : m_device(device),
+      m_first(true),
+      m_error(false)
+{
+    m_buffer.reserve(WRITE_CHUNK_SIZE + 1024);
+}
+
+MusicPlaylistLineWriter::~MusicPlaylistLineWriter()
+{
+    flush();
+}
+
+void MusicPlaylistLineWriter::writeLine(const QString &line)
+{
+    if(!m_first)
+    {
+        m_buffer.append('\n');
+    }
+
+    m_first = false;
+    m_buffer.append(line.toUtf8());
+
+    if(m_buffer.size() >= WRITE_CHUNK_SIZE)
+    {
+        flush();
+    }
+}
+
+void MusicPlaylistLineWriter::write(const QByteArray &data)
+{
+    m_first = false;
+    m_buffer.append(data);
+
+    if(m_buffer.size() >= WRITE_CHUNK_SIZE)
+    {
+        flush();
+    }
+}
+
+bool MusicPlaylistLineWriter::flush()
+{
+    if(!m_buffer.isEmpty())
+    {
+        if(!m_device || m_device->write(m_buffer) != m_buffer.size())
+        {
+            m_error = true;
+        }
+        m_buffer.clear();
+    }
+    return !m_error;
+}
@@ -0,0 +1,84 @@
+#ifndef MUSICPLAYLISTSTREAM_H
+#define MUSICPLAYLISTSTREAM_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QIODevice>
+#include "ttkmoduleexport.h"
+
+/*! @brief The class of the playlist line reader.
+ * Lines are pulled one by one from the device buffer, memory does not grow with the file.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicPlaylistLineReader
+{
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicPlaylistLineReader(QIODevice *device);
+
+    /*!
+     * Read next utf8 line without the line break, return false at the end.
+     */
+    bool readLine(QString &line);
+
+private:
+    QIODevice *m_device;
+
+};
+
+
+/*! @brief The class of the playlist line writer.
+ * Lines are collected in a small buffer and written chunk by chunk.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicPlaylistLineWriter
+{
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicPlaylistLineWriter(QIODevice *device);
+    /*!
+     * Object destructor.
+     */
+    ~MusicPlaylistLineWriter();
+
+    /*!
+     * Write utf8 line, lines are separated by "\n".
+     */
+    void writeLine(const QString &line);
+    /*!
+     * Write utf8 data as it is, no line break is added.
+     */
+    void write(const QByteArray &data);
+    /*!
+     * Write buffered data to device.
+     */
+    bool flush();
+
+private:
+    QIODevice *m_device;
+    QByteArray m_buffer;
+    bool m_first, m_error;
+
+};
+
+#endif // MUSICPLAYLISTSTREAM_H
@@ -12,45 +12,60 @@ bool MusicPLSConfigManager::readBuffer(MusicSongItemList &items)
     MusicSongItem item;
     item.m_itemName = QFileInfo(m_file.fileName()).baseName();
 
-    QStringList data(QString(m_file.readAll()).split("\n"));
-    if(data.isEmpty())
+    QString line;
+    MusicPlaylistLineReader reader(&m_file);
+
+    if(!reader.readLine(line) || !line.toLower().contains("[playlist]"))
     {
         return false;
     }
 
-    if(!data.takeFirst().toLower().contains("[playlist]"))
+    bool error = false;
+    while(reader.readLine(line))
     {
-        return false;
-    }
+        // FileN=path and LengthN=seconds, N counts from 1
+        const int index = line.indexOf('=');
+        if(index == -1)
+        {
+            continue;
+        }
 
-    const QRegExp regx1("^File(\\d+)=(.+)");
-    const QRegExp regx2("^Length(\\d+)=(-{0,1}\\d+)");
+        int offset = 0;
+        if(line.startsWith("File"))
+        {
+            offset = 4;
+        }
+        else if(line.startsWith("Length"))
+        {
+            offset = 6;
+        }
+        else
+        {
+            continue;
+        }
 
-    int number = 0;
-    bool error = false;
+        bool ok = false;
+        const int number = line.mid(offset, index - offset).toInt(&ok);
+        const QString &value = line.mid(index + 1);
+        if(!ok || value.isEmpty())
+        {
+            continue;
+        }
 
-    for(const QString &line : qAsConst(data))
-    {
-        if(regx1.indexIn(line) > -1)
+        if(number <= 0)
         {
-            if((number = regx1.cap(1).toInt()) > 0)
-            {
-                item.m_songs << MusicSong(regx1.cap(2));
-            }
-            else
-            {
-                error = true;
-            }
+            error = true;
         }
-        else if(regx2.indexIn(line) > -1)
+        else if(offset == 4)
         {
-            if((number = regx2.cap(1).toInt()) > 0)
-            {
-                item.m_songs.back().setDuration(TTKTime::formatDuration(regx2.cap(2).toInt() * TTK_DN_S2MS));
-            }
-            else
+            item.m_songs << MusicSong(value);
+        }
+        else if(!item.m_songs.isEmpty())
+        {
+            const int length = value.toInt(&ok);
+            if(ok)
             {
-                error = true;
+                item.m_songs.back().setDuration(TTKTime::formatDuration(length * TTK_DN_S2MS));
             }
         }
 
@@ -77,8 +92,8 @@ bool MusicPLSConfigManager::writeBuffer(const MusicSongItemList &items)
         return false;
     }
 
-    QStringList data;
-    data << QString("[playlist]");
+    MusicPlaylistLineWriter writer(&m_file);
+    writer.writeLine("[playlist]");
 
     int count = 0;
     for(int i = 0; i < items.count(); ++i)
@@ -87,16 +102,16 @@ bool MusicPLSConfigManager::writeBuffer(const MusicSongItemList &items)
         for(const MusicSong &song : qAsConst(item.m_songs))
         {
             ++count;
-            data << QString("File%1=%2").arg(count).arg(song.path());
-            data << QString("Title%1=%2").arg(count).arg(song.name());
-            data << QString("Length%1=%2").arg(count).arg(TTKTime::formatDuration(song.duration()) / 1000);
+            writer.writeLine(QString("File%1=%2").arg(count).arg(song.path()));
+            writer.writeLine(QString("Title%1=%2").arg(count).arg(song.name()));
+            writer.writeLine(QString("Length%1=%2").arg(count).arg(TTKTime::formatDuration(song.duration()) / 1000));
         }
     }
 
-    data << "NumberOfEntries=" + QString::number(count);
-    data << "Version=2";
+    writer.writeLine("NumberOfEntries=" + QString::number(count));
+    writer.writeLine("Version=2");
 
-    m_file.write(data.join("\n").toUtf8());
+    const bool ok = writer.flush();
     m_file.close();
-    return true;
+    return ok;
 }
@@ -1,7 +1,70 @@
 #include "musictkplconfigmanager.h"
+#include "musicformats.h"
+#include "musicplayliststream.h"
+
+#include <QBuffer>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+static bool writeDocument(const MusicSongItemList &items, QByteArray *data, MusicPlaylistLineWriter *output)
+{
+    // with an output the buffer is handed over song by song, memory does not grow with the playlist
+    QBuffer buffer(data);
+    buffer.open(QIODevice::WriteOnly);
+
+    QXmlStreamWriter writer(&buffer);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(4);
+
+    writer.writeStartDocument();
+    writer.writeStartElement(TTK_APP_NAME);
+
+    for(int i = 0; i < items.count(); ++i)
+    {
+        const MusicSongItem &item = items[i];
+        writer.writeStartElement("musicList");
+        writer.writeAttribute("name", item.m_itemName);
+        writer.writeAttribute("index", QString::number(i));
+        writer.writeAttribute("count", QString::number(item.m_songs.count()));
+        writer.writeAttribute("sortIndex", QString::number(item.m_sort.m_type));
+        writer.writeAttribute("sortType", QString::number(item.m_sort.m_order));
+
+        for(const MusicSong &song : qAsConst(item.m_songs))
+        {
+            QString duration = song.duration();
+            if(item.m_itemIndex == MUSIC_NETWORK_LIST && duration == TTK_DEFAULT_STR)
+            {
+                duration = TTK::generateNetworkSongTime(song.path());
+            }
+
+            writer.writeStartElement("value");
+            writer.writeAttribute("name", song.name());
+            writer.writeAttribute("playCount", QString::number(song.playCount()));
+            writer.writeAttribute("time", duration);
+            writer.writeCharacters(song.path());
+            writer.writeEndElement();
+
+            if(output)
+            {
+                output->write(*data);
+                data->clear();
+                buffer.seek(0);
+            }
+        }
+        writer.writeEndElement();
+    }
+
+    writer.writeEndDocument();
+    if(output)
+    {
+        output->write(*data);
+        data->clear();
+    }
+    return !writer.hasError();
+}
 
 MusicTKPLConfigManager::MusicTKPLConfigManager()
-    : TTKAbstractXml()
+    : MusicPlaylistRenderer()
     , MusicPlaylistInterface()
 {
 
@@ -9,22 +72,52 @@ MusicTKPLConfigManager::MusicTKPLConfigManager()
 
 bool MusicTKPLConfigManager::readBuffer(MusicSongItemList &items)
 {
-    const QDomNodeList &nodes = m_document->elementsByTagName("musicList");
-    for(int i = 0; i < nodes.count(); ++i)
+    QXmlStreamReader reader(&m_file);
+
+    MusicSongItemList list;
+    while(!reader.atEnd())
     {
-        const QDomNode &node = nodes.item(i);
-        MusicSongItem item;
-        item.m_songs = readMusicFilePath(node);
-
-        const QDomElement &element = node.toElement();
-        item.m_itemIndex = element.attribute("index").toInt();
-        item.m_itemName = element.attribute("name");
-
-        const QString &string = element.attribute("sortIndex");
-        item.m_sort.m_type = string.isEmpty() ? -1 : string.toInt();
-        item.m_sort.m_order = TTKStaticCast(Qt::SortOrder, element.attribute("sortType").toInt());
-        items << item;
+        reader.readNext();
+        if(!reader.isStartElement())
+        {
+            continue;
+        }
+
+        const QXmlStreamAttributes &attributes = reader.attributes();
+        if(reader.name() == QLatin1String("musicList"))
+        {
+            MusicSongItem item;
+            item.m_itemIndex = attributes.value("index").toString().toInt();
+            item.m_itemName = attributes.value("name").toString();
+
+            const QString &string = attributes.value("sortIndex").toString();
+            item.m_sort.m_type = string.isEmpty() ? -1 : string.toInt();
+            item.m_sort.m_order = TTKStaticCast(Qt::SortOrder, attributes.value("sortType").toString().toInt());
+            list << item;
+        }
+        else if(reader.name() == QLatin1String("value") && !list.isEmpty())
+        {
+            const QString &time = attributes.value("time").toString();
+            const QString &name = attributes.value("name").toString();
+            const int playCount = attributes.value("playCount").toString().toInt();
+
+            const QString &path = reader.readElementText(QXmlStreamReader::SkipChildElements);
+            MusicSong song(path, time, name, MusicFormats::isTrack(path));
+            song.setPlayCount(playCount);
+            list.back().m_songs << song;
+        }
     }
+
+    m_file.close();
+
+    // a broken file is rejected as a whole, like the document parser did
+    if(reader.hasError())
+    {
+        TTK_ERROR_STREAM("read tkpl format playlist error:" << reader.errorString());
+        return false;
+    }
+
+    items << list;
     return true;
 }
 
@@ -32,49 +125,30 @@ bool MusicTKPLConfigManager::writeBuffer(const MusicSongItemList &items)
 {
     if(items.isEmpty())
     {
+        m_file.cancelWriting();
         return false;
     }
 
-    createProcessingInstruction();
-    QDomElement rootDom = createRoot(TTK_APP_NAME);
-
-    for(int i = 0; i < items.count(); ++i)
+    QByteArray data;
+    MusicPlaylistLineWriter writer(&m_file);
+    const bool ok = writeDocument(items, &data, &writer);
+    if(!writer.flush() || !ok)
     {
-        const MusicSongItem &item = items[i];
-        QDomElement pathDom = writeDomMultiElement(rootDom, "musicList", {{"name", item.m_itemName},
-                                                                          {"index", i},
-                                                                          {"count", item.m_songs.count()},
-                                                                          {"sortIndex", item.m_sort.m_type},
-                                                                          {"sortType", item.m_sort.m_order}});
-        for(const MusicSong &song : qAsConst(item.m_songs))
-        {
-            QString duration = song.duration();
-            if(item.m_itemIndex == MUSIC_NETWORK_LIST && duration == TTK_DEFAULT_STR)
-            {
-                duration = TTK::generateNetworkSongTime(song.path());
-            }
-
-            writeDomMultiElement(pathDom, "value", {{"name", song.name()},
-                                                    {"playCount", song.playCount()},
-                                                    {"time", duration}}, song.path());
-        }
+        // keep the previous playlist file
+        m_file.cancelWriting();
+        return false;
     }
 
-    save();
-    return true;
+    m_file.close();
+    return m_file.isCommitted();
 }
 
-MusicSongList MusicTKPLConfigManager::readMusicFilePath(const QDomNode &node) const
+QByteArray MusicTKPLConfigManager::toByteArray(const MusicSongItemList &items)
 {
-    const QDomNodeList &nodes = node.childNodes();
-
-    MusicSongList songs;
-    for(int i = 0; i < nodes.count(); ++i)
+    QByteArray data;
+    if(items.isEmpty())
     {
-        const QDomElement &element = nodes.item(i).toElement();
-        MusicSong song(element.text(), element.attribute("time"), element.attribute("name"), true);
-        song.setPlayCount(element.attribute("playCount").toInt());
-        songs << song;
+        return data;
     }
-    return songs;
+    return writeDocument(items, &data, nullptr) ? data : QByteArray();
 }
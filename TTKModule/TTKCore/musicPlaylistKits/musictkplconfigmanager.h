@@ -19,13 +19,12 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
-#include "ttkabstractxml.h"
 #include "musicplaylistinterface.h"
 
 /*! @brief The class of the tkpl config manager.
  * @author Greedysky <greedysky@163.com>
  */
-class TTK_MODULE_EXPORT MusicTKPLConfigManager : public TTKAbstractXml, public MusicPlaylistInterface
+class TTK_MODULE_EXPORT MusicTKPLConfigManager : public MusicPlaylistRenderer, public MusicPlaylistInterface
 {
     TTK_DECLARE_MODULE(MusicTKPLConfigManager)
 public:
@@ -43,11 +42,10 @@ public:
      */
     virtual bool writeBuffer(const MusicSongItemList &items) override final;
 
-private:
     /*!
-     * Read Music File Path.
+     * Serialize datas into byteArray.
      */
-    MusicSongList readMusicFilePath(const QDomNode &node) const;
+    static QByteArray toByteArray(const MusicSongItemList &items);
 
 };
 
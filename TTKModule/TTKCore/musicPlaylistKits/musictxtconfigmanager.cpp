@@ -12,13 +12,10 @@ bool MusicTXTConfigManager::readBuffer(MusicSongItemList &items)
     MusicSongItem item;
     item.m_itemName = QFileInfo(m_file.fileName()).baseName();
 
-    const QStringList data(QString(m_file.readAll()).split("\n"));
-    if(data.isEmpty())
-    {
-        return false;
-    }
+    QString line;
+    MusicPlaylistLineReader reader(&m_file);
 
-    for(const QString &line : qAsConst(data))
+    while(reader.readLine(line))
     {
         int index = line.indexOf(":");
         if(index != -1)
@@ -48,7 +45,7 @@ bool MusicTXTConfigManager::writeBuffer(const MusicSongItemList &items)
         return false;
     }
 
-    QStringList data;
+    MusicPlaylistLineWriter writer(&m_file);
 
     int count = 0;
     for(int i = 0; i < items.count(); ++i)
@@ -56,11 +53,11 @@ bool MusicTXTConfigManager::writeBuffer(const MusicSongItemList &items)
         const MusicSongItem &item = items[i];
         for(const MusicSong &song : qAsConst(item.m_songs))
         {
-            data << QString("%1:%2 - %3").arg(++count).arg(song.path(), song.duration());
+            writer.writeLine(QString("%1:%2 - %3").arg(++count).arg(song.path(), song.duration()));
         }
     }
 
-    m_file.write(data.join("\n").toUtf8());
+    const bool ok = writer.flush();
     m_file.close();
-    return true;
+    return ok;
 }
@@ -1,8 +1,11 @@
 #include "musicwplconfigmanager.h"
 #include "ttkversion.h"
 
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
 MusicWPLConfigManager::MusicWPLConfigManager()
-    : TTKAbstractXml()
+    : MusicPlaylistRenderer()
     , MusicPlaylistInterface()
 {
 
@@ -10,19 +13,36 @@ MusicWPLConfigManager::MusicWPLConfigManager()
 
 bool MusicWPLConfigManager::readBuffer(MusicSongItemList &items)
 {
-    TTKXmlHelper helper(m_document->documentElement());
-    helper.load();
-
     MusicSongItem item;
-    item.m_itemName = QFileInfo(m_file->fileName()).baseName();
+    item.m_itemName = QFileInfo(m_file.fileName()).baseName();
+
+    QXmlStreamReader reader(&m_file);
 
-    const QDomNodeList &nodes = m_document->elementsByTagName(helper.nodeName("seq"));
-    for(int i = 0; i < nodes.count(); ++i)
+    int seq = 0;
+    while(!reader.atEnd())
     {
-        const QDomNode &node = nodes.item(i);
-        item.m_songs << readMusicFilePath(node);
+        reader.readNext();
+
+        if(reader.isStartElement())
+        {
+            const QString &name = reader.name().toString().toLower();
+            if(name == "seq")
+            {
+                ++seq;
+            }
+            else if(seq > 0 && name == "media")
+            {
+                item.m_songs << MusicSong(reader.attributes().value("src").toString());
+            }
+        }
+        else if(reader.isEndElement() && seq > 0 && reader.name().toString().toLower() == "seq")
+        {
+            --seq;
+        }
     }
 
+    m_file.close();
+
     if(!item.m_songs.isEmpty())
     {
         items << item;
@@ -37,39 +57,36 @@ bool MusicWPLConfigManager::writeBuffer(const MusicSongItemList &items)
         return false;
     }
 
-    const QDomNode &node = m_document->createProcessingInstruction(WPL_FILE_SUFFIX, "version='1.0' encoding='UTF-8'");
-    m_document->appendChild(node);
+    QXmlStreamWriter writer(&m_file);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(4);
 
-    QDomElement rootDom = createRoot("smil");
-    QDomElement headDom = writeDomElement(rootDom, "head");
-    QDomElement bodyDom = writeDomElement(rootDom, "body");
-
-    writeDomMultiElement(headDom, "meta", {{"name", "Generator"}, {"content", QString("%1 %2").arg(TTK_APP_NAME, TTK_VERSION_STR)}});
+    writer.writeProcessingInstruction(WPL_FILE_SUFFIX, "version='1.0' encoding='UTF-8'");
+    writer.writeStartElement("smil");
+    writer.writeStartElement("head");
+    writer.writeStartElement("meta");
+    writer.writeAttribute("name", "Generator");
+    writer.writeAttribute("content", QString("%1 %2").arg(TTK_APP_NAME, TTK_VERSION_STR));
+    writer.writeEndElement();
+    writer.writeEndElement();
 
+    writer.writeStartElement("body");
     for(int i = 0; i < items.count(); ++i)
     {
         const MusicSongItem &item = items[i];
-        QDomElement seqDom = writeDomElement(bodyDom, "seq");
+        writer.writeStartElement("seq");
 
         for(const MusicSong &song : qAsConst(item.m_songs))
         {
-            writeDomElement(seqDom, "media", {"src", song.path()});
+            writer.writeStartElement("media");
+            writer.writeAttribute("src", song.path());
+            writer.writeEndElement();
         }
+        writer.writeEndElement();
     }
 
-    save();
-    return true;
-}
-
-MusicSongList MusicWPLConfigManager::readMusicFilePath(const QDomNode &node) const
-{
-    const QDomNodeList &nodes = node.childNodes();
-
-    MusicSongList songs;
-    for(int i = 0; i < nodes.count(); ++i)
-    {
-        const QDomElement &element = nodes.item(i).toElement();
-        songs << MusicSong(element.attribute("src"));
-    }
-    return songs;
+    writer.writeEndElement();
+    writer.writeEndElement();
+    m_file.close();
+    return !writer.hasError();
 }
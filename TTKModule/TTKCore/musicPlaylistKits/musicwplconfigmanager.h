@@ -19,13 +19,12 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
-#include "ttkabstractxml.h"
 #include "musicplaylistinterface.h"
 
 /*! @brief The class of the wpl playlist config manager.
  * @author Greedysky <greedysky@163.com>
  */
-class TTK_MODULE_EXPORT MusicWPLConfigManager : public TTKAbstractXml, public MusicPlaylistInterface
+class TTK_MODULE_EXPORT MusicWPLConfigManager : public MusicPlaylistRenderer, public MusicPlaylistInterface
 {
     TTK_DECLARE_MODULE(MusicWPLConfigManager)
 public:
@@ -43,12 +42,6 @@ public:
      */
     virtual bool writeBuffer(const MusicSongItemList &items) override final;
 
-private:
-    /*!
-     * Read Music File Path.
-     */
-    MusicSongList readMusicFilePath(const QDomNode &node) const;
-
 };
 
 #endif // MUSICWPLCONFIGMANAGER_H
@@ -1,7 +1,10 @@
 #include "musicxspfconfigmanager.h"
 
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
 MusicXSPFConfigManager::MusicXSPFConfigManager()
-    : TTKAbstractXml()
+    : MusicPlaylistRenderer()
     , MusicPlaylistInterface()
 {
 
@@ -9,37 +12,40 @@ MusicXSPFConfigManager::MusicXSPFConfigManager()
 
 bool MusicXSPFConfigManager::readBuffer(MusicSongItemList &items)
 {
-    TTKXmlHelper helper(m_document->documentElement());
-    helper.load();
-
     MusicSongItem item;
-    item.m_itemName = QFileInfo(m_file->fileName()).baseName();
+    item.m_itemName = QFileInfo(m_file.fileName()).baseName();
+
+    QXmlStreamReader reader(&m_file);
 
-    const QDomNodeList &nodes = m_document->elementsByTagName(helper.nodeName("trackList"));
-    for(int i = 0; i < nodes.count(); ++i)
+    bool track = false;
+    QString duration, path;
+    while(!reader.atEnd())
     {
-        const QDomNodeList &trackNodes = nodes.item(i).childNodes();
-        for(int i = 0; i < trackNodes.count(); ++i)
-        {
-            const QDomNodeList &trackChildNodes = trackNodes.item(i).childNodes();
+        reader.readNext();
 
-            QString duration, path;
-            for(int i = 0; i < trackChildNodes.count(); ++i)
+        if(reader.isStartElement())
+        {
+            // element names are matched case insensitively
+            const QString &name = reader.name().toString().toLower();
+            if(name == "track")
             {
-                const QDomElement &element = trackChildNodes.item(i).toElement();
-                const QString &name = element.nodeName().toLower();
-
-                if(name == "location")
-                {
-                    path = element.text();
-                    path.remove("file://");
-                }
-                else if(name == "length" || name == "duration")
-                {
-                    duration = element.text();
-                }
+                track = true;
+                duration.clear();
+                path.clear();
             }
-
+            else if(track && name == "location")
+            {
+                path = reader.readElementText(QXmlStreamReader::SkipChildElements);
+                path.remove("file://");
+            }
+            else if(track && (name == "length" || name == "duration"))
+            {
+                duration = reader.readElementText(QXmlStreamReader::SkipChildElements);
+            }
+        }
+        else if(reader.isEndElement() && track && reader.name().toString().toLower() == "track")
+        {
+            track = false;
             if(!path.isEmpty())
             {
                 item.m_songs << MusicSong(path, duration);
@@ -47,6 +53,8 @@ bool MusicXSPFConfigManager::readBuffer(MusicSongItemList &items)
         }
     }
 
+    m_file.close();
+
     if(!item.m_songs.isEmpty())
     {
         items << item;
@@ -61,28 +69,38 @@ bool MusicXSPFConfigManager::writeBuffer(const MusicSongItemList &items)
         return false;
     }
 
-    createProcessingInstruction();
-    QDomElement rootDom = createRoot("playlist", {{"version", "1"}, {"xmlns", "http://xspf.org/ns/0/"}});
-    writeDomElement(rootDom, "creator", TTK_APP_NAME);
+    QXmlStreamWriter writer(&m_file);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(4);
+
+    writer.writeStartDocument();
+    writer.writeStartElement("playlist");
+    writer.writeAttribute("version", "1");
+    writer.writeAttribute("xmlns", "http://xspf.org/ns/0/");
+    writer.writeTextElement("creator", TTK_APP_NAME);
 
     for(int i = 0; i < items.count(); ++i)
     {
-        QDomElement trackListDom = writeDomElement(rootDom, "trackList");
+        writer.writeStartElement("trackList");
         for(const MusicSong &song : qAsConst(items[i].m_songs))
         {
-            QDomElement trackDom = writeDomElement(trackListDom, "track");
-
-            writeDomElement(trackDom, "location", song.path());
-            writeDomElement(trackDom, "title", song.title());
-            writeDomElement(trackDom, "creator", song.artist());
-            writeDomElement(trackDom, "duration", song.duration());
-            writeDomElement(trackDom, "annotation", QString());
-            writeDomElement(trackDom, "album", QString());
-            writeDomElement(trackDom, "trackNum", QString());
-            writeDomElement(trackDom, "meta", {"rel", "year"}, {});
+            writer.writeStartElement("track");
+            writer.writeTextElement("location", song.path());
+            writer.writeTextElement("title", song.title());
+            writer.writeTextElement("creator", song.artist());
+            writer.writeTextElement("duration", song.duration());
+            writer.writeTextElement("annotation", QString());
+            writer.writeTextElement("album", QString());
+            writer.writeTextElement("trackNum", QString());
+            writer.writeStartElement("meta");
+            writer.writeAttribute("rel", "year");
+            writer.writeEndElement();
+            writer.writeEndElement();
         }
+        writer.writeEndElement();
     }
 
-    save();
-    return true;
+    writer.writeEndDocument();
+    m_file.close();
+    return !writer.hasError();
 }
@@ -20,6 +20,9 @@ INCLUDEPATH += $$PWD
 
 HEADERS += \
     $$PWD/musicsearchinterface.h \
-    $$PWD/musicsongsearchrecordconfigmanager.h
+    $$PWD/musicsongsearchrecordconfigmanager.h \
+    $$PWD/musicsongsuggestservice.h
 
-SOURCES += $$PWD/musicsongsearchrecordconfigmanager.cpp
+SOURCES += \
+    $$PWD/musicsongsearchrecordconfigmanager.cpp \
+    $$PWD/musicsongsuggestservice.cpp
@@ -0,0 +1,235 @@
+#include "musicsongsuggestservice.h"
+#include "musicsongsuggestrequest.h"
+#include "ttktime.h"
+
+static constexpr int DEBOUNCE_INTERVAL = 180;
+static constexpr int MAX_CACHE_COUNT = 64;
+static constexpr int MAX_HISTORY_COUNT = 3;
+static constexpr int MIN_REUSE_COUNT = 5;
+static constexpr int FULL_RESULT_COUNT = 10;
+
+MusicSongSuggestService::MusicSongSuggestService()
+    : QObject(nullptr),
+      m_loaded(false),
+      m_cache(MAX_CACHE_COUNT),
+      m_request(nullptr),
+      m_owner(nullptr)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(DEBOUNCE_INTERVAL);
+    connect(&m_timer, SIGNAL(timeout()), SLOT(startToQuery()));
+
+    m_request = new MusicSongSuggestRequest(this);
+    connect(m_request, SIGNAL(downLoadDataChanged(QString)), SLOT(downLoadFinished()));
+}
+
+MusicSongSuggestService::~MusicSongSuggestService()
+{
+    abort();
+}
+
+void MusicSongSuggestService::query(const QString &text, const QObject *owner)
+{
+    m_owner = owner;
+    m_text = text.trimmed();
+    if(m_text.isEmpty())
+    {
+        abort();
+        return;
+    }
+
+    QStringList names;
+    if(findCache(m_text, &names))
+    {
+        m_timer.stop();
+        Q_EMIT suggestChanged(m_text, merge(m_text, names));
+        return;
+    }
+
+    // show what the history knows, the remote results replace it later
+    names = merge(m_text, {});
+    if(!names.isEmpty())
+    {
+        Q_EMIT suggestChanged(m_text, names);
+    }
+
+    // every key stroke restarts the timer, only the last text goes to the net
+    m_timer.start();
+}
+
+void MusicSongSuggestService::abort(const QObject *owner)
+{
+    if(m_owner == owner)
+    {
+        abort();
+    }
+}
+
+void MusicSongSuggestService::abort()
+{
+    m_owner = nullptr;
+    m_timer.stop();
+    m_queryText.clear();
+    m_request->abort();
+}
+
+const MusicSearchRecordList &MusicSongSuggestService::records()
+{
+    if(!m_loaded)
+    {
+        m_loaded = true;
+
+        MusicSongSearchRecordConfigManager manager;
+        if(manager.fromFile(SEARCH_PATH_FULL))
+        {
+            manager.readBuffer(m_records);
+        }
+        updateIndex();
+    }
+    return m_records;
+}
+
+void MusicSongSuggestService::addRecord(const QString &text)
+{
+    records();
+
+    MusicSearchRecord record;
+    record.m_name = text;
+    record.m_timestamp = QString::number(TTKDateTime::currentTimestamp());
+    m_records.insert(0, record);
+    updateRecords();
+}
+
+void MusicSongSuggestService::clearRecords()
+{
+    m_loaded = true;
+    m_records.clear();
+    updateRecords();
+}
+
+void MusicSongSuggestService::startToQuery()
+{
+    m_queryText = m_text;
+    m_latency.start();
+    TTK_INFO_STREAM(className() << "startToQuery" << m_queryText);
+    m_request->startToSearch(m_queryText);
+}
+
+void MusicSongSuggestService::downLoadFinished()
+{
+    if(m_queryText.isEmpty())
+    {
+        return;
+    }
+
+    QStringList *names = new QStringList;
+    for(const MusicResultDataItem &item : qAsConst(m_request->items()))
+    {
+        names->append(item.m_name);
+    }
+
+    const QString text = m_queryText;
+    m_queryText.clear();
+    m_cache.insert(text.toLower(), names);
+    TTK_INFO_STREAM(className() << "downLoadFinished" << text << names->count() << "items in" << m_latency.elapsed() << "ms");
+
+    // the result of an older text is cached only
+    if(text == m_text)
+    {
+        Q_EMIT suggestChanged(text, merge(text, *names));
+    }
+}
+
+bool MusicSongSuggestService::findCache(const QString &text, QStringList *names)
+{
+    const QString &key = text.toLower();
+    if(const QStringList *cached = m_cache.object(key))
+    {
+        *names = *cached;
+        return true;
+    }
+
+    // the results of a shorter prefix narrowed down locally, unless the list was cut by the server
+    for(int i = key.length() - 1; i > 0; --i)
+    {
+        const QStringList *cached = m_cache.object(key.left(i));
+        if(!cached)
+        {
+            continue;
+        }
+
+        QStringList filtered;
+        for(const QString &name : qAsConst(*cached))
+        {
+            if(name.contains(text, Qt::CaseInsensitive))
+            {
+                filtered << name;
+            }
+        }
+
+        if(cached->count() < FULL_RESULT_COUNT || filtered.count() >= MIN_REUSE_COUNT)
+        {
+            *names = filtered;
+            return true;
+        }
+        break;
+    }
+    return false;
+}
+
+QStringList MusicSongSuggestService::merge(const QString &text, const QStringList &names)
+{
+    records();
+
+    // matched names of the history index, the newest first
+    const QString &key = text.toLower();
+    QList<int> indexs;
+    for(auto it = m_recordIndex.lowerBound(key); it != m_recordIndex.end() && it.key().startsWith(key); ++it)
+    {
+        indexs << it.value();
+    }
+    std::sort(indexs.begin(), indexs.end());
+
+    QStringList result;
+    QSet<QString> keys;
+    for(int i = 0; i < indexs.count() && result.count() < MAX_HISTORY_COUNT; ++i)
+    {
+        const QString &name = m_records[indexs[i]].m_name;
+        keys.insert(name.toLower());
+        result << name;
+    }
+
+    for(const QString &name : qAsConst(names))
+    {
+        const QString &lower = name.toLower();
+        if(!keys.contains(lower))
+        {
+            keys.insert(lower);
+            result << name;
+        }
+    }
+    return result;
+}
+
+void MusicSongSuggestService::updateIndex()
+{
+    // walked backwards, so a repeated name keeps its newest record
+    m_recordIndex.clear();
+    for(int i = m_records.count() - 1; i >= 0; --i)
+    {
+        m_recordIndex.insert(m_records[i].m_name.toLower(), i);
+    }
+}
+
+void MusicSongSuggestService::updateRecords()
+{
+    updateIndex();
+
+    MusicSongSearchRecordConfigManager manager;
+    if(!manager.load(SEARCH_PATH_FULL))
+    {
+        return;
+    }
+
+    manager.writeBuffer(m_records);
+}
@@ -0,0 +1,127 @@
+#ifndef MUSICSONGSUGGESTSERVICE_H
+#define MUSICSONGSUGGESTSERVICE_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QCache>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "ttksingleton.h"
+#include "musicsongsearchrecordconfigmanager.h"
+
+class MusicSongSuggestRequest;
+
+/*! @brief The class of the search suggest service.
+ * Input is debounced, remote results are cached by prefix and merged with the search history.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicSongSuggestService : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicSongSuggestService)
+public:
+    /*!
+     * Query suggestions by input text.
+     * Local results come at once, remote ones when the input is idle for a while.
+     */
+    void query(const QString &text, const QObject *owner);
+    /*!
+     * Abort the waiting and running query of the owner.
+     * The service is shared, the query of another owner goes on.
+     */
+    void abort(const QObject *owner);
+
+    /*!
+     * Get the search history records, the newest first.
+     */
+    const MusicSearchRecordList &records();
+    /*!
+     * Add search text into the history records.
+     */
+    void addRecord(const QString &text);
+    /*!
+     * Clear the history records.
+     */
+    void clearRecords();
+
+Q_SIGNALS:
+    /*!
+     * Suggest names of the trimmed text changed.
+     */
+    void suggestChanged(const QString &text, const QStringList &names);
+
+private Q_SLOTS:
+    /*!
+     * Start to query the remote suggestions.
+     */
+    void startToQuery();
+    /*!
+     * Remote suggestions download finished.
+     */
+    void downLoadFinished();
+
+private:
+    /*!
+     * Object constructor.
+     */
+    MusicSongSuggestService();
+    /*!
+     * Object destructor.
+     */
+    ~MusicSongSuggestService();
+
+    /*!
+     * Find remote results of the text or of its prefix in cache.
+     */
+    bool findCache(const QString &text, QStringList *names);
+    /*!
+     * Merge the history records of the text prefix with the remote names.
+     */
+    QStringList merge(const QString &text, const QStringList &names);
+    /*!
+     * Rebuild the prefix index of the history records.
+     */
+    void updateIndex();
+    /*!
+     * Save the history records and rebuild the prefix index.
+     */
+    void updateRecords();
+    /*!
+     * Abort the waiting and running query.
+     */
+    void abort();
+
+    bool m_loaded;
+    QString m_text, m_queryText;
+    QTimer m_timer;
+    QElapsedTimer m_latency;
+    MusicSearchRecordList m_records;
+    QMap<QString, int> m_recordIndex;
+    QCache<QString, QStringList> m_cache;
+    MusicSongSuggestRequest *m_request;
+    const QObject *m_owner;
+
+    TTK_DECLARE_SINGLETON_CLASS(MusicSongSuggestService)
+
+};
+
+#define G_SUGGEST_PTR makeMusicSongSuggestService()
+TTK_MODULE_EXPORT MusicSongSuggestService* makeMusicSongSuggestService();
+
+#endif // MUSICSONGSUGGESTSERVICE_H
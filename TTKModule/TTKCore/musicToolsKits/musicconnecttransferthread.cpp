@@ -1,28 +1,372 @@
 #include "musicconnecttransferthread.h"
+#include "ttksavefile.h"
 
 #include <QFileInfo>
+#include <QDateTime>
+#include <QDataStream>
+#include <QCryptographicHash>
+
+static constexpr const char *MANIFEST_NAME = ".ttkmanifest";
+static constexpr quint32 MANIFEST_MAGIC = 0x534B5454;
+static constexpr quint32 MANIFEST_VERSION = 1;
+static constexpr int WORKER_COUNT = 3;
+static constexpr int CHUNK_SIZE = 1024 * 1024;
+static constexpr int SYNC_BATCH_COUNT = 16;
+static constexpr qint64 SYNC_BATCH_SIZE = 64 * 1024 * 1024;
+static constexpr int PROGRESS_INTERVAL = 100;
+
+static QByteArray fileHash(const QString &path)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    while(!file.atEnd())
+    {
+        hash.addData(file.read(CHUNK_SIZE));
+    }
+    return hash.result();
+}
+
+
+/*! @brief The class of the connect transfer task.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicConnectTransferTask
+{
+public:
+    explicit MusicConnectTransferTask(MusicConnectTransferThread *thread)
+        : m_thread(thread)
+    {
+
+    }
+
+    void run()
+    {
+        // written files are committed in batches, a sync right after every file stalls slow devices
+        QList<Pending> pendings;
+        qint64 size = 0;
+
+        MusicConnectTransferThread::Job job;
+        while(m_thread->takeJob(&job))
+        {
+            Pending pending;
+            if(copy(job, &pending))
+            {
+                pendings << pending;
+                size += job.m_item.m_size;
+            }
+
+            if(pendings.count() >= SYNC_BATCH_COUNT || size >= SYNC_BATCH_SIZE)
+            {
+                commit(pendings);
+                size = 0;
+            }
+        }
+
+        commit(pendings);
+    }
+
+private:
+    struct Pending
+    {
+        TTKSaveFile *m_file;
+        MusicConnectTransferThread::Item m_item;
+    };
+
+    bool copy(MusicConnectTransferThread::Job &job, Pending *pending) const
+    {
+        const QString &target = m_thread->m_target + job.m_item.m_name;
+        QFile source(job.m_source);
+        // written to a temporary file beside the target, which is replaced on commit only
+        TTKSaveFile *file = new TTKSaveFile(target);
+
+        qint64 remaining = job.m_item.m_size;
+        bool success = source.open(QIODevice::ReadOnly) && file->open(QIODevice::WriteOnly);
+
+        QCryptographicHash hash(QCryptographicHash::Md5);
+        while(success && m_thread->m_running && !source.atEnd())
+        {
+            const QByteArray &data = source.read(CHUNK_SIZE);
+            success = !data.isEmpty() && file->write(data) == data.size();
+            hash.addData(data);
+
+            remaining -= data.size();
+            m_thread->addProgress(data.size());
+        }
+
+        // keep the total reachable when a file fails or changes while copying
+        m_thread->addProgress(remaining);
+
+        if(!success || !m_thread->m_running || source.error() != QFile::NoError)
+        {
+            file->cancelWriting();
+            delete file;
+            return false;
+        }
+
+        job.m_item.m_hash = hash.result();
+        pending->m_file = file;
+        pending->m_item = job.m_item;
+        return true;
+    }
+
+    void commit(QList<Pending> &pendings) const
+    {
+        QList<MusicConnectTransferThread::Item> items;
+        for(const Pending &pending : qAsConst(pendings))
+        {
+            TTKSaveFile *file = pending.m_file;
+            file->close();
+
+            if(file->isCommitted())
+            {
+                items << pending.m_item;
+            }
+            delete file;
+        }
+
+        pendings.clear();
+        if(!items.isEmpty())
+        {
+            m_thread->finishJobs(items);
+        }
+    }
+
+    MusicConnectTransferThread *m_thread;
+
+};
+
 
 MusicConnectTransferThread::MusicConnectTransferThread(QObject *parent)
-    : TTKAbstractThread(parent)
+    : TTKAbstractThread(parent),
+      m_removeOrphans(false),
+      m_copied(0),
+      m_value(0),
+      m_total(0)
 {
 
 }
 
+MusicConnectTransferThread::~MusicConnectTransferThread()
+{
+    stop();
+}
+
 void MusicConnectTransferThread::setFilePath(const QString &target, const QStringList &path)
 {
     m_target = target;
-    m_path << path;
+    m_path = path;
+}
+
+void MusicConnectTransferThread::setRemoveOrphans(bool remove)
+{
+    m_removeOrphans = remove;
 }
 
 void MusicConnectTransferThread::run()
 {
+    if(m_target.isEmpty())
+    {
+        return;
+    }
+
+    const QHash<QString, Item> &olds = readManifest();
+    QSet<QString> names;
+    int skipped = 0, removed = 0;
+
+    m_items.clear();
+    m_jobs.clear();
+    m_copied = 0;
+    m_value = 0;
+    m_total = 0;
+
     for(const QString &path : qAsConst(m_path))
     {
-        if(m_running && !m_target.isEmpty())
+        if(!m_running)
+        {
+            break;
+        }
+
+        const QFileInfo fin(path);
+        if(!fin.isFile() || names.contains(fin.fileName()))
+        {
+            // files of the same name share one target, the first one wins
+            continue;
+        }
+
+        Item item;
+        item.m_name = fin.fileName();
+        item.m_size = fin.size();
+        item.m_modified = fin.lastModified().toMSecsSinceEpoch();
+        names.insert(item.m_name);
+
+        const QString &target = m_target + item.m_name;
+        const QFileInfo tin(target);
+        const auto it = olds.find(item.m_name);
+
+        bool unchanged = false;
+        if(tin.isFile() && tin.size() == item.m_size)
+        {
+            if(it == olds.end())
+            {
+                // copied before the device had a manifest
+                item.m_hash = fileHash(path);
+                unchanged = !item.m_hash.isEmpty() && item.m_hash == fileHash(target);
+            }
+            else if(it->m_size == item.m_size && it->m_modified == item.m_modified)
+            {
+                item.m_hash = it->m_hash;
+                unchanged = true;
+            }
+            else
+            {
+                // touched files are compared by content before copying again
+                item.m_hash = fileHash(path);
+                unchanged = !item.m_hash.isEmpty() && item.m_hash == it->m_hash;
+            }
+        }
+
+        if(unchanged)
+        {
+            m_items.insert(item.m_name, item);
+            ++skipped;
+            continue;
+        }
+
+        if(it != olds.end())
+        {
+            // the previous copy stays valid until the new one replaces it
+            m_items.insert(it.key(), it.value());
+        }
+
+        Job job;
+        job.m_source = path;
+        job.m_item = item;
+        m_jobs << job;
+        m_total += item.m_size;
+    }
+
+    for(auto it = olds.constBegin(); it != olds.constEnd(); ++it)
+    {
+        if(names.contains(it.key()))
+        {
+            continue;
+        }
+
+        // a stopped scan has not seen every selected file, nothing is removed then
+        const QString &target = m_target + it.key();
+        if(m_removeOrphans && m_running && (!QFile::exists(target) || QFile::remove(target)))
         {
-            const QString &targetPath = QString("%1%2").arg(m_target, QFileInfo(path).fileName());
-            QFile::copy(path, targetPath);
-            Q_EMIT transferFileFinished(targetPath);
+            ++removed;
         }
+        else
+        {
+            m_items.insert(it.key(), it.value());
+        }
+    }
+
+    m_timer.start();
+    Q_EMIT transferProgressChanged(0, m_total);
+
+    // copies share the thread pool, waiting here runs other tasks meanwhile
+    QList<TTKFuture<void>> futures;
+    for(int i = 0; i < qMin(WORKER_COUNT, m_jobs.count()); ++i)
+    {
+        futures << TTKThreadPool::instance()->run([this]() { MusicConnectTransferTask(this).run(); });
+    }
+
+    for(const TTKFuture<void> &future : qAsConst(futures))
+    {
+        future.waitForFinished();
+    }
+
+    if(!saveManifest())
+    {
+        TTK_ERROR_STREAM("Save transfer manifest error:" << m_target);
+    }
+
+    Q_EMIT transferProgressChanged(m_total, m_total);
+    Q_EMIT transferFinished(m_copied, skipped, removed);
+}
+
+bool MusicConnectTransferThread::takeJob(Job *job)
+{
+    QMutexLocker locker(&m_mutex);
+    if(!m_running || m_jobs.isEmpty())
+    {
+        return false;
+    }
+
+    *job = m_jobs.takeFirst();
+    return true;
+}
+
+void MusicConnectTransferThread::addProgress(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_value += bytes;
+
+    if(m_timer.elapsed() >= PROGRESS_INTERVAL)
+    {
+        m_timer.restart();
+        Q_EMIT transferProgressChanged(m_value, m_total);
+    }
+}
+
+void MusicConnectTransferThread::finishJobs(const QList<Item> &items)
+{
+    QMutexLocker locker(&m_mutex);
+    for(const Item &item : qAsConst(items))
+    {
+        m_items.insert(item.m_name, item);
+        ++m_copied;
+        Q_EMIT transferFileFinished(m_target + item.m_name);
+    }
+}
+
+QHash<QString, MusicConnectTransferThread::Item> MusicConnectTransferThread::readManifest() const
+{
+    QHash<QString, Item> items;
+    QFile file(m_target + MANIFEST_NAME);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return items;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0, version = 0, count = 0;
+    stream >> magic >> version >> count;
+
+    if(magic != MANIFEST_MAGIC || version != MANIFEST_VERSION)
+    {
+        return items;
+    }
+
+    for(quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+    {
+        Item item;
+        stream >> item.m_name >> item.m_size >> item.m_modified >> item.m_hash;
+        if(stream.status() == QDataStream::Ok)
+        {
+            items.insert(item.m_name, item);
+        }
+    }
+    return items;
+}
+
+bool MusicConnectTransferThread::saveManifest() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << MANIFEST_MAGIC << MANIFEST_VERSION << quint32(m_items.count());
+
+    for(const Item &item : qAsConst(m_items))
+    {
+        stream << item.m_name << item.m_size << item.m_modified << item.m_hash;
     }
+    return TTKSaveFile::writeFile(m_target + MANIFEST_NAME, data);
 }
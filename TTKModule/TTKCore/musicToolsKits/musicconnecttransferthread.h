@@ -19,9 +19,13 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
+#include <QMutex>
+#include <QElapsedTimer>
 #include "ttkabstractthread.h"
 
 /*! @brief The class of the connect transfer thread.
+ * A manifest on the device remembers what was copied, so only new or changed
+ * files are transferred, by a small pool of chunked writers.
  * @author Greedysky <greedysky@163.com>
  */
 class TTK_MODULE_EXPORT MusicConnectTransferThread : public TTKAbstractThread
@@ -33,26 +37,85 @@ public:
      * Object constructor.
      */
     explicit MusicConnectTransferThread(QObject *parent = nullptr);
+    /*!
+     * Object destructor.
+     */
+    ~MusicConnectTransferThread();
 
     /*!
      * Set copy file path list.
      */
     void setFilePath(const QString &target, const QStringList &path);
+    /*!
+     * Set remove the synced files on device which are not in the list.
+     */
+    void setRemoveOrphans(bool remove);
 
 Q_SIGNALS:
     /*!
      * Send the transfer file or path.
      */
     void transferFileFinished(const QString &name);
+    /*!
+     * Send the transferred bytes and the total bytes to transfer.
+     */
+    void transferProgressChanged(qint64 value, qint64 total);
+    /*!
+     * Send the count of copied, unchanged and removed files.
+     */
+    void transferFinished(int copied, int skipped, int removed);
 
 private:
+    friend class MusicConnectTransferTask;
+
+    struct Item
+    {
+        QString m_name;
+        qint64 m_size;
+        qint64 m_modified;
+        QByteArray m_hash;
+    };
+
+    struct Job
+    {
+        QString m_source;
+        Item m_item;
+    };
+
     /*!
      * Thread run now.
      */
     virtual void run() override final;
 
+    /*!
+     * Take the next waiting job, false when nothing is left.
+     */
+    bool takeJob(Job *job);
+    /*!
+     * Count the transferred bytes.
+     */
+    void addProgress(qint64 bytes);
+    /*!
+     * Record the jobs that reached the device.
+     */
+    void finishJobs(const QList<Item> &items);
+
+    /*!
+     * Read and save the manifest of the device.
+     */
+    QHash<QString, Item> readManifest() const;
+    bool saveManifest() const;
+
     QString m_target;
     QStringList m_path;
+    bool m_removeOrphans;
+
+    QMutex m_mutex;
+    QList<Job> m_jobs;
+    QHash<QString, Item> m_items;
+    int m_copied;
+    qint64 m_value, m_total;
+    QElapsedTimer m_timer;
 
 };
 
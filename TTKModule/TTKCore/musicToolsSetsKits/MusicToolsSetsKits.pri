@@ -24,7 +24,13 @@ HEADERS += \
     $$PWD/musictimerautomodule.h \
     $$PWD/musicsongsmanagerthread.h \
     $$PWD/musicaudiorecordermodule.h \
-    $$PWD/musicnetworktestthread.h \
+    $$PWD/musicaudiorecorderwriter.h \
+    $$PWD/musicaudioringbuffer.h \
+    $$PWD/musicaudiofingerprint.h \
+    $$PWD/musicfingerprintindex.h \
+    $$PWD/musicfingerprintindexthread.h \
+    $$PWD/musicnetworktestrequest.h \
+    $$PWD/musicnetworktestserver.h \
     $$PWD/musicsongchecktoolsthread.h \
     $$PWD/musicsongchecktoolsunit.h
 
@@ -34,5 +40,11 @@ SOURCES += \
     $$PWD/musictimerautomodule.cpp \
     $$PWD/musicsongsmanagerthread.cpp \
     $$PWD/musicaudiorecordermodule.cpp \
-    $$PWD/musicnetworktestthread.cpp \
+    $$PWD/musicaudiorecorderwriter.cpp \
+    $$PWD/musicaudioringbuffer.cpp \
+    $$PWD/musicaudiofingerprint.cpp \
+    $$PWD/musicfingerprintindex.cpp \
+    $$PWD/musicfingerprintindexthread.cpp \
+    $$PWD/musicnetworktestrequest.cpp \
+    $$PWD/musicnetworktestserver.cpp \
     $$PWD/musicsongchecktoolsthread.cpp
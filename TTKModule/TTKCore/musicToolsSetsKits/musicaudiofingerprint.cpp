@@ -0,0 +1,323 @@
+#include "musicaudiofingerprint.h"
+
+#include <qmmp/decoder.h>
+#include <qmmp/decoderfactory.h>
+#include <qmmp/audioconverter.h>
+
+#include <qmath.h>
+
+static constexpr int SAMPLE_RATE = 8000;
+static constexpr int FRAME_SIZE = 1024;
+static constexpr int HOP_SIZE = 512;
+static constexpr int BAND_COUNT = 6;
+static constexpr int PEAK_RANGE = 2;
+static constexpr int FAN_OUT = 5;
+static constexpr int MAX_DELTA = 63;
+
+// fft bins of the bands, 62Hz to 4kHz in octaves
+static constexpr int BAND_BINS[BAND_COUNT + 1] = {8, 16, 32, 64, 128, 256, FRAME_SIZE / 2};
+
+/*! @brief The class of the fft table.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct MusicFFTTable
+{
+    MusicFFTTable()
+    {
+        for(int i = 0; i < FRAME_SIZE; ++i)
+        {
+            m_window[i] = 0.5f - 0.5f * std::cos(2 * M_PI * i / (FRAME_SIZE - 1));
+
+            int reverse = 0;
+            for(int bit = 1, value = i; bit < FRAME_SIZE; bit <<= 1, value >>= 1)
+            {
+                reverse = (reverse << 1) | (value & 1);
+            }
+            m_reverse[i] = reverse;
+        }
+
+        for(int i = 0; i < FRAME_SIZE / 2; ++i)
+        {
+            m_cos[i] = std::cos(2 * M_PI * i / FRAME_SIZE);
+            m_sin[i] = -std::sin(2 * M_PI * i / FRAME_SIZE);
+        }
+    }
+
+    float m_window[FRAME_SIZE];
+    float m_cos[FRAME_SIZE / 2];
+    float m_sin[FRAME_SIZE / 2];
+    int m_reverse[FRAME_SIZE];
+};
+
+/*!
+ * Log magnitude spectrum of the windowed frame, output has half frame size bins.
+ */
+static void spectrum(const float *input, float *output)
+{
+    static const MusicFFTTable table;
+
+    float re[FRAME_SIZE], im[FRAME_SIZE];
+    for(int i = 0; i < FRAME_SIZE; ++i)
+    {
+        re[table.m_reverse[i]] = input[i] * table.m_window[i];
+        im[i] = 0;
+    }
+
+    for(int size = 2; size <= FRAME_SIZE; size <<= 1)
+    {
+        const int half = size >> 1;
+        const int step = FRAME_SIZE / size;
+        for(int i = 0; i < FRAME_SIZE; i += size)
+        {
+            for(int j = 0; j < half; ++j)
+            {
+                const float wr = table.m_cos[j * step];
+                const float wi = table.m_sin[j * step];
+                const int a = i + j, b = a + half;
+                const float tr = re[b] * wr - im[b] * wi;
+                const float ti = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+
+    for(int i = 0; i < FRAME_SIZE / 2; ++i)
+    {
+        output[i] = std::log(1.0f + std::sqrt(re[i] * re[i] + im[i] * im[i]));
+    }
+}
+
+
+MusicAudioFingerprint::MusicAudioFingerprint(int sampleRate)
+    : m_step(double(SAMPLE_RATE) / qMax(1, sampleRate)),
+      m_phase(0),
+      m_sum(0),
+      m_count(0)
+{
+    m_samples.reserve(FRAME_SIZE);
+}
+
+void MusicAudioFingerprint::append(const float *data, int count)
+{
+    for(int i = 0; i < count; ++i)
+    {
+        // box filter down to the target rate, a lower rate repeats the samples
+        m_sum += data[i];
+        ++m_count;
+        m_phase += m_step;
+
+        if(m_phase < 1.0)
+        {
+            continue;
+        }
+
+        const float value = m_sum / m_count;
+        m_sum = 0;
+        m_count = 0;
+
+        for(; m_phase >= 1.0; m_phase -= 1.0)
+        {
+            m_samples << value;
+            if(m_samples.count() == FRAME_SIZE)
+            {
+                processFrame();
+                m_samples.remove(0, HOP_SIZE);
+            }
+        }
+    }
+}
+
+MusicFingerprintHashList MusicAudioFingerprint::hashes() const
+{
+    const int frames = m_peaks.count() / BAND_COUNT;
+    if(frames == 0)
+    {
+        return {};
+    }
+
+    float mean = 0;
+    for(const Peak &peak : qAsConst(m_peaks))
+    {
+        mean += peak.m_value;
+    }
+    mean /= m_peaks.count();
+
+    // keep the band peaks louder than average and strongest around in time
+    QVector<QPair<int, int>> points;
+    for(int t = 0; t < frames; ++t)
+    {
+        for(int b = 0; b < BAND_COUNT; ++b)
+        {
+            const float value = m_peaks[t * BAND_COUNT + b].m_value;
+            if(value <= mean)
+            {
+                continue;
+            }
+
+            bool peak = true;
+            for(int i = qMax(0, t - PEAK_RANGE); i <= qMin(frames - 1, t + PEAK_RANGE) && peak; ++i)
+            {
+                const float other = m_peaks[i * BAND_COUNT + b].m_value;
+                peak = i == t || other < value || (other == value && i > t);
+            }
+
+            if(peak)
+            {
+                points << qMakePair(t, m_peaks[t * BAND_COUNT + b].m_bin);
+            }
+        }
+    }
+
+    MusicFingerprintHashList hashes;
+    hashes.reserve(points.count() * FAN_OUT);
+    for(int i = 0; i < points.count(); ++i)
+    {
+        const QPair<int, int> &anchor = points[i];
+        for(int j = i + 1, paired = 0; j < points.count() && paired < FAN_OUT; ++j)
+        {
+            const QPair<int, int> &target = points[j];
+            const int delta = target.first - anchor.first;
+            if(delta == 0)
+            {
+                continue;
+            }
+
+            if(delta > MAX_DELTA)
+            {
+                break;
+            }
+
+            MusicFingerprintHash hash;
+            hash.m_hash = (anchor.second << 15) | (target.second << 6) | delta;
+            hash.m_time = anchor.first;
+            hashes << hash;
+            ++paired;
+        }
+    }
+    return hashes;
+}
+
+int MusicAudioFingerprint::timeUnit()
+{
+    return HOP_SIZE * TTK_DN_S2MS / SAMPLE_RATE;
+}
+
+MusicFingerprintHashList MusicAudioFingerprint::fromPcm(const QByteArray &data, int sampleRate)
+{
+    MusicAudioFingerprint fingerprint(sampleRate);
+    const qint16 *samples = TTKReinterpretCast(const qint16*, data.constData());
+    const int count = data.size() / sizeof(qint16);
+
+    float buffer[FRAME_SIZE];
+    for(int i = 0; i < count; i += FRAME_SIZE)
+    {
+        const int size = qMin(FRAME_SIZE, count - i);
+        for(int j = 0; j < size; ++j)
+        {
+            buffer[j] = samples[i + j] / 32768.0f;
+        }
+        fingerprint.append(buffer, size);
+    }
+    return fingerprint.hashes();
+}
+
+MusicFingerprintHashList MusicAudioFingerprint::fromFile(const QString &path, int seconds)
+{
+    DecoderFactory *factory = Decoder::findByFilePath(path);
+    if(!factory)
+    {
+        return {};
+    }
+
+    QFile file(path);
+    if(!factory->properties().noInput && !file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+
+    Decoder *decoder = factory->create(path, file.isOpen() ? &file : nullptr);
+    if(!decoder || !decoder->initialize())
+    {
+        delete decoder;
+        return {};
+    }
+
+    const AudioParameters &parameters = decoder->audioParameters();
+    const int channels = qMax(1, parameters.channels());
+    const int frameSize = parameters.frameSize();
+    if(frameSize <= 0 || parameters.sampleRate() == 0)
+    {
+        delete decoder;
+        return {};
+    }
+
+    AudioConverter converter;
+    converter.configure(parameters.format());
+
+    MusicAudioFingerprint fingerprint(parameters.sampleRate());
+    QByteArray buffer(frameSize * FRAME_SIZE, 0);
+    QVector<float> samples(channels * FRAME_SIZE), mono(FRAME_SIZE);
+    qint64 remaining = qint64(seconds) * parameters.sampleRate();
+    int offset = 0;
+
+    while(remaining > 0)
+    {
+        // a read may end inside a frame, its first bytes wait for the next read
+        const qint64 size = decoder->read(TTKReinterpretCast(uchar*, buffer.data() + offset), buffer.size() - offset);
+        if(size <= 0)
+        {
+            break;
+        }
+
+        const int bytes = offset + size;
+        const int frames = qMin<qint64>(bytes / frameSize, remaining);
+        offset = bytes - frames * frameSize;
+
+        if(frames == 0)
+        {
+            continue;
+        }
+
+        converter.toFloat(TTKReinterpretCast(const uchar*, buffer.constData()), samples.data(), frames * channels);
+
+        for(int i = 0; i < frames; ++i)
+        {
+            float value = 0;
+            for(int c = 0; c < channels; ++c)
+            {
+                value += samples[i * channels + c];
+            }
+            mono[i] = value / channels;
+        }
+
+        fingerprint.append(mono.constData(), frames);
+        remaining -= frames;
+        memmove(buffer.data(), buffer.constData() + frames * frameSize, offset);
+    }
+
+    delete decoder;
+    return fingerprint.hashes();
+}
+
+void MusicAudioFingerprint::processFrame()
+{
+    float bins[FRAME_SIZE / 2];
+    spectrum(m_samples.constData(), bins);
+
+    for(int b = 0; b < BAND_COUNT; ++b)
+    {
+        Peak peak = {bins[BAND_BINS[b]], BAND_BINS[b]};
+        for(int i = BAND_BINS[b] + 1; i < BAND_BINS[b + 1]; ++i)
+        {
+            if(bins[i] > peak.m_value)
+            {
+                peak.m_value = bins[i];
+                peak.m_bin = i;
+            }
+        }
+        m_peaks << peak;
+    }
+}
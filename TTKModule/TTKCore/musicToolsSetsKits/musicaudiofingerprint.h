@@ -0,0 +1,91 @@
+#ifndef MUSICAUDIOFINGERPRINT_H
+#define MUSICAUDIOFINGERPRINT_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include "musicglobaldefine.h"
+
+/*! @brief The class of the audio fingerprint hash item.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct TTK_MODULE_EXPORT MusicFingerprintHash
+{
+    quint32 m_hash;
+    quint32 m_time;
+};
+Q_DECLARE_TYPEINFO(MusicFingerprintHash, Q_PRIMITIVE_TYPE);
+using MusicFingerprintHashList = QVector<MusicFingerprintHash>;
+
+/*! @brief The class of the audio fingerprint.
+ * Audio is mixed to mono at 8 kHz, the spectral peaks of every band are paired
+ * into hashes of both frequencies and their time distance.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicAudioFingerprint
+{
+    TTK_DECLARE_MODULE(MusicAudioFingerprint)
+public:
+    /*!
+     * Object constructor by the sample rate of input.
+     */
+    explicit MusicAudioFingerprint(int sampleRate = 8000);
+
+    /*!
+     * Append mono samples in range -1.0 to 1.0.
+     */
+    void append(const float *data, int count);
+    /*!
+     * Get the hashes of all appended samples.
+     */
+    MusicFingerprintHashList hashes() const;
+
+    /*!
+     * Time of one hash time unit in milliseconds.
+     */
+    static int timeUnit();
+    /*!
+     * Get the hashes of signed 16 bit mono samples.
+     */
+    static MusicFingerprintHashList fromPcm(const QByteArray &data, int sampleRate);
+    /*!
+     * Get the hashes of the first seconds of the file, decoded by the audio plugins.
+     */
+    static MusicFingerprintHashList fromFile(const QString &path, int seconds);
+
+private:
+    /*!
+     * Find the band peaks of the current frame.
+     */
+    void processFrame();
+
+    struct Peak
+    {
+        float m_value;
+        int m_bin;
+    };
+
+    double m_step, m_phase;
+    float m_sum;
+    int m_count;
+    QVector<float> m_samples;
+    QVector<Peak> m_peaks;
+
+};
+
+#endif // MUSICAUDIOFINGERPRINT_H
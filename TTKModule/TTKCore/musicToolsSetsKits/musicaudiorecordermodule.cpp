@@ -1,226 +1,324 @@
 #include "musicaudiorecordermodule.h"
+#include "musicaudiorecorderwriter.h"
+#include "musicaudioringbuffer.h"
 
-static constexpr int OPEN_FILE_ERROR = -1;
-static constexpr int SAVE_FILE_ERROR = -2;
-static constexpr int WRITE_FILE_ERROR = -3;
-static constexpr int REWRITE_FILE_ERROR = -4;
+#include <QtEndian>
 
-struct WavHeader
+static constexpr int BUFFER_SECONDS = 4;
+static constexpr int READ_SIZE = 4096;
+
+/*!
+ * Pcm formats the samples can be converted from.
+ */
+static bool isFormatSupported(const QAudioFormat &format)
+{
+    if(format.codec() != "audio/pcm" || format.channelCount() <= 0)
+    {
+        return false;
+    }
+
+    switch(format.sampleSize())
+    {
+        case 8:
+        case 16: return format.sampleType() == QAudioFormat::SignedInt || format.sampleType() == QAudioFormat::UnSignedInt;
+        case 32: return format.sampleType() != QAudioFormat::Unknown;
+        default: return false;
+    }
+}
+
+/*!
+ * Read one sample of the format scaled to 16 bit signed range.
+ */
+static int readSample(const uchar *data, const QAudioFormat &format)
 {
-    char riffName[4];
-    ulong riffLength;
-    char wavName[4];
-    char fmtName[4];
-    ulong fmtLength;
-    ushort audioFormat;
-    ushort channleNumber;
-    ulong sampleRate;
-    ulong bytesPperSecond;
-    ushort bytesPerSample;
-    ushort bitsPerSample;
-    char dataName[4];
-    ulong dataLength;
-};
+    const bool little = format.byteOrder() == QAudioFormat::LittleEndian;
+    const bool unsign = format.sampleType() == QAudioFormat::UnSignedInt;
+
+    switch(format.sampleSize())
+    {
+        case 8: return (unsign ? int(data[0]) - 0x80 : int(qint8(data[0]))) * 0x100;
+        case 16:
+        {
+            const quint16 value = little ? qFromLittleEndian<quint16>(data) : qFromBigEndian<quint16>(data);
+            return unsign ? int(value) - 0x8000 : int(qint16(value));
+        }
+        default:
+        {
+            const quint32 value = little ? qFromLittleEndian<quint32>(data) : qFromBigEndian<quint32>(data);
+            if(format.sampleType() == QAudioFormat::Float)
+            {
+                float sample;
+                memcpy(&sample, &value, sizeof(float));
+                return qRound(qBound(-1.0f, sample, 1.0f) * 32767.0f);
+            }
+            return unsign ? int(value >> 16) - 0x8000 : int(qint32(value) >> 16);
+        }
+    }
+}
 
 
 MusicAudioRecorderModule::MusicAudioRecorderModule(QObject *parent)
     : QObject(parent),
       m_inputVolume(0),
-      m_audioInputFile(nullptr),
-      m_audioOutputFile(nullptr)
+      m_level(0),
+      m_fileName(TTK_RECORD_DATA_FILE),
+      m_audioInput(nullptr),
+      m_inputDevice(nullptr),
+      m_device(nullptr),
+      m_buffer(nullptr),
+      m_writer(nullptr)
 {
-    m_file = new QFile(this);
-    m_file->setFileName(TTK_RECORD_FILE);
-
-    m_formatFile.setChannelCount(1);
-    m_formatFile.setSampleSize(16);
-    m_formatFile.setSampleRate(8000);
-    m_formatFile.setSampleType(QAudioFormat::SignedInt);
-    m_formatFile.setByteOrder(QAudioFormat::LittleEndian);
-    m_formatFile.setCodec("audio/pcm");
+    m_format.setChannelCount(1);
+    m_format.setSampleSize(16);
+    m_format.setSampleRate(8000);
+    m_format.setSampleType(QAudioFormat::SignedInt);
+    m_format.setByteOrder(QAudioFormat::LittleEndian);
+    m_format.setCodec("audio/pcm");
 
     const QAudioDeviceInfo input_info(QAudioDeviceInfo::defaultInputDevice());
-    if(!input_info.isFormatSupported(m_formatFile))
+    if(!input_info.isFormatSupported(m_format))
     {
         TTK_WARN_STREAM("Input default format file not supported try to use nearest");
-        m_formatFile = input_info.nearestFormat(m_formatFile);
+        m_format = input_info.nearestFormat(m_format);
     }
 
-    const QAudioDeviceInfo output_info(QAudioDeviceInfo::defaultOutputDevice());
-    if(!output_info.isFormatSupported(m_formatFile))
+    if(!isFormatSupported(m_format))
     {
-        TTK_WARN_STREAM("Output default format file not supported - trying to use nearest");
-        TTK_WARN_STREAM("Output no support input format file.");
+        TTK_ERROR_STREAM("Audio input format not supported:" << m_format.codec() << m_format.sampleSize() << "bit");
     }
 
-    if(m_formatFile.sampleSize() != 16)
-    {
-        TTK_INFO_STREAM(QString("Audio device doesn't support 16 bit support %d bit samples, example cannot run %1").arg(m_formatFile.sampleSize()));
-    }
+    createBuffer();
 }
 
 MusicAudioRecorderModule::~MusicAudioRecorderModule()
 {
-    QFile::remove(TTK_RECORD_FILE);
-    QFile::remove(TTK_RECORD_DATA_FILE);
+    onRecordStop();
+    QFile::remove(m_fileName);
 
-    delete m_file;
-    delete m_audioInputFile;
-    delete m_audioOutputFile;
+    delete m_writer;
+    delete m_buffer;
 }
 
-int MusicAudioRecorderModule::addWavHeader(const char *fileName) const
+void MusicAudioRecorderModule::setVolume(int volume)
 {
-    WavHeader fileHeader;
-    fileHeader.riffName[0] = 'R';
-    fileHeader.riffName[1] = 'I';
-    fileHeader.riffName[2] = 'F';
-    fileHeader.riffName[3] = 'F';
-
-    fileHeader.wavName[0] = 'W';
-    fileHeader.wavName[1] = 'A';
-    fileHeader.wavName[2] = 'V';
-    fileHeader.wavName[3] = 'E';
+    m_inputVolume = volume;
+#if TTK_QT_VERSION_CHECK(5,0,0)
+    if(m_audioInput)
+    {
+        m_audioInput->setVolume(volume);
+    }
+#endif
+}
 
-    fileHeader.fmtName[0] = 'f';
-    fileHeader.fmtName[1] = 'm';
-    fileHeader.fmtName[2] = 't';
-    fileHeader.fmtName[3] = 0x20;
-    fileHeader.fmtLength = 16;
-    fileHeader.audioFormat = 1;
+int MusicAudioRecorderModule::volume() const
+{
+    return m_inputVolume;
+}
 
-    fileHeader.dataName[0] = 'd';
-    fileHeader.dataName[1] = 'a';
-    fileHeader.dataName[2] = 't';
-    fileHeader.dataName[3] = 'a';
-    fileHeader.bitsPerSample = 16;
-    fileHeader.bytesPerSample = 2;
-    fileHeader.sampleRate = 8000;
-    fileHeader.bytesPperSecond = 16000;
-    fileHeader.channleNumber = 1;
+void MusicAudioRecorderModule::setFileName(const QString &name)
+{
+    m_fileName = name;
+}
 
-    int fileLen = 0;
-    const int headerSize = sizeof(fileHeader);
+QString MusicAudioRecorderModule::fileName() const
+{
+    return m_fileName;
+}
 
-    FILE *input = nullptr;
-    FILE *output = nullptr;
-    if((input = fopen(qPrintable(m_file->fileName()), "rb")) == nullptr)
+QByteArray MusicAudioRecorderModule::pcmData() const
+{
+    QFile file(m_fileName);
+    if(!isFormatSupported(m_format) || !file.open(QIODevice::ReadOnly) || !file.seek(MusicAudioRecorderWriter::headerSize()))
     {
-        return OPEN_FILE_ERROR;
+        return {};
     }
 
-    if((output = fopen(qPrintable(fileName), "wb+")) == nullptr)
+    const QByteArray &data = file.readAll();
+    const bool mono16 = m_format.channelCount() == 1 && m_format.sampleSize() == 16 && m_format.sampleType() == QAudioFormat::SignedInt;
+    if(mono16 && m_format.byteOrder() == QAudioFormat::LittleEndian)
     {
-        return SAVE_FILE_ERROR;
+        return data;
     }
 
-    if(fwrite(&fileHeader, 1, headerSize, output) != headerSize)
-    {
-        fclose(input);
-        fclose(output);
-        return WRITE_FILE_ERROR;
-    }
+    // channels are mixed down to one, the samples are scaled to 16 bit
+    const int channels = m_format.channelCount();
+    const int sampleBytes = m_format.sampleSize() / 8;
+    const int frameBytes = channels * sampleBytes;
+    const int frames = data.size() / frameBytes;
+
+    QByteArray output(frames * 2, '\0');
+    const uchar *input = TTKReinterpretCast(const uchar*, data.constData());
+    uchar *samples = TTKReinterpretCast(uchar*, output.data());
 
-    while(!feof(input))
+    for(int i = 0; i < frames; ++i)
     {
-        char readBuf[4096];
-        const int nRead = fread(readBuf, 1, 4096, input);
-        if(nRead > 0)
+        int sum = 0;
+        for(int c = 0; c < channels; ++c)
         {
-            fwrite(readBuf, 1, nRead, output);
+            sum += readSample(input + i * frameBytes + c * sampleBytes, m_format);
         }
-
-        fileLen += nRead;
+        qToLittleEndian<qint16>(sum / channels, samples + i * 2);
     }
-
-    fseek(output, 0L, SEEK_SET);
-    fileHeader.riffLength = fileLen - 8 + headerSize;
-    fileHeader.dataLength = fileLen;
-
-    if(fwrite(&fileHeader, 1, headerSize, output) != headerSize)
-    {
-        fclose(input);
-        fclose(output);
-        return REWRITE_FILE_ERROR;
-    }
-
-    fclose(input);
-    fclose(output);
-
-    return fileLen;
+    return output;
 }
 
-void MusicAudioRecorderModule::setVolume(int volume)
+void MusicAudioRecorderModule::setInputDevice(QIODevice *device, const QAudioFormat &format)
 {
-    m_inputVolume = volume;
-#if TTK_QT_VERSION_CHECK(5,0,0)
-    if(m_audioInputFile)
+    if(m_device)
     {
-        m_audioInputFile->setVolume(volume);
+        return;
     }
-#endif
-}
 
-int MusicAudioRecorderModule::volume() const
-{
-    return m_inputVolume;
+    m_inputDevice = device;
+    m_format = format;
+    createBuffer();
 }
 
-void MusicAudioRecorderModule::setFileName(const QString &name)
+bool MusicAudioRecorderModule::error() const
 {
-    m_file->setFileName(name);
-}
+    if(!isFormatSupported(m_format))
+    {
+        return true;
+    }
 
-QString MusicAudioRecorderModule::fileName() const
-{
-    return m_file->fileName();
-}
+    if(m_inputDevice)
+    {
+        return false;
+    }
 
-bool MusicAudioRecorderModule::error() const
-{
-    if(!m_audioInputFile)
+    if(!m_audioInput)
     {
         return true;
     }
 
-    return m_audioInputFile->error() != QAudio::NoError;
+    return m_audioInput->error() != QAudio::NoError;
 }
 
 void MusicAudioRecorderModule::onRecordStart()
 {
-    if(!m_file->isOpen())
+    if(m_device)
+    {
+        return;
+    }
+
+    if(!isFormatSupported(m_format))
+    {
+        TTK_ERROR_STREAM("Audio input format not supported, record is rejected");
+        return;
+    }
+
+    QIODevice *device = m_inputDevice;
+    if(!device)
     {
-        m_file->open(QIODevice::WriteOnly | QIODevice::Truncate);
-        m_audioInputFile = new QAudioInput(m_formatFile, this);
+        delete m_audioInput;
+        m_audioInput = new QAudioInput(m_format, this);
+        if(m_audioInput->error() != QAudio::NoError)
+        {
+            TTK_ERROR_STREAM("Audio input open error");
+            return;
+        }
     }
 
-    if(m_audioInputFile->error() != QAudio::NoError)
+    m_buffer->clear();
+    m_frame.clear();
+    if(!m_writer->open(m_fileName, m_format))
     {
-        TTK_ERROR_STREAM("Audio input open error");
+        TTK_ERROR_STREAM("Audio record file open error:" << m_fileName);
         return;
     }
+    m_writer->start();
 
+    if(m_audioInput)
+    {
 #if TTK_QT_VERSION_CHECK(5,0,0)
-    m_audioInputFile->setVolume(m_inputVolume);
+        m_audioInput->setVolume(m_inputVolume);
 #endif
-    m_audioInputFile->start(m_file);
+        // pull mode, the input is read as soon as it is available
+        device = m_audioInput->start();
+    }
+
+    m_device = device;
+    if(m_device)
+    {
+        connect(m_device, SIGNAL(readyRead()), SLOT(readInput()));
+        readInput();
+    }
 }
 
 void MusicAudioRecorderModule::onRecordStop()
 {
-    if(m_audioInputFile)
+    if(m_device)
     {
-        m_audioInputFile->stop();
-        delete m_audioInputFile;
-        m_audioInputFile = nullptr;
+        readInput();
+        disconnect(m_device, nullptr, this, nullptr);
+        m_device = nullptr;
     }
 
-    if(m_audioOutputFile)
+    if(m_audioInput)
+    {
+        m_audioInput->stop();
+        delete m_audioInput;
+        m_audioInput = nullptr;
+    }
+
+    // only the data still in the ring buffer is left to write
+    m_writer->close();
+    m_level = 0;
+}
+
+void MusicAudioRecorderModule::readInput()
+{
+    if(!m_device)
     {
-        m_audioOutputFile->stop();
-        delete m_audioOutputFile;
-        m_audioOutputFile = nullptr;
+        return;
     }
 
-    m_file->close();
+    const int sampleBytes = m_format.sampleSize() / 8;
+    const int frameBytes = m_format.channelCount() * sampleBytes;
+    // only whole frames are handled, the bytes of a split frame wait for the next read
+    const int readSize = READ_SIZE / frameBytes * frameBytes;
+    int peak = 0;
+    qint64 size = 0;
+    char data[READ_SIZE];
+
+    int offset = m_frame.size();
+    memcpy(data, m_frame.constData(), offset);
+
+    while((size = m_device->read(data + offset, readSize - offset)) > 0)
+    {
+        const int total = offset + size;
+        const int whole = total - total % frameBytes;
+
+        const uchar *samples = TTKReinterpretCast(const uchar*, data);
+        for(int i = 0; i < whole; i += sampleBytes)
+        {
+            peak = qMax(peak, qAbs(readSample(samples + i, m_format)));
+        }
+
+        // the writer only frees space, so the rounded free size is always written in full
+        const int space = (m_buffer->capacity() - m_buffer->available()) / frameBytes * frameBytes;
+        if(m_buffer->write(data, qMin(whole, space)) != whole)
+        {
+            TTK_WARN_STREAM("Audio record buffer overflow, frames dropped");
+        }
+
+        offset = total - whole;
+        memmove(data, data + whole, offset);
+    }
+
+    m_frame = QByteArray(data, offset);
+
+    m_writer->wakeUp();
+
+    m_level = qMin(1.0f, peak / 32768.0f);
+    Q_EMIT levelChanged(m_level);
+}
+
+void MusicAudioRecorderModule::createBuffer()
+{
+    delete m_writer;
+    delete m_buffer;
+
+    m_buffer = new MusicAudioRingBuffer(qMax(READ_SIZE, m_format.sampleRate() * m_format.channelCount() * m_format.sampleSize() / 8 * BUFFER_SECONDS));
+    m_writer = new MusicAudioRecorderWriter(m_buffer, this);
 }
@@ -19,13 +19,16 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
-#include <QFile>
 #include <QAudioInput>
-#include <QAudioOutput>
 #include <QAudioDeviceInfo>
 #include "musicglobaldefine.h"
 
+class MusicAudioRingBuffer;
+class MusicAudioRecorderWriter;
+
 /*! @brief The class of the audio recorder core.
+ * Input is pushed into a ring buffer and drained by a writer thread into a
+ * wav file, so stopping never waits for the recorded data to be copied.
  * @author Greedysky <greedysky@163.com>
  */
 class TTK_MODULE_EXPORT MusicAudioRecorderModule : public QObject
@@ -42,11 +45,6 @@ public:
      */
     ~MusicAudioRecorderModule();
 
-    /*!
-     * Add the header of wav.
-     */
-    int addWavHeader(const char *fileName) const;
-
     /*!
      * Set volume by value.
      */
@@ -57,17 +55,36 @@ public:
     int volume() const;
 
     /*!
-     * Set output file name.
+     * Set output wav file name.
      */
     void setFileName(const QString &name);
     /*!
-     * Get output file name.
+     * Get output wav file name.
      */
     QString fileName() const;
+    /*!
+     * Get the recording audio format.
+     */
+    inline const QAudioFormat &format() const { return m_format; }
+    /*!
+     * Read the recorded samples as mono 16 bit signed little endian pcm.
+     * Samples of other recording formats are converted, the sample rate is kept.
+     */
+    QByteArray pcmData() const;
+
+    /*!
+     * Set the device to read samples of format from instead of the default audio input.
+     * Only while not recording.
+     */
+    void setInputDevice(QIODevice *device, const QAudioFormat &format);
     /*!
      * Current input device error or not.
      */
     bool error() const;
+    /*!
+     * Get the peak level of the last input in range 0.0 to 1.0.
+     */
+    inline float level() const { return m_level; }
 
     /*!
      * Recorder play start.
@@ -78,12 +95,33 @@ public:
      */
     void onRecordStop();
 
+Q_SIGNALS:
+    /*!
+     * The peak level of input changed.
+     */
+    void levelChanged(float level);
+
+private Q_SLOTS:
+    /*!
+     * Read the available input into the ring buffer.
+     */
+    void readInput();
+
 private:
+    /*!
+     * Create the ring buffer and the writer by the current format.
+     */
+    void createBuffer();
+
     int m_inputVolume;
-    QFile *m_file;
-    QAudioFormat m_formatFile;
-    QAudioInput *m_audioInputFile;
-    QAudioOutput *m_audioOutputFile;
+    float m_level;
+    QString m_fileName;
+    QAudioFormat m_format;
+    QAudioInput *m_audioInput;
+    QIODevice *m_inputDevice, *m_device;
+    MusicAudioRingBuffer *m_buffer;
+    MusicAudioRecorderWriter *m_writer;
+    QByteArray m_frame;
 
 };
 
@@ -0,0 +1,129 @@
+#include "musicaudiorecorderwriter.h"
+#include "musicaudioringbuffer.h"
+
+#include <QtEndian>
+
+static constexpr int WAV_HEADER_SIZE = 44;
+static constexpr int WAIT_INTERVAL = 50;
+static constexpr int CHUNK_SIZE = 64 * 1024;
+static constexpr int WAVE_FORMAT_PCM = 1;
+static constexpr int WAVE_FORMAT_IEEE_FLOAT = 3;
+
+static inline void writeUInt16(char *data, quint16 value)
+{
+    qToLittleEndian<quint16>(value, TTKReinterpretCast(uchar*, data));
+}
+
+static inline void writeUInt32(char *data, quint32 value)
+{
+    qToLittleEndian<quint32>(value, TTKReinterpretCast(uchar*, data));
+}
+
+
+MusicAudioRecorderWriter::MusicAudioRecorderWriter(MusicAudioRingBuffer *buffer, QObject *parent)
+    : QThread(parent),
+      m_running(false),
+      m_buffer(buffer),
+      m_size(0)
+{
+
+}
+
+bool MusicAudioRecorderWriter::open(const QString &path, const QAudioFormat &format)
+{
+    m_file.setFileName(path);
+    m_format = format;
+    m_size = 0;
+    m_running = true;
+
+    if(!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    // sizes are unknown yet, they are patched on close
+    return writeHeader();
+}
+
+void MusicAudioRecorderWriter::close()
+{
+    if(!m_file.isOpen())
+    {
+        return;
+    }
+
+    m_mutex.lock();
+    m_running = false;
+    m_condition.wakeAll();
+    m_mutex.unlock();
+    wait();
+
+    drain();
+    m_file.seek(0);
+    writeHeader();
+    m_file.close();
+}
+
+void MusicAudioRecorderWriter::wakeUp()
+{
+    QMutexLocker locker(&m_mutex);
+    m_condition.wakeAll();
+}
+
+int MusicAudioRecorderWriter::headerSize()
+{
+    return WAV_HEADER_SIZE;
+}
+
+void MusicAudioRecorderWriter::run()
+{
+    while(m_running)
+    {
+        drain();
+
+        QMutexLocker locker(&m_mutex);
+        if(m_running && m_buffer->available() == 0)
+        {
+            m_condition.wait(&m_mutex, WAIT_INTERVAL);
+        }
+    }
+}
+
+void MusicAudioRecorderWriter::drain()
+{
+    char data[CHUNK_SIZE];
+    int size = 0;
+    while((size = m_buffer->read(data, CHUNK_SIZE)) > 0)
+    {
+        if(m_file.write(data, size) != size)
+        {
+            TTK_ERROR_STREAM("Audio record write error:" << m_file.fileName());
+        }
+        m_size += size;
+    }
+}
+
+bool MusicAudioRecorderWriter::writeHeader()
+{
+    const int channels = m_format.channelCount();
+    const int sampleSize = m_format.sampleSize();
+    const int sampleRate = m_format.sampleRate();
+    const quint32 size = quint32(qMin<qint64>(m_size, 0xFFFFFFFF - WAV_HEADER_SIZE));
+
+    char header[WAV_HEADER_SIZE];
+    memcpy(header, "RIFF", 4);
+    writeUInt32(header + 4, size + WAV_HEADER_SIZE - 8);
+    memcpy(header + 8, "WAVE", 4);
+    memcpy(header + 12, "fmt ", 4);
+    writeUInt32(header + 16, 16);
+    writeUInt16(header + 20, m_format.sampleType() == QAudioFormat::Float ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM);
+    writeUInt16(header + 22, channels);
+    writeUInt32(header + 24, sampleRate);
+    writeUInt32(header + 28, sampleRate * channels * sampleSize / 8);
+    writeUInt16(header + 32, channels * sampleSize / 8);
+    writeUInt16(header + 34, sampleSize);
+    memcpy(header + 36, "data", 4);
+    writeUInt32(header + 40, size);
+
+    return m_file.write(header, WAV_HEADER_SIZE) == WAV_HEADER_SIZE;
+}
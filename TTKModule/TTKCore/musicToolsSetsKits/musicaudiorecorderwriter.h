@@ -0,0 +1,94 @@
+#ifndef MUSICAUDIORECORDERWRITER_H
+#define MUSICAUDIORECORDERWRITER_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <atomic>
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QAudioFormat>
+#include <QWaitCondition>
+#include "musicglobaldefine.h"
+
+class MusicAudioRingBuffer;
+
+/*! @brief The class of the audio recorder wav writer thread.
+ * Samples are drained from the ring buffer straight into the wav file, the
+ * sizes of the header are patched on close. It blocks for the whole record,
+ * so it keeps a thread of its own instead of a task of the thread pool.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicAudioRecorderWriter : public QThread
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicAudioRecorderWriter)
+public:
+    /*!
+     * Object constructor by the ring buffer to drain.
+     */
+    explicit MusicAudioRecorderWriter(MusicAudioRingBuffer *buffer, QObject *parent = nullptr);
+
+    /*!
+     * Open the wav file by path and format.
+     */
+    bool open(const QString &path, const QAudioFormat &format);
+    /*!
+     * Write the left data, patch the header and close the file.
+     */
+    void close();
+    /*!
+     * Wake up the writer when new data is available.
+     */
+    void wakeUp();
+
+    /*!
+     * Get the size of the written samples.
+     */
+    inline qint64 size() const { return m_size; }
+    /*!
+     * Get the size of the wav header.
+     */
+    static int headerSize();
+
+private:
+    /*!
+     * Thread run now.
+     */
+    virtual void run() override final;
+    /*!
+     * Write all available data of the ring buffer.
+     */
+    void drain();
+    /*!
+     * Write the wav header by the size of samples.
+     */
+    bool writeHeader();
+
+    std::atomic<bool> m_running;
+    MusicAudioRingBuffer *m_buffer;
+    QFile m_file;
+    QAudioFormat m_format;
+    qint64 m_size;
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+
+};
+
+#endif // MUSICAUDIORECORDERWRITER_H
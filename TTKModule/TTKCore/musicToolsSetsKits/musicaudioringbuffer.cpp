@@ -0,0 +1,84 @@
+#include "musicaudioringbuffer.h"
+
+static inline quint32 loadAcquire(const QAtomicInt &value)
+{
+#if TTK_QT_VERSION_CHECK(5,0,0)
+    return quint32(value.loadAcquire());
+#else
+    return quint32(const_cast<QAtomicInt&>(value).fetchAndAddAcquire(0));
+#endif
+}
+
+static inline void storeRelease(QAtomicInt &value, quint32 v)
+{
+#if TTK_QT_VERSION_CHECK(5,0,0)
+    value.storeRelease(int(v));
+#else
+    value.fetchAndStoreRelease(int(v));
+#endif
+}
+
+
+MusicAudioRingBuffer::MusicAudioRingBuffer(int capacity)
+    : m_head(0),
+      m_tail(0)
+{
+    int size = 1;
+    while(size < capacity)
+    {
+        size <<= 1;
+    }
+
+    m_buffer.resize(size);
+    m_mask = size - 1;
+}
+
+int MusicAudioRingBuffer::write(const char *data, int size)
+{
+    // positions only grow, the unsigned difference stays right when they wrap
+    const quint32 head = loadAcquire(m_head);
+    const quint32 tail = loadAcquire(m_tail);
+    const int count = qMin<int>(size, capacity() - int(head - tail));
+    if(count <= 0)
+    {
+        return 0;
+    }
+
+    const int offset = head & m_mask;
+    const int first = qMin(count, capacity() - offset);
+    memcpy(m_buffer.data() + offset, data, first);
+    memcpy(m_buffer.data(), data + first, count - first);
+
+    storeRelease(m_head, head + count);
+    return count;
+}
+
+int MusicAudioRingBuffer::read(char *data, int size)
+{
+    const quint32 tail = loadAcquire(m_tail);
+    const quint32 head = loadAcquire(m_head);
+    const int count = qMin<int>(size, int(head - tail));
+    if(count <= 0)
+    {
+        return 0;
+    }
+
+    const int offset = tail & m_mask;
+    const int first = qMin(count, capacity() - offset);
+    memcpy(data, m_buffer.constData() + offset, first);
+    memcpy(data + first, m_buffer.constData(), count - first);
+
+    storeRelease(m_tail, tail + count);
+    return count;
+}
+
+int MusicAudioRingBuffer::available() const
+{
+    return int(loadAcquire(m_head) - loadAcquire(m_tail));
+}
+
+void MusicAudioRingBuffer::clear()
+{
+    storeRelease(m_head, 0);
+    storeRelease(m_tail, 0);
+}
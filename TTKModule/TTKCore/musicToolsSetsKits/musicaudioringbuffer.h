@@ -0,0 +1,68 @@
+#ifndef MUSICAUDIORINGBUFFER_H
+#define MUSICAUDIORINGBUFFER_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QAtomicInt>
+#include "musicglobaldefine.h"
+
+/*! @brief The class of the audio single producer single consumer ring buffer.
+ * Producer and consumer only publish their own position, so neither side
+ * ever waits for a lock.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicAudioRingBuffer
+{
+    TTK_DECLARE_MODULE(MusicAudioRingBuffer)
+public:
+    /*!
+     * Object constructor by capacity, rounded up to a power of two.
+     */
+    explicit MusicAudioRingBuffer(int capacity);
+
+    /*!
+     * Write data by producer, return the written size.
+     */
+    int write(const char *data, int size);
+    /*!
+     * Read data by consumer, return the read size.
+     */
+    int read(char *data, int size);
+
+    /*!
+     * Get the size of the readable data.
+     */
+    int available() const;
+    /*!
+     * Get the buffer capacity.
+     */
+    inline int capacity() const { return m_buffer.size(); }
+    /*!
+     * Drop all data, only while producer and consumer are idle.
+     */
+    void clear();
+
+private:
+    QByteArray m_buffer;
+    quint32 m_mask;
+    QAtomicInt m_head, m_tail;
+
+};
+
+#endif // MUSICAUDIORINGBUFFER_H
@@ -4,6 +4,7 @@
 #include "musictkplconfigmanager.h"
 #include "musicsongscontainerwidget.h"
 #include "musicfileutils.h"
+#include "musicpersistservice.h"
 
 MusicAbstractBackup::MusicAbstractBackup(int interval, QObject *parent)
     : QObject(parent)
@@ -45,19 +46,16 @@ void MusicPlaylistBackupModule::runBackup()
 
     dir.cd(child);
 
-    MusicTKPLConfigManager manager;
-    if(!manager.load(QString("%1/%2%3").arg(dir.absolutePath()).arg(TTKDateTime::currentTimestamp()).arg(TKF_FILE)))
-    {
-        return;
-    }
-
-    manager.writeBuffer(MusicApplication::instance()->m_songTreeWidget->items());
-
+    // the new backup is written in background, so keep one slot for it
     const QFileInfoList &fileList = dir.entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
-    if(fileList.count() > 7)
+    if(fileList.count() >= 7)
     {
         QFile::remove(fileList.front().absoluteFilePath());
     }
+
+    const QString &path = QString("%1/%2%3").arg(dir.absolutePath()).arg(TTKDateTime::currentTimestamp()).arg(TKF_FILE);
+    const MusicSongItemList items = MusicApplication::instance()->m_songTreeWidget->items();
+    G_PERSIST_PTR->save(path, [items]() { return MusicTKPLConfigManager::toByteArray(items); }, false);
 }
 
 
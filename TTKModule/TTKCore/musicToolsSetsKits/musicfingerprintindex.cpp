@@ -0,0 +1,234 @@
+#include "musicfingerprintindex.h"
+#include "ttksavefile.h"
+
+#include <QDataStream>
+#include <climits>
+#include <algorithm>
+
+static constexpr quint32 INDEX_MAGIC = 0x464B5454;
+static constexpr quint32 INDEX_VERSION = 1;
+static constexpr int MAX_POSTING_COUNT = 4096;
+static constexpr int MIN_MATCH_SCORE = 6;
+
+/*! @brief The class of the fingerprint index file header.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct MusicFingerprintHeader
+{
+    quint32 m_magic;
+    quint32 m_version;
+    quint32 m_tableSize;
+    quint32 m_count;
+};
+
+static inline qint64 alignSize(qint64 size)
+{
+    return (size + 3) & ~qint64(3);
+}
+
+static inline bool hashLess(const MusicFingerprintIndex::Entry &a, const MusicFingerprintIndex::Entry &b)
+{
+    return a.m_hash < b.m_hash;
+}
+
+static inline quint64 voteKey(quint32 song, qint32 offset)
+{
+    return (quint64(song) << 32) | quint32(offset);
+}
+
+
+MusicFingerprintIndex::MusicFingerprintIndex()
+    : m_data(nullptr),
+      m_entries(nullptr),
+      m_count(0)
+{
+
+}
+
+MusicFingerprintIndex::~MusicFingerprintIndex()
+{
+    close();
+}
+
+bool MusicFingerprintIndex::load(const QString &path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if(!m_file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    m_data = size >= qint64(sizeof(MusicFingerprintHeader)) ? m_file.map(0, size) : nullptr;
+    if(!m_data)
+    {
+        close();
+        return false;
+    }
+
+    MusicFingerprintHeader header;
+    memcpy(&header, m_data, sizeof(header));
+
+    // the table must fit the file before it is aligned, the table data is an int sized byte array
+    const qint64 tableSize = header.m_tableSize;
+    if(header.m_magic != INDEX_MAGIC || header.m_version != INDEX_VERSION || tableSize > size - qint64(sizeof(header)) || tableSize > INT_MAX)
+    {
+        TTK_ERROR_STREAM("Fingerprint index file is broken:" << path);
+        close();
+        return false;
+    }
+
+    const qint64 offset = sizeof(header) + alignSize(tableSize);
+    if(offset + qint64(header.m_count) * qint64(sizeof(Entry)) > size)
+    {
+        TTK_ERROR_STREAM("Fingerprint index file is broken:" << path);
+        close();
+        return false;
+    }
+
+    const QByteArray &table = QByteArray::fromRawData(TTKReinterpretCast(const char*, m_data + sizeof(header)), header.m_tableSize);
+    QDataStream stream(table);
+
+    quint32 count = 0;
+    stream >> count;
+    for(quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+    {
+        MusicFingerprintSong song;
+        stream >> song.m_path >> song.m_size >> song.m_modified;
+        m_songs << song;
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        TTK_ERROR_STREAM("Fingerprint index file is broken:" << path);
+        close();
+        return false;
+    }
+
+    m_entries = TTKReinterpretCast(const Entry*, m_data + offset);
+    m_count = header.m_count;
+    return true;
+}
+
+void MusicFingerprintIndex::close()
+{
+    if(m_data)
+    {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+    }
+
+    m_file.close();
+    m_entries = nullptr;
+    m_count = 0;
+    m_songs.clear();
+}
+
+bool MusicFingerprintIndex::find(const MusicFingerprintHashList &hashes, MusicFingerprintMatch *match) const
+{
+    if(isEmpty())
+    {
+        return false;
+    }
+
+    QHash<quint64, int> votes;
+    const Entry *end = m_entries + m_count;
+    for(const MusicFingerprintHash &hash : qAsConst(hashes))
+    {
+        const Entry key = {hash.m_hash, 0, 0};
+        const Entry *lower = std::lower_bound(m_entries, end, key, hashLess);
+        const Entry *upper = std::upper_bound(lower, end, key, hashLess);
+        if(upper - lower > MAX_POSTING_COUNT)
+        {
+            // too common to tell songs apart
+            continue;
+        }
+
+        for(const Entry *it = lower; it != upper; ++it)
+        {
+            ++votes[voteKey(it->m_song, qint32(it->m_time) - qint32(hash.m_time))];
+        }
+    }
+
+    // the frames of recording and song are not aligned, so the next offset counts too
+    QHash<quint32, QPair<int, qint32>> scores;
+    for(auto it = votes.constBegin(); it != votes.constEnd(); ++it)
+    {
+        const quint32 song = it.key() >> 32;
+        const qint32 offset = qint32(it.key() & 0xFFFFFFFF);
+        const int score = it.value() + votes.value(voteKey(song, offset + 1));
+
+        QPair<int, qint32> &best = scores[song];
+        if(score > best.first)
+        {
+            best = qMakePair(score, offset);
+        }
+    }
+
+    quint32 song = 0;
+    int first = 0, second = 0;
+    for(auto it = scores.constBegin(); it != scores.constEnd(); ++it)
+    {
+        if(it.value().first > first)
+        {
+            second = first;
+            first = it.value().first;
+            song = it.key();
+        }
+        else if(it.value().first > second)
+        {
+            second = it.value().first;
+        }
+    }
+
+    if(first < MIN_MATCH_SCORE || first < 2 * second || song >= quint32(m_songs.count()))
+    {
+        return false;
+    }
+
+    match->m_path = m_songs[song].m_path;
+    match->m_position = qMax(0, scores[song].second) * MusicAudioFingerprint::timeUnit();
+    match->m_score = first;
+    return true;
+}
+
+bool MusicFingerprintIndex::save(const QString &path, const MusicFingerprintSongList &songs, QVector<Entry> &entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+    {
+        if(a.m_hash != b.m_hash)
+        {
+            return a.m_hash < b.m_hash;
+        }
+        return a.m_song != b.m_song ? a.m_song < b.m_song : a.m_time < b.m_time;
+    });
+
+    QByteArray table;
+    QDataStream stream(&table, QIODevice::WriteOnly);
+    stream << quint32(songs.count());
+    for(const MusicFingerprintSong &song : qAsConst(songs))
+    {
+        stream << song.m_path << song.m_size << song.m_modified;
+    }
+
+    MusicFingerprintHeader header;
+    header.m_magic = INDEX_MAGIC;
+    header.m_version = INDEX_VERSION;
+    header.m_tableSize = table.size();
+    header.m_count = entries.count();
+    table.append(QByteArray(TTKStaticCast(int, alignSize(table.size()) - table.size()), 0));
+
+    TTKSaveFile file(path);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    file.write(TTKReinterpretCast(const char*, &header), sizeof(header));
+    file.write(table);
+    file.write(TTKReinterpretCast(const char*, entries.constData()), entries.count() * sizeof(Entry));
+    file.close();
+    return file.isCommitted();
+}
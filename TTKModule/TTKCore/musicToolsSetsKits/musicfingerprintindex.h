@@ -0,0 +1,118 @@
+#ifndef MUSICFINGERPRINTINDEX_H
+#define MUSICFINGERPRINTINDEX_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QFile>
+#include "musicaudiofingerprint.h"
+
+/*! @brief The class of the fingerprint indexed song item.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct TTK_MODULE_EXPORT MusicFingerprintSong
+{
+    QString m_path;
+    qint64 m_size;
+    qint64 m_modified;
+};
+TTK_DECLARE_LIST(MusicFingerprintSong);
+
+/*! @brief The class of the fingerprint match item.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct TTK_MODULE_EXPORT MusicFingerprintMatch
+{
+    QString m_path;
+    qint64 m_position;
+    int m_score;
+};
+
+/*! @brief The class of the fingerprint inverted index.
+ * Entries are sorted by hash and mapped from disk, so a lookup is a binary search
+ * without loading the index into memory.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicFingerprintIndex
+{
+    TTK_DECLARE_MODULE(MusicFingerprintIndex)
+public:
+    struct Entry
+    {
+        quint32 m_hash;
+        quint32 m_song;
+        quint32 m_time;
+    };
+
+    /*!
+     * Object constructor.
+     */
+    MusicFingerprintIndex();
+    /*!
+     * Object destructor.
+     */
+    ~MusicFingerprintIndex();
+
+    /*!
+     * Map the index file by given path.
+     */
+    bool load(const QString &path);
+    /*!
+     * Unmap the index file.
+     */
+    void close();
+
+    /*!
+     * Check the index has no entry.
+     */
+    inline bool isEmpty() const { return m_count == 0; }
+    /*!
+     * Get the indexed songs.
+     */
+    inline const MusicFingerprintSongList &songs() const { return m_songs; }
+    /*!
+     * Get the sorted entries.
+     */
+    inline const Entry *entries() const { return m_entries; }
+    /*!
+     * Get the entries count.
+     */
+    inline int count() const { return m_count; }
+
+    /*!
+     * Find the song matched the most hashes at the same time offset.
+     */
+    bool find(const MusicFingerprintHashList &hashes, MusicFingerprintMatch *match) const;
+
+    /*!
+     * Sort the entries and save the index atomically by given path.
+     */
+    static bool save(const QString &path, const MusicFingerprintSongList &songs, QVector<Entry> &entries);
+
+private:
+    QFile m_file;
+    uchar *m_data;
+    const Entry *m_entries;
+    int m_count;
+    MusicFingerprintSongList m_songs;
+
+};
+
+Q_DECLARE_TYPEINFO(MusicFingerprintIndex::Entry, Q_PRIMITIVE_TYPE);
+
+#endif // MUSICFINGERPRINTINDEX_H
@@ -0,0 +1,105 @@
+#include "musicfingerprintindexthread.h"
+#include "musicfingerprintindex.h"
+
+#include <QFileInfo>
+
+static constexpr int MAX_INDEX_SECONDS = 10 * 60;
+
+MusicFingerprintIndexThread::MusicFingerprintIndexThread(QObject *parent)
+    : TTKAbstractThread(parent)
+{
+
+}
+
+MusicFingerprintIndexThread::~MusicFingerprintIndexThread()
+{
+    stop();
+}
+
+void MusicFingerprintIndexThread::setFilePaths(const QStringList &paths)
+{
+    m_paths = paths;
+    m_paths.removeDuplicates();
+}
+
+void MusicFingerprintIndexThread::run()
+{
+    MusicFingerprintIndex index;
+    index.load(FINGERPRINT_PATH_FULL);
+
+    const MusicFingerprintSongList &olds = index.songs();
+    QHash<QString, int> oldIndexs;
+    for(int i = 0; i < olds.count(); ++i)
+    {
+        oldIndexs.insert(olds[i].m_path, i);
+    }
+
+    MusicFingerprintSongList songs;
+    QVector<int> songIndexs(olds.count(), -1);
+    QStringList pending;
+
+    for(const QString &path : qAsConst(m_paths))
+    {
+        const QFileInfo fin(path);
+        if(!fin.isFile())
+        {
+            continue;
+        }
+
+        const int i = oldIndexs.value(path, -1);
+        if(i != -1 && olds[i].m_size == fin.size() && olds[i].m_modified == fin.lastModified().toMSecsSinceEpoch())
+        {
+            songIndexs[i] = songs.count();
+            songs << olds[i];
+        }
+        else
+        {
+            pending << path;
+        }
+    }
+
+    if(pending.isEmpty() && songs.count() == olds.count())
+    {
+        return;
+    }
+
+    QVector<MusicFingerprintIndex::Entry> entries;
+    entries.reserve(index.count());
+    for(int i = 0; i < index.count(); ++i)
+    {
+        MusicFingerprintIndex::Entry entry = index.entries()[i];
+        if(entry.m_song < quint32(songIndexs.count()) && songIndexs[entry.m_song] != -1)
+        {
+            entry.m_song = songIndexs[entry.m_song];
+            entries << entry;
+        }
+    }
+    index.close();
+
+    for(const QString &path : qAsConst(pending))
+    {
+        if(!m_running)
+        {
+            break;
+        }
+
+        // files fail to decode are kept too, so they are not tried again
+        const QFileInfo fin(path);
+        MusicFingerprintSong song;
+        song.m_path = path;
+        song.m_size = fin.size();
+        song.m_modified = fin.lastModified().toMSecsSinceEpoch();
+
+        for(const MusicFingerprintHash &hash : MusicAudioFingerprint::fromFile(path, MAX_INDEX_SECONDS))
+        {
+            MusicFingerprintIndex::Entry entry;
+            entry.m_hash = hash.m_hash;
+            entry.m_song = songs.count();
+            entry.m_time = hash.m_time;
+            entries << entry;
+        }
+        songs << song;
+    }
+
+    MusicFingerprintIndex::save(FINGERPRINT_PATH_FULL, songs, entries);
+}
@@ -0,0 +1,275 @@
+#include "musicnetworktestrequest.h"
+
+#include <algorithm>
+
+static constexpr int SAMPLE_TIMEOUT = 10 * TTK_DN_S2MS;
+static constexpr int READ_SIZE = 64 * 1024;
+
+/*!
+ * Nearest rank percentile of the values.
+ */
+static qint64 percentile(QVector<qint64> values, int percent)
+{
+    if(values.isEmpty())
+    {
+        return 0;
+    }
+
+    std::sort(values.begin(), values.end());
+    return values[qBound(0, (percent * values.count() + 99) / 100 - 1, values.count() - 1)];
+}
+
+
+MusicNetworkTestRequest::MusicNetworkTestRequest(QObject *parent)
+    : MusicAbstractNetwork(parent),
+      m_sampleCount(5),
+      m_streamCount(3),
+      m_sample(0),
+      m_maxSize(4 * TTK_SN_MB2B),
+      m_bytes(0),
+      m_firstByte(0),
+      m_success(false)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, SIGNAL(timeout()), SLOT(sampleTimeout()));
+    connect(&m_socket, SIGNAL(connected()), SLOT(socketConnected()));
+    QtSocketErrorVoidConnect(&m_socket, this, socketError, TTK_SLOT);
+}
+
+void MusicNetworkTestRequest::setUrl(const QString &url)
+{
+    // a bare host name is tested by its index page
+    m_url = QUrl::fromUserInput(url);
+}
+
+void MusicNetworkTestRequest::setSampleCount(int count)
+{
+    m_sampleCount = qMax(1, count);
+}
+
+void MusicNetworkTestRequest::setStreamCount(int count)
+{
+    m_streamCount = qMax(1, count);
+}
+
+void MusicNetworkTestRequest::setMaxSize(qint64 size)
+{
+    m_maxSize = qMax<qint64>(1, size);
+}
+
+void MusicNetworkTestRequest::startToRequest()
+{
+    deleteAll();
+
+    m_interrupt = false;
+    m_stateCode = TTK::NetworkCode::Query;
+    m_sample = 0;
+    m_connects.clear();
+    m_firstBytes.clear();
+    m_speeds.clear();
+    m_result = MusicNetworkTestResult();
+
+    if(!m_url.isValid() || m_url.host().isEmpty())
+    {
+        finishTest();
+        return;
+    }
+
+    startSample();
+}
+
+void MusicNetworkTestRequest::deleteAll()
+{
+    m_timer.stop();
+    m_socket.abort();
+
+    const QList<QNetworkReply*> replies = m_streams.keys();
+    m_streams.clear();
+
+    for(QNetworkReply *reply : qAsConst(replies))
+    {
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+
+    MusicAbstractNetwork::deleteAll();
+}
+
+void MusicNetworkTestRequest::downLoadFinished()
+{
+    QNetworkReply *reply = TTKObjectCast(QNetworkReply*, sender());
+    if(!reply || !m_streams.contains(reply))
+    {
+        return;
+    }
+
+    const Stream stream = m_streams.take(reply);
+    if((reply->error() == QNetworkReply::NoError || stream.m_enough) && stream.m_firstByte >= 0)
+    {
+        m_success = true;
+        m_bytes += stream.m_bytes;
+        m_firstByte = m_firstByte < 0 ? stream.m_firstByte : qMin(m_firstByte, stream.m_firstByte);
+        m_firstBytes << stream.m_firstByte;
+    }
+    reply->deleteLater();
+
+    if(!m_streams.isEmpty())
+    {
+        return;
+    }
+
+    m_timer.stop();
+    if(m_success)
+    {
+        // sustained speed of all streams together, the wait for the first byte excluded
+        const qint64 elapsed = qMax<qint64>(1, m_clock.elapsed() - m_firstByte);
+        m_speeds << m_bytes * TTK_DN_S2MS / elapsed;
+    }
+    finishSample(m_success);
+}
+
+void MusicNetworkTestRequest::startSample()
+{
+    if(m_interrupt)
+    {
+        return;
+    }
+
+    if(m_sample >= m_sampleCount)
+    {
+        finishTest();
+        return;
+    }
+
+    // host lookup is cached after the first sample, so later samples measure the connect only
+    const bool ssl = m_url.scheme() == HTTPS_PROTOCOL_PREFIX;
+    m_timer.start(SAMPLE_TIMEOUT);
+    m_clock.start();
+    m_socket.abort();
+    m_socket.connectToHost(m_url.host(), m_url.port(ssl ? 443 : 80));
+}
+
+void MusicNetworkTestRequest::socketConnected()
+{
+    m_connects << m_clock.elapsed();
+    m_socket.abort();
+    startStreams();
+}
+
+void MusicNetworkTestRequest::socketError()
+{
+    if(!m_timer.isActive())
+    {
+        return;
+    }
+
+    TTK_ERROR_STREAM("Network test connect error:" << m_socket.errorString());
+    m_timer.stop();
+    m_socket.abort();
+    finishSample(false);
+}
+
+void MusicNetworkTestRequest::readData()
+{
+    QNetworkReply *reply = TTKObjectCast(QNetworkReply*, sender());
+    if(!reply || !m_streams.contains(reply))
+    {
+        return;
+    }
+
+    Stream &stream = m_streams[reply];
+    if(stream.m_firstByte < 0)
+    {
+        stream.m_firstByte = m_clock.elapsed();
+    }
+
+    char data[READ_SIZE];
+    qint64 size = 0;
+    while((size = reply->read(data, READ_SIZE)) > 0)
+    {
+        stream.m_bytes += size;
+    }
+
+    if(stream.m_bytes >= m_maxSize && !stream.m_enough)
+    {
+        stream.m_enough = true;
+        reply->abort();
+    }
+}
+
+void MusicNetworkTestRequest::sampleTimeout()
+{
+    m_socket.abort();
+    if(m_streams.isEmpty())
+    {
+        finishSample(false);
+        return;
+    }
+
+    // streams still running count with the bytes received so far
+    const QList<QNetworkReply*> replies = m_streams.keys();
+    for(QNetworkReply *reply : qAsConst(replies))
+    {
+        if(m_streams.contains(reply))
+        {
+            m_streams[reply].m_enough = true;
+            reply->abort();
+        }
+    }
+}
+
+void MusicNetworkTestRequest::startStreams()
+{
+    m_bytes = 0;
+    m_firstByte = -1;
+    m_success = false;
+    m_clock.restart();
+
+    for(int i = 0; i < m_streamCount; ++i)
+    {
+        QNetworkRequest request;
+        request.setUrl(m_url);
+        TTK::setSslConfiguration(&request);
+        TTK::makeUserAgentHeader(&request);
+#if TTK_QT_VERSION_CHECK(5,6,0)
+        request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+#endif
+
+        QNetworkReply *reply = m_manager.get(request);
+        connect(reply, SIGNAL(readyRead()), SLOT(readData()));
+        connect(reply, SIGNAL(finished()), SLOT(downLoadFinished()));
+
+        Stream stream;
+        stream.m_firstByte = -1;
+        stream.m_bytes = 0;
+        stream.m_enough = false;
+        m_streams.insert(reply, stream);
+    }
+}
+
+void MusicNetworkTestRequest::finishSample(bool success)
+{
+    if(!success)
+    {
+        ++m_result.m_failed;
+    }
+
+    ++m_sample;
+    // the finished reply is still on the stack, start the next sample later
+    QMetaObject::invokeMethod(this, "startSample", Qt::QueuedConnection);
+}
+
+void MusicNetworkTestRequest::finishTest()
+{
+    m_result.m_samples = m_speeds.count();
+    m_result.m_connect = percentile(m_connects, 50);
+    m_result.m_connectHigh = percentile(m_connects, 90);
+    m_result.m_firstByte = percentile(m_firstBytes, 50);
+    m_result.m_firstByteHigh = percentile(m_firstBytes, 90);
+    m_result.m_speed = percentile(m_speeds, 50);
+    m_result.m_speedLow = percentile(m_speeds, 10);
+
+    m_stateCode = m_result.m_samples > 0 ? TTK::NetworkCode::Success : TTK::NetworkCode::Error;
+    Q_EMIT networkConnectionTestChanged(m_result.m_samples > 0);
+}
@@ -0,0 +1,171 @@
+#ifndef MUSICNETWORKTESTREQUEST_H
+#define MUSICNETWORKTESTREQUEST_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QTimer>
+#include <QTcpSocket>
+#include <QElapsedTimer>
+#include "musicabstractnetwork.h"
+
+/*! @brief The class of the network test result item.
+ * Times are in milliseconds and speeds in bytes per second.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct TTK_MODULE_EXPORT MusicNetworkTestResult
+{
+    int m_samples;
+    int m_failed;
+    qint64 m_connect;
+    qint64 m_connectHigh;
+    qint64 m_firstByte;
+    qint64 m_firstByteHigh;
+    qint64 m_speed;
+    qint64 m_speedLow;
+
+    MusicNetworkTestResult()
+        : m_samples(0),
+          m_failed(0),
+          m_connect(0),
+          m_connectHigh(0),
+          m_firstByte(0),
+          m_firstByteHigh(0),
+          m_speed(0),
+          m_speedLow(0)
+    {
+
+    }
+};
+
+/*! @brief The class of the network throughput and latency test request.
+ * Every sample measures the tcp connect time, then downloads the url by
+ * concurrent streams for the time to first byte and the sustained speed.
+ * Results are the median and the worse percentile of all samples.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicNetworkTestRequest : public MusicAbstractNetwork
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicNetworkTestRequest)
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicNetworkTestRequest(QObject *parent = nullptr);
+
+    /*!
+     * Set current test url, host name is tested by http.
+     */
+    void setUrl(const QString &url);
+    /*!
+     * Set the count of samples.
+     */
+    void setSampleCount(int count);
+    /*!
+     * Set the count of concurrent streams of one sample.
+     */
+    void setStreamCount(int count);
+    /*!
+     * Set the max bytes to download by one stream.
+     */
+    void setMaxSize(qint64 size);
+
+    /*!
+     * Start to test the url.
+     */
+    void startToRequest();
+    /*!
+     * Get the test result.
+     */
+    inline const MusicNetworkTestResult &result() const { return m_result; }
+
+    /*!
+     * Release the network object.
+     */
+    virtual void deleteAll() override;
+
+Q_SIGNALS:
+    /*!
+     * Network connection test changed.
+     */
+    void networkConnectionTestChanged(bool state);
+
+public Q_SLOTS:
+    /*!
+     * Download data from net finished.
+     */
+    virtual void downLoadFinished() override;
+
+private Q_SLOTS:
+    /*!
+     * Start the next sample.
+     */
+    void startSample();
+    /*!
+     * Tcp socket connected.
+     */
+    void socketConnected();
+    /*!
+     * Tcp socket connect error.
+     */
+    void socketError();
+    /*!
+     * Read the received data of stream.
+     */
+    void readData();
+    /*!
+     * Sample run out of time.
+     */
+    void sampleTimeout();
+
+private:
+    struct Stream
+    {
+        qint64 m_firstByte;
+        qint64 m_bytes;
+        bool m_enough;
+    };
+
+    /*!
+     * Start the concurrent streams of the sample.
+     */
+    void startStreams();
+    /*!
+     * Finish the current sample.
+     */
+    void finishSample(bool success);
+    /*!
+     * Finish the test and compute the result.
+     */
+    void finishTest();
+
+    QUrl m_url;
+    int m_sampleCount, m_streamCount, m_sample;
+    qint64 m_maxSize, m_bytes, m_firstByte;
+    bool m_success;
+    QTcpSocket m_socket;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    QHash<QNetworkReply*, Stream> m_streams;
+    QVector<qint64> m_connects, m_firstBytes, m_speeds;
+    MusicNetworkTestResult m_result;
+
+};
+
+#endif // MUSICNETWORKTESTREQUEST_H
@@ -0,0 +1,156 @@
+#include "musicnetworktestserver.h"
+
+#include "qhttpserver/qhttpserver.h"
+#include "qhttpserver/qhttprequest.h"
+#include "qhttpserver/qhttpresponse.h"
+
+static constexpr int WRITE_INTERVAL = 10;
+static constexpr int CHUNK_SIZE = 1024 * 1024;
+static constexpr qint64 MAX_RESPONSE_SIZE = 1024 * 1024 * 1024;
+
+MusicNetworkTestServer::MusicNetworkTestServer(QObject *parent)
+    : QObject(parent),
+      m_server(nullptr),
+      m_bandwidth(0),
+      m_latency(0)
+{
+    m_timer.setInterval(WRITE_INTERVAL);
+    connect(&m_timer, SIGNAL(timeout()), SLOT(writeData()));
+}
+
+MusicNetworkTestServer::~MusicNetworkTestServer()
+{
+    close();
+}
+
+void MusicNetworkTestServer::setBandwidth(qint64 bytes)
+{
+    m_bandwidth = qMax<qint64>(0, bytes);
+}
+
+void MusicNetworkTestServer::setLatency(int msec)
+{
+    m_latency = qMax(0, msec);
+}
+
+bool MusicNetworkTestServer::listen(quint16 port)
+{
+    close();
+
+    m_server = new QHttpServer(this);
+    connect(m_server, SIGNAL(newRequest(QHttpRequest*,QHttpResponse*)), SLOT(handleRequest(QHttpRequest*,QHttpResponse*)));
+
+    if(!m_server->listen(QHostAddress::LocalHost, port))
+    {
+        TTK_ERROR_STREAM("Network test server listen error, port:" << port);
+        close();
+        return false;
+    }
+
+    m_clock.start();
+    return true;
+}
+
+void MusicNetworkTestServer::close()
+{
+    m_timer.stop();
+    m_streams.clear();
+
+    if(m_server)
+    {
+        m_server->close();
+        m_server->deleteLater();
+        m_server = nullptr;
+    }
+}
+
+QString MusicNetworkTestServer::url(qint64 size) const
+{
+    return QString("http://127.0.0.1:%1/bytes/%2").arg(m_server ? m_server->serverPort() : 0).arg(size);
+}
+
+void MusicNetworkTestServer::handleRequest(QHttpRequest *request, QHttpResponse *response)
+{
+    const QString &path = request->path();
+    const qint64 size = path.section(TTK_SEPARATOR, 2, 2).toLongLong();
+
+    if(!path.startsWith("/bytes/") || size <= 0 || size > MAX_RESPONSE_SIZE)
+    {
+        response->writeHead(QHttpResponse::STATUS_NOT_FOUND);
+        response->end("Resource not found");
+        return;
+    }
+
+    response->setHeader("Content-Type", "application/octet-stream");
+    response->setHeader("Content-Length", QString::number(size));
+
+    Stream stream;
+    stream.m_response = response;
+    stream.m_size = size;
+    stream.m_remaining = size;
+    stream.m_start = m_clock.elapsed() + m_latency;
+    stream.m_head = false;
+    m_streams << stream;
+
+    if(!m_timer.isActive())
+    {
+        m_timer.start();
+    }
+}
+
+void MusicNetworkTestServer::writeData()
+{
+    static const QByteArray data(CHUNK_SIZE, 0);
+
+    const qint64 now = m_clock.elapsed();
+    for(auto it = m_streams.begin(); it != m_streams.end();)
+    {
+        Stream &stream = *it;
+        if(!stream.m_response)
+        {
+            // client has gone, the connection deleted the response
+            it = m_streams.erase(it);
+            continue;
+        }
+
+        if(now < stream.m_start)
+        {
+            ++it;
+            continue;
+        }
+
+        if(!stream.m_head)
+        {
+            stream.m_response->writeHead(QHttpResponse::STATUS_OK);
+            stream.m_head = true;
+        }
+
+        // sent in proportion to the elapsed time, timer ticks are not exact
+        qint64 size = stream.m_remaining;
+        if(m_bandwidth > 0)
+        {
+            const qint64 allowed = (now - stream.m_start) * m_bandwidth / TTK_DN_S2MS;
+            size = qMin(stream.m_remaining, allowed - (stream.m_size - stream.m_remaining));
+        }
+
+        size = qMin<qint64>(size, CHUNK_SIZE);
+        if(size > 0)
+        {
+            stream.m_response->write(size == CHUNK_SIZE ? data : data.left(size));
+            stream.m_remaining -= size;
+        }
+
+        if(stream.m_remaining == 0)
+        {
+            stream.m_response->end();
+            it = m_streams.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    if(m_streams.isEmpty())
+    {
+        m_timer.stop();
+    }
+}
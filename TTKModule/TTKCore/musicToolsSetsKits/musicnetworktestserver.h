@@ -0,0 +1,101 @@
+#ifndef MUSICNETWORKTESTSERVER_H
+#define MUSICNETWORKTESTSERVER_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QTimer>
+#include <QPointer>
+#include <QElapsedTimer>
+#include "musicglobaldefine.h"
+
+class QHttpServer;
+class QHttpRequest;
+class QHttpResponse;
+
+/*! @brief The class of the local network test server.
+ * Requests of /bytes/<size> are answered with size bytes after the latency
+ * and paced to the bandwidth, so the network test can run offline.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicNetworkTestServer : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicNetworkTestServer)
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicNetworkTestServer(QObject *parent = nullptr);
+    /*!
+     * Object destructor.
+     */
+    ~MusicNetworkTestServer();
+
+    /*!
+     * Set bytes per second of every response, zero means unlimited.
+     */
+    void setBandwidth(qint64 bytes);
+    /*!
+     * Set milliseconds before the response starts.
+     */
+    void setLatency(int msec);
+
+    /*!
+     * Listen on local host by port, zero picks a free port.
+     */
+    bool listen(quint16 port = 0);
+    /*!
+     * Stop listening and drop the running responses.
+     */
+    void close();
+    /*!
+     * Get the url of the given size bytes.
+     */
+    QString url(qint64 size) const;
+
+private Q_SLOTS:
+    /*!
+     * Handle the new request.
+     */
+    void handleRequest(QHttpRequest *request, QHttpResponse *response);
+    /*!
+     * Write the next part of all responses.
+     */
+    void writeData();
+
+private:
+    struct Stream
+    {
+        QPointer<QHttpResponse> m_response;
+        qint64 m_size;
+        qint64 m_remaining;
+        qint64 m_start;
+        bool m_head;
+    };
+
+    QHttpServer *m_server;
+    qint64 m_bandwidth;
+    int m_latency;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    QList<Stream> m_streams;
+
+};
+
+#endif // MUSICNETWORKTESTSERVER_H
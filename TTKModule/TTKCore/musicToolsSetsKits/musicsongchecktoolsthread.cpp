@@ -9,6 +9,11 @@ MusicSongCheckToolsRenameThread::MusicSongCheckToolsRenameThread(QObject *parent
 
 }
 
+MusicSongCheckToolsRenameThread::~MusicSongCheckToolsRenameThread()
+{
+    stop();
+}
+
 void MusicSongCheckToolsRenameThread::setRenameSongs(MusicSongList *songs)
 {
     m_songItems = songs;
@@ -68,6 +73,11 @@ MusicSongCheckToolsDuplicateThread::MusicSongCheckToolsDuplicateThread(QObject *
     m_songItems = nullptr;
 }
 
+MusicSongCheckToolsDuplicateThread::~MusicSongCheckToolsDuplicateThread()
+{
+    stop();
+}
+
 void MusicSongCheckToolsDuplicateThread::setDuplicateSongs(MusicSongList *songs)
 {
     m_songItems = songs;
@@ -123,6 +133,11 @@ MusicSongCheckToolsQualityThread::MusicSongCheckToolsQualityThread(QObject *pare
     m_songItems = nullptr;
 }
 
+MusicSongCheckToolsQualityThread::~MusicSongCheckToolsQualityThread()
+{
+    stop();
+}
+
 void MusicSongCheckToolsQualityThread::setQualitySongs(MusicSongList *songs)
 {
     m_songItems = songs;
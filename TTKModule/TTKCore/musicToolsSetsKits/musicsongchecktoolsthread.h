@@ -34,6 +34,10 @@ public:
      * Object constructor.
      */
     explicit MusicSongCheckToolsRenameThread(QObject *parent = nullptr);
+    /*!
+     * Object destructor.
+     */
+    ~MusicSongCheckToolsRenameThread();
 
     /*!
      * Set music song check tool mode.
@@ -85,6 +89,10 @@ public:
      * Object constructor.
      */
     explicit MusicSongCheckToolsDuplicateThread(QObject *parent = nullptr);
+    /*!
+     * Object destructor.
+     */
+    ~MusicSongCheckToolsDuplicateThread();
 
     /*!
      * Set music song check tool mode.
@@ -136,6 +144,10 @@ public:
      * Object constructor.
      */
     explicit MusicSongCheckToolsQualityThread(QObject *parent = nullptr);
+    /*!
+     * Object destructor.
+     */
+    ~MusicSongCheckToolsQualityThread();
 
     /*!
      * Set find file path by given path.
@@ -8,6 +8,11 @@ MusicSongsManagerThread::MusicSongsManagerThread(QObject *parent)
 
 }
 
+MusicSongsManagerThread::~MusicSongsManagerThread()
+{
+    stop();
+}
+
 void MusicSongsManagerThread::setFindFilePath(const QString &path)
 {
     setFindFilePath(QStringList(path));
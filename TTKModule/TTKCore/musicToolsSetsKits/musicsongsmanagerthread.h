@@ -33,6 +33,10 @@ public:
      * Object constructor.
      */
     explicit MusicSongsManagerThread(QObject *parent = nullptr);
+    /*!
+     * Object destructor.
+     */
+    ~MusicSongsManagerThread();
 
     /*!
      * Set find file path by given path.
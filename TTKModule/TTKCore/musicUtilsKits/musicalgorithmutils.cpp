@@ -2,6 +2,64 @@
 #include "ttkcryptographichash.h"
 
 #include <QCryptographicHash>
+#include <QReadWriteLock>
+
+static constexpr int MAX_VALUE_COUNT = 1024;
+
+/*!
+ * Decrypted text of the mdII data, every endpoint constant is decrypted only once.
+ * Values are keyed by the content of data and key, never by the address of a buffer.
+ */
+struct MusicEndpointTable
+{
+    QReadWriteLock m_lock;
+    QHash<QPair<QByteArray, QByteArray>, QString> m_constants;
+    QHash<QPair<QString, QString>, QString> m_values;
+};
+
+static MusicEndpointTable &endpointTable()
+{
+    static MusicEndpointTable table;
+    return table;
+}
+
+static inline const QPair<QString, QString> &storedKey(const QPair<QString, QString> &key)
+{
+    return key;
+}
+
+/*!
+ * Lookup keys of string constants wrap the caller buffer, the stored key owns a copy.
+ */
+static inline QPair<QByteArray, QByteArray> storedKey(const QPair<QByteArray, QByteArray> &key)
+{
+    return qMakePair(QByteArray(key.first.constData(), key.first.size()), QByteArray(key.second.constData(), key.second.size()));
+}
+
+template <typename T>
+static QString endpointValue(QHash<T, QString> &values, const T &key, const QString &data, const QString &secret)
+{
+    MusicEndpointTable &table = endpointTable();
+    {
+        QReadLocker locker(&table.m_lock);
+        const auto it = values.constFind(key);
+        if(it != values.constEnd())
+        {
+            return it.value();
+        }
+    }
+
+    TTKCryptographicHash hash;
+    const QString &value = hash.decrypt(data, secret);
+
+    QWriteLocker locker(&table.m_lock);
+    if(values.count() >= MAX_VALUE_COUNT)
+    {
+        values.clear();
+    }
+    values.insert(storedKey(key), value);
+    return value;
+}
 
 QByteArray TTK::Algorithm::md5(const QByteArray &data)
 {
@@ -40,12 +98,32 @@ QByteArray TTK::Algorithm::hmacSha1(const QByteArray &data, const QByteArray &ke
 
 QString TTK::Algorithm::mdII(const QString &data, bool encode)
 {
-    TTKCryptographicHash hash;
-    return encode ? hash.encrypt(data, ALG_URL_KEY) : hash.decrypt(data, ALG_URL_KEY);
+    return mdII(data, ALG_URL_KEY, encode);
 }
 
 QString TTK::Algorithm::mdII(const QString &data, const QString &key, bool encode)
 {
-    TTKCryptographicHash hash;
-    return encode ? hash.encrypt(data, key) : hash.decrypt(data, key);
+    if(encode)
+    {
+        TTKCryptographicHash hash;
+        return hash.encrypt(data, key);
+    }
+    return endpointValue(endpointTable().m_values, qMakePair(data, key), data, key);
+}
+
+QString TTK::Algorithm::mdII(const char *data, bool encode)
+{
+    return mdII(data, ALG_URL_KEY, encode);
+}
+
+QString TTK::Algorithm::mdII(const char *data, const char *key, bool encode)
+{
+    if(encode)
+    {
+        TTKCryptographicHash hash;
+        return hash.encrypt(data, key);
+    }
+    // the raw data wrappers avoid a copy for the lookup, only a new entry copies the content
+    const QPair<QByteArray, QByteArray> &lookup = qMakePair(QByteArray::fromRawData(data, qstrlen(data)), QByteArray::fromRawData(key, qstrlen(key)));
+    return endpointValue(endpointTable().m_constants, lookup, data, key);
 }
@@ -53,6 +53,16 @@ namespace TTK
          * Get mdII(greedysky) algorithm.
          */
         TTK_MODULE_EXPORT QString mdII(const QString &data, const QString &key, bool encode);
+        /*!
+         * Get mdII(greedysky) algorithm of the string.
+         * The decrypted text is kept by the content of the data.
+         */
+        TTK_MODULE_EXPORT QString mdII(const char *data, bool encode);
+        /*!
+         * Get mdII(greedysky) algorithm of the string.
+         * The decrypted text is kept by the content of the data and key.
+         */
+        TTK_MODULE_EXPORT QString mdII(const char *data, const char *key, bool encode);
 
     }
 }
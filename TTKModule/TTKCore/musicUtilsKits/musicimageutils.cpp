@@ -1,4 +1,5 @@
 #include "musicimageutils.h"
+#include "qalgorithm/pixelkernel.h"
 
 #include <QBitmap>
 #include <QBuffer>
@@ -76,6 +77,11 @@ void TTK::Image::fusionPixmap(QImage &back, const QImage &front, const QPoint &p
         return;
     }
 
+    if(QAlgorithm::sourceOver(back, front, pt))
+    {
+        return;
+    }
+
     QPainter painter(&back);
     painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
     painter.drawImage(pt.x(), pt.y(), front);
@@ -96,26 +102,17 @@ void TTK::Image::fusionPixmap(QPixmap &back, const QPixmap &front, const QPoint
 QRgb TTK::Image::colorContrast(const QRgb color)
 {
     // Counting the perceptive luminance - human eye favors green color...
-    int v = 255 - (2.0 * qRed(color) + 3.0 * qGreen(color) + qBlue(color)) / 6.0;
-        v = v < 128 ? 0 : 255;
+    // 255 - (2r + 3g + b) / 6 < 128 equals to 2r + 3g + b > 762
+    const int v = (2 * qRed(color) + 3 * qGreen(color) + qBlue(color)) > 762 ? 0 : 255;
     // 0, bright colors; 255, dark colors
     return qRgb(v, v, v);
 }
 
 QPixmap TTK::Image::grayScalePixmap(const QPixmap &input, int radius)
 {
-    QImage pix = input.toImage();
-    for(int w = 0; w < pix.width(); ++w)
-    {
-        for(int h = 0; h < pix.height(); ++h)
-        {
-            int gray = qGray(pix.pixel(w, h)) + radius;
-                gray = qBound(0, gray, 255);
-            const QRgb rgb = qRgb(gray, gray, gray);
-            pix.setPixel(w, h, rgb);
-        }
-    }
-    return QPixmap::fromImage(pix);
+    QImage image = input.toImage();
+    QAlgorithm::grayScale(image, radius);
+    return QPixmap::fromImage(image);
 }
 
 static int colorBurnTransform(int c, int delta)
@@ -125,28 +122,25 @@ static int colorBurnTransform(int c, int delta)
         return c;
     }
 
-    const int result = (c - (c * delta)/(0xFF - delta));
-    if(result > 0xFF)
-    {
-        return 0xFF;
-    }
-    else if(result < 0)
+    if(delta == 0xFF)
     {
         return 0;
     }
-    return result;
+
+    return qBound(0, c - (c * delta) / (0xFF - delta), 0xFF);
 }
 
 void TTK::Image::reRenderImage(int delta, const QImage *input, QImage *output)
 {
-    for(int w = 0; w < input->width(); ++w)
+    uchar table[256];
+    for(int i = 0; i < 256; ++i)
     {
-        for(int h = 0; h < input->height(); ++h)
-        {
-            const QRgb rgb = input->pixel(w, h);
-            output->setPixel(w, h, qRgb(colorBurnTransform(qRed(rgb), delta),
-                                        colorBurnTransform(qGreen(rgb), delta),
-                                        colorBurnTransform(qBlue(rgb), delta)));
-        }
+        table[i] = colorBurnTransform(i, delta);
     }
+
+    // the kernel may convert the image, so work on a copy and hand back the format output already has
+    const QImage::Format format = output->isNull() ? input->format() : output->format();
+    QImage image = *input;
+    QAlgorithm::mapChannels(image, table);
+    *output = image.format() == format ? image : image.convertToFormat(format);
 }
@@ -1,7 +1,6 @@
 #include "musiclrcdownloadbatchwidget.h"
-#include "musicabstractqueryrequest.h"
 #include "ui_musiclrcdownloadbatchwidget.h"
-#include "musicdownloadqueryfactory.h"
+#include "musiclrcbatchrequest.h"
 
 MusicLrcDownloadBatchTableWidget::MusicLrcDownloadBatchTableWidget(QWidget *parent)
     : MusicAbstractTableWidget(parent)
@@ -64,7 +63,8 @@ void MusicLrcDownloadBatchTableWidget::addCellItems(const MusicSongList &items)
 
 MusicLrcDownloadBatchWidget::MusicLrcDownloadBatchWidget(QWidget *parent)
     : MusicAbstractMoveWidget(parent),
-      m_ui(new Ui::MusicLrcDownloadBatchWidget)
+      m_ui(new Ui::MusicLrcDownloadBatchWidget),
+      m_request(nullptr)
 {
     m_ui->setupUi(this);
     setFixedSize(size());
@@ -95,6 +95,10 @@ MusicLrcDownloadBatchWidget::MusicLrcDownloadBatchWidget(QWidget *parent)
 
     m_ui->skipAlreadyLrcCheckBox->setChecked(true);
     m_ui->saveToLrcDirRadioBox->setChecked(true);
+
+    m_request = new MusicLrcBatchRequest(this);
+    connect(m_request, SIGNAL(downloadStateChanged(int, bool, bool)), SLOT(downloadStateChanged(int, bool, bool)));
+    connect(m_request, SIGNAL(finished()), SLOT(downloadFinished()));
 }
 
 MusicLrcDownloadBatchWidget::~MusicLrcDownloadBatchWidget()
@@ -146,32 +150,39 @@ void MusicLrcDownloadBatchWidget::downloadButtonClicked()
             continue;
         }
 
-        TTKSemaphoreLoop loop;
-        MusicAbstractQueryRequest *d = G_DOWNLOAD_QUERY_PTR->makeQueryRequest(this);
-        connect(d, SIGNAL(downLoadDataChanged(QString)), &loop, SLOT(quit()));
-        d->setQueryMode(MusicAbstractQueryRequest::QueryMode::Meta);
-        d->setQueryType(MusicAbstractQueryRequest::QueryType::Music);
-        d->startToSearch(song->name().trimmed());
-        loop.exec();
+        m_request->addTask(i, song->name(), path);
+    }
 
-        if(!d->isEmpty())
-        {
-            const TTK::MusicSongInformation info(d->items().front());
-            MusicAbstractDownLoadRequest *d = G_DOWNLOAD_QUERY_PTR->makeLrcRequest(info.m_lrcUrl, path, this);
-            connect(d, SIGNAL(downLoadDataChanged(QString)), &loop, SLOT(quit()));
-            d->startToRequest();
-            loop.exec();
-
-            it->setForeground(QColor(0, 0xFF, 0));
-            it->setText(tr("Finish"));
-        }
-        else
-        {
-            it->setForeground(QColor(0xFF, 0, 0));
-            it->setText(tr("Error"));
-        }
+    m_request->startToRequest();
+}
+
+void MusicLrcDownloadBatchWidget::downloadStateChanged(int index, bool success, bool skip)
+{
+    QTableWidgetItem *it = m_ui->tableWidget->item(index, 4);
+    if(!it)
+    {
+        return;
     }
 
+    if(skip)
+    {
+        it->setForeground(QColor(TTK::UI::Color02));
+        it->setText(tr("Skip"));
+    }
+    else if(success)
+    {
+        it->setForeground(QColor(0, 0xFF, 0));
+        it->setText(tr("Finish"));
+    }
+    else
+    {
+        it->setForeground(QColor(0xFF, 0, 0));
+        it->setText(tr("Error"));
+    }
+}
+
+void MusicLrcDownloadBatchWidget::downloadFinished()
+{
     m_ui->addButton->setEnabled(true);
     m_ui->downloadButton->setEnabled(true);
 }
@@ -26,6 +26,7 @@
 namespace Ui {
 class MusicLrcDownloadBatchWidget;
 }
+class MusicLrcBatchRequest;
 
 /*! @brief The class of the the lrc batch download table widget.
  * @author Greedysky <greedysky@163.com>
@@ -75,10 +76,19 @@ public Q_SLOTS:
      * Download button clicked.
      */
     void downloadButtonClicked();
+    /*!
+     * Lrc download state of the row changed.
+     */
+    void downloadStateChanged(int index, bool success, bool skip);
+    /*!
+     * All lrc downloads finished.
+     */
+    void downloadFinished();
 
 private:
     Ui::MusicLrcDownloadBatchWidget *m_ui;
     MusicSongList m_localSongs;
+    MusicLrcBatchRequest *m_request;
 
 };
 
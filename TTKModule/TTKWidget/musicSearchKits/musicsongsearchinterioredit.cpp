@@ -1,15 +1,15 @@
 #include "musicsongsearchinterioredit.h"
 #include "musicsongsearchpopwidget.h"
-#include "musicsongsuggestrequest.h"
+#include "musicsongsuggestservice.h"
 #include "musicdownloadqueryfactory.h"
 #include "musicdiscoverlistrequest.h"
 
 MusicSongSearchInteriorEdit::MusicSongSearchInteriorEdit(QWidget *parent)
     : MusicSearchEdit(parent),
-      m_popWidget(nullptr),
-      m_suggestRequest(nullptr)
+      m_popWidget(nullptr)
 {
     connect(this, SIGNAL(textChanged(QString)), SLOT(textChanged(QString)));
+    connect(G_SUGGEST_PTR, SIGNAL(suggestChanged(QString,QStringList)), SLOT(suggestDataChanged(QString,QStringList)));
 
     m_discoverRequest = G_DOWNLOAD_QUERY_PTR->makeDiscoverListRequest(this);
     connect(m_discoverRequest, SIGNAL(downLoadDataChanged(QString)), SLOT(discoverInfoFinished(QString)));
@@ -19,7 +19,7 @@ MusicSongSearchInteriorEdit::MusicSongSearchInteriorEdit(QWidget *parent)
 MusicSongSearchInteriorEdit::~MusicSongSearchInteriorEdit()
 {
     delete m_discoverRequest;
-    delete m_suggestRequest;
+    G_SUGGEST_PTR->abort(this);
 }
 
 void MusicSongSearchInteriorEdit::initialize(QWidget *parent)
@@ -42,14 +42,17 @@ void MusicSongSearchInteriorEdit::setText(const QString &text)
 
 void MusicSongSearchInteriorEdit::textChanged(const QString &text)
 {
-    delete m_suggestRequest;
-    m_suggestRequest = new MusicSongSuggestRequest(this);
-    connect(m_suggestRequest, SIGNAL(downLoadDataChanged(QString)), SLOT(suggestDataChanged()));
-    m_suggestRequest->startToSearch(text);
+    G_SUGGEST_PTR->query(text, this);
 
     if(text.trimmed().isEmpty())
     {
         m_popWidget->initialize(this);
+
+        // workaround to clear border stylesheet
+        QWidget *widget = TTKStaticCast(QWidget*, m_popWidget->parent());
+        const QSize &size = widget->size();
+        widget->resize(size.width(), size.height() + 1);
+        widget->resize(size.width(), size.height());
     }
 
     if(m_popWidget->height() != 0)
@@ -72,40 +75,24 @@ void MusicSongSearchInteriorEdit::selectedTextChanged(const QString &text, bool
     }
 }
 
-void MusicSongSearchInteriorEdit::suggestDataChanged()
+void MusicSongSearchInteriorEdit::suggestDataChanged(const QString &text, const QStringList &names)
 {
-    if(!m_popWidget)
+    // the service is shared, drop the results of other texts
+    if(!m_popWidget || text != this->text().trimmed())
     {
         return;
     }
 
-    QStringList names;
-    for(const MusicResultDataItem &item : m_suggestRequest->items())
+    if(names.isEmpty())
     {
-        names << item.m_name;
+        setPopWidgetVisible(false);
     }
-
-    if(text().trimmed().isEmpty())
+    else if(!m_popWidget->isVisible())
     {
-        // workaround to clear border stylesheet
-        QWidget *widget = TTKStaticCast(QWidget*, m_popWidget->parent());
-        const QSize &size = widget->size();
-        widget->resize(size.width(), size.height() + 1);
-        widget->resize(size.width(), size.height());
+        setPopWidgetVisible(true);
     }
-    else
-    {
-        if(names.isEmpty())
-        {
-            setPopWidgetVisible(false);
-        }
-        else if(!m_popWidget->isVisible())
-        {
-            setPopWidgetVisible(true);
-        }
 
-        m_popWidget->addCellItems(names);
-    }
+    m_popWidget->addCellItems(names);
 }
 
 void MusicSongSearchInteriorEdit::discoverInfoFinished(const QString &bytes)
@@ -23,7 +23,6 @@
 
 class MusicDiscoverListRequest;
 class MusicSongSearchPopWidget;
-class MusicSongSuggestRequest;
 
 /*! @brief The class of the net search interior edit widget.
  * @author Greedysky <greedysky@163.com>
@@ -63,7 +62,7 @@ public Q_SLOTS:
     /*!
      * Suggest data changed.
      */
-    void suggestDataChanged();
+    void suggestDataChanged(const QString &text, const QStringList &names);
     /*!
      * Search discover list information finished.
      */
@@ -84,7 +83,6 @@ private:
 
     MusicSongSearchPopWidget *m_popWidget;
     MusicDiscoverListRequest *m_discoverRequest;
-    MusicSongSuggestRequest *m_suggestRequest;
 
 };
 
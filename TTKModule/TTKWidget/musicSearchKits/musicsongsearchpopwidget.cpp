@@ -1,5 +1,5 @@
 #include "musicsongsearchpopwidget.h"
-#include "musicsongsearchrecordconfigmanager.h"
+#include "musicsongsuggestservice.h"
 #include "musicwidgetheaders.h"
 
 static constexpr int MAX_ITEM_COUNT = 7;
@@ -129,15 +129,7 @@ void MusicSongSearchPopWidget::initialize(QWidget *parent)
     setControlEnabled(true);
     m_tableWidget->removeItems();
 
-    MusicSongSearchRecordConfigManager manager;
-    if(!manager.fromFile(SEARCH_PATH_FULL))
-    {
-        return;
-    }
-
-    MusicSearchRecordList records;
-    manager.readBuffer(records);
-
+    const MusicSearchRecordList &records = G_SUGGEST_PTR->records();
     const int count = records.count();
     m_tableWidget->setRowCount(count);
 
@@ -208,13 +200,7 @@ QString MusicSongSearchPopWidget::utcTimeToLocal(const QString &time) const
 
 void MusicSongSearchPopWidget::clearButtonClicked()
 {
-    MusicSongSearchRecordConfigManager manager;
-    if(!manager.load(SEARCH_PATH_FULL))
-    {
-        return;
-    }
-
-    manager.writeBuffer(MusicSearchRecordList());
+    G_SUGGEST_PTR->clearRecords();
     close();
 }
 
@@ -38,15 +38,25 @@ MusicConnectTransferWidget::MusicConnectTransferWidget(QWidget *parent)
     m_ui->transferUSBButton->setCursor(QCursor(Qt::PointingHandCursor));
     connect(m_ui->transferUSBButton, SIGNAL(clicked()), SLOT(startToTransferFiles()));
 
+    m_ui->removeCheckBox->setStyleSheet(TTK::UI::CheckBoxStyle03);
+    m_ui->removeCheckBox->setCursor(QCursor(Qt::PointingHandCursor));
+    m_ui->removeCheckBox->setText(tr("Remove unselected synced files"));
+
+    m_ui->transferProgressBar->setStyleSheet(TTK::UI::ProgressBar01);
+    m_ui->transferProgressBar->setRange(0, 100);
+
     m_ui->searchLineEdit->setStyleSheet(TTK::UI::LineEditStyle03);
     connect(m_ui->searchLineEdit, SIGNAL(cursorPositionChanged(int,int)), SLOT(searchResultChanged(int,int)));
 
     m_thread = new MusicConnectTransferThread(this);
     connect(m_thread, SIGNAL(transferFileFinished(QString)), m_ui->completeTableWidget, SLOT(addCellItem(QString)));
+    connect(m_thread, SIGNAL(transferProgressChanged(qint64,qint64)), SLOT(transferProgressChanged(qint64,qint64)));
+    connect(m_thread, SIGNAL(transferFinished(int,int,int)), SLOT(transferFinished(int,int,int)));
 
 #ifdef Q_OS_UNIX
     m_ui->allSelectedcheckBox->setFocusPolicy(Qt::NoFocus);
     m_ui->transferUSBButton->setFocusPolicy(Qt::NoFocus);
+    m_ui->removeCheckBox->setFocusPolicy(Qt::NoFocus);
     m_ui->searchLineLabel->setFocusPolicy(Qt::NoFocus);
 #endif
 
@@ -59,6 +69,7 @@ MusicConnectTransferWidget::MusicConnectTransferWidget(QWidget *parent)
 MusicConnectTransferWidget::~MusicConnectTransferWidget()
 {
     G_CONNECTION_PTR->removeValue(this);
+    m_thread->stop();
     delete m_ui;
     delete m_thread;
 }
@@ -175,16 +186,35 @@ void MusicConnectTransferWidget::selectedAllItems(bool checked)
 
 void MusicConnectTransferWidget::startToTransferFiles()
 {
+    if(m_thread->isRunning())
+    {
+        MusicToastLabel::popup(tr("Transfer is running, please wait"));
+        return;
+    }
+
     const QStringList &names = selectedFiles();
     if(names.isEmpty())
     {
         return;
     }
 
+    m_ui->transferProgressBar->setValue(0);
+    m_thread->setRemoveOrphans(m_ui->removeCheckBox->isChecked());
     m_thread->setFilePath(m_currentDeviceItem->m_path + TTK_SEPARATOR, names);
     m_thread->start();
 }
 
+void MusicConnectTransferWidget::transferProgressChanged(qint64 value, qint64 total)
+{
+    m_ui->transferProgressBar->setValue(total > 0 ? value * 100 / total : 100);
+}
+
+void MusicConnectTransferWidget::transferFinished(int copied, int skipped, int removed)
+{
+    m_ui->transferProgressBar->setValue(100);
+    MusicToastLabel::popup(tr("%1 copied, %2 unchanged, %3 removed").arg(copied).arg(skipped).arg(removed));
+}
+
 void MusicConnectTransferWidget::searchResultChanged(int, int column)
 {
     TTKIntList result;
@@ -74,6 +74,14 @@ public Q_SLOTS:
      * Start to transfer files.
      */
     void startToTransferFiles();
+    /*!
+     * Transfer progress changed.
+     */
+    void transferProgressChanged(qint64 value, qint64 total);
+    /*!
+     * Transfer files finished.
+     */
+    void transferFinished(int copied, int skipped, int removed);
     /*!
      * Search result from list.
      */
@@ -1,24 +1,30 @@
 #include "musicidentifysongwidget.h"
 #include "musictoolsetsuiobject.h"
-#include "musicidentifysongrequest.h"
 #include "musicdownloadqueryfactory.h"
 #include "musicdownloaddatarequest.h"
 #include "musicaudiorecordermodule.h"
+#include "musicfingerprintindexthread.h"
+#include "musicfingerprintindex.h"
+#include "musicsongsmanagerthread.h"
+#include "musicsongscontainerwidget.h"
+#include "musicconnectionpool.h"
 #include "musicsongsharingwidget.h"
 #include "musicdownloadwidget.h"
 #include "musiccoremplayer.h"
 #include "musiclrcanalysis.h"
 #include "musictoastlabel.h"
-#include "musicsong.h"
+#include "musicsongmeta.h"
 
 #include <QMovie>
+#include <QFileInfo>
 #include <QShortcut>
 
 MusicIdentifySongWidget::MusicIdentifySongWidget(QWidget *parent)
     : QWidget(parent),
       m_lrcLabel(nullptr),
       m_player(nullptr),
-      m_analysis(nullptr)
+      m_analysis(nullptr),
+      m_remote(false)
 {
     QHBoxLayout *layout = new QHBoxLayout(this);
     layout->setSpacing(0);
@@ -37,15 +43,34 @@ MusicIdentifySongWidget::MusicIdentifySongWidget(QWidget *parent)
     m_recordCore = new MusicAudioRecorderModule(this);
     m_networkRequest = new MusicIdentifySongRequest(this);
 
+    m_index = new MusicFingerprintIndex;
+    m_index->load(FINGERPRINT_PATH_FULL);
+
+    m_scanThread = new MusicSongsManagerThread(this);
+    connect(m_scanThread, SIGNAL(searchFilePathChanged(QStringList)), SLOT(searchFilePathChanged(QStringList)));
+
+    m_indexThread = new MusicFingerprintIndexThread(this);
+    connect(m_indexThread, SIGNAL(finished()), SLOT(indexFinished()));
+
     QShortcut *cut = new QShortcut(Qt::SHIFT + Qt::CTRL + Qt::Key_T, this);
     connect(cut, SIGNAL(activated()), SLOT(detectedButtonClicked()));
 
     createDetectedWidget();
     m_detectedButton->setEnabled(false);
+
+    G_CONNECTION_PTR->setValue(className(), this);
+    G_CONNECTION_PTR->connect(className(), MusicSongsContainerWidget::className());
 }
 
 MusicIdentifySongWidget::~MusicIdentifySongWidget()
 {
+    G_CONNECTION_PTR->removeValue(this);
+    m_scanThread->stop();
+    m_indexThread->stop();
+
+    delete m_scanThread;
+    delete m_indexThread;
+    delete m_index;
     delete m_timer;
     delete m_player;
     delete m_analysis;
@@ -59,7 +84,12 @@ MusicIdentifySongWidget::~MusicIdentifySongWidget()
 
 void MusicIdentifySongWidget::queryIdentifyKey()
 {
-    if(m_networkRequest->queryIdentifyKey())
+    // index the downloaded songs and the local playlists in background
+    m_scanThread->setFindFilePath(MUSIC_DIR_FULL);
+    m_scanThread->start();
+
+    m_remote = m_networkRequest->queryIdentifyKey();
+    if(m_remote || !m_index->isEmpty())
     {
         m_detectedButton->setEnabled(true);
     }
@@ -111,21 +141,16 @@ void MusicIdentifySongWidget::reDetectButtonClicked()
 
 void MusicIdentifySongWidget::detectedTimeOut()
 {
-    m_recordCore->addWavHeader(TTK_RECORD_DATA_FILE);
-
-    TTKSemaphoreLoop loop;
-    connect(m_networkRequest, SIGNAL(downLoadDataChanged(QString)), &loop, SLOT(quit()));
-    m_networkRequest->startToRequest(TTK_RECORD_DATA_FILE);
-    loop.exec();
-
+    // stop first, the recording file is flushed on close
     detectedButtonClicked();
-    if(m_networkRequest->items().isEmpty())
+
+    if(identifyByIndex() || identifyByRequest())
     {
-        createDetectedFailedWidget();
+        createDetectedSuccessedWidget();
     }
     else
     {
-        createDetectedSuccessedWidget();
+        createDetectedFailedWidget();
     }
 }
 
@@ -204,6 +229,89 @@ void MusicIdentifySongWidget::positionChanged(qint64 position)
     }
 }
 
+void MusicIdentifySongWidget::searchFilePathChanged(const QStringList &path)
+{
+    QStringList paths(path);
+    MusicSongItemList items;
+    Q_EMIT queryMusicItemList(items);
+
+    for(const MusicSongItem &item : qAsConst(items))
+    {
+        for(const MusicSong &song : qAsConst(item.m_songs))
+        {
+            paths << song.path();
+        }
+    }
+
+    // the mapped file can not be replaced on some platforms
+    m_index->close();
+    m_indexThread->setFilePaths(paths);
+    m_indexThread->start();
+}
+
+void MusicIdentifySongWidget::indexFinished()
+{
+    m_index->load(FINGERPRINT_PATH_FULL);
+    if(!m_index->isEmpty())
+    {
+        m_detectedButton->setEnabled(true);
+    }
+}
+
+bool MusicIdentifySongWidget::identifyByIndex()
+{
+    if(m_index->isEmpty())
+    {
+        return false;
+    }
+
+    // the recorder writes mono signed 16 bit samples
+    const MusicFingerprintHashList &hashes = MusicAudioFingerprint::fromPcm(m_recordCore->pcmData(), m_recordCore->format().sampleRate());
+
+    MusicFingerprintMatch match;
+    if(!m_index->find(hashes, &match))
+    {
+        return false;
+    }
+
+    TTK_INFO_STREAM("Identify song by local index" << match.m_path << match.m_score);
+
+    MusicSongMeta meta;
+    if(meta.read(match.m_path) && !meta.title().isEmpty())
+    {
+        m_identify.m_artistName = meta.artist();
+        m_identify.m_songName = meta.title();
+    }
+    else
+    {
+        const QString &name = QFileInfo(match.m_path).completeBaseName();
+        m_identify.m_artistName = TTK::generateSongArtist(name);
+        m_identify.m_songName = TTK::generateSongTitle(name);
+    }
+    return true;
+}
+
+bool MusicIdentifySongWidget::identifyByRequest()
+{
+    if(!m_remote)
+    {
+        return false;
+    }
+
+    TTKSemaphoreLoop loop;
+    connect(m_networkRequest, SIGNAL(downLoadDataChanged(QString)), &loop, SLOT(quit()));
+    m_networkRequest->startToRequest(m_recordCore->fileName());
+    loop.exec();
+
+    if(m_networkRequest->items().isEmpty())
+    {
+        return false;
+    }
+
+    m_identify = m_networkRequest->items().front();
+    return true;
+}
+
 void MusicIdentifySongWidget::createDetectedWidget()
 {
     QWidget *widget = new QWidget(m_mainWindow);
@@ -262,7 +370,7 @@ void MusicIdentifySongWidget::createDetectedSuccessedWidget()
         m_analysis->setLineMax(11);
         connect(m_player, SIGNAL(positionChanged(qint64)), SLOT(positionChanged(qint64)));
     }
-    const MusicSongIdentifyData songIdentify(m_networkRequest->items().front());
+    const MusicSongIdentifyData songIdentify(m_identify);
 
     QWidget *widget = new QWidget(m_mainWindow);
     widget->setStyleSheet(TTK::UI::ColorStyle03 + TTK::UI::FontStyle04);
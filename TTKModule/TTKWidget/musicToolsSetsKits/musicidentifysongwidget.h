@@ -19,15 +19,18 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
-#include "musicglobaldefine.h"
+#include "musicsong.h"
 #include "musicwidgetheaders.h"
+#include "musicidentifysongrequest.h"
 
 class QMovie;
 class QStackedWidget;
 class MusicCoreMPlayer;
 class MusicLrcAnalysis;
 class MusicAudioRecorderModule;
-class MusicIdentifySongRequest;
+class MusicFingerprintIndex;
+class MusicFingerprintIndexThread;
+class MusicSongsManagerThread;
 
 /*! @brief The class of the song identify widget.
  * @author Greedysky <greedysky@163.com>
@@ -35,7 +38,7 @@ class MusicIdentifySongRequest;
 class TTK_MODULE_EXPORT MusicIdentifySongWidget : public QWidget
 {
     Q_OBJECT
-    TTK_DECLARE_MODULE(MusicIdentifySongRequest)
+    TTK_DECLARE_MODULE(MusicIdentifySongWidget)
 public:
     /*!
      * Object constructor.
@@ -51,6 +54,12 @@ public:
      */
     void queryIdentifyKey();
 
+Q_SIGNALS:
+    /*!
+     * Query music song item list.
+     */
+    void queryMusicItemList(MusicSongItemList &songs);
+
 public Q_SLOTS:
     /*!
      * Detected the song button clicked.
@@ -80,8 +89,24 @@ public Q_SLOTS:
      * Current position changed.
      */
     void positionChanged(qint64 position);
+    /*!
+     * Library files search finished.
+     */
+    void searchFilePathChanged(const QStringList &path);
+    /*!
+     * Fingerprint index update finished.
+     */
+    void indexFinished();
 
 private:
+    /*!
+     * Identify the recording by the local fingerprint index.
+     */
+    bool identifyByIndex();
+    /*!
+     * Identify the recording by the remote service.
+     */
+    bool identifyByRequest();
     /*!
      * Create the detected widget.
      */
@@ -104,6 +129,11 @@ private:
     MusicLrcAnalysis *m_analysis;
     MusicAudioRecorderModule *m_recordCore;
     MusicIdentifySongRequest *m_networkRequest;
+    MusicFingerprintIndex *m_index;
+    MusicFingerprintIndexThread *m_indexThread;
+    MusicSongsManagerThread *m_scanThread;
+    MusicSongIdentifyData m_identify;
+    bool m_remote;
     TTK::MusicSongInformation m_songInfo;
 
 };
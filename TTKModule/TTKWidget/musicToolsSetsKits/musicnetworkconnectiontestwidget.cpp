@@ -1,13 +1,21 @@
 #include "musicnetworkconnectiontestwidget.h"
 #include "ui_musicnetworkconnectiontestwidget.h"
-#include "musicnetworktestthread.h"
+#include "musicnetworktestrequest.h"
+#include "musicnumberutils.h"
 #include "musicalgorithmutils.h"
-
-static constexpr const char *CHECK_WWW_VISIT = "dm81Smp4VzI3eHFVNzV4aHgyU2RYN2paNDhJPQ==";
-static constexpr const char *CHECK_NORMAL_VISIT = "aGEvbU52TkJVMzQ0Z0hoSllOd2wwZz09";
-static constexpr const char *CHECK_VIP_VISIT = "ZjlBQUFxY25KM1BKd2h3VzZVZ1F5dVJHMThEYlFkTWU=";
-static constexpr const char *CHECK_DOWNLOAD_VISIT = "bkIwTS9NZE9wSUZyLythbm5YQVJVeDBtQStBPQ==";
-static constexpr const char *CHECK_SERVER_VISIT = "T2tjRlYvUVUvVUVORDg4dHI1NlorOUR0SHVvZ3RUQ1g=";
+#include "musicabstractqueryrequest.h"
+#include "musicwyqueryinterface.h"
+#include "musickwqueryinterface.h"
+#include "musickgqueryinterface.h"
+
+/*!
+ * Origin of the endpoint, its path needs query arguments.
+ */
+static QString serverOrigin(const QString &url)
+{
+    const QUrl value(url);
+    return value.scheme() + "://" + value.host();
+}
 
 MusicNetworkConnectionItem::MusicNetworkConnectionItem(QWidget *parent)
     : QWidget(parent)
@@ -28,8 +36,8 @@ MusicNetworkConnectionItem::MusicNetworkConnectionItem(QWidget *parent)
     layout->addWidget(m_nameText);
     layout->addWidget(m_stateText);
 
-    m_thread = new MusicNetworkTestThread(this);
-    connect(m_thread, SIGNAL(networkConnectionTestChanged(bool)), SLOT(testFinshed(bool)));
+    m_request = new MusicNetworkTestRequest(this);
+    connect(m_request, SIGNAL(networkConnectionTestChanged(bool)), SLOT(testFinshed(bool)));
     stop();
 
     setLayout(layout);
@@ -37,8 +45,7 @@ MusicNetworkConnectionItem::MusicNetworkConnectionItem(QWidget *parent)
 
 MusicNetworkConnectionItem::~MusicNetworkConnectionItem()
 {
-    m_thread->stop();
-    delete m_thread;
+    delete m_request;
     delete m_iconLabel;
     delete m_nameText;
     delete m_stateText;
@@ -51,14 +58,15 @@ void MusicNetworkConnectionItem::setText(const QString &text)
 
 void MusicNetworkConnectionItem::setUrl(const QString &url)
 {
-    m_thread->setUrl(url);
+    m_request->setUrl(url);
 }
 
 void MusicNetworkConnectionItem::start()
 {
+    m_stateText->setToolTip({});
     m_stateText->setText(tr("Detecting"));
     m_stateText->setStyleSheet(TTK::UI::ColorStyle07);
-    m_thread->start();
+    m_request->startToRequest();
 }
 
 void MusicNetworkConnectionItem::stop()
@@ -67,15 +75,24 @@ void MusicNetworkConnectionItem::stop()
 
     m_stateText->setText(tr("Undetected"));
     m_stateText->setStyleSheet(TTK::UI::ColorStyle03);
-    if(m_thread->isRunning())
-    {
-        m_thread->stop();
-    }
+    m_stateText->setToolTip({});
+    m_request->deleteAll();
 }
 
 void MusicNetworkConnectionItem::testFinshed(bool state)
 {
-    m_stateText->setText(state ? tr("Detected") : tr("Failed"));
+    const MusicNetworkTestResult &result = m_request->result();
+    if(state)
+    {
+        m_stateText->setText(TTK::Number::speedByteToLabel(result.m_speed));
+        m_stateText->setToolTip(tr("Connect: %1ms (p90 %2ms)\nFirst byte: %3ms (p90 %4ms)\nSpeed: %5 (p10 %6)\nFailed: %7")
+                                .arg(result.m_connect).arg(result.m_connectHigh).arg(result.m_firstByte).arg(result.m_firstByteHigh)
+                                .arg(TTK::Number::speedByteToLabel(result.m_speed), TTK::Number::speedByteToLabel(result.m_speedLow)).arg(result.m_failed));
+    }
+    else
+    {
+        m_stateText->setText(tr("Failed"));
+    }
     m_iconLabel->setPixmap(QPixmap(state ? ":/tiny/lb_right" : ":/tiny/lb_error"));
     m_stateText->setStyleSheet(state ? TTK::UI::ColorStyle09 : TTK::UI::ColorStyle11);
 
@@ -86,7 +103,8 @@ void MusicNetworkConnectionItem::testFinshed(bool state)
 MusicNetworkConnectionTestWidget::MusicNetworkConnectionTestWidget(QWidget *parent)
     : MusicAbstractMoveWidget(parent),
       m_ui(new Ui::MusicNetworkConnectionTestWidget),
-      m_index(0)
+      m_index(0),
+      m_count(0)
 {
     m_ui->setupUi(this);
     setFixedSize(size());
@@ -105,44 +123,26 @@ MusicNetworkConnectionTestWidget::MusicNetworkConnectionTestWidget(QWidget *pare
 #ifdef Q_OS_UNIX
     m_ui->startButton->setFocusPolicy(Qt::NoFocus);
 #endif
+    m_ui->urlLineEdit->setStyleSheet(TTK::UI::LineEditStyle01);
+    m_ui->urlLineEdit->setPlaceholderText(tr("Input custom url"));
 
     m_ui->verticalLayout->setSpacing(3);
     m_ui->verticalLayout->setContentsMargins(0, 0, 0, 0);
 
-    MusicNetworkConnectionItem *item = new MusicNetworkConnectionItem(this);
-    m_connectionItems << item;
-    item->setText(tr("Check www visit"));
-    item->setUrl(TTK::Algorithm::mdII(CHECK_WWW_VISIT, false));
-    connect(item, SIGNAL(networkConnectionTestChanged()), SLOT(testFinshed()));
-    m_ui->verticalLayout->addWidget(item);
-
-    item = new MusicNetworkConnectionItem(this);
-    m_connectionItems << item;
-    item->setText(tr("Check normal visit"));
-    item->setUrl(TTK::Algorithm::mdII(CHECK_NORMAL_VISIT, false));
-    connect(item, SIGNAL(networkConnectionTestChanged()), SLOT(testFinshed()));
-    m_ui->verticalLayout->addWidget(item);
-
-    item = new MusicNetworkConnectionItem(this);
-    m_connectionItems << item;
-    item->setText(tr("Check vip visit"));
-    item->setUrl(TTK::Algorithm::mdII(CHECK_VIP_VISIT, false));
-    connect(item, SIGNAL(networkConnectionTestChanged()), SLOT(testFinshed()));
-    m_ui->verticalLayout->addWidget(item);
-
-    item = new MusicNetworkConnectionItem(this);
-    m_connectionItems << item;
-    item->setText(tr("Check download visit"));
-    item->setUrl(TTK::Algorithm::mdII(CHECK_DOWNLOAD_VISIT, false));
-    connect(item, SIGNAL(networkConnectionTestChanged()), SLOT(testFinshed()));
-    m_ui->verticalLayout->addWidget(item);
-
-    item = new MusicNetworkConnectionItem(this);
-    m_connectionItems << item;
-    item->setText(tr("Check server visit"));
-    item->setUrl(TTK::Algorithm::mdII(CHECK_SERVER_VISIT, false));
-    connect(item, SIGNAL(networkConnectionTestChanged()), SLOT(testFinshed()));
-    m_ui->verticalLayout->addWidget(item);
+    // query and download server of the settings, the urls are taken when the test starts
+    for(int i = 0; i < 2; ++i)
+    {
+        MusicNetworkConnectionItem *item = new MusicNetworkConnectionItem(this);
+        m_connectionItems << item;
+        connect(item, SIGNAL(networkConnectionTestChanged()), SLOT(testFinshed()));
+        m_ui->verticalLayout->addWidget(item);
+    }
+    updateServerUrls();
+
+    m_urlItem = new MusicNetworkConnectionItem(this);
+    m_urlItem->setText(tr("Check custom url"));
+    connect(m_urlItem, SIGNAL(networkConnectionTestChanged()), SLOT(testFinshed()));
+    m_ui->verticalLayout->addWidget(m_urlItem);
 
     connect(m_ui->startButton, SIGNAL(clicked()), SLOT(buttonStateChanged()));
 }
@@ -151,6 +151,7 @@ MusicNetworkConnectionTestWidget::~MusicNetworkConnectionTestWidget()
 {
     TTKRemoveSingleWidget(className());
     qDeleteAll(m_connectionItems);
+    delete m_urlItem;
     delete m_ui;
 }
 
@@ -168,10 +169,20 @@ void MusicNetworkConnectionTestWidget::buttonStateChanged()
         m_ui->iconLabel->start();
         m_ui->startButton->setText(tr("Stop"));
 
+        updateServerUrls();
         for(MusicNetworkConnectionItem *item : qAsConst(m_connectionItems))
         {
             item->start();
         }
+
+        m_count = m_connectionItems.count();
+        const QString &url = m_ui->urlLineEdit->text().trimmed();
+        if(!url.isEmpty())
+        {
+            ++m_count;
+            m_urlItem->setUrl(url);
+            m_urlItem->start();
+        }
     }
     else
     {
@@ -182,12 +193,47 @@ void MusicNetworkConnectionTestWidget::buttonStateChanged()
         {
             item->stop();
         }
+        m_urlItem->stop();
+    }
+}
+
+void MusicNetworkConnectionTestWidget::updateServerUrls()
+{
+    QString name, query, download;
+    switch(TTKStaticCast(MusicAbstractQueryRequest::QueryServer, G_SETTING_PTR->value(MusicSettingManager::DownloadServerIndex).toInt()))
+    {
+        case MusicAbstractQueryRequest::QueryServer::KW:
+        {
+            name = QUERY_KW_INTERFACE;
+            query = TTK::Algorithm::mdII(KW_SONG_SEARCH_URL, false);
+            download = TTK::Algorithm::mdII(KW_SONG_DETAIL_URL, false);
+            break;
+        }
+        case MusicAbstractQueryRequest::QueryServer::KG:
+        {
+            name = QUERY_KG_INTERFACE;
+            query = TTK::Algorithm::mdII(KG_SONG_SEARCH_URL, false);
+            download = TTK::Algorithm::mdII(KG_SONG_DETAIL_URL, false);
+            break;
+        }
+        default:
+        {
+            name = QUERY_WY_INTERFACE;
+            query = TTK::Algorithm::mdII(WY_SONG_SEARCH_URL, false);
+            download = TTK::Algorithm::mdII(WY_SONG_PATH_URL, false);
+            break;
+        }
     }
+
+    m_connectionItems[0]->setText(tr("Check %1 query server").arg(name));
+    m_connectionItems[0]->setUrl(serverOrigin(query));
+    m_connectionItems[1]->setText(tr("Check %1 download server").arg(name));
+    m_connectionItems[1]->setUrl(serverOrigin(download));
 }
 
 void MusicNetworkConnectionTestWidget::testFinshed()
 {
-    if(++m_index == 5)
+    if(++m_index == m_count)
     {
         m_ui->iconLabel->stop();
         m_ui->startButton->setText(tr("Start"));
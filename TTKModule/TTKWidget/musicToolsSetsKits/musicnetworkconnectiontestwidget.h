@@ -21,7 +21,7 @@
 
 #include "musicabstractmovewidget.h"
 
-class MusicNetworkTestThread;
+class MusicNetworkTestRequest;
 
 /*! @brief The class of the network connection item Widget.
  * @author Greedysky <greedysky@163.com>
@@ -71,7 +71,7 @@ private Q_SLOTS:
     void testFinshed(bool state);
 
 private:
-    MusicNetworkTestThread *m_thread;
+    MusicNetworkTestRequest *m_request;
     QLabel *m_iconLabel, *m_nameText, *m_stateText;
 
 };
@@ -113,9 +113,15 @@ public Q_SLOTS:
     void testFinshed();
 
 private:
+    /*!
+     * Point the server items at the endpoints of the current server.
+     */
+    void updateServerUrls();
+
     Ui::MusicNetworkConnectionTestWidget *m_ui;
 
-    int m_index;
+    int m_index, m_count;
+    MusicNetworkConnectionItem *m_urlItem;
     QList<MusicNetworkConnectionItem*> m_connectionItems;
 
 };
@@ -109,7 +109,8 @@ void MusicScreenSaverHoverItem::paintEvent(QPaintEvent *event)
 
 
 MusicScreenSaverListItem::MusicScreenSaverListItem(QObject *object, QWidget *parent)
-    : QLabel(parent)
+    : QLabel(parent),
+      m_index(-1)
 {
     setFixedSize(155, 100);
 
@@ -130,6 +131,7 @@ void MusicScreenSaverListItem::setFilePath(const QString &path)
 
 void MusicScreenSaverListItem::setStatus(int index, bool status)
 {
+    m_index = index;
     m_hoverItem->setStatus(index, status);
 }
 
@@ -173,8 +175,23 @@ void MusicScreenSaverListWidget::addCellItem(QObject *object, const QString &pat
     item->setFilePath(path);
     item->setStatus(index, status);
 
-    m_gridLayout->addWidget(item, m_items.count() / 4, m_items.count() % 4, Qt::AlignLeft | Qt::AlignTop);
-    m_items << item;
+    // items are downloaded in parallel, keep them in index order
+    int pos = m_items.count();
+    while(pos > 0 && m_items[pos - 1]->index() > index)
+    {
+        --pos;
+    }
+
+    for(int i = pos; i < m_items.count(); ++i)
+    {
+        m_gridLayout->removeWidget(m_items[i]);
+    }
+
+    m_items.insert(pos, item);
+    for(int i = pos; i < m_items.count(); ++i)
+    {
+        m_gridLayout->addWidget(m_items[i], i / 4, i % 4, Qt::AlignLeft | Qt::AlignTop);
+    }
 }
 
 void MusicScreenSaverListWidget::resizeWindow()
@@ -106,6 +106,10 @@ public:
      * Set item status.
      */
     void setStatus(int index, bool status);
+    /*!
+     * Get item index.
+     */
+    inline int index() const { return m_index; }
     /*!
      * Set item visible or not.
      */
@@ -117,6 +121,7 @@ private:
      */
     virtual void enterEvent(QtEnterEvent *event) override final;
 
+    int m_index;
     MusicScreenSaverHoverItem *m_hoverItem;
 
 };
@@ -27,8 +27,16 @@
 struct TTK_MODULE_EXPORT MusicBarrageRecord
 {
     int m_size;
+    qint64 m_time;
     QString m_color;
     QString m_value;
+
+    MusicBarrageRecord()
+        : m_size(20),
+          m_time(-1)
+    {
+
+    }
 };
 TTK_DECLARE_LIST(MusicBarrageRecord);
 
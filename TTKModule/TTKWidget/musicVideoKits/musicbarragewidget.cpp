@@ -1,53 +1,155 @@
 #include "musicbarragewidget.h"
-#include "musicwidgetutils.h"
 #include "musicbarragerequest.h"
 
-MusicBarrageAnimation::MusicBarrageAnimation(QObject *parent)
-    : QPropertyAnimation(parent)
+#include <QPainter>
+#include <algorithm>
+
+static constexpr int ATLAS_PAGE_WIDTH = 1024;
+static constexpr int ATLAS_PAGE_HEIGHT = 512;
+
+static constexpr int BARRAGE_DURATION = 8 * TTK_DN_S2MS;
+static constexpr int BARRAGE_SPACING = 24;
+static constexpr int FRAME_INTERVAL = 16;
+
+MusicBarrageAtlas::MusicBarrageAtlas()
+    : m_current(-1)
 {
-    initialize();
+
 }
 
-MusicBarrageAnimation::MusicBarrageAnimation(QObject *target, const QByteArray &name, QObject *parent)
-    : QPropertyAnimation(target, name, parent)
+MusicBarrageAtlas::Sprite MusicBarrageAtlas::sprite(const MusicBarrageRecord &record, const QFont &font)
 {
-    initialize();
+    const QString &key = QString("%1|%2|%3").arg(record.m_size).arg(record.m_color, record.m_value);
+    const auto it = m_sprites.constFind(key);
+    if(it != m_sprites.constEnd())
+    {
+        return it.value();
+    }
+
+    QFont f(font);
+    f.setPointSize(record.m_size);
+    const QFontMetrics ftm(f);
+    // one pixel more for the shadow
+    const QSize size(qMin(QtFontWidth(ftm, record.m_value) + 1, ATLAS_PAGE_WIDTH), qMin(ftm.height() + 1, ATLAS_PAGE_HEIGHT));
+
+    QPoint pos;
+    Sprite sprite;
+    sprite.m_page = allocate(size, &pos);
+    sprite.m_rect = QRect(pos, size);
+
+    Page &page = m_pages[sprite.m_page];
+    QPainter painter(&page.m_image);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(sprite.m_rect, Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.setFont(f);
+    painter.setPen(QColor(0, 0, 0, 160));
+    painter.drawText(sprite.m_rect.translated(1, 1), Qt::AlignLeft | Qt::AlignTop, record.m_value);
+    painter.setPen(QColor(record.m_color));
+    painter.drawText(sprite.m_rect, Qt::AlignLeft | Qt::AlignTop, record.m_value);
+
+    page.m_keys << key;
+    m_sprites.insert(key, sprite);
+    return sprite;
 }
 
-void MusicBarrageAnimation::animationFinished()
+void MusicBarrageAtlas::retain(int page)
 {
-    setDuration(TTK::random(10 * TTK_DN_S2MS) + TTK_DN_S2MS);
-    setSize(m_parentSize);
-    start();
+    ++m_pages[page].m_refs;
 }
 
-void MusicBarrageAnimation::setSize(const QSize &size)
+void MusicBarrageAtlas::release(int page)
 {
-    m_parentSize = size;
-    const int height = TTK::random(size.height());
-    setStartValue(QPoint(0, height));
-    setEndValue(QPoint(size.width(), height));
+    --m_pages[page].m_refs;
 }
 
-void MusicBarrageAnimation::initialize()
+void MusicBarrageAtlas::clear()
 {
-    setDuration(TTK::random(10000) + TTK_DN_S2MS);
-    setEasingCurve(QEasingCurve::Linear);
+    m_current = -1;
+    m_pages.clear();
+    m_sprites.clear();
+}
+
+int MusicBarrageAtlas::allocate(const QSize &size, QPoint *pos)
+{
+    if(m_current != -1)
+    {
+        Page &page = m_pages[m_current];
+        if(page.m_x + size.width() > ATLAS_PAGE_WIDTH)
+        {
+            // next shelf
+            page.m_x = 0;
+            page.m_y += page.m_shelf;
+            page.m_shelf = 0;
+        }
+
+        if(page.m_y + size.height() <= ATLAS_PAGE_HEIGHT)
+        {
+            *pos = QPoint(page.m_x, page.m_y);
+            page.m_x += size.width();
+            page.m_shelf = qMax(page.m_shelf, size.height());
+            return m_current;
+        }
+    }
+
+    // current page is full, recycle one page without shown sprites or add a new one
+    int index = -1;
+    for(int i = 0; i < m_pages.count(); ++i)
+    {
+        if(i != m_current && m_pages[i].m_refs == 0)
+        {
+            index = i;
+            break;
+        }
+    }
 
-    connect(this, SIGNAL(finished()), SLOT(animationFinished()));
+    if(index == -1)
+    {
+        Page page;
+        page.m_image = QImage(ATLAS_PAGE_WIDTH, ATLAS_PAGE_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+        page.m_refs = 0;
+        m_pages << page;
+        index = m_pages.count() - 1;
+    }
+
+    Page &page = m_pages[index];
+    for(const QString &key : qAsConst(page.m_keys))
+    {
+        m_sprites.remove(key);
+    }
+
+    page.m_keys.clear();
+    page.m_image.fill(Qt::transparent);
+    page.m_x = size.width();
+    page.m_y = 0;
+    page.m_shelf = size.height();
+
+    m_current = index;
+    *pos = QPoint(0, 0);
+    return m_current;
 }
 
 
-MusicBarrageWidget::MusicBarrageWidget(QObject *parent)
-    : QObject(parent),
+MusicBarrageWidget::MusicBarrageWidget(QWidget *parent)
+    : QWidget(parent),
       m_state(false),
-      m_parent(TTKObjectCast(QWidget*, parent))
+      m_playing(false),
+      m_cursor(0),
+      m_laneHeight(1),
+      m_base(0)
 {
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NoSystemBackground);
+    hide();
+
+    // the smallest barrage size is the lane unit, bigger barrages take more lanes
+    QFont f(font());
+    f.setPointSize(15);
+    m_laneHeight = qMax(1, QFontMetrics(f).height() + 1);
 
-    m_sizeTimer = new QTimer(this);
-    m_sizeTimer->setSingleShot(true);
-    m_sizeTimer->setInterval(TTK_DN_S2MS / 2);
-    connect(m_sizeTimer, SIGNAL(timeout()), SLOT(sizeChanged()));
+    m_timer = new QTimer(this);
+    m_timer->setInterval(FRAME_INTERVAL);
+    connect(m_timer, SIGNAL(timeout()), SLOT(updateRender()));
 
     m_networkRequest = new MusicBarrageRequest(this);
     connect(m_networkRequest, SIGNAL(downLoadRawDataChanged(QByteArray)), SLOT(downLoadFinished(QByteArray)));
@@ -55,54 +157,40 @@ MusicBarrageWidget::MusicBarrageWidget(QObject *parent)
 
 MusicBarrageWidget::~MusicBarrageWidget()
 {
-    m_sizeTimer->stop();
-    delete m_sizeTimer;
-    clearItems();
+    m_timer->stop();
+    delete m_timer;
     delete m_networkRequest;
 }
 
 void MusicBarrageWidget::start()
 {
-    if(!m_state)
+    if(!m_playing)
     {
-        return;
+        m_playing = true;
+        m_clock.start();
     }
 
-    for(int i = 0; i < m_labels.count(); ++i)
+    if(m_state)
     {
-        m_labels[i]->show();
-        m_animations[i]->start();
+        m_timer->start();
     }
 }
 
 void MusicBarrageWidget::pause()
 {
-    if(!m_state)
-    {
-        return;
-    }
-
-    for(int i = 0; i < m_labels.count(); ++i)
+    if(m_playing)
     {
-        m_labels[i]->hide();
-        m_animations[i]->pause();
+        m_base = currentTime();
+        m_playing = false;
     }
+    m_timer->stop();
 }
 
 void MusicBarrageWidget::stop()
 {
-    for(int i = 0; i < m_labels.count(); ++i)
-    {
-        m_labels[i]->hide();
-        m_animations[i]->stop();
-    }
-}
-
-void MusicBarrageWidget::setSize(const QSize &size)
-{
-    stop();
-    m_parentSize = size;
-    m_sizeTimer->start();
+    m_playing = false;
+    m_timer->stop();
+    seek(0);
 }
 
 void MusicBarrageWidget::setBarrage(const QString &name, const QString &id)
@@ -117,147 +205,253 @@ void MusicBarrageWidget::setBarrage(const QString &name, const QString &id)
     m_networkRequest->startToRequest(name);
 }
 
+void MusicBarrageWidget::setPosition(qint64 position)
+{
+    // the player reports whole seconds, the local clock fills the gaps between them
+    const qint64 time = currentTime();
+    if(qAbs(time - position) > 2 * TTK_DN_S2MS)
+    {
+        seek(position);
+    }
+    else if(time < position || time - position > TTK_DN_S2MS)
+    {
+        m_base = position;
+        m_clock.start();
+    }
+}
+
 void MusicBarrageWidget::barrageStateChanged(bool on)
 {
     m_state = on;
-    if(m_state && !m_barrageRecords.isEmpty())
+    setVisible(m_state);
+
+    if(m_state && m_playing)
     {
-        clearItems();
-        createLabel();
-        createAnimation();
-        start();
+        m_timer->start();
     }
     else
     {
-        stop();
+        m_timer->stop();
     }
 }
 
 void MusicBarrageWidget::addBarrage(const MusicBarrageRecord &record)
 {
-    TTK::initRandom();
+    MusicBarrageRecord item(record);
+    item.m_time = currentTime();
 
-    QLabel *label = createLabel(record);
-    createAnimation(label);
-    m_barrageRecords << record;
+    int index = m_barrageRecords.count();
+    while(index > 0 && m_barrageRecords[index - 1].m_time > item.m_time)
+    {
+        --index;
+    }
 
-    if(m_state)
+    m_barrageRecords.insert(index, item);
+    if(index < m_cursor)
     {
-        start();
+        // the schedule has passed it already
+        ++m_cursor;
+        launch(item, item.m_time);
     }
 }
 
-void MusicBarrageWidget::sizeChanged()
+void MusicBarrageWidget::updateRender()
 {
-    for(MusicBarrageAnimation *animation : qAsConst(m_animations))
+    const qint64 time = currentTime();
+    for(int i = m_items.count() - 1; i >= 0; --i)
     {
-        animation->setSize(m_parentSize);
+        if(time - m_items[i].m_start >= BARRAGE_DURATION)
+        {
+            m_atlas.release(m_items[i].m_sprite.m_page);
+            m_items.remove(i);
+        }
+    }
+
+    for(; m_cursor < m_barrageRecords.count(); ++m_cursor)
+    {
+        const MusicBarrageRecord &record = m_barrageRecords[m_cursor];
+        if(record.m_time > time)
+        {
+            break;
+        }
+
+        // skip the barrages which are already out of the screen
+        if(time - record.m_time < BARRAGE_DURATION)
+        {
+            launch(record, record.m_time);
+        }
     }
 
-    start();
+    update();
 }
 
 void MusicBarrageWidget::downLoadFinished(const QByteArray &bytes)
 {
     TTKAbstractXml xml;
-    if(xml.fromByteArray(bytes))
+    if(!xml.fromByteArray(bytes))
+    {
+        return;
+    }
+
+    const TTKXmlNodeList &nodes = xml.readMultiNodeByTagName("d");
+    MusicBarrageRecordList records;
+    records.reserve(nodes.count());
+
+    for(const TTKXmlNode &node : qAsConst(nodes))
     {
-        for(const TTKXmlNode &node : xml.readMultiNodeByTagName("d"))
+        QString attrValue;
+        for(const TTKXmlAttr &attr : qAsConst(node.m_attrs))
         {
-            if(m_barrageRecords.count() > 20) // limit size
+            if(attr.m_key == "p")
             {
+                attrValue = attr.m_value.toString();
                 break;
             }
+        }
 
-            QString attrValue;
-            for(const TTKXmlAttr &attr : qAsConst(node.m_attrs))
-            {
-                if(attr.m_key == "p")
-                {
-                    attrValue = attr.m_value.toString();
-                    break;
-                }
-            }
+        const QStringList &keys = attrValue.split(",");
+        if(keys.count() < 8 || node.m_text.isEmpty())
+        {
+            continue;
+        }
 
-            if(!attrValue.isEmpty())
-            {
-                const QStringList &keys = attrValue.split(",");
-                if(keys.count() < 8)
-                {
-                    continue;
-                }
-
-                const int size = keys[2].toInt();
-
-                MusicBarrageRecord record;
-                if(size < 25)
-                {
-                    record.m_size = 15;
-                }
-                else if(size > 25)
-                {
-                    record.m_size = 30;
-                }
-                else
-                {
-                    record.m_size = 20;
-                }
-
-                record.m_color = QColor(keys[3].toInt()).name();
-                record.m_value = node.m_text;
-                addBarrage(record);
-            }
+        const int size = keys[2].toInt();
+
+        MusicBarrageRecord record;
+        if(size < 25)
+        {
+            record.m_size = 15;
+        }
+        else if(size > 25)
+        {
+            record.m_size = 30;
+        }
+        else
+        {
+            record.m_size = 20;
         }
+
+        record.m_time = keys[0].toDouble() * TTK_DN_S2MS;
+        record.m_color = QColor(keys[3].toInt()).name();
+        record.m_value = node.m_text;
+        records << record;
     }
-}
 
-void MusicBarrageWidget::clearItems()
-{
-    qDeleteAll(m_labels);
-    qDeleteAll(m_animations);
-    m_labels.clear();
-    m_animations.clear();
+    std::stable_sort(records.begin(), records.end(), [](const MusicBarrageRecord &a, const MusicBarrageRecord &b)
+    {
+        return a.m_time < b.m_time;
+    });
+
+    m_barrageRecords = records;
+    seek(currentTime());
 }
 
-void MusicBarrageWidget::createLabel()
+void MusicBarrageWidget::paintEvent(QPaintEvent *event)
 {
-    TTK::initRandom();
-    for(const MusicBarrageRecord &record : qAsConst(m_barrageRecords))
+    Q_UNUSED(event);
+    if(m_items.isEmpty())
+    {
+        return;
+    }
+
+    const qint64 time = currentTime();
+    const int w = width();
+
+    QPainter painter(this);
+    for(const Item &item : qAsConst(m_items))
     {
-        createLabel(record);
+        const QPointF pos(w - (time - item.m_start) * item.m_speed, item.m_y);
+        painter.drawImage(pos, m_atlas.page(item.m_sprite.m_page), item.m_sprite.m_rect);
     }
 }
 
-void MusicBarrageWidget::clearBarrages()
+void MusicBarrageWidget::resizeEvent(QResizeEvent *event)
 {
-    clearItems();
-    m_barrageRecords.clear();
+    QWidget::resizeEvent(event);
+    seek(currentTime());
 }
 
-QLabel *MusicBarrageWidget::createLabel(const MusicBarrageRecord &record)
+qint64 MusicBarrageWidget::currentTime() const
 {
-    QLabel *label = new QLabel(m_parent);
-    label->setStyleSheet(QString("QLabel{ color:%1; }").arg(record.m_color));
-    label->setText(record.m_value);
-
-    TTK::Widget::setFontSize(label, record.m_size);
-    label->resize(TTK::Widget::fontTextWidth(label->font(), label->text()), TTK::Widget::fontTextHeight(label->font()));
-    label->hide();
-    m_labels << label;
-    return label;
+    return m_playing ? m_base + m_clock.elapsed() : m_base;
 }
 
-void MusicBarrageWidget::createAnimation()
+void MusicBarrageWidget::seek(qint64 time)
 {
-    for(QLabel *label : qAsConst(m_labels))
+    for(const Item &item : qAsConst(m_items))
+    {
+        m_atlas.release(item.m_sprite.m_page);
+    }
+    m_items.clear();
+
+    m_lanes.fill(Lane{0, 0, 0}, qMax(1, height() / m_laneHeight));
+
+    m_base = time;
+    if(m_playing)
     {
-        createAnimation(label);
+        m_clock.start();
+    }
+
+    // first record not before the time, the ones a little earlier are still in the screen
+    const qint64 from = time - BARRAGE_DURATION;
+    m_cursor = std::lower_bound(m_barrageRecords.begin(), m_barrageRecords.end(), from, [](const MusicBarrageRecord &record, qint64 value)
+    {
+        return record.m_time < value;
+    }) - m_barrageRecords.begin();
+
+    update();
+}
+
+void MusicBarrageWidget::launch(const MusicBarrageRecord &record, qint64 time)
+{
+    const MusicBarrageAtlas::Sprite &sprite = m_atlas.sprite(record, font());
+    const int w = width();
+    const float speed = float(w + sprite.m_rect.width()) / BARRAGE_DURATION;
+    // the lane is free when the previous tail is in the screen, and a faster head can not catch it before it leaves
+    const qint64 enter = time + (sprite.m_rect.width() + BARRAGE_SPACING) / speed;
+    const qint64 reach = time + w / speed;
+    const int span = (sprite.m_rect.height() + m_laneHeight - 1) / m_laneHeight;
+
+    for(int i = 0; i + span <= m_lanes.count(); ++i)
+    {
+        bool free = true;
+        for(int j = i; j < i + span; ++j)
+        {
+            const Lane &lane = m_lanes[j];
+            if(time < lane.m_enter || (speed > lane.m_speed && reach < lane.m_leave))
+            {
+                free = false;
+                break;
+            }
+        }
+
+        if(!free)
+        {
+            continue;
+        }
+
+        for(int j = i; j < i + span; ++j)
+        {
+            m_lanes[j].m_enter = enter;
+            m_lanes[j].m_leave = time + BARRAGE_DURATION;
+            m_lanes[j].m_speed = speed;
+        }
+
+        Item item;
+        item.m_sprite = sprite;
+        item.m_start = time;
+        item.m_speed = speed;
+        item.m_y = i * m_laneHeight;
+
+        m_atlas.retain(sprite.m_page);
+        m_items << item;
+        return;
     }
 }
 
-void MusicBarrageWidget::createAnimation(QLabel *label)
+void MusicBarrageWidget::clearBarrages()
 {
-    MusicBarrageAnimation *anim = new MusicBarrageAnimation(label, "pos");
-    anim->setSize(m_parentSize);
-    m_animations << anim;
+    m_barrageRecords.clear();
+    seek(0);
+    m_atlas.clear();
 }
@@ -19,43 +19,67 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ***************************************************************************/
 
+
+#include <QElapsedTimer>
 #include "musicwidgetheaders.h"
 #include "musicbarragerecord.h"
 
-#include <QPropertyAnimation>
-
-/*! @brief The class of the barrage animation.
+/*! @brief The class of the barrage glyph atlas.
  * @author Greedysky <greedysky@163.com>
  */
-class TTK_MODULE_EXPORT MusicBarrageAnimation : public QPropertyAnimation
+class TTK_MODULE_EXPORT MusicBarrageAtlas
 {
-    Q_OBJECT
-    TTK_DECLARE_MODULE(MusicBarrageAnimation)
 public:
+    struct Sprite
+    {
+        int m_page;
+        QRect m_rect;
+    };
+
     /*!
      * Object constructor.
      */
-    explicit MusicBarrageAnimation(QObject *parent = nullptr);
-    MusicBarrageAnimation(QObject *target, const QByteArray &name, QObject *parent = nullptr);
+    MusicBarrageAtlas();
 
     /*!
-     * Set animation region size.
+     * Get the sprite of the record, render it into a page on first use.
      */
-    void setSize(const QSize &size);
+    Sprite sprite(const MusicBarrageRecord &record, const QFont &font);
+    /*!
+     * Get the page image by index.
+     */
+    inline const QImage &page(int index) const { return m_pages[index].m_image; }
 
-private Q_SLOTS:
     /*!
-     * Current animation is finished.
+     * Mark one sprite of the page in use, pages in use are never recycled.
      */
-    void animationFinished();
+    void retain(int page);
+    /*!
+     * Mark one sprite of the page not in use.
+     */
+    void release(int page);
+    /*!
+     * Drop all pages.
+     */
+    void clear();
 
 private:
+    struct Page
+    {
+        QImage m_image;
+        int m_x, m_y, m_shelf;
+        int m_refs;
+        QStringList m_keys;
+    };
+
     /*!
-     * Init parameters.
+     * Find the space of size in the pages, recycle unused pages when full.
      */
-    void initialize();
+    int allocate(const QSize &size, QPoint *pos);
 
-    QSize m_parentSize;
+    int m_current;
+    QVector<Page> m_pages;
+    QHash<QString, Sprite> m_sprites;
 
 };
 
@@ -65,7 +89,7 @@ class MusicBarrageRequest;
 /*! @brief The class of the barrage widget.
  * @author Greedysky <greedysky@163.com>
  */
-class TTK_MODULE_EXPORT MusicBarrageWidget : public QObject
+class TTK_MODULE_EXPORT MusicBarrageWidget : public QWidget
 {
     Q_OBJECT
     TTK_DECLARE_MODULE(MusicBarrageWidget)
@@ -73,7 +97,7 @@ public:
     /*!
      * Object constructor.
      */
-    explicit MusicBarrageWidget(QObject *parent = nullptr);
+    explicit MusicBarrageWidget(QWidget *parent = nullptr);
     /*!
      * Object destructor.
      */
@@ -92,14 +116,14 @@ public:
      */
     void stop();
 
-    /*!
-     * Set animation region size.
-     */
-    void setSize(const QSize &size);
     /*!
      * Set barrage play data.
      */
     void setBarrage(const QString &name, const QString &id);
+    /*!
+     * Set current media position in ms, barrages are scheduled against it.
+     */
+    void setPosition(qint64 position);
 
 public Q_SLOTS:
     /*!
@@ -107,15 +131,15 @@ public Q_SLOTS:
      */
     void barrageStateChanged(bool on);
     /*!
-     * Add barrage record.
+     * Add barrage record at current position.
      */
     void addBarrage(const MusicBarrageRecord &record);
 
 private Q_SLOTS:
     /*!
-     * Region size changed.
+     * Advance barrages to the current time.
      */
-    void sizeChanged();
+    void updateRender();
     /*!
      * Send recieved data from net.
      */
@@ -123,37 +147,52 @@ private Q_SLOTS:
 
 private:
     /*!
-     * Clear all items.
+     * Override the widget event.
      */
-    void clearItems();
-    /*!
-     * Create barrage item label.
-     */
-    void createLabel();
+    virtual void paintEvent(QPaintEvent *event) override final;
+    virtual void resizeEvent(QResizeEvent *event) override final;
+
+    struct Item
+    {
+        MusicBarrageAtlas::Sprite m_sprite;
+        qint64 m_start;
+        float m_speed;
+        int m_y;
+    };
+
+    struct Lane
+    {
+        qint64 m_enter;
+        qint64 m_leave;
+        float m_speed;
+    };
+
     /*!
-     * Clear all barrage.
+     * Get current media time in ms.
      */
-    void clearBarrages();
+    qint64 currentTime() const;
     /*!
-     * Create barrage item label by object.
+     * Drop the shown barrages and restart the schedule from the time.
      */
-    QLabel *createLabel(const MusicBarrageRecord &record);
+    void seek(qint64 time);
     /*!
-     * Create barrage animation.
+     * Place the record into free lanes, drop it when all lanes are busy.
      */
-    void createAnimation();
+    void launch(const MusicBarrageRecord &record, qint64 time);
     /*!
-     * Create barrage animation by object.
+     * Clear all barrage.
      */
-    void createAnimation(QLabel *label);
+    void clearBarrages();
 
-    bool m_state;
-    QSize m_parentSize;
-    QWidget *m_parent;
-    QTimer *m_sizeTimer;
+    bool m_state, m_playing;
+    int m_cursor, m_laneHeight;
+    qint64 m_base;
+    QElapsedTimer m_clock;
+    QTimer *m_timer;
     QString m_lastQueryID;
-    QList<QLabel*> m_labels;
-    QList<MusicBarrageAnimation*> m_animations;
+    QVector<Item> m_items;
+    QVector<Lane> m_lanes;
+    MusicBarrageAtlas m_atlas;
     MusicBarrageRecordList m_barrageRecords;
     MusicBarrageRequest *m_networkRequest;
 
@@ -119,7 +119,7 @@ void MusicVideoView::resizeGeometry(int width, int height)
 {
     m_videoWidget->setGeometry(20, 20, 640 + width, 372 + height);
     m_videoControl->setGeometry(0, 413 + height, 680 + width, 60);
-    m_barrageWidget->setSize(m_videoWidget->size());
+    m_barrageWidget->setGeometry(m_videoWidget->geometry());
 }
 
 void MusicVideoView::createRightMenu()
@@ -171,6 +171,7 @@ void MusicVideoView::stop()
 void MusicVideoView::positionChanged(qint64 position)
 {
     m_videoControl->setValue(position);
+    m_barrageWidget->setPosition(position * TTK_DN_S2MS);
 }
 
 void MusicVideoView::durationChanged(qint64 duration)
@@ -1,5 +1,5 @@
 #include "musicbackgroundlistwidget.h"
-#include "musicextractwrapper.h"
+#include "musicskinthumbnailloader.h"
 #include "musictoastlabel.h"
 #include "musicwidgetutils.h"
 
@@ -17,18 +17,6 @@ MusicBackgroundListItem::MusicBackgroundListItem(QWidget *parent)
     setCursor(Qt::PointingHandCursor);
 }
 
-void MusicBackgroundListItem::updatePixmap()
-{
-    if(!m_path.isEmpty())
-    {
-        MusicBackgroundImage image;
-        if(MusicExtractWrapper::outputSkin(&image, m_path))
-        {
-            updatePixmap(image);
-        }
-    }
-}
-
 void MusicBackgroundListItem::updatePixmap(const MusicBackgroundImage &image)
 {
     m_imageInfo = image.m_item;
@@ -143,10 +131,14 @@ MusicBackgroundListWidget::MusicBackgroundListWidget(QWidget *parent)
     m_gridLayout->setAlignment(Qt::AlignLeft | Qt::AlignTop);
     m_gridLayout->setContentsMargins(7, 0, 7, 0);
     setLayout(m_gridLayout);
+
+    m_loader = new MusicSkinThumbnailLoader(this);
+    connect(m_loader, SIGNAL(finished(QString,QPixmap,MusicSkinItem)), SLOT(thumbnailFinished(QString,QPixmap,MusicSkinItem)));
 }
 
 MusicBackgroundListWidget::~MusicBackgroundListWidget()
 {
+    m_loader->abort();
     clearItems();
     delete m_gridLayout;
 }
@@ -197,7 +189,20 @@ void MusicBackgroundListWidget::addCellItem(const QString &name, const QString &
     item->setCloseEnabled(state);
     item->setFileName(name);
     item->setFilePath(path);
-    item->updatePixmap();
+
+    // the skin config arrives with the thumbnail, the item matches no skin until then
+    MusicSkinItem info;
+    info.m_name.clear();
+    info.m_useCount = 0;
+    item->setImageInfo(info);
+
+    // show placeholder until the thumbnail is decoded
+    if(m_placeholder.isNull())
+    {
+        m_placeholder = QPixmap(":/image/lb_none_image").scaled(item->size());
+    }
+    item->setPixmap(m_placeholder);
+    m_loader->load(path, item->size());
 
     connect(item, SIGNAL(itemClicked(MusicBackgroundListItem*)), SLOT(currentItemClicked(MusicBackgroundListItem*)));
     connect(item, SIGNAL(closeClicked(MusicBackgroundListItem*)), SLOT(itemCloseClicked(MusicBackgroundListItem*)));
@@ -205,19 +210,32 @@ void MusicBackgroundListWidget::addCellItem(const QString &name, const QString &
     m_items << item;
 }
 
-void MusicBackgroundListWidget::updateItem(const MusicBackgroundImage &image, const QString &path)
+void MusicBackgroundListWidget::updateItem(int index, const MusicBackgroundImage &image, const QString &path)
 {
-    for(MusicBackgroundListItem *item : qAsConst(m_items))
+    if(index < 0 || index >= m_items.count())
     {
-        if(item->fileName().isEmpty())
+        return;
+    }
+
+    MusicBackgroundListItem *item = m_items[index];
+    item->setShowNameEnabled(false);
+    item->setSelectEnabled(false);
+    item->setFileName(path);
+    item->updatePixmap(image);
+}
+
+TTKIntList MusicBackgroundListWidget::visibleItems() const
+{
+    TTKIntList items;
+    for(int i = 0; i < m_items.count(); ++i)
+    {
+        // clipped by the scroll area view port
+        if(!m_items[i]->visibleRegion().isEmpty())
         {
-            item->setShowNameEnabled(false);
-            item->setSelectEnabled(false);
-            item->setFileName(path);
-            item->updatePixmap(image);
-            break;
+            items << i;
         }
     }
+    return items;
 }
 
 bool MusicBackgroundListWidget::contains(const QString &name) const
@@ -304,6 +322,7 @@ void MusicBackgroundListWidget::itemCloseClicked(MusicBackgroundListItem *item)
     const int index = find(item);
     const int cIndex = find(m_currentItem);
     QFile::remove(item->filePath());
+    MusicSkinThumbnailLoader::remove(item->filePath(), item->size());
     m_gridLayout->removeWidget(item);
     m_items.takeAt(index)->deleteLater();
 
@@ -333,3 +352,16 @@ void MusicBackgroundListWidget::currentItemClicked(MusicBackgroundListItem *item
     m_currentItem->setSelected(true);
     Q_EMIT itemClicked(m_type, item->fileName());
 }
+
+void MusicBackgroundListWidget::thumbnailFinished(const QString &path, const QPixmap &pixmap, const MusicSkinItem &info)
+{
+    for(MusicBackgroundListItem *item : qAsConst(m_items))
+    {
+        if(item->filePath() == path)
+        {
+            item->setImageInfo(info);
+            item->setPixmap(pixmap);
+            break;
+        }
+    }
+}
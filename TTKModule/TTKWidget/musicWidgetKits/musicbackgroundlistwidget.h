@@ -23,6 +23,8 @@
 #include <QGridLayout>
 #include "musicbackgroundconfigmanager.h"
 
+class MusicSkinThumbnailLoader;
+
 /*! @brief The class of the background list item.
  * @author Greedysky <greedysky@163.com>
  */
@@ -54,9 +56,10 @@ public:
     inline QString filePath() const { return m_path; }
 
     /*!
-     * Update pix image.
+     * Set item skin config.
      */
-    void updatePixmap();
+    inline void setImageInfo(const MusicSkinItem &item) { m_imageInfo = item; }
+
     /*!
      * Update pix image.
      */
@@ -187,9 +190,13 @@ public:
     void addCellItem(const QString &name, const QString &path, bool state);
 
     /*!
-     * Update item by backgroud image.
+     * Update item by index and backgroud image.
      */
-    void updateItem(const MusicBackgroundImage &image, const QString &path);
+    void updateItem(int index, const MusicBackgroundImage &image, const QString &path);
+    /*!
+     * Get the indexes of the items shown in the view port.
+     */
+    TTKIntList visibleItems() const;
 
     /*!
      * Current item contains or not.
@@ -238,12 +245,18 @@ private Q_SLOTS:
      * Current item has clicked.
      */
     void currentItemClicked(MusicBackgroundListItem *item);
+    /*!
+     * Skin thumbnail and config of item are ready.
+     */
+    void thumbnailFinished(const QString &path, const QPixmap &pixmap, const MusicSkinItem &info);
 
 private:
     Module m_type;
+    QPixmap m_placeholder;
     QGridLayout *m_gridLayout;
     MusicBackgroundListItem *m_currentItem;
     QList<MusicBackgroundListItem*> m_items;
+    MusicSkinThumbnailLoader *m_loader;
 
 };
 
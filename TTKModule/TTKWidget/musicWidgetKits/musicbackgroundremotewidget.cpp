@@ -54,7 +54,7 @@ void MusicBackgroundRemoteWidget::downLoadFinished(const QString &bytes)
         image.m_pix = QPixmap(":/image/lb_none_image");
     }
 
-    m_backgroundList->updateItem(image, bytes);
+    m_backgroundList->updateItem(m_paths.indexOf(bytes), image, bytes);
 }
 
 void MusicBackgroundRemoteWidget::downLoadFinished(const MusicSkinRemoteGroupList &bytes)
@@ -73,6 +73,7 @@ void MusicBackgroundRemoteWidget::startToRequest(const QString &prefix)
     QDir().mkpath(path);
 
     m_backgroundList->clearItems();
+    m_paths.clear();
 
     MusicDownloadQueueDataList datas;
     for(const MusicSkinRemoteItem &item : qAsConst(m_groups[m_currentIndex].m_items))
@@ -82,12 +83,33 @@ void MusicBackgroundRemoteWidget::startToRequest(const QString &prefix)
         data.m_url = item.m_url;
         data.m_path = QString("%1/%2%3").arg(path).arg(item.m_index).arg(prefix);
         datas << data;
+        m_paths << data.m_path;
+    }
+
+    for(QWidget *widget = parentWidget(); widget; widget = widget->parentWidget())
+    {
+        QAbstractScrollArea *area = TTKObjectCast(QAbstractScrollArea*, widget);
+        if(area)
+        {
+            connect(area->verticalScrollBar(), SIGNAL(valueChanged(int)), SLOT(updatePriority()), Qt::UniqueConnection);
+            break;
+        }
     }
 
     m_networkRequest->addImageQueue(datas);
+    updatePriority();
     m_networkRequest->startToRequest();
 }
 
+void MusicBackgroundRemoteWidget::updatePriority()
+{
+    const TTKIntList &items = m_backgroundList->visibleItems();
+    for(int i = 0; i < m_paths.count(); ++i)
+    {
+        m_networkRequest->setPriority(m_paths[i], items.contains(i) ? 1 : 0);
+    }
+}
+
 
 
 MusicBackgroundDailyWidget::MusicBackgroundDailyWidget(QWidget *parent)
@@ -64,6 +64,12 @@ public Q_SLOTS:
      */
     virtual void downLoadFinished(const MusicSkinRemoteGroupList &bytes);
 
+private Q_SLOTS:
+    /*!
+     * Download the items shown in the view port first.
+     */
+    void updatePriority();
+
 protected:
     /*!
      * Start to download background data by suffix.
@@ -71,6 +77,7 @@ protected:
     void startToRequest(const QString &suffix);
 
     int m_currentIndex;
+    QStringList m_paths;
     MusicSkinRemoteGroupList m_groups;
     MusicBackgroundListWidget *m_backgroundList;
     MusicDownloadQueueRequest *m_networkRequest;
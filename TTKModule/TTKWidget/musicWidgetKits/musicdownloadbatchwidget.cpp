@@ -196,6 +196,7 @@ void MusicDownloadBatchTableWidget::currentQualityChanged(int index)
 
 void MusicDownloadBatchTableWidget::startToRequest()
 {
+    // only queued here, the download manager limits the running ones
     for(MusicDownloadBatchTableItem *item : qAsConst(m_items))
     {
         item->startToRequest();
@@ -1,7 +1,7 @@
 #include "musicdownloadwidget.h"
 #include "ui_musicdownloadwidget.h"
 #include "musicdownloadrecordconfigmanager.h"
-#include "musicdownloadmetadatarequest.h"
+#include "musicdownloadmanager.h"
 #include "musicdownloadqueryfactory.h"
 #include "musictoastlabel.h"
 #include "musicwidgetheaders.h"
@@ -197,7 +197,7 @@ void MusicDownloadWidget::initialize(const TTK::MusicSongInformation &info, Musi
     }
 }
 
-void MusicDownloadWidget::startToRequestMusic(const TTK::MusicSongInformation &info, int bitrate, QObject *parent)
+void MusicDownloadWidget::startToRequestMusic(const TTK::MusicSongInformation &info, int bitrate, QObject *parent, int priority)
 {
     if(!G_NETWORK_PTR->isOnline() || info.m_songProps.isEmpty())
     {
@@ -261,22 +261,21 @@ void MusicDownloadWidget::startToRequestMusic(const TTK::MusicSongInformation &i
         }
     }
 
-    MusicDownloadMetaDataRequest *d = new MusicDownloadMetaDataRequest(prop.m_url, downloadPath, parent);
-    connect(d, SIGNAL(downLoadDataChanged(QString)), parent, SLOT(downloadFinished()));
-
-    MusicSongMeta meta;
-    meta.setComment(info.m_coverUrl);
-    meta.setTitle(info.m_songName);
-    meta.setArtist(info.m_artistName);
-    meta.setAlbum(info.m_albumName);
-    meta.setTrackNum(info.m_trackNumber);
-    meta.setYear(info.m_year);
-
-    d->setSongMeta(meta);
-    d->startToRequest();
+    MusicDownloadTaskData data;
+    data.m_priority = priority;
+    data.m_url = prop.m_url;
+    data.m_path = downloadPath;
+    data.m_type = TTK::Download::Music;
+    data.m_cover = info.m_coverUrl;
+    data.m_title = info.m_songName;
+    data.m_artist = info.m_artistName;
+    data.m_album = info.m_albumName;
+    data.m_trackNumber = info.m_trackNumber;
+    data.m_year = info.m_year;
+    G_DOWNLOAD_MANAGER_PTR->addTask(data, parent);
 }
 
-void MusicDownloadWidget::startToRequestMovie(const TTK::MusicSongInformation &info, int bitrate, QObject *parent)
+void MusicDownloadWidget::startToRequestMovie(const TTK::MusicSongInformation &info, int bitrate, QObject *parent, int priority)
 {
     if(!G_NETWORK_PTR->isOnline() || info.m_songProps.isEmpty())
     {
@@ -321,9 +320,12 @@ void MusicDownloadWidget::startToRequestMovie(const TTK::MusicSongInformation &i
         }
     }
 
-    MusicDownloadDataRequest *d = new MusicDownloadDataRequest(prop.m_url, downloadPath, TTK::Download::Video, parent);
-    connect(d, SIGNAL(downLoadDataChanged(QString)), parent, SLOT(downloadFinished()));
-    d->startToRequest();
+    MusicDownloadTaskData data;
+    data.m_priority = priority;
+    data.m_url = prop.m_url;
+    data.m_path = downloadPath;
+    data.m_type = TTK::Download::Video;
+    G_DOWNLOAD_MANAGER_PTR->addTask(data, parent);
 }
 
 void MusicDownloadWidget::downLoadNormalFinished()
@@ -455,13 +457,14 @@ void MusicDownloadWidget::startToRequest()
 
     hide(); ///hide download widget
 
+    // a single download goes ahead of the queued batch ones
     if(m_queryType == MusicAbstractQueryRequest::QueryType::Music)
     {
-        MusicDownloadWidget::startToRequestMusic(m_songInfo, bitrate, this);
+        MusicDownloadWidget::startToRequestMusic(m_songInfo, bitrate, this, 1);
     }
     else if(m_queryType == MusicAbstractQueryRequest::QueryType::Movie)
     {
-        MusicDownloadWidget::startToRequestMovie(m_songInfo, bitrate, this);
+        MusicDownloadWidget::startToRequestMovie(m_songInfo, bitrate, this, 1);
     }
     controlEnabled(false);
 }
@@ -135,13 +135,13 @@ public:
 
 public:
     /*!
-     * Strat to download music.
+     * Strat to download music, queued by priority in download manager.
      */
-    static void startToRequestMusic(const TTK::MusicSongInformation &info, int bitrate, QObject *parent);
+    static void startToRequestMusic(const TTK::MusicSongInformation &info, int bitrate, QObject *parent, int priority = 0);
     /*!
-     * Strat to download movie.
+     * Strat to download movie, queued by priority in download manager.
      */
-    static void startToRequestMovie(const TTK::MusicSongInformation &info, int bitrate, QObject *parent);
+    static void startToRequestMovie(const TTK::MusicSongInformation &info, int bitrate, QObject *parent, int priority = 0);
 
 Q_SIGNALS:
     /*!
@@ -347,6 +347,7 @@ void MusicSettingWidget::downloadCacheClean()
     dir.mkpath(ART_DIR_FULL);
     dir.mkpath(CACHE_DIR_FULL);
     dir.mkpath(BACKGROUND_DIR_FULL);
+    dir.mkpath(THUMBNAIL_DIR_FULL);
 
     MusicToastLabel::popup(tr("Cache is cleaned"));
 }
@@ -1,5 +1,5 @@
 #include "musicsongsearchonlinewidget.h"
-#include "musicsongsearchrecordconfigmanager.h"
+#include "musicsongsuggestservice.h"
 #include "musicdownloadbatchwidget.h"
 #include "musicconnectionpool.h"
 #include "musicdownloadqueryfactory.h"
@@ -42,22 +42,7 @@ void MusicSongSearchTableWidget::startToSearchByText(const QString &text)
         return;
     }
 
-    MusicSongSearchRecordConfigManager manager;
-    if(!manager.fromFile(SEARCH_PATH_FULL))
-    {
-        return;
-    }
-
-    MusicSearchRecordList records;
-    manager.readBuffer(records);
-
-    MusicSearchRecord record;
-    record.m_name = text;
-    record.m_timestamp = QString::number(TTKDateTime::currentTimestamp());
-    records.insert(0, record);
-
-    manager.reset();
-    manager.writeBuffer(records);
+    G_SUGGEST_PTR->addRecord(text);
 
     MusicItemSearchTableWidget::startToSearchByText(text);
 
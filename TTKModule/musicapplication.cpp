@@ -20,8 +20,13 @@
 #include "musictinyuiobject.h"
 #include "musicdispatchmanager.h"
 #include "musictkplconfigmanager.h"
+#include "musicplaylistsnapshot.h"
+#include "musicpersistservice.h"
+#include "musicdownloadmanager.h"
 #include "musicinputdialog.h"
 #include "ttkversion.h"
+#include "ttktracer.h"
+#include "ttkthreadpool.h"
 
 MusicApplication *MusicApplication::m_instance = nullptr;
 
@@ -31,15 +36,22 @@ MusicApplication::MusicApplication(QWidget *parent)
       m_quitWindowMode(false),
       m_currentSongTreeIndex(TTK_NORMAL_LEVEL)
 {
+    TTK_TRACE_SCOPE("MusicApplication");
     m_instance = this;
 
-    m_applicationObject = new MusicApplicationModule(this);
-    m_topAreaWidget = new MusicTopAreaWidget(this);
-    m_bottomAreaWidget = new MusicBottomAreaWidget(this);
-    m_rightAreaWidget = new MusicRightAreaWidget(this);
-    m_leftAreaWidget = new MusicLeftAreaWidget(this);
+    {
+        TTK_TRACE_SCOPE("area widgets");
+        m_applicationObject = new MusicApplicationModule(this);
+        m_topAreaWidget = new MusicTopAreaWidget(this);
+        m_bottomAreaWidget = new MusicBottomAreaWidget(this);
+        m_rightAreaWidget = new MusicRightAreaWidget(this);
+        m_leftAreaWidget = new MusicLeftAreaWidget(this);
+    }
 
-    m_ui->setupUi(this);
+    {
+        TTK_TRACE_SCOPE("setup ui");
+        m_ui->setupUi(this);
+    }
     const QSize &size = G_SETTING_PTR->value(MusicSettingManager::ScreenSize).toSize();
     setMinimumSize(WINDOW_WIDTH_MIN, WINDOW_HEIGHT_MIN);
     setMaximumSize(size.width(), size.height());
@@ -49,11 +61,14 @@ MusicApplication::MusicApplication(QWidget *parent)
     m_songTreeWidget = new MusicSongsContainerWidget(this);
     m_ui->songsContainer->addWidget(m_songTreeWidget);
 
-    m_bottomAreaWidget->setupUi(m_ui);
-    m_topAreaWidget->setupUi(m_ui);
-    m_rightAreaWidget->setupUi(m_ui);
-    m_leftAreaWidget->setupUi(m_ui);
-    m_topAreaWidget->backgroundAnimationChanged(false);
+    {
+        TTK_TRACE_SCOPE("area setup ui");
+        m_bottomAreaWidget->setupUi(m_ui);
+        m_topAreaWidget->setupUi(m_ui);
+        m_rightAreaWidget->setupUi(m_ui);
+        m_leftAreaWidget->setupUi(m_ui);
+        m_topAreaWidget->backgroundAnimationChanged(false);
+    }
 
     connect(m_rightAreaWidget, SIGNAL(updateBackgroundTheme()), m_topAreaWidget, SLOT(backgroundTransparentChanged()));
     connect(m_rightAreaWidget, SIGNAL(updateBackgroundThemeDownload()), m_topAreaWidget, SLOT(backgroundThemeDownloadFinished()));
@@ -87,12 +102,17 @@ MusicApplication::MusicApplication(QWidget *parent)
     /////////// Objects Mouse tracking;
     setObjectsTracking({m_ui->background, m_ui->songsContainer});
 
-    readSystemConfigFromFile();
+    {
+        TTK_TRACE_SCOPE("readSystemConfigFromFile");
+        readSystemConfigFromFile();
+    }
+    G_DOWNLOAD_MANAGER_PTR->resumeTasks();
     TTK_SIGNLE_SHOT(m_rightAreaWidget, showSongMainWidget, TTK_SLOT);
 }
 
 MusicApplication::~MusicApplication()
 {
+    G_PERSIST_PTR->flush();
     delete m_player;
     delete m_playlist;
     delete m_songTreeWidget;
@@ -102,6 +122,11 @@ MusicApplication::~MusicApplication()
     delete m_leftAreaWidget;
     delete m_applicationObject;
     delete m_ui;
+
+    // the pool outlives the other singletons, no task may run against them after here
+    TTKThreadPool::instance()->shutdown();
+    // the writes canceled while queued are still pending
+    G_PERSIST_PTR->flush();
 }
 
 MusicApplication *MusicApplication::instance()
@@ -179,6 +204,47 @@ void MusicApplication::importSongsOutsideMode(const QString &file, bool play)
     }
 }
 
+void MusicApplication::importSongsOutsideMode(const QList<QStringList> &messages)
+{
+    QStringList files;
+    QString playFile;
+    for(const QStringList &message : qAsConst(messages))
+    {
+        bool option = false, open = false, played = false;
+        for(const QString &arg : qAsConst(message))
+        {
+            if(arg == MUSIC_OUTSIDE_OPEN || arg == MUSIC_OUTSIDE_LIST)
+            {
+                option = true;
+                open = (arg == MUSIC_OUTSIDE_OPEN);
+            }
+            else if(option && !arg.isEmpty())
+            {
+                // each option may be followed by many paths, the first opened one of the latest message is played
+                if(open && !played)
+                {
+                    played = true;
+                    playFile = arg;
+                }
+                files << arg;
+            }
+        }
+    }
+
+    if(files.isEmpty())
+    {
+        return;
+    }
+
+    m_songTreeWidget->importMusicSongsByPath(files, MUSIC_NORMAL_LIST);
+    if(!playFile.isEmpty())
+    {
+        // songs already in the list are skipped by the import, so the song is found by its path
+        const int index = m_songTreeWidget->mapSongIndexByFilePath(MUSIC_NORMAL_LIST, playFile);
+        playIndexBy(index != -1 ? index : m_playlist->count() - 1, 0);
+    }
+}
+
 QString MusicApplication::containsDownloadItem(bool &contains) const
 {
     contains = false;
@@ -257,7 +323,7 @@ void MusicApplication::quitWindow()
     m_applicationObject->cleanup();
     m_applicationObject->windowCloseAnimation();
     //Write configuration files
-    writeSystemConfigToFile();
+    writeSystemConfigToFile(true);
 }
 
 void MusicApplication::positionChanged(qint64 position)
@@ -804,6 +870,11 @@ void MusicApplication::applyParameter()
     m_bottomAreaWidget->applyParameter();
 }
 
+void MusicApplication::saveParameter()
+{
+    writeSystemConfigToFile(false);
+}
+
 void MusicApplication::removeLoveItemAt(const QString &path, bool current)
 {
     removeItemAt({path}, false, current, MUSIC_LOVEST_LIST);
@@ -1034,13 +1105,26 @@ void MusicApplication::readSystemConfigFromFile()
     //Path configuration song
     MusicSongItemList songs;
     {
-        MusicTKPLConfigManager manager;
-        if(manager.fromFile(PLAYLIST_PATH_FULL))
+        TTK_TRACE_SCOPE("read playlist");
+        // the snapshot is used unless the tkpl was written after it
+        const QFileInfo snapshot(PLAYLIST_SNAPSHOT_PATH_FULL), playlist(PLAYLIST_PATH_FULL);
+        const bool fresh = snapshot.exists() && (!playlist.exists() || snapshot.lastModified() >= playlist.lastModified());
+
+        if(!fresh || !MusicPlaylistSnapshot::read(snapshot.absoluteFilePath(), songs))
         {
-            manager.readBuffer(songs);
+            MusicTKPLConfigManager manager;
+            if(manager.fromFile(PLAYLIST_PATH_FULL))
+            {
+                manager.readBuffer(songs);
+            }
         }
     }
-    const bool success = m_songTreeWidget->addMusicItemList(songs);
+
+    bool success = false;
+    {
+        TTK_TRACE_SCOPE("song tree");
+        success = m_songTreeWidget->addMusicItemList(songs);
+    }
 
     MusicConfigManager manager;
     if(!manager.fromFile(COFIG_PATH_FULL))
@@ -1107,7 +1191,7 @@ void MusicApplication::readSystemConfigFromFile()
     m_rightAreaWidget->setInteriorLrcVisible(true);
 
     //Set the desktop lrc should be shown
-    m_rightAreaWidget->setWindowLrcTypeChanged();
+    m_rightAreaWidget->setupDesktopLrc();
     G_SETTING_PTR->setValue(MusicSettingManager::DLrcGeometry, manager.readShowDesktopLrcGeometry());
 
     //Set the current background color and alpha value
@@ -1170,7 +1254,7 @@ void MusicApplication::readSystemConfigFromFile()
     }
 }
 
-void MusicApplication::writeSystemConfigToFile()
+void MusicApplication::writeSystemConfigToFile(bool quit)
 {
     MusicConfigManager manager;
     if(!manager.load(COFIG_PATH_FULL))
@@ -1202,14 +1286,14 @@ void MusicApplication::writeSystemConfigToFile()
     G_SETTING_PTR->setValue(MusicSettingManager::BackgroundTransparentEnable, m_topAreaWidget->backgroundTransparentEnable());
     G_SETTING_PTR->setValue(MusicSettingManager::ShowDesktopLrc, m_rightAreaWidget->destopLrcVisible());
     manager.writeBuffer();
+    //Serialized here, written atomically in background
+    G_PERSIST_PTR->save(COFIG_PATH_FULL, manager.toByteArray(4), !quit);
 
+    //Items are shared copy on write, serialized in background
+    const MusicSongItemList items = m_songTreeWidget->items();
+    if(quit)
     {
-        MusicTKPLConfigManager manager;
-        if(!manager.load(PLAYLIST_PATH_FULL))
-        {
-            return;
-        }
-
-        manager.writeBuffer(m_songTreeWidget->items());
+        G_PERSIST_PTR->save(PLAYLIST_PATH_FULL, [items]() { return MusicTKPLConfigManager::toByteArray(items); }, false);
     }
+    G_PERSIST_PTR->save(PLAYLIST_SNAPSHOT_PATH_FULL, [items]() { return MusicPlaylistSnapshot::toByteArray(items); }, !quit);
 }
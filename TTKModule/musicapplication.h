@@ -115,6 +115,10 @@ public:
     TTK::PlayMode playMode() const;
 
 public Q_SLOTS:
+    /*!
+     * Import outside command line messages into container as one batch.
+     */
+    void importSongsOutsideMode(const QList<QStringList> &messages);
     /*!
      * Application window close.
      */
@@ -264,6 +268,10 @@ public Q_SLOTS:
      * Apply settings parameters.
      */
     void applyParameter();
+    /*!
+     * Save settings parameters in background.
+     */
+    void saveParameter();
     /*!
      * Remove love item from indexs.
      */
@@ -315,9 +323,9 @@ private:
      */
     void readSystemConfigFromFile();
     /*!
-     * Write system config to file.
+     * Write system config to file, the playlist only when quit.
      */
-    void writeSystemConfigToFile();
+    void writeSystemConfigToFile(bool quit);
 
 private:
     Ui::MusicApplication *m_ui;
@@ -23,7 +23,7 @@
 #include "musicscreensaverwidget.h"
 #include "musicplatformmanager.h"
 #include "ttklibrary.h"
-#include "ttkconcurrent.h"
+#include "ttkthreadpool.h"
 #include "ttkdesktopwrapper.h"
 #include "ttkfileassociation.h"
 #include "ttkplatformsystem.h"
@@ -280,7 +280,8 @@ void MusicApplicationModule::applyParameter()
     MusicPlatformManager manager;
     manager.windowsStartUpMode(G_SETTING_PTR->value(MusicSettingManager::StartUpMode).toBool());
 
-    TTKConcurrent(
+    // the registry work may take seconds, keep it off the short task workers
+    TTKThreadPool::instance()->runBlocking([]()
     {
         TTKFileAssociation association;
         const QStringList &keys = association.keys();
@@ -11,6 +11,7 @@
 #include "musictinyuiobject.h"
 #include "musicfunctionlistuiobject.h"
 #include "musictopareawidget.h"
+#include "ttktracer.h"
 
 #include "musicwebdjradiowidget.h"
 #include "musicscreensaverwidget.h"
@@ -52,13 +53,21 @@ MusicRightAreaWidget::MusicRightAreaWidget(QWidget *parent)
     m_lrcAnalysis->setLineMax(MUSIC_LRC_INTERIOR_MAX_LINE);
 
     m_downloadStatusObject = new MusicDownloadStatusModule(parent);
-    m_settingWidget = new MusicSettingWidget(this);
-    connect(m_settingWidget, SIGNAL(parameterSettingChanged()), parent, SLOT(applyParameter()));
+
+    // setting widget is the heaviest dialog, it is built on idle or first use
+    m_settingWidget.setFactory([this, parent]() {
+        TTK_TRACE_SCOPE("MusicSettingWidget");
+        MusicSettingWidget *widget = new MusicSettingWidget(this);
+        connect(widget, SIGNAL(parameterSettingChanged()), parent, SLOT(applyParameter()));
+        connect(widget, SIGNAL(parameterSettingChanged()), parent, SLOT(saveParameter()));
+        return widget;
+    });
+    TTKIdleTaskQueue::instance()->append("setting widget", [this]() { m_settingWidget.get(); });
 }
 
 MusicRightAreaWidget::~MusicRightAreaWidget()
 {
-    delete m_settingWidget;
+    m_settingWidget.reset();
     delete m_downloadStatusObject;
     delete m_lrcForDesktop;
     delete m_lrcForWallpaper;
@@ -95,7 +104,7 @@ void MusicRightAreaWidget::setupUi(Ui::MusicApplication *ui)
     buttonGroup->addButton(ui->musicWindowIdentify, MusicRightAreaWidget::IndentifyWidget);
     QtButtonGroupConnect(buttonGroup, this, functionClicked, TTK_SLOT);
     //
-    connect(m_lrcForInterior, SIGNAL(showCurrentLrcColorSetting()), m_settingWidget, SLOT(changeInteriorLrcWidget()));
+    connect(m_lrcForInterior, SIGNAL(showCurrentLrcColorSetting()), SLOT(showInteriorLrcColorSetting()));
     connect(m_lrcForInterior, SIGNAL(currentLrcUpdated()), MusicApplication::instance(), SLOT(currentLrcUpdated()));
     connect(m_lrcForInterior, SIGNAL(backgroundChanged()), SIGNAL(updateBackgroundThemeDownload()));
     connect(m_lrcForInterior, SIGNAL(showCurrentLrcSetting()), MusicApplication::instance(), SLOT(showSettingWidget()));
@@ -108,7 +117,11 @@ void MusicRightAreaWidget::setupUi(Ui::MusicApplication *ui)
 void MusicRightAreaWidget::startDrawLrc() const
 {
    m_lrcForInterior->startDrawLrc();
-   m_lrcForDesktop->startDrawLrc();
+   if(m_lrcForDesktop)
+   {
+       m_lrcForDesktop->startDrawLrc();
+   }
+
    if(m_lrcForWallpaper)
    {
        m_lrcForWallpaper->startDrawLrc();
@@ -118,7 +131,11 @@ void MusicRightAreaWidget::startDrawLrc() const
 void MusicRightAreaWidget::stopDrawLrc() const
 {
     m_lrcForInterior->stopDrawLrc();
-    m_lrcForDesktop->stopDrawLrc();
+    if(m_lrcForDesktop)
+    {
+        m_lrcForDesktop->stopDrawLrc();
+    }
+
     if(m_lrcForWallpaper)
     {
         m_lrcForWallpaper->stopDrawLrc();
@@ -127,12 +144,15 @@ void MusicRightAreaWidget::stopDrawLrc() const
 
 void MusicRightAreaWidget::setCurrentPlayState(bool state) const
 {
-    m_lrcForDesktop->setCurrentPlayState(state);
+    if(m_lrcForDesktop)
+    {
+        m_lrcForDesktop->setCurrentPlayState(state);
+    }
 }
 
 bool MusicRightAreaWidget::destopLrcVisible() const
 {
-    return m_lrcForDesktop->isVisible();
+    return m_lrcForDesktop && m_lrcForDesktop->isVisible();
 }
 
 void MusicRightAreaWidget::setInteriorLrcVisible(bool status) const
@@ -160,6 +180,7 @@ void MusicRightAreaWidget::updateCurrentLrc(qint64 current, qint64 total, bool p
                 m_lrcForInterior->updateCurrentLrc(intervalTime);
             }
 
+            if(m_lrcForDesktop)
             {
                 m_lrcForDesktop->setCurrentTime(current, total);
                 m_lrcForDesktop->updateCurrentLrc(currentLrc, laterLrc, intervalTime);
@@ -192,12 +213,15 @@ void MusicRightAreaWidget::loadCurrentSongLrc(const QString &name, const QString
     }
 
     m_lrcForInterior->updateCurrentLrc(state);
-    m_lrcForDesktop->stopDrawLrc();
-    m_lrcForDesktop->setCurrentSongName(name);
-
-    if(state == MusicLrcAnalysis::State::Failed)
+    if(m_lrcForDesktop)
     {
-        m_lrcForDesktop->updateCurrentLrc(tr("No lrc data file found"), {}, 0);
+        m_lrcForDesktop->stopDrawLrc();
+        m_lrcForDesktop->setCurrentSongName(name);
+
+        if(state == MusicLrcAnalysis::State::Failed)
+        {
+            m_lrcForDesktop->updateCurrentLrc(tr("No lrc data file found"), {}, 0);
+        }
     }
 
     if(m_lrcForWallpaper)
@@ -223,12 +247,29 @@ void MusicRightAreaWidget::checkMetaDataValid(bool mode) const
     m_downloadStatusObject->checkMetaDataValid(mode);
 }
 
-void MusicRightAreaWidget::showSettingWidget() const
+void MusicRightAreaWidget::showSettingWidget()
 {
     m_settingWidget->initialize();
     m_settingWidget->exec();
 }
 
+void MusicRightAreaWidget::setupDesktopLrc()
+{
+    if(G_SETTING_PTR->value(MusicSettingManager::ShowDesktopLrc).toBool())
+    {
+        createDesktopLrc();
+        return;
+    }
+
+    // a hidden desktop lrc is not needed for the first paint
+    TTKIdleTaskQueue::instance()->append("desktop lrc", [this]() {
+        if(!m_lrcForDesktop)
+        {
+            createDesktopLrc();
+        }
+    });
+}
+
 void MusicRightAreaWidget::artistSearchByID(const QString &id)
 {
     m_rawData = id;
@@ -278,7 +319,11 @@ void MusicRightAreaWidget::resizeWindow()
 
 void MusicRightAreaWidget::applyParameter()
 {
-    m_lrcForDesktop->applyParameter();
+    if(m_lrcForDesktop)
+    {
+        m_lrcForDesktop->applyParameter();
+    }
+
     m_lrcForInterior->applyParameter();
     if(m_lrcForWallpaper)
     {
@@ -286,7 +331,15 @@ void MusicRightAreaWidget::applyParameter()
     }
 
     bool config = G_SETTING_PTR->value(MusicSettingManager::ShowDesktopLrc).toBool();
-    m_lrcForDesktop->setVisible(config);
+    if(config && !m_lrcForDesktop)
+    {
+        createDesktopLrc();
+    }
+
+    if(m_lrcForDesktop)
+    {
+        m_lrcForDesktop->setVisible(config);
+    }
     m_ui->musicDesktopLrc->setChecked(config);
 
     config = G_SETTING_PTR->value(MusicSettingManager::RippleLowPowerMode).toBool();
@@ -661,23 +714,43 @@ void MusicRightAreaWidget::showSongMainWidget()
     G_SETTING_PTR->setValue(MusicSettingManager::WindowConciseMode, pre);
 }
 
-void MusicRightAreaWidget::setDestopLrcVisible(bool visible) const
+void MusicRightAreaWidget::setDestopLrcVisible(bool visible)
 {
+    G_SETTING_PTR->setValue(MusicSettingManager::ShowDesktopLrc, visible);
     m_ui->musicDesktopLrc->setChecked(visible);
+
+    if(!m_lrcForDesktop)
+    {
+        if(!visible)
+        {
+            return;
+        }
+        createDesktopLrc();
+    }
+
     m_lrcForDesktop->setVisible(visible);
     m_lrcForDesktop->initCurrentLrc();
-    G_SETTING_PTR->setValue(MusicSettingManager::ShowDesktopLrc, visible);
 }
 
 void MusicRightAreaWidget::setWindowLockedChanged()
 {
+    if(!m_lrcForDesktop)
+    {
+        createDesktopLrc();
+    }
     m_lrcForDesktop->setWindowLockedChanged();
 }
 
 void MusicRightAreaWidget::setWindowLrcTypeChanged()
 {
-    const bool type = m_lrcForDesktop ? m_lrcForDesktop->isVerticalWindowType() : TTKStaticCast(bool, G_SETTING_PTR->value(MusicSettingManager::DLrcWindowMode).toInt());
     G_SETTING_PTR->setValue(MusicSettingManager::DLrcGeometry, QPoint());
+    createDesktopLrc();
+}
+
+void MusicRightAreaWidget::createDesktopLrc()
+{
+    TTK_TRACE_SCOPE("MusicLrcContainerForDesktop");
+    const bool type = m_lrcForDesktop ? m_lrcForDesktop->isVerticalWindowType() : TTKStaticCast(bool, G_SETTING_PTR->value(MusicSettingManager::DLrcWindowMode).toInt());
 
     MusicLrcContainerForDesktop *desktop = m_lrcForDesktop;
     if(type)
@@ -695,6 +768,12 @@ void MusicRightAreaWidget::setWindowLrcTypeChanged()
         m_lrcForDesktop->statusCopyFrom(desktop);
         desktop->deleteLater();
     }
+    else
+    {
+        // built after the current song is loaded, so take its state over
+        m_lrcForDesktop->setCurrentSongName(MusicApplication::instance()->currentFileName());
+        m_lrcForDesktop->setCurrentPlayState(MusicApplication::instance()->isPlaying());
+    }
 
     m_lrcForDesktop->applyParameter();
     m_lrcForDesktop->initCurrentLrc();
@@ -702,7 +781,7 @@ void MusicRightAreaWidget::setWindowLrcTypeChanged()
 
     connect(m_lrcForDesktop, SIGNAL(currentLrcUpdated()), MusicApplication::instance(), SLOT(currentLrcUpdated()));
     connect(m_lrcForDesktop, SIGNAL(showCurrentLrcSetting()), MusicApplication::instance(), SLOT(showSettingWidget()));
-    connect(m_lrcForDesktop, SIGNAL(showCurrentLrcColorSetting()), m_settingWidget, SLOT(changeDesktopLrcWidget()));
+    connect(m_lrcForDesktop, SIGNAL(showCurrentLrcColorSetting()), SLOT(showDesktopLrcColorSetting()));
 
     G_SETTING_PTR->setValue(MusicSettingManager::DLrcWindowMode, type);
 }
@@ -813,6 +892,16 @@ void MusicRightAreaWidget::changeDownloadCustumWidget()
     showSettingWidget();
 }
 
+void MusicRightAreaWidget::showInteriorLrcColorSetting()
+{
+    m_settingWidget->changeInteriorLrcWidget();
+}
+
+void MusicRightAreaWidget::showDesktopLrcColorSetting()
+{
+    m_settingWidget->changeDesktopLrcWidget();
+}
+
 void MusicRightAreaWidget::functionInitialize()
 {
     if(G_SETTING_PTR->value(MusicSettingManager::WindowConciseMode).toBool())
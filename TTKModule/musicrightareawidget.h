@@ -21,6 +21,7 @@
 
 #include <QWidget>
 #include "musicglobaldefine.h"
+#include "ttkdeferredobject.h"
 
 class MusicSettingWidget;
 class MusicVideoPlayWidget;
@@ -133,7 +134,11 @@ public:
     /*!
      * Show setting widget.
      */
-    void showSettingWidget() const;
+    void showSettingWidget();
+    /*!
+     * Build desktop lrc now when it is shown, otherwise on idle.
+     */
+    void setupDesktopLrc();
     /*!
      * Music artist search function.
      */
@@ -250,7 +255,7 @@ public Q_SLOTS:
     /*!
      * Set destop lrc visible or invisible.
      */
-    void setDestopLrcVisible(bool visible) const;
+    void setDestopLrcVisible(bool visible);
     /*!
      * Lock current desktop lrc state changed.
      */
@@ -292,6 +297,16 @@ public Q_SLOTS:
      */
     void changeDownloadCustumWidget();
 
+private Q_SLOTS:
+    /*!
+     * Change setting widget to interior lrc page.
+     */
+    void showInteriorLrcColorSetting();
+    /*!
+     * Change setting widget to desktop lrc page.
+     */
+    void showDesktopLrcColorSetting();
+
 private:
     /*!
      * Function initialize.
@@ -301,6 +316,10 @@ private:
      * Create kugou web window.
      */
     void createkWebWindow(int type);
+    /*!
+     * Create desktop lrc by the current window type.
+     */
+    void createDesktopLrc();
 
     Ui::MusicApplication *m_ui;
     QVariant m_rawData;
@@ -308,7 +327,7 @@ private:
     FunctionModule m_funcIndex;
     QWidget *m_stackedWidget;
     QWidget *m_stackedStandWidget;
-    MusicSettingWidget *m_settingWidget;
+    TTKDeferredObject<MusicSettingWidget> m_settingWidget;
     MusicVideoPlayWidget *m_videoPlayerWidget;
     MusicLrcAnalysis *m_lrcAnalysis;
     MusicLrcContainerForInterior *m_lrcForInterior;
@@ -0,0 +1,67 @@
+# ***************************************************************************
+# * This file is part of the TTK Music Player project
+# * Copyright (C) 2015 - 2024 Greedysky Studio
+#
+# * This program is free software; you can redistribute it and/or modify
+# * it under the terms of the GNU General Public License as published by
+# * the Free Software Foundation; either version 3 of the License, or
+# * (at your option) any later version.
+#
+# * This program is distributed in the hope that it will be useful,
+# * but WITHOUT ANY WARRANTY; without even the implied warranty of
+# * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# * GNU General Public License for more details.
+#
+# * You should have received a copy of the GNU General Public License along
+# * with this program; If not, see <http://www.gnu.org/licenses/>.
+# ***************************************************************************
+
+
+QT += core gui network testlib
+
+TEMPLATE = app
+CONFIG += console
+
+include($$PWD/../../TTKVersion.pri)
+
+DESTDIR = $$OUT_PWD/../../bin/$$TTK_VERSION
+TARGET = TTKBenchmark
+
+DEFINES += TTK_LIBRARY
+
+win32:msvc{
+    CONFIG += c++11
+}else{
+    equals(QT_MAJOR_VERSION, 6){ #Qt6
+        QMAKE_CXXFLAGS += -std=c++17
+    }else{
+        QMAKE_CXXFLAGS += -std=c++11
+    }
+}
+
+LIBS += -L$$DESTDIR -lTTKCore -lTTKLibrary -lTTKExtras
+unix:LIBS += -L$$DESTDIR -lTTKqmmp -lTTKUi -lTTKWatcher -lTTKDumper -lTTKZip -lzlib
+
+INCLUDEPATH += \
+    $$PWD/../../TTKCommon \
+    $$PWD/../../TTKCommon/TTKLibrary \
+    $$PWD/../../TTKModule/TTKCore/musicCoreKits \
+    $$PWD/../../TTKModule/TTKCore/musicLrcKits \
+    $$PWD/../../TTKModule/TTKCore/musicNetworkKits/core \
+    $$PWD/../../TTKModule/TTKCore/musicPlaylistKits \
+    $$PWD/../../TTKModule/TTKCore/musicToolsSetsKits \
+    $$PWD/../../TTKModule/TTKCore/musicUtilsKits \
+    $$PWD/../../TTKThirdParty/TTKExtras
+
+HEADERS += \
+    $$PWD/musicbenchmark.h \
+    $$PWD/musicbenchmarkfixtures.h \
+    $$PWD/musicbenchmarkexporter.h
+
+SOURCES += \
+    $$PWD/musicbenchmarkmain.cpp \
+    $$PWD/musicbenchmark.cpp \
+    $$PWD/musicbenchmarkfixtures.cpp \
+    $$PWD/musicbenchmarkexporter.cpp
+
+RESOURCES += $$PWD/$${TARGET}.qrc
@@ -0,0 +1,556 @@
+#include "musicbenchmark.h"
+#include "musicbenchmarkfixtures.h"
+#include "musicfileutils.h"
+#include "musicimageutils.h"
+#include "musicalgorithmutils.h"
+#include "musiclrcanalysis.h"
+#include "musicsongmeta.h"
+#include "musicm3uconfigmanager.h"
+#include "musicfplconfigmanager.h"
+#include "musictkplconfigmanager.h"
+#include "musicplaylistsnapshot.h"
+#include "musicnetworktestserver.h"
+#include "musicnetworktestrequest.h"
+#include "ttkthreadpool.h"
+#include "ttkconcurrentqueue.h"
+#include "ttkcryptographichash.h"
+
+#include "qjson/parser.h"
+#include "qjson/serializer.h"
+#include "qalgorithm/blurkernel.h"
+#include "qalgorithm/pixelkernel.h"
+#include "qalgorithm/imagewrapper.h"
+
+#include <thread>
+
+#if TTK_QT_VERSION_CHECK(5,0,0)
+#  define TTK_BENCHMARK_SKIP(message) QSKIP(message)
+#else
+#  define TTK_BENCHMARK_SKIP(message) QSKIP(message, SkipSingle)
+#endif
+
+static constexpr int PLAYLIST_ITEM_COUNT = 4;
+static constexpr int PLAYLIST_SONG_COUNT = 2500;
+static constexpr int TASK_COUNT = 10000;
+static constexpr int NETWORK_SIZE = 16 * TTK_SN_MB2B;
+static constexpr char CODEC_KEY[] = "greedysky";
+
+/*!
+ * Write the fixture data to file.
+ */
+static bool writeFixture(const QString &path, const QByteArray &data)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    const bool v = file.write(data) == data.size();
+    file.close();
+    return v;
+}
+
+/*!
+ * Read the playlist file by the config manager.
+ */
+template <typename T>
+static bool readPlaylist(const QString &path, MusicSongItemList &items)
+{
+    T manager;
+    return manager.fromFile(path) && manager.readBuffer(items);
+}
+
+
+MusicBenchmark::MusicBenchmark(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+void MusicBenchmark::initTestCase()
+{
+    m_dir = QDir::tempPath() + QString("/TTKBenchmark-%1/").arg(QCoreApplication::applicationPid());
+    QVERIFY(QDir().mkpath(m_dir));
+
+    m_image = TTK::Benchmark::generateImage(QSize(1024, 1024));
+    m_items = TTK::Benchmark::generateSongItems(PLAYLIST_ITEM_COUNT, PLAYLIST_SONG_COUNT);
+
+    const int count = PLAYLIST_ITEM_COUNT * PLAYLIST_SONG_COUNT;
+    QVERIFY(writeFixture(fixturePath("benchmark.m3u"), TTK::Benchmark::generateM3U(count)));
+    QVERIFY(writeFixture(fixturePath("benchmark.fpl"), TTK::Benchmark::generateFPL(count)));
+    QVERIFY(writeFixture(fixturePath("benchmark.tkpl"), MusicTKPLConfigManager::toByteArray(m_items)));
+    QVERIFY(writeFixture(fixturePath("benchmark.tkps"), MusicPlaylistSnapshot::toByteArray(m_items)));
+    QVERIFY(writeFixture(fixturePath("benchmark.mp3"), TTK::Benchmark::generateMP3(1000)));
+}
+
+void MusicBenchmark::cleanupTestCase()
+{
+    TTK::File::removeRecursively(m_dir);
+}
+
+void MusicBenchmark::lrcParse_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("500 lines") << TTK::Benchmark::generateLrc(500);
+    QTest::newRow("5000 lines") << TTK::Benchmark::generateLrc(5000);
+}
+
+void MusicBenchmark::lrcParse()
+{
+    QFETCH(QByteArray, data);
+
+    MusicLrcAnalysis analysis;
+    QVERIFY(analysis.setData(data) == MusicLrcAnalysis::State::Success);
+
+    QBENCHMARK
+    {
+        analysis.setData(data);
+    }
+}
+
+void MusicBenchmark::songMetaRead()
+{
+    const QString &path = fixturePath("benchmark.mp3");
+
+    MusicSongMeta meta;
+    if(!meta.read(path))
+    {
+        // the meta is read by the decoder plugins, they are not installed next to every build
+        TTK_BENCHMARK_SKIP("No decoder plugin can read the mp3 fixture");
+    }
+
+    QBENCHMARK
+    {
+        meta.read(path);
+    }
+}
+
+void MusicBenchmark::playlistRead_data()
+{
+    QTest::addColumn<QString>("format");
+
+    QTest::newRow("m3u") << QString("m3u");
+    QTest::newRow("fpl") << QString("fpl");
+    QTest::newRow("tkpl") << QString("tkpl");
+    QTest::newRow("tkps") << QString("tkps");
+}
+
+void MusicBenchmark::playlistRead()
+{
+    QFETCH(QString, format);
+
+    const QString &path = fixturePath("benchmark." + format);
+    const auto read = [&format, &path](MusicSongItemList &items) -> bool
+    {
+        if(format == "m3u")
+        {
+            return readPlaylist<MusicM3UConfigManager>(path, items);
+        }
+        else if(format == "fpl")
+        {
+            return readPlaylist<MusicFPLConfigManager>(path, items);
+        }
+        else if(format == "tkpl")
+        {
+            return readPlaylist<MusicTKPLConfigManager>(path, items);
+        }
+        return MusicPlaylistSnapshot::read(path, items);
+    };
+
+    MusicSongItemList items;
+    QVERIFY(read(items));
+    QVERIFY(!items.isEmpty());
+
+    QBENCHMARK
+    {
+        items.clear();
+        read(items);
+    }
+}
+
+void MusicBenchmark::playlistWrite_data()
+{
+    QTest::addColumn<QString>("format");
+
+    QTest::newRow("tkpl") << QString("tkpl");
+    QTest::newRow("tkps") << QString("tkps");
+}
+
+void MusicBenchmark::playlistWrite()
+{
+    QFETCH(QString, format);
+
+    QByteArray data;
+    if(format == "tkpl")
+    {
+        QBENCHMARK
+        {
+            data = MusicTKPLConfigManager::toByteArray(m_items);
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            data = MusicPlaylistSnapshot::toByteArray(m_items);
+        }
+    }
+    QVERIFY(!data.isEmpty());
+}
+
+void MusicBenchmark::songSort_data()
+{
+    QTest::addColumn<int>("sort");
+
+    // sorts by file size and add time stat the files, they measure the file system instead
+    QTest::newRow("file name") << TTKStaticCast(int, MusicSong::Sort::ByFileName);
+    QTest::newRow("duration") << TTKStaticCast(int, MusicSong::Sort::ByDuration);
+    QTest::newRow("play count") << TTKStaticCast(int, MusicSong::Sort::ByPlayCount);
+}
+
+void MusicBenchmark::songSort()
+{
+    QFETCH(int, sort);
+
+    MusicSongList songs;
+    for(const MusicSongItem &item : qAsConst(m_items))
+    {
+        songs << item.m_songs;
+    }
+
+    for(MusicSong &song : songs)
+    {
+        song.setSort(TTKStaticCast(MusicSong::Sort, sort));
+    }
+
+    QBENCHMARK
+    {
+        // the copy is sorted, the shared list detaches on the first swap
+        MusicSongList list = songs;
+        std::sort(list.begin(), list.end());
+    }
+}
+
+void MusicBenchmark::imageGaussBlur_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<int>("radius");
+
+    QTest::newRow("1024x1024 radius 4") << QSize(1024, 1024) << 4;
+    QTest::newRow("1024x1024 radius 16") << QSize(1024, 1024) << 16;
+    QTest::newRow("1024x1024 radius 64") << QSize(1024, 1024) << 64;
+
+    // the backgrounds are blurred at screen size, a large radius must cost the same as a small one
+    const QList<QSize> screens{QSize(1920, 1080), QSize(3840, 2160)};
+    const QList<int> radiuses{5, 20, 50, 100};
+    for(const QSize &screen : qAsConst(screens))
+    {
+        for(const int radius : qAsConst(radiuses))
+        {
+            QTest::newRow(qPrintable(QString("%1x%2 radius %3").arg(screen.width()).arg(screen.height()).arg(radius))) << screen << radius;
+        }
+    }
+}
+
+void MusicBenchmark::imageGaussBlur()
+{
+    QFETCH(QSize, size);
+    QFETCH(int, radius);
+
+    const QImage &source = size == m_image.size() ? m_image : TTK::Benchmark::generateImage(size);
+    QBENCHMARK
+    {
+        QImage image = source;
+        QAlgorithm::gaussBlur(image, radius);
+    }
+}
+
+void MusicBenchmark::imagePixelKernel_data()
+{
+    QTest::addColumn<QString>("kernel");
+
+    QTest::newRow("gray scale") << QString("grayScale");
+    QTest::newRow("map channels") << QString("mapChannels");
+    QTest::newRow("source over") << QString("sourceOver");
+    QTest::newRow("re render") << QString("reRenderImage");
+}
+
+void MusicBenchmark::imagePixelKernel()
+{
+    QFETCH(QString, kernel);
+
+    // the in place kernels detach a copy of the shared image per loop, the copy is part of the cost
+    if(kernel == "grayScale")
+    {
+        QBENCHMARK
+        {
+            QImage image = m_image;
+            QAlgorithm::grayScale(image, 0);
+        }
+    }
+    else if(kernel == "mapChannels")
+    {
+        uchar table[256];
+        for(int i = 0; i < 256; ++i)
+        {
+            table[i] = 255 - i;
+        }
+
+        QBENCHMARK
+        {
+            QImage image = m_image;
+            QAlgorithm::mapChannels(image, table);
+        }
+    }
+    else if(kernel == "sourceOver")
+    {
+        const QImage &front = m_image.scaled(m_image.size() / 2).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        QBENCHMARK
+        {
+            QImage image = m_image;
+            QAlgorithm::sourceOver(image, front, QPoint(m_image.width() / 4, m_image.height() / 4));
+        }
+    }
+    else
+    {
+        QImage image(m_image.size(), m_image.format());
+        QBENCHMARK
+        {
+            TTK::Image::reRenderImage(50, &m_image, &image);
+        }
+    }
+}
+
+void MusicBenchmark::imageTransition_data()
+{
+    QTest::addColumn<QString>("effect");
+
+    QTest::newRow("gauss blur") << QString("gaussBlur");
+    QTest::newRow("cube wave") << QString("cubeWave");
+    QTest::newRow("water wave") << QString("waterWave");
+}
+
+void MusicBenchmark::imageTransition()
+{
+    QFETCH(QString, effect);
+
+    const QImage &image = m_image.scaled(QSize(640, 360));
+    const QPixmap &pixmap = QPixmap::fromImage(image);
+
+    QScopedPointer<QAlgorithm::SharpeImage> sharpe;
+    if(effect == "gaussBlur")
+    {
+        sharpe.reset(new QAlgorithm::GaussBlur);
+    }
+    else if(effect == "cubeWave")
+    {
+        sharpe.reset(new QAlgorithm::CubeWave);
+    }
+    else
+    {
+        sharpe.reset(new QAlgorithm::WaterWave(image, image.height() / 6));
+    }
+    sharpe->input(image.rect());
+
+    // a frame in the middle of the animation, the gauss blur takes it as radius
+    QBENCHMARK
+    {
+        sharpe->render(pixmap, 50);
+    }
+}
+
+void MusicBenchmark::jsonParse_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    // kuwo replies with single quotes, the query request replaces them before parsing
+    QTest::newRow("wy search") << TTK::Benchmark::readResponse("wy_search");
+    QTest::newRow("kg search") << TTK::Benchmark::readResponse("kg_search");
+    QTest::newRow("kw search") << TTK::Benchmark::readResponse("kw_search").replace("'", "\"");
+    QTest::newRow("wy playlist") << TTK::Benchmark::readResponse("wy_playlist");
+}
+
+void MusicBenchmark::jsonParse()
+{
+    QFETCH(QByteArray, data);
+
+    bool ok = false;
+    QJson::Parser json;
+    json.parse(data, &ok);
+    QVERIFY(ok);
+
+    QBENCHMARK
+    {
+        json.parse(data, &ok);
+    }
+}
+
+void MusicBenchmark::jsonSerialize()
+{
+    bool ok = false;
+    QJson::Parser json;
+    const QVariant &data = json.parse(TTK::Benchmark::readResponse("wy_playlist"), &ok);
+    QVERIFY(ok);
+
+    QJson::Serializer serializer;
+    QBENCHMARK
+    {
+        serializer.serialize(data, &ok);
+    }
+    QVERIFY(ok);
+}
+
+void MusicBenchmark::stringCodec_data()
+{
+    QTest::addColumn<QString>("codec");
+    QTest::addColumn<bool>("encode");
+
+    QTest::newRow("mdII encode") << QString("mdII") << true;
+    QTest::newRow("mdII decode") << QString("mdII") << false;
+    QTest::newRow("xxtea encrypt") << QString("xxtea") << true;
+    QTest::newRow("xxtea decrypt") << QString("xxtea") << false;
+}
+
+void MusicBenchmark::stringCodec()
+{
+    QFETCH(QString, codec);
+    QFETCH(bool, encode);
+
+    // about the size of the song queries of the requests
+    QString data = QString::fromUtf8(TTK::Benchmark::readResponse("wy_search")).left(256);
+    TTKCryptographicHash hash;
+
+    if(codec == "mdII")
+    {
+        if(!encode)
+        {
+            data = TTK::Algorithm::mdII(data, true);
+        }
+
+        QBENCHMARK
+        {
+            TTK::Algorithm::mdII(data, encode);
+        }
+    }
+    else
+    {
+        if(!encode)
+        {
+            data = hash.encrypt(data, CODEC_KEY);
+        }
+
+        QBENCHMARK
+        {
+            encode ? hash.encrypt(data, CODEC_KEY) : hash.decrypt(data, CODEC_KEY);
+        }
+    }
+}
+
+void MusicBenchmark::taskThroughput_data()
+{
+    QTest::addColumn<QString>("queue");
+
+    QTest::newRow("TTKThreadPool") << QString("TTKThreadPool");
+    QTest::newRow("TTKConcurrentQueue") << QString("TTKConcurrentQueue");
+}
+
+void MusicBenchmark::taskThroughput()
+{
+    QFETCH(QString, queue);
+
+    TTKThreadPool *pool = TTKThreadPool::instance();
+    std::atomic<int> counter(0);
+
+    if(queue == "TTKThreadPool")
+    {
+        QBENCHMARK
+        {
+            counter = 0;
+            for(int i = 0; i < TASK_COUNT; ++i)
+            {
+                pool->run([&counter]() { ++counter; });
+            }
+            pool->waitForDone();
+        }
+    }
+    else
+    {
+        // the same worker count behind one locked queue, the layout the pool replaced
+        using Task = std::function<void()>;
+        TTKConcurrentQueue<Task> tasks;
+        std::vector<std::thread> threads;
+
+        for(int i = 0; i < pool->threadCount(); ++i)
+        {
+            threads.emplace_back([&tasks]()
+            {
+                Task task;
+                while(tasks.pop(task) && task)
+                {
+                    task();
+                }
+            });
+        }
+
+        QBENCHMARK
+        {
+            counter = 0;
+            for(int i = 0; i < TASK_COUNT; ++i)
+            {
+                tasks.push([&counter]() { ++counter; });
+            }
+
+            while(counter < TASK_COUNT)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        for(size_t i = 0; i < threads.size(); ++i)
+        {
+            tasks.push(Task());
+        }
+
+        for(std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    QCOMPARE(counter.load(), TASK_COUNT);
+}
+
+void MusicBenchmark::networkThroughput()
+{
+    MusicNetworkTestServer server;
+    server.setBandwidth(0);
+    server.setLatency(0);
+    if(!server.listen())
+    {
+        TTK_BENCHMARK_SKIP("Local network test server can not listen");
+    }
+
+    MusicNetworkTestRequest request;
+    request.setUrl(server.url(NETWORK_SIZE));
+    request.setSampleCount(1);
+    request.setStreamCount(1);
+    request.setMaxSize(NETWORK_SIZE);
+
+    QEventLoop loop;
+    connect(&request, SIGNAL(networkConnectionTestChanged(bool)), &loop, SLOT(quit()));
+
+    QBENCHMARK
+    {
+        request.startToRequest();
+        loop.exec();
+    }
+
+    QVERIFY(request.result().m_samples > 0);
+}
+
+QString MusicBenchmark::fixturePath(const QString &name) const
+{
+    return m_dir + name;
+}
@@ -0,0 +1,127 @@
+#ifndef MUSICBENCHMARK_H
+#define MUSICBENCHMARK_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QtTest>
+#include "musicsong.h"
+
+/*! @brief The class of the core hot path benchmark.
+ * Fixtures are written to a temporary directory once, so only the measured path runs in the loops.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicBenchmark : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicBenchmark(QObject *parent = nullptr);
+
+private Q_SLOTS:
+    /*!
+     * Generate the fixtures.
+     */
+    void initTestCase();
+    /*!
+     * Remove the fixtures.
+     */
+    void cleanupTestCase();
+
+    /*!
+     * Lrc lyrics parse.
+     */
+    void lrcParse_data();
+    void lrcParse();
+    /*!
+     * Tagged audio meta read.
+     */
+    void songMetaRead();
+    /*!
+     * Playlist file read.
+     */
+    void playlistRead_data();
+    void playlistRead();
+    /*!
+     * Playlist file write.
+     */
+    void playlistWrite_data();
+    void playlistWrite();
+    /*!
+     * Playlist song sort.
+     */
+    void songSort_data();
+    void songSort();
+
+    /*!
+     * Image gauss blur kernel.
+     */
+    void imageGaussBlur_data();
+    void imageGaussBlur();
+    /*!
+     * Image pixel kernels.
+     */
+    void imagePixelKernel_data();
+    void imagePixelKernel();
+    /*!
+     * Image transition effects.
+     */
+    void imageTransition_data();
+    void imageTransition();
+
+    /*!
+     * Json document parse.
+     */
+    void jsonParse_data();
+    void jsonParse();
+    /*!
+     * Json document serialize.
+     */
+    void jsonSerialize();
+
+    /*!
+     * String codecs.
+     */
+    void stringCodec_data();
+    void stringCodec();
+
+    /*!
+     * Background task throughput.
+     */
+    void taskThroughput_data();
+    void taskThroughput();
+    /*!
+     * Local network download throughput.
+     */
+    void networkThroughput();
+
+private:
+    /*!
+     * Get the fixture path by file name.
+     */
+    QString fixturePath(const QString &name) const;
+
+    QString m_dir;
+    QImage m_image;
+    MusicSongItemList m_items;
+
+};
+
+#endif // MUSICBENCHMARK_H
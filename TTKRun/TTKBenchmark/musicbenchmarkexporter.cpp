@@ -0,0 +1,84 @@
+#include "musicbenchmarkexporter.h"
+#include "ttkversion.h"
+
+#include "qjson/serializer.h"
+
+#include <QThread>
+#include <QDateTime>
+#include <QXmlStreamReader>
+
+bool MusicBenchmarkExporter::convert(const QString &xml, const QString &json)
+{
+    QFile file(xml);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        TTK_ERROR_STREAM("Benchmark xml log open error:" << xml);
+        return false;
+    }
+
+    QString function;
+    QVariantList results;
+    QXmlStreamReader reader(&file);
+
+    while(!reader.atEnd())
+    {
+        if(!reader.readNextStartElement())
+        {
+            continue;
+        }
+
+        const QXmlStreamAttributes &attributes = reader.attributes();
+        if(reader.name() == QString("TestFunction"))
+        {
+            function = attributes.value("name").toString();
+        }
+        else if(reader.name() == QString("BenchmarkResult"))
+        {
+            // the logged value is already per iteration
+            const QString &tag = attributes.value("tag").toString();
+
+            QVariantMap result;
+            result["name"] = tag.isEmpty() ? function : function + ":" + tag;
+            result["function"] = function;
+            result["tag"] = tag;
+            result["metric"] = attributes.value("metric").toString();
+            result["value"] = attributes.value("value").toString().toDouble();
+            result["iterations"] = attributes.value("iterations").toString().toInt();
+            results << result;
+        }
+    }
+    file.close();
+
+    if(reader.hasError())
+    {
+        TTK_ERROR_STREAM("Benchmark xml log parse error:" << reader.errorString());
+        return false;
+    }
+
+    QVariantMap data;
+    data["version"] = TTK_VERSION_STR;
+    data["qt"] = qVersion();
+    data["threads"] = QThread::idealThreadCount();
+    data["date"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    data["results"] = results;
+
+    bool ok = false;
+    QJson::Serializer serializer;
+    serializer.setIndentMode(QJson::IndentFull);
+    const QByteArray &bytes = serializer.serialize(data, &ok);
+    if(!ok)
+    {
+        return false;
+    }
+
+    file.setFileName(json);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        TTK_ERROR_STREAM("Benchmark json file open error:" << json);
+        return false;
+    }
+
+    ok = file.write(bytes) == bytes.size();
+    file.close();
+    return ok;
+}
@@ -0,0 +1,39 @@
+#ifndef MUSICBENCHMARKEXPORTER_H
+#define MUSICBENCHMARKEXPORTER_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include "musicglobaldefine.h"
+
+/*! @brief The class of the benchmark results exporter.
+ * The xml log of the test library is turned into a flat json document,
+ * one result per benchmark row, for the compare script and the history of runs.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicBenchmarkExporter
+{
+public:
+    /*!
+     * Convert the xml log by path to json file by path.
+     */
+    static bool convert(const QString &xml, const QString &json);
+
+};
+
+#endif // MUSICBENCHMARKEXPORTER_H
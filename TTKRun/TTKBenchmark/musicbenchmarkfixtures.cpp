@@ -0,0 +1,243 @@
+#include "musicbenchmarkfixtures.h"
+#include "ttktime.h"
+
+#include <QFile>
+#include <QtEndian>
+
+static constexpr quint32 FIXTURE_SEED = 0x5454484B;
+
+static const char *FIXTURE_WORDS[] = {
+    "moon", "river", "light", "summer", "heart", "road", "rain", "dream", "fire", "star",
+    "night", "ocean", "wind", "city", "home", "blue", "golden", "silent", "falling", "forever"
+};
+static constexpr int FIXTURE_WORD_COUNT = sizeof(FIXTURE_WORDS) / sizeof(FIXTURE_WORDS[0]);
+
+/*! @brief The class of the benchmark linear congruential random generator.
+ * The sequence only depends on the seed, unlike qrand it is the same on every platform.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct MusicBenchmarkRandom
+{
+    quint32 m_state;
+
+    explicit MusicBenchmarkRandom(quint32 seed = FIXTURE_SEED)
+        : m_state(seed)
+    {
+
+    }
+
+    inline quint32 next()
+    {
+        m_state = m_state * 1664525U + 1013904223U;
+        return m_state >> 8;
+    }
+
+    inline int bounded(int max)
+    {
+        return TTKStaticCast(int, next() % max);
+    }
+
+    QString words(int count)
+    {
+        QString value;
+        for(int i = 0; i < count; ++i)
+        {
+            if(i != 0)
+            {
+                value += ' ';
+            }
+            value += FIXTURE_WORDS[bounded(FIXTURE_WORD_COUNT)];
+        }
+        return value;
+    }
+};
+
+template <typename T>
+static void writeValue(QByteArray &data, T value)
+{
+    uchar buffer[sizeof(T)];
+    qToLittleEndian<T>(value, buffer);
+    data.append(TTKReinterpretCast(const char*, buffer), sizeof(T));
+}
+
+/*!
+ * Id3v2.3 text frame, size is plain big endian in this version.
+ */
+static void writeTextFrame(QByteArray &data, const char *id, const QString &text)
+{
+    const QByteArray &value = text.toLatin1();
+    uchar size[4];
+    qToBigEndian<quint32>(value.size() + 1, size);
+
+    data.append(id, 4);
+    data.append(TTKReinterpretCast(const char*, size), 4);
+    data.append(QByteArray(2, '\0'));
+    data.append('\0');
+    data.append(value);
+}
+
+
+QByteArray TTK::Benchmark::generateLrc(int lines)
+{
+    MusicBenchmarkRandom random;
+    QByteArray data;
+    data.append("[ti:benchmark]\n[ar:ttk]\n[al:fixtures]\n[by:greedysky]\n[offset:0]\n");
+
+    qint64 time = 0;
+    for(int i = 0; i < lines; ++i)
+    {
+        time += 1500 + random.bounded(3500);
+        const QString &text = random.words(3 + random.bounded(6));
+        const QString &line = QString("[%1.%2]%3\n").arg(TTKTime::formatDuration(time)).arg(time % 1000 / 10, 2, 10, QChar('0')).arg(text);
+        data.append(line.toUtf8());
+    }
+    return data;
+}
+
+QByteArray TTK::Benchmark::generateM3U(int count)
+{
+    MusicBenchmarkRandom random;
+    QByteArray data;
+    data.append("#EXTM3U\n");
+
+    for(int i = 0; i < count; ++i)
+    {
+        const QString &singer = random.words(2);
+        const QString &title = random.words(3);
+        data.append(QString("#EXTINF:%1,%2 - %3\n").arg(120 + random.bounded(240)).arg(singer, title).toUtf8());
+        data.append(QString("Music/%1/%2 %3.mp3\n").arg(singer, title).arg(i).toUtf8());
+    }
+    return data;
+}
+
+QByteArray TTK::Benchmark::generateFPL(int count)
+{
+    static constexpr uchar FPL_MAGIC[] = {
+        0xE1, 0xA0, 0x9C, 0x91, 0xF8, 0x3C, 0x77, 0x42, 0x85, 0x2C, 0x3B, 0xCC, 0x14, 0x01, 0xD3, 0xF2
+    };
+    // seven uints, the double duration, four floats and four uints
+    static constexpr int FPL_CHUNK_SIZE = 68;
+
+    MusicBenchmarkRandom random;
+    QByteArray strings;
+    QVector<quint32> offsets;
+    offsets.reserve(count);
+
+    for(int i = 0; i < count; ++i)
+    {
+        offsets << strings.size();
+        strings.append(QString("file://Music/%1 %2.mp3").arg(random.words(3)).arg(i).toUtf8());
+        strings.append('\0');
+    }
+
+    QByteArray data;
+    data.append(TTKReinterpretCast(const char*, FPL_MAGIC), sizeof(FPL_MAGIC));
+    writeValue<quint32>(data, strings.size());
+    data.append(strings);
+    writeValue<quint32>(data, count);
+
+    for(int i = 0; i < count; ++i)
+    {
+        QByteArray chunk(FPL_CHUNK_SIZE, '\0');
+        uchar *buffer = TTKReinterpretCast(uchar*, chunk.data());
+        qToLittleEndian<quint32>(offsets[i], buffer + 4);
+
+        const double duration = 120 + random.bounded(240000) / 1000.0;
+        memcpy(buffer + 28, &duration, sizeof(double));
+        // no keys follow the three counted by the chunk itself
+        qToLittleEndian<quint32>(3, buffer + 52);
+        data.append(chunk);
+    }
+    return data;
+}
+
+MusicSongItemList TTK::Benchmark::generateSongItems(int items, int count)
+{
+    MusicBenchmarkRandom random;
+    MusicSongItemList list;
+
+    for(int i = 0; i < items; ++i)
+    {
+        MusicSongItem item;
+        item.m_itemIndex = i;
+        item.m_itemName = random.words(2);
+        item.m_songs.reserve(count);
+
+        for(int j = 0; j < count; ++j)
+        {
+            const QString &singer = random.words(2);
+            const QString &name = singer + " - " + random.words(3);
+            MusicSong song(QString("Music/%1 %2.mp3").arg(name).arg(j), TTKTime::formatDuration((120 + random.bounded(240)) * TTK_DN_S2MS), name);
+            song.setPlayCount(random.bounded(100));
+            item.m_songs << song;
+        }
+        list << item;
+    }
+    return list;
+}
+
+QByteArray TTK::Benchmark::readResponse(const QString &name)
+{
+    QFile file(":/response/" + name);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        TTK_ERROR_STREAM("Benchmark response fixture open error:" << name);
+        return {};
+    }
+    return file.readAll();
+}
+
+QImage TTK::Benchmark::generateImage(const QSize &size)
+{
+    MusicBenchmarkRandom random;
+    QImage image(size, QImage::Format_ARGB32);
+
+    for(int y = 0; y < size.height(); ++y)
+    {
+        QRgb *line = TTKReinterpretCast(QRgb*, image.scanLine(y));
+        for(int x = 0; x < size.width(); ++x)
+        {
+            // gradient with noise, flat images are far easier on the kernels than covers
+            const int noise = random.bounded(64);
+            line[x] = qRgba((x * 255 / size.width() + noise) & 0xFF, (y * 255 / size.height() + noise) & 0xFF, (x + y + noise) & 0xFF, 255);
+        }
+    }
+    return image;
+}
+
+QByteArray TTK::Benchmark::generateMP3(int frames)
+{
+    // mpeg1 layer3, 128 kbps, 44100 hz, no padding
+    static constexpr uchar FRAME_HEADER[] = { 0xFF, 0xFB, 0x90, 0x00 };
+    static constexpr int FRAME_SIZE = 144 * 128000 / 44100;
+    static constexpr int TAG_PADDING = 256;
+
+    MusicBenchmarkRandom random;
+    QByteArray frame;
+    writeTextFrame(frame, "TIT2", random.words(3));
+    writeTextFrame(frame, "TPE1", random.words(2));
+    writeTextFrame(frame, "TALB", random.words(2));
+    writeTextFrame(frame, "TCON", "Pop");
+    writeTextFrame(frame, "TRCK", "1");
+    writeTextFrame(frame, "TYER", "2024");
+    frame.append(QByteArray(TAG_PADDING, '\0'));
+
+    // tag size is sync safe, seven bits per byte
+    const int size = frame.size();
+    QByteArray data("ID3\x03\x00\x00", 6);
+    data.append(TTKStaticCast(char, (size >> 21) & 0x7F));
+    data.append(TTKStaticCast(char, (size >> 14) & 0x7F));
+    data.append(TTKStaticCast(char, (size >> 7) & 0x7F));
+    data.append(TTKStaticCast(char, size & 0x7F));
+    data.append(frame);
+
+    QByteArray audio(FRAME_SIZE, '\0');
+    memcpy(audio.data(), FRAME_HEADER, sizeof(FRAME_HEADER));
+
+    data.reserve(data.size() + frames * FRAME_SIZE);
+    for(int i = 0; i < frames; ++i)
+    {
+        data.append(audio);
+    }
+    return data;
+}
@@ -0,0 +1,66 @@
+#ifndef MUSICBENCHMARKFIXTURES_H
+#define MUSICBENCHMARKFIXTURES_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QImage>
+#include "musicsong.h"
+
+/*! @brief The namespace of the benchmark fixtures.
+ * Every fixture is generated from a fixed seed, so runs on any machine see the same data.
+ * Network responses are shaped like the replies of the query requests and read from fixture files.
+ * @author Greedysky <greedysky@163.com>
+ */
+namespace TTK
+{
+    namespace Benchmark
+    {
+        /*!
+         * Get lrc lyrics of the given line count.
+         */
+        QByteArray generateLrc(int lines);
+        /*!
+         * Get extended m3u playlist of the given song count.
+         */
+        QByteArray generateM3U(int count);
+        /*!
+         * Get foobar2000 fpl playlist of the given song count.
+         */
+        QByteArray generateFPL(int count);
+        /*!
+         * Get playlist items of the given item and song count.
+         */
+        MusicSongItemList generateSongItems(int items, int count);
+        /*!
+         * Get the json response of the fixture file by name.
+         */
+        QByteArray readResponse(const QString &name);
+        /*!
+         * Get argb32 image of the given size.
+         */
+        QImage generateImage(const QSize &size);
+        /*!
+         * Get mp3 stub with id3v2 tags and silent frames of the given frame count.
+         */
+        QByteArray generateMP3(int frames);
+
+    }
+}
+
+#endif // MUSICBENCHMARKFIXTURES_H
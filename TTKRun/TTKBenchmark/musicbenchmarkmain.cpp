@@ -0,0 +1,57 @@
+#include "musicbenchmark.h"
+#include "musicbenchmarkexporter.h"
+#if TTK_QT_VERSION_CHECK(5,0,0)
+#  include <QGuiApplication>
+using TTKApplication = QGuiApplication;
+#else
+#  include <QApplication>
+using TTKApplication = QApplication;
+#endif
+
+int main(int argc, char *argv[])
+{
+#if TTK_QT_VERSION_CHECK(5,0,0)
+    // pixmaps need a platform, benchmarks run on build machines without a display
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty())
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+#endif
+    TTKApplication app(argc, argv);
+
+    QCoreApplication::setOrganizationName(TTK_APP_NAME);
+    QCoreApplication::setOrganizationDomain(TTK_APP_COME_NAME);
+    QCoreApplication::setApplicationName("TTKBenchmark");
+
+    // --json <path> writes the results for the compare script, the rest is passed to the test library
+    QString json, xml;
+    QStringList arguments = app.arguments();
+    const int index = arguments.indexOf("--json");
+    if(index != -1 && index + 1 < arguments.count())
+    {
+        json = arguments[index + 1];
+        arguments.removeAt(index + 1);
+        arguments.removeAt(index);
+
+        xml = json + ".xml";
+#if TTK_QT_VERSION_CHECK(5,0,0)
+        arguments << "-o" << xml + ",xml" << "-o" << "-,txt";
+#else
+        arguments << "-xml" << "-o" << xml;
+#endif
+    }
+
+    MusicBenchmark benchmark;
+    const int code = QTest::qExec(&benchmark, arguments);
+
+    if(!json.isEmpty())
+    {
+        const bool ok = MusicBenchmarkExporter::convert(xml, json);
+        QFile::remove(xml);
+        if(!ok)
+        {
+            return -1;
+        }
+    }
+    return code;
+}
@@ -16,7 +16,7 @@
 # * with this program; If not, see <http://www.gnu.org/licenses/>.
 # ***************************************************************************
 
-QT += core
+QT += core network
 
 TEMPLATE = app
 CONFIG += console
@@ -38,20 +38,26 @@ win32:msvc{
     }
 }
 
-LIBS += -L$$DESTDIR -lTTKCore -lTTKLibrary
-unix:LIBS += -L$$DESTDIR -lTTKqmmp -lTTKUi -lTTKExtras -lTTKWatcher -lTTKDumper -lTTKZip -lzlib
+LIBS += -L$$DESTDIR -lTTKCore -lTTKLibrary -lTTKExtras
+unix:LIBS += -L$$DESTDIR -lTTKqmmp -lTTKUi -lTTKWatcher -lTTKDumper -lTTKZip -lzlib
 
 INCLUDEPATH += \
     $$PWD/../../TTKCommon \
     $$PWD/../../TTKCommon/TTKLibrary \
     $$PWD/../../TTKModule/TTKCore/musicCoreKits \
     $$PWD/../../TTKModule/TTKCore/musicPlaylistKits \
-    $$PWD/../../TTKModule/TTKCore/musicUtilsKits
+    $$PWD/../../TTKModule/TTKCore/musicUtilsKits \
+    $$PWD/../../TTKThirdParty/TTKExtras
 
-HEADERS += $$PWD/musicconsolemodule.h
+HEADERS += \
+    $$PWD/musicconsolemodule.h \
+    $$PWD/musicconsolestate.h \
+    $$PWD/musicconsoleserver.h
 
 SOURCES += \
     $$PWD/musicconsolemain.cpp \
-    $$PWD/musicconsolemodule.cpp
+    $$PWD/musicconsolemodule.cpp \
+    $$PWD/musicconsolestate.cpp \
+    $$PWD/musicconsoleserver.cpp
 
 win32:RC_FILE = $$PWD/$${TARGET}.rc
@@ -1,4 +1,6 @@
 #include "musicconsolemodule.h"
+#include "musicconsolestate.h"
+#include "musicconsoleserver.h"
 #include "musicplayer.h"
 #include "musicplaylist.h"
 #include "musicformats.h"
@@ -9,14 +11,13 @@
 
 MusicConsoleModule::MusicConsoleModule(QObject *parent)
     : QObject(parent),
-      m_volume(100),
-      m_playbackMode("Order"),
-      m_enhanced("Off")
+      m_server(nullptr)
 {
     m_playlist = new MusicPlaylist(this);
     m_playlist->setPlaybackMode(TTK::PlayMode::Order);
     m_player = new MusicPlayer(this);
     m_player->setPlaylist(m_playlist);
+    m_state = new MusicConsoleState(m_player, m_playlist, this);
 
     connect(m_player, SIGNAL(positionChanged(qint64)), SLOT(positionChanged(qint64)));
     connect(m_playlist, SIGNAL(currentIndexChanged(int)), SLOT(currentIndexChanged(int)));
@@ -41,6 +42,8 @@ MusicConsoleModule::MusicConsoleModule(QObject *parent)
 
 MusicConsoleModule::~MusicConsoleModule()
 {
+    delete m_server;
+    delete m_state;
     delete m_player;
     delete m_playlist;
 }
@@ -52,11 +55,15 @@ bool MusicConsoleModule::initialize()
     TTKCommandLineOption op1("-u", "--url", "Music play url path");
     TTKCommandLineOption op2("-d", "--dir", "Music play dir path");
     TTKCommandLineOption op3("-l", "--playlist", "Music playlist url path");
+    TTKCommandLineOption op4("-s", "--server", "Remote control server port");
+    TTKCommandLineOption op5("-t", "--token", "Remote control server session token");
 
     TTKCommandLineParser parser;
     parser.addOption(op1);
     parser.addOption(op2);
     parser.addOption(op3);
+    parser.addOption(op4);
+    parser.addOption(op5);
     parser.process();
 
     if(parser.isEmpty())
@@ -65,6 +72,28 @@ bool MusicConsoleModule::initialize()
         return false;
     }
 
+    if(parser.isSet(op4))
+    {
+        bool ok = false;
+        const int port = parser.value(op4).toInt(&ok);
+        if(!ok || port <= 0 || port > 65535)
+        {
+            TTK_LOG_STREAM("Remote control server port is invalid");
+            return false;
+        }
+
+        m_server = new MusicConsoleServer(m_player, m_playlist, m_state, this);
+        if(parser.isSet(op5))
+        {
+            m_server->setToken(parser.value(op5));
+        }
+
+        if(!m_server->listen(port))
+        {
+            return false;
+        }
+    }
+
     if(parser.isSet(op1))
     {
         const QString &path = parser.value(op1);
@@ -143,7 +172,7 @@ bool MusicConsoleModule::initialize()
             }
         }
     }
-    else
+    else if(!m_server)
     {
         TTK_LOG_STREAM("Options unknown error");
         return false;
@@ -151,8 +180,11 @@ bool MusicConsoleModule::initialize()
 
     TTK_LOG_STREAM("Music Files count: " << m_playlist->count() << "\n");
 
-    m_player->play();
-    m_player->setVolume(m_volume);
+    if(!m_playlist->isEmpty())
+    {
+        m_player->play();
+        m_player->setVolume(m_state->volume());
+    }
     return QCoreApplication::exec();
 }
 
@@ -166,7 +198,8 @@ void MusicConsoleModule::currentIndexChanged(int index)
     TTK_LOG_STREAM("Current Play Indedx: " << index);
     TTK_SIGNLE_SHOT(TTK_DN_S2MS, this, resetVolume, TTK_SLOT);
 
-    if(index == TTK_NORMAL_LEVEL)
+    // the remote control server keeps running when the playlist ends
+    if(index == TTK_NORMAL_LEVEL && !m_server)
     {
         m_player->stop();
         TTK_SIGNLE_SHOT(TTK_DN_S2MS, qApp, quit, TTK_SLOT);
@@ -188,7 +221,7 @@ void MusicConsoleModule::switchToPlayState()
     else
     {
         m_player->play();
-        m_player->setVolume(m_volume);
+        m_player->setVolume(m_state->volume());
     }
 }
 
@@ -202,7 +235,7 @@ void MusicConsoleModule::playPrevious()
     m_playlist->setCurrentIndex(PLAY_PREVIOUS_LEVEL);
 
     m_player->play();
-    m_player->setVolume(m_volume);
+    m_player->setVolume(m_state->volume());
 }
 
 void MusicConsoleModule::playNext()
@@ -215,96 +248,77 @@ void MusicConsoleModule::playNext()
     m_playlist->setCurrentIndex(PLAY_NEXT_LEVEL);
 
     m_player->play();
-    m_player->setVolume(m_volume);
+    m_player->setVolume(m_state->volume());
 }
 
 void MusicConsoleModule::resetVolume()
 {
-    m_player->setVolume(m_volume);
+    m_player->setVolume(m_state->volume());
 }
 
 void MusicConsoleModule::volumeDown()
 {
-    m_volume = m_player->volume();
-    m_volume -= 15;
-    if(m_volume < 0)
-    {
-        m_volume = 0;
-    }
-
-    m_player->setVolume(m_volume);
+    m_state->setVolume(m_player->volume() - 15);
 }
 
 void MusicConsoleModule::volumeUp()
 {
-    m_volume = m_player->volume();
-    m_volume += 15;
-    if(m_volume > 100)
-    {
-        m_volume = 100;
-    }
-
-    m_player->setVolume(m_volume);
+    m_state->setVolume(m_player->volume() + 15);
 }
 
 void MusicConsoleModule::playOrder()
 {
     m_playlist->setPlaybackMode(TTK::PlayMode::Order);
-    m_playbackMode = "Order";
 }
 
 void MusicConsoleModule::playRandom()
 {
     m_playlist->setPlaybackMode(TTK::PlayMode::Random);
-    m_playbackMode = "Random";
 }
 
 void MusicConsoleModule::playlistLoop()
 {
     m_playlist->setPlaybackMode(TTK::PlayMode::ListLoop);
-    m_playbackMode = "ListLoop";
 }
 
 void MusicConsoleModule::playOneLoop()
 {
     m_playlist->setPlaybackMode(TTK::PlayMode::OneLoop);
-    m_playbackMode = "OneLoop";
 }
 
 void MusicConsoleModule::playOnce()
 {
     m_playlist->setPlaybackMode(TTK::PlayMode::Once);
-    m_playbackMode = "Once";
 }
 
 void MusicConsoleModule::setEnhancedOff()
 {
     m_player->setEnhanced(MusicPlayer::Enhance::Off);
-    m_enhanced = "Off";
+    m_state->setEnhanced("Off");
 }
 
 void MusicConsoleModule::setEnhanced3D()
 {
     m_player->setEnhanced(MusicPlayer::Enhance::M3D);
-    m_enhanced = "3D";
+    m_state->setEnhanced("3D");
 }
 
 void MusicConsoleModule::setEnhancedNICAM()
 {
     m_player->setEnhanced(MusicPlayer::Enhance::NICAM);
-    m_enhanced = "NICAM";
+    m_state->setEnhanced("NICAM");
 }
 
 void MusicConsoleModule::setEnhancedSubwoofer()
 {
     m_player->setEnhanced(MusicPlayer::Enhance::Subwoofer);
-    m_enhanced = "Subwoofer";
+    m_state->setEnhanced("Subwoofer");
 }
 
 void MusicConsoleModule::setEnhancedVocal()
 {
     m_player->setEnhanced(MusicPlayer::Enhance::Vocal);
-    m_enhanced = "Vocal";
+    m_state->setEnhanced("Vocal");
 }
 
 void MusicConsoleModule::print(qint64 position, qint64 duration) const
@@ -313,5 +327,5 @@ void MusicConsoleModule::print(qint64 position, qint64 duration) const
     TTK_LOG_STREAM(QString("Music Name: %1, Time:[%2/%3], Volume:%4, PlaybackMode:%5, Enhance:%6")
                 .arg(item.m_path, TTKTime::formatDuration(position), TTKTime::formatDuration(duration))
                 .arg(m_player->volume())
-                .arg(m_playbackMode, m_enhanced));
+                .arg(MusicConsoleState::playbackModeName(m_playlist->playbackMode()), m_state->enhanced()));
 }
@@ -24,6 +24,8 @@
 
 class MusicPlayer;
 class MusicPlaylist;
+class MusicConsoleState;
+class MusicConsoleServer;
 
 /*! @brief The class of the music console module.
  * @author Greedysky <greedysky@163.com>
@@ -132,8 +134,8 @@ private:
 
     MusicPlayer *m_player;
     MusicPlaylist *m_playlist;
-    int m_volume;
-    QString m_playbackMode, m_enhanced;
+    MusicConsoleState *m_state;
+    MusicConsoleServer *m_server;
 
 };
 
@@ -0,0 +1,499 @@
+#include "musicconsoleserver.h"
+#include "musicconsolestate.h"
+#include "musicplayer.h"
+#include "musicplaylist.h"
+#include "qjson/parser.h"
+#include "qjson/serializer.h"
+#include "qhttpserver/qhttpserver.h"
+#include "qhttpserver/qhttprequest.h"
+#include "qhttpserver/qhttpresponse.h"
+
+#include <random>
+#if TTK_QT_VERSION_CHECK(5,0,0)
+#  include <QUrlQuery>
+#endif
+
+static constexpr const char *API_PREFIX = "/api/";
+static constexpr const char *JSON_CONTENT_TYPE = "application/json";
+static constexpr int HEARTBEAT_INTERVAL = 15 * TTK_DN_S2MS;
+static constexpr int TOKEN_SIZE = 16;
+
+/*!
+ * Make the random session token.
+ */
+static QString generateToken()
+{
+    std::random_device device;
+    QByteArray data;
+    for(int i = 0; i < TOKEN_SIZE; ++i)
+    {
+        data.append(TTKStaticCast(char, device() & 0xFF));
+    }
+    return data.toHex();
+}
+
+/*!
+ * Compare the tokens in constant time, so the token can not be guessed by timing.
+ */
+static bool tokenEquals(const QString &token, const QString &other)
+{
+    if(token.isEmpty() || token.length() != other.length())
+    {
+        return false;
+    }
+
+    ushort diff = 0;
+    for(int i = 0; i < token.length(); ++i)
+    {
+        diff |= token[i].unicode() ^ other[i].unicode();
+    }
+    return diff == 0;
+}
+
+/*!
+ * Get the token query item of the url.
+ */
+static QString queryToken(const QUrl &url)
+{
+#if TTK_QT_VERSION_CHECK(5,0,0)
+    return QUrlQuery(url).queryItemValue("token");
+#else
+    return url.queryItemValue("token");
+#endif
+}
+
+/*!
+ * Serialize the value to json text.
+ */
+static QByteArray toJson(const QVariant &value)
+{
+    bool ok = false;
+    QJson::Serializer json;
+    const QByteArray &data = json.serialize(value, &ok);
+    return ok ? data : QByteArray("{}");
+}
+
+/*!
+ * Write the json value as the whole response.
+ */
+static void writeJson(QHttpResponse *response, int status, const QVariant &value)
+{
+    const QByteArray &data = toJson(value);
+
+    response->setHeader("Content-Type", "application/json; charset=utf-8");
+    response->setHeader("Content-Length", QString::number(data.length()));
+    response->writeHead(status);
+    response->end(data);
+}
+
+/*!
+ * Write the error message as the whole response.
+ */
+static void writeError(QHttpResponse *response, int status, const QString &message)
+{
+    QVariantMap value;
+    value["error"] = message;
+    writeJson(response, status, value);
+}
+
+
+MusicConsoleServer::MusicConsoleServer(MusicPlayer *player, MusicPlaylist *playlist, MusicConsoleState *state, QObject *parent)
+    : QObject(parent),
+      m_server(nullptr),
+      m_player(player),
+      m_playlist(playlist),
+      m_state(state)
+{
+    m_timer.setInterval(HEARTBEAT_INTERVAL);
+    connect(&m_timer, SIGNAL(timeout()), SLOT(heartbeat()));
+    connect(m_state, SIGNAL(stateChanged(QString)), SLOT(stateChanged(QString)));
+}
+
+MusicConsoleServer::~MusicConsoleServer()
+{
+    m_timer.stop();
+    if(m_server)
+    {
+        m_server->close();
+    }
+    delete m_server;
+}
+
+bool MusicConsoleServer::listen(quint16 port)
+{
+    m_server = new QHttpServer(this);
+    connect(m_server, SIGNAL(newRequest(QHttpRequest*,QHttpResponse*)), SLOT(handleRequest(QHttpRequest*,QHttpResponse*)));
+
+    // remote control is never exposed beyond local host, and other local processes need the token
+    if(!m_server->listen(QHostAddress::LocalHost, port))
+    {
+        TTK_ERROR_STREAM("Console server listen error, port:" << port);
+        return false;
+    }
+
+    m_timer.start();
+    TTK_LOG_STREAM("Console server listen on: http://127.0.0.1:" << m_server->serverPort() << API_PREFIX);
+
+    if(m_token.isEmpty())
+    {
+        m_token = generateToken();
+        TTK_LOG_STREAM("Console server session token: " << m_token);
+    }
+    return true;
+}
+
+quint16 MusicConsoleServer::port() const
+{
+    return m_server ? m_server->serverPort() : 0;
+}
+
+void MusicConsoleServer::handleRequest(QHttpRequest *request, QHttpResponse *response)
+{
+    m_requests.insert(request, response);
+    request->storeBody();
+    connect(request, SIGNAL(end()), SLOT(requestFinished()));
+}
+
+void MusicConsoleServer::requestFinished()
+{
+    QHttpRequest *request = TTKObjectCast(QHttpRequest*, sender());
+    if(!request || !m_requests.contains(request))
+    {
+        return;
+    }
+
+    const QPointer<QHttpResponse> response = m_requests.take(request);
+    if(response && request->successful() && authorize(request, response))
+    {
+        dispatch(request, response);
+    }
+}
+
+void MusicConsoleServer::stateChanged(const QString &event)
+{
+    if(m_clients.isEmpty())
+    {
+        return;
+    }
+
+    const QByteArray &data = "event: " + event.toUtf8() + "\ndata: " + toJson(eventPayload(event)) + "\n\n";
+
+    for(const QPointer<QHttpResponse> &client : qAsConst(m_clients))
+    {
+        if(client)
+        {
+            client->write(data);
+        }
+    }
+}
+
+void MusicConsoleServer::eventClientDone()
+{
+    QHttpResponse *response = TTKObjectCast(QHttpResponse*, sender());
+    m_clients.removeAll(response);
+}
+
+void MusicConsoleServer::heartbeat()
+{
+    // a write to a dropped connection closes it, so dead clients are released
+    for(const QPointer<QHttpResponse> &client : qAsConst(m_clients))
+    {
+        if(client)
+        {
+            client->write(": ping\n\n");
+        }
+    }
+}
+
+bool MusicConsoleServer::authorize(QHttpRequest *request, QHttpResponse *response)
+{
+    // web pages may reach local host too, a foreign host is a rebound name and a foreign origin is a cross site request
+    const QString &port = QString::number(m_server->serverPort());
+    const QString &host = request->header("host");
+    if(host != "127.0.0.1:" + port && host != "localhost:" + port)
+    {
+        writeError(response, QHttpResponse::STATUS_FORBIDDEN, "Host is not allowed");
+        return false;
+    }
+
+    const HeaderHash &headers = request->headers();
+    if(headers.contains("origin"))
+    {
+        const QString &origin = headers.value("origin");
+        if(origin != "http://127.0.0.1:" + port && origin != "http://localhost:" + port)
+        {
+            writeError(response, QHttpResponse::STATUS_FORBIDDEN, "Origin is not allowed");
+            return false;
+        }
+    }
+
+    // event sources can not set headers, so the token may be a query item as well
+    QString token = request->header("authorization");
+    token = token.startsWith("Bearer ", Qt::CaseInsensitive) ? token.mid(7).trimmed() : queryToken(request->url());
+    if(!tokenEquals(m_token, token))
+    {
+        writeError(response, QHttpResponse::STATUS_UNAUTHORIZED, "Session token is invalid");
+        return false;
+    }
+
+    // only json bodies are accepted, so a page can not post a form without a preflight
+    const QHttpRequest::HttpMethod method = request->method();
+    const bool hasBody = method == QHttpRequest::HTTP_POST || method == QHttpRequest::HTTP_PUT || !request->body().isEmpty();
+    const QString &type = request->header("content-type").section(';', 0, 0).trimmed().toLower();
+    if(hasBody && type != JSON_CONTENT_TYPE)
+    {
+        writeError(response, QHttpResponse::STATUS_REQUEST_UNSUPPORTED_MEDIA_TYPE, "Content type must be application/json");
+        return false;
+    }
+    return true;
+}
+
+void MusicConsoleServer::dispatch(QHttpRequest *request, QHttpResponse *response)
+{
+    const QString &path = request->path();
+    if(!path.startsWith(API_PREFIX))
+    {
+        writeError(response, QHttpResponse::STATUS_NOT_FOUND, "Resource not found");
+        return;
+    }
+
+    QVariantMap body;
+    if(!request->body().trimmed().isEmpty())
+    {
+        bool ok = false;
+        QJson::Parser json;
+        const QVariant &data = json.parse(request->body(), &ok);
+        if(!ok)
+        {
+            writeError(response, QHttpResponse::STATUS_BAD_REQUEST, "Request body is not valid json");
+            return;
+        }
+        body = data.toMap();
+    }
+
+    const QHttpRequest::HttpMethod method = request->method();
+    const QString &route = path.mid(strlen(API_PREFIX));
+    const QString &command = route.section(TTK_SEPARATOR, 0, 0);
+    const QString &argument = route.section(TTK_SEPARATOR, 1, 1);
+
+    if(command == "state" && method == QHttpRequest::HTTP_GET)
+    {
+        writeJson(response, QHttpResponse::STATUS_OK, m_state->state());
+    }
+    else if(command == "events" && method == QHttpRequest::HTTP_GET)
+    {
+        addEventClient(response);
+    }
+    else if(command == "play" && method == QHttpRequest::HTTP_POST)
+    {
+        const int index = body.value("index", qMax(0, m_playlist->currentIndex())).toInt();
+        if(!play(index))
+        {
+            writeError(response, QHttpResponse::STATUS_BAD_REQUEST, "Playlist index out of range");
+            return;
+        }
+        writeJson(response, QHttpResponse::STATUS_OK, m_state->state());
+    }
+    else if(command == "pause" && method == QHttpRequest::HTTP_POST)
+    {
+        if(m_player->isPlaying())
+        {
+            m_player->pause();
+        }
+        writeJson(response, QHttpResponse::STATUS_OK, m_state->state());
+    }
+    else if(command == "stop" && method == QHttpRequest::HTTP_POST)
+    {
+        m_player->stop();
+        writeJson(response, QHttpResponse::STATUS_OK, m_state->state());
+    }
+    else if((command == "next" || command == "previous") && method == QHttpRequest::HTTP_POST)
+    {
+        if(m_playlist->isEmpty())
+        {
+            writeError(response, QHttpResponse::STATUS_BAD_REQUEST, "Playlist is empty");
+            return;
+        }
+
+        m_playlist->setCurrentIndex(command == "next" ? PLAY_NEXT_LEVEL : PLAY_PREVIOUS_LEVEL);
+        play(m_playlist->currentIndex());
+        writeJson(response, QHttpResponse::STATUS_OK, m_state->state());
+    }
+    else if(command == "seek" && method == QHttpRequest::HTTP_POST)
+    {
+        bool ok = false;
+        const qint64 position = body.value("position").toLongLong(&ok);
+        if(!ok || position < 0)
+        {
+            writeError(response, QHttpResponse::STATUS_BAD_REQUEST, "Seek position is invalid");
+            return;
+        }
+
+        m_player->setPosition(position);
+        writeJson(response, QHttpResponse::STATUS_OK, m_state->state());
+    }
+    else if(command == "volume" && method == QHttpRequest::HTTP_POST)
+    {
+        bool ok = false;
+        const int volume = body.value("volume").toInt(&ok);
+        if(!ok)
+        {
+            writeError(response, QHttpResponse::STATUS_BAD_REQUEST, "Volume is invalid");
+            return;
+        }
+
+        m_state->setVolume(volume);
+        writeJson(response, QHttpResponse::STATUS_OK, m_state->state());
+    }
+    else if(command == "mode" && method == QHttpRequest::HTTP_POST)
+    {
+        TTK::PlayMode mode;
+        if(!MusicConsoleState::playbackModeByName(body.value("mode").toString(), &mode))
+        {
+            writeError(response, QHttpResponse::STATUS_BAD_REQUEST, "Play mode is unknown");
+            return;
+        }
+
+        m_playlist->setPlaybackMode(mode);
+        writeJson(response, QHttpResponse::STATUS_OK, m_state->state());
+    }
+    else if(command == "queue" && method == QHttpRequest::HTTP_POST)
+    {
+        const QString &path = body.value("path").toString();
+        if(path.isEmpty())
+        {
+            writeError(response, QHttpResponse::STATUS_BAD_REQUEST, "Queue path is empty");
+            return;
+        }
+
+        m_playlist->appendQueue(0, path);
+        m_state->notifyPlaylistChanged();
+        writeJson(response, QHttpResponse::STATUS_OK, m_state->playlist());
+    }
+    else if(command == "playlist")
+    {
+        if(method == QHttpRequest::HTTP_GET)
+        {
+            writeJson(response, QHttpResponse::STATUS_OK, m_state->playlist());
+        }
+        else if(method == QHttpRequest::HTTP_POST || method == QHttpRequest::HTTP_PUT)
+        {
+            QStringList paths = body.value("paths").toStringList();
+            if(body.contains("path"))
+            {
+                paths << body.value("path").toString();
+            }
+            paths.removeAll({});
+
+            if(paths.isEmpty())
+            {
+                writeError(response, QHttpResponse::STATUS_BAD_REQUEST, "Playlist paths are empty");
+                return;
+            }
+
+            // put replaces the whole playlist, post appends to it
+            if(method == QHttpRequest::HTTP_PUT)
+            {
+                m_player->stop();
+                m_playlist->add(0, paths);
+                m_playlist->setCurrentIndex(0);
+            }
+            else
+            {
+                m_playlist->append(0, paths);
+            }
+
+            m_state->notifyPlaylistChanged();
+            writeJson(response, QHttpResponse::STATUS_OK, m_state->playlist());
+        }
+        else if(method == QHttpRequest::HTTP_DELETE && argument.isEmpty())
+        {
+            m_player->stop();
+            m_playlist->clear();
+            m_playlist->setCurrentIndex(TTK_NORMAL_LEVEL);
+            m_state->notifyPlaylistChanged();
+            writeJson(response, QHttpResponse::STATUS_OK, m_state->playlist());
+        }
+        else if(method == QHttpRequest::HTTP_DELETE)
+        {
+            bool ok = false;
+            const int index = argument.toInt(&ok);
+            const int current = m_playlist->currentIndex();
+            if(!ok || !m_playlist->remove(index))
+            {
+                writeError(response, QHttpResponse::STATUS_NOT_FOUND, "Playlist index out of range");
+                return;
+            }
+
+            // keep the current item, or move on to the item after the removed one
+            if(index < current)
+            {
+                m_playlist->setCurrentIndex(current - 1);
+            }
+            else if(index == current)
+            {
+                m_player->stop();
+                m_playlist->setCurrentIndex(m_playlist->isEmpty() ? TTK_NORMAL_LEVEL : qMin(index, m_playlist->count() - 1));
+            }
+
+            m_state->notifyPlaylistChanged();
+            writeJson(response, QHttpResponse::STATUS_OK, m_state->playlist());
+        }
+        else
+        {
+            writeError(response, QHttpResponse::STATUS_METHOD_NOT_ALLOWED, "Method not allowed");
+        }
+    }
+    else
+    {
+        writeError(response, QHttpResponse::STATUS_NOT_FOUND, "Command not found");
+    }
+}
+
+void MusicConsoleServer::addEventClient(QHttpResponse *response)
+{
+    // no content length, so the stream lasts until the client goes away
+    response->setHeader("Content-Type", "text/event-stream");
+    response->setHeader("Cache-Control", "no-cache");
+    response->writeHead(QHttpResponse::STATUS_OK);
+
+    response->write("event: state\ndata: " + toJson(eventPayload("state")) + "\n\n");
+
+    connect(response, SIGNAL(done()), SLOT(eventClientDone()));
+    m_clients << response;
+}
+
+QVariant MusicConsoleServer::eventPayload(const QString &event) const
+{
+    if(event == "playlist")
+    {
+        return m_state->playlist();
+    }
+
+    if(event == "position")
+    {
+        QVariantMap value;
+        value["position"] = m_player->position();
+        value["duration"] = m_player->duration();
+        return value;
+    }
+
+    return m_state->state();
+}
+
+bool MusicConsoleServer::play(int index)
+{
+    if(index < 0 || index >= m_playlist->count())
+    {
+        return false;
+    }
+
+    if(index != m_playlist->currentIndex())
+    {
+        m_playlist->setCurrentIndex(index);
+    }
+
+    m_player->play();
+    m_player->setVolume(m_state->volume());
+    return true;
+}
@@ -0,0 +1,126 @@
+#ifndef MUSICCONSOLESERVER_H
+#define MUSICCONSOLESERVER_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QTimer>
+#include <QPointer>
+#include "musicobject.h"
+
+class QHttpServer;
+class QHttpRequest;
+class QHttpResponse;
+class MusicPlayer;
+class MusicPlaylist;
+class MusicConsoleState;
+
+/*! @brief The class of the music console remote control server.
+ * Commands are json requests under /api, state changes are pushed to the
+ * clients of /api/events as server sent events. Every request must carry the
+ * session token, as a bearer authorization header or as the token query item.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicConsoleServer : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    MusicConsoleServer(MusicPlayer *player, MusicPlaylist *playlist, MusicConsoleState *state, QObject *parent = nullptr);
+    /*!
+     * Object destructor.
+     */
+    ~MusicConsoleServer();
+
+    /*!
+     * Set the session token, a random one is made on listen if empty.
+     */
+    inline void setToken(const QString &token) { m_token = token; }
+    /*!
+     * Get the session token.
+     */
+    inline QString token() const { return m_token; }
+
+    /*!
+     * Listen on local host by port.
+     */
+    bool listen(quint16 port);
+    /*!
+     * Get the listening port.
+     */
+    quint16 port() const;
+
+private Q_SLOTS:
+    /*!
+     * Handle the new request.
+     */
+    void handleRequest(QHttpRequest *request, QHttpResponse *response);
+    /*!
+     * The body of the request is received.
+     */
+    void requestFinished();
+    /*!
+     * Push the state event to all event clients.
+     */
+    void stateChanged(const QString &event);
+    /*!
+     * Event client connection is done.
+     */
+    void eventClientDone();
+    /*!
+     * Keep the event client connections alive.
+     */
+    void heartbeat();
+
+private:
+    /*!
+     * Check the host, origin, token and content type of the request.
+     * Write the error response and return false when it is rejected.
+     */
+    bool authorize(QHttpRequest *request, QHttpResponse *response);
+    /*!
+     * Dispatch the command of the request.
+     */
+    void dispatch(QHttpRequest *request, QHttpResponse *response);
+    /*!
+     * Add the event client.
+     */
+    void addEventClient(QHttpResponse *response);
+    /*!
+     * Get the payload of the state event.
+     */
+    QVariant eventPayload(const QString &event) const;
+    /*!
+     * Start to play by playlist index.
+     */
+    bool play(int index);
+
+    QHttpServer *m_server;
+    MusicPlayer *m_player;
+    MusicPlaylist *m_playlist;
+    MusicConsoleState *m_state;
+    QString m_token;
+    QTimer m_timer;
+    QHash<QHttpRequest*, QPointer<QHttpResponse>> m_requests;
+    QList<QPointer<QHttpResponse>> m_clients;
+
+};
+
+#endif // MUSICCONSOLESERVER_H
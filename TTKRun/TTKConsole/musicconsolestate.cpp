@@ -0,0 +1,118 @@
+#include "musicconsolestate.h"
+#include "musicplayer.h"
+#include "musicplaylist.h"
+
+MusicConsoleState::MusicConsoleState(MusicPlayer *player, MusicPlaylist *playlist, QObject *parent)
+    : QObject(parent),
+      m_player(player),
+      m_playlist(playlist),
+      m_volume(100),
+      m_second(-1),
+      m_enhanced("Off")
+{
+    connect(m_player, SIGNAL(stateChanged(TTK::PlayState)), SLOT(updateState()));
+    connect(m_player, SIGNAL(durationChanged(qint64)), SLOT(updateState()));
+    connect(m_player, SIGNAL(positionChanged(qint64)), SLOT(positionChanged(qint64)));
+    connect(m_playlist, SIGNAL(currentIndexChanged(int)), SLOT(updateState()));
+    connect(m_playlist, SIGNAL(playbackModeChanged(TTK::PlayMode)), SLOT(updateState()));
+}
+
+void MusicConsoleState::setVolume(int volume)
+{
+    m_volume = qBound(0, volume, 100);
+    m_player->setVolume(m_volume);
+    Q_EMIT stateChanged("volume");
+}
+
+void MusicConsoleState::setEnhanced(const QString &enhanced)
+{
+    m_enhanced = enhanced;
+    Q_EMIT stateChanged("state");
+}
+
+void MusicConsoleState::notifyPlaylistChanged()
+{
+    Q_EMIT stateChanged("playlist");
+}
+
+QVariantMap MusicConsoleState::state() const
+{
+    QString state;
+    switch(m_player->state())
+    {
+        case TTK::PlayState::Playing: state = "Playing"; break;
+        case TTK::PlayState::Paused: state = "Paused"; break;
+        default: state = "Stopped"; break;
+    }
+
+    QVariantMap value;
+    value["state"] = state;
+    value["index"] = m_playlist->currentIndex();
+    value["path"] = m_playlist->currentMediaPath();
+    value["position"] = m_player->position();
+    value["duration"] = m_player->duration();
+    value["volume"] = m_volume;
+    value["mode"] = playbackModeName(m_playlist->playbackMode());
+    value["enhanced"] = m_enhanced;
+    value["count"] = m_playlist->count();
+    return value;
+}
+
+QVariantMap MusicConsoleState::playlist() const
+{
+    QVariantList items;
+    for(const MusicPlayItem &item : qAsConst(m_playlist->mediaList()))
+    {
+        items << item.m_path;
+    }
+
+    QVariantMap value;
+    value["index"] = m_playlist->currentIndex();
+    value["items"] = items;
+    return value;
+}
+
+QString MusicConsoleState::playbackModeName(TTK::PlayMode mode)
+{
+    switch(mode)
+    {
+        case TTK::PlayMode::Order: return "Order";
+        case TTK::PlayMode::Random: return "Random";
+        case TTK::PlayMode::ListLoop: return "ListLoop";
+        case TTK::PlayMode::OneLoop: return "OneLoop";
+        case TTK::PlayMode::Once: return "Once";
+        default: return {};
+    }
+}
+
+bool MusicConsoleState::playbackModeByName(const QString &name, TTK::PlayMode *mode)
+{
+    static const TTK::PlayMode modes[] = {TTK::PlayMode::Order, TTK::PlayMode::Random, TTK::PlayMode::ListLoop, TTK::PlayMode::OneLoop, TTK::PlayMode::Once};
+    for(const TTK::PlayMode m : modes)
+    {
+        if(playbackModeName(m).compare(name, Qt::CaseInsensitive) == 0)
+        {
+            *mode = m;
+            return true;
+        }
+    }
+    return false;
+}
+
+void MusicConsoleState::updateState()
+{
+    // the next position event is sent at once
+    m_second = -1;
+    Q_EMIT stateChanged("state");
+}
+
+void MusicConsoleState::positionChanged(qint64 position)
+{
+    // the player ticks several times per second, listeners only need the seconds
+    const qint64 second = position / TTK_DN_S2MS;
+    if(second != m_second)
+    {
+        m_second = second;
+        Q_EMIT stateChanged("position");
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef MUSICCONSOLESTATE_H
+#define MUSICCONSOLESTATE_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include "musicobject.h"
+
+class MusicPlayer;
+class MusicPlaylist;
+
+/*! @brief The class of the music console state model.
+ * Player and playlist signals are turned into named events, position events
+ * are coalesced to one per second.
+ * @author Greedysky <greedysky@163.com>
+ */
+class TTK_MODULE_EXPORT MusicConsoleState : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicConsoleState(MusicPlayer *player, MusicPlaylist *playlist, QObject *parent = nullptr);
+
+    /*!
+     * Set current player volume.
+     */
+    void setVolume(int volume);
+    /*!
+     * Get current player volume.
+     */
+    inline int volume() const { return m_volume; }
+
+    /*!
+     * Set current player enhanced name.
+     */
+    void setEnhanced(const QString &enhanced);
+    /*!
+     * Get current player enhanced name.
+     */
+    inline QString enhanced() const { return m_enhanced; }
+
+    /*!
+     * Notify the playlist items have changed.
+     */
+    void notifyPlaylistChanged();
+
+    /*!
+     * Get the snapshot of the player state.
+     */
+    QVariantMap state() const;
+    /*!
+     * Get the snapshot of the playlist.
+     */
+    QVariantMap playlist() const;
+
+    /*!
+     * Map play mode to name.
+     */
+    static QString playbackModeName(TTK::PlayMode mode);
+    /*!
+     * Map name to play mode, false when name is unknown.
+     */
+    static bool playbackModeByName(const QString &name, TTK::PlayMode *mode);
+
+Q_SIGNALS:
+    /*!
+     * Player state changed, event is state, position, volume or playlist.
+     */
+    void stateChanged(const QString &event);
+
+private Q_SLOTS:
+    /*!
+     * Play state, duration, playlist index or play mode changed.
+     */
+    void updateState();
+    /*!
+     * Current position changed.
+     */
+    void positionChanged(qint64 position);
+
+private:
+    MusicPlayer *m_player;
+    MusicPlaylist *m_playlist;
+    int m_volume;
+    qint64 m_second;
+    QString m_enhanced;
+
+};
+
+#endif // MUSICCONSOLESTATE_H
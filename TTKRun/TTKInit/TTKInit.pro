@@ -46,7 +46,7 @@ win32{
     }
 }
 
-LIBS += -L$$DESTDIR -lTTKConfig
+LIBS += -L$$DESTDIR -lTTKConfig -lTTKLibrary
 
 INCLUDEPATH += \
     $$PWD/../../TTKCommon \
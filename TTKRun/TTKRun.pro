@@ -19,3 +19,8 @@
 TEMPLATE = subdirs
 CONFIG += ordered
 SUBDIRS += TTKInit TTKConsole TTKApp TTKTools
+
+# qmake "CONFIG += ttk_benchmark" builds the benchmark too
+ttk_benchmark:SUBDIRS += TTKBenchmark
+# qmake "CONFIG += ttk_test" builds the tests too
+ttk_test:SUBDIRS += TTKTest
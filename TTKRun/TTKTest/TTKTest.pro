@@ -0,0 +1,87 @@
+# ***************************************************************************
+# * This file is part of the TTK Music Player project
+# * Copyright (C) 2015 - 2024 Greedysky Studio
+#
+# * This program is free software; you can redistribute it and/or modify
+# * it under the terms of the GNU General Public License as published by
+# * the Free Software Foundation; either version 3 of the License, or
+# * (at your option) any later version.
+#
+# * This program is distributed in the hope that it will be useful,
+# * but WITHOUT ANY WARRANTY; without even the implied warranty of
+# * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# * GNU General Public License for more details.
+#
+# * You should have received a copy of the GNU General Public License along
+# * with this program; If not, see <http://www.gnu.org/licenses/>.
+# ***************************************************************************
+
+
+QT += core gui network testlib
+greaterThan(QT_MAJOR_VERSION, 4){ #Qt5
+    QT += multimedia
+}else:unix{
+    QMAKE_CXXFLAGS += -I/usr/include/QtMultimediaKit -I/usr/include/QtMobility
+    LIBS += -lQtMultimediaKit
+}
+
+TEMPLATE = app
+CONFIG += console
+
+include($$PWD/../../TTKVersion.pri)
+
+DESTDIR = $$OUT_PWD/../../bin/$$TTK_VERSION
+TARGET = TTKTest
+
+DEFINES += TTK_LIBRARY
+
+win32:msvc{
+    CONFIG += c++11
+}else{
+    equals(QT_MAJOR_VERSION, 6){ #Qt6
+        QMAKE_CXXFLAGS += -std=c++17
+    }else{
+        QMAKE_CXXFLAGS += -std=c++11
+    }
+}
+
+LIBS += -L$$DESTDIR -lTTKCore -lTTKLibrary -lTTKExtras
+unix:LIBS += -L$$DESTDIR -lTTKqmmp -lTTKUi -lTTKWatcher -lTTKDumper -lTTKZip -lzlib
+
+INCLUDEPATH += \
+    $$PWD/../../TTKCommon \
+    $$PWD/../../TTKCommon/TTKLibrary \
+    $$PWD/../../TTKModule/TTKCore/musicCoreKits \
+    $$PWD/../../TTKModule/TTKCore/musicLrcKits \
+    $$PWD/../../TTKModule/TTKCore/musicNetworkKits/core \
+    $$PWD/../../TTKModule/TTKCore/musicPlaylistKits \
+    $$PWD/../../TTKModule/TTKCore/musicToolsKits \
+    $$PWD/../../TTKModule/TTKCore/musicToolsSetsKits \
+    $$PWD/../../TTKModule/TTKCore/musicUtilsKits \
+    $$PWD/../../TTKThirdParty/TTKExtras \
+    $$PWD/../TTKConsole
+
+HEADERS += \
+    $$PWD/../TTKConsole/musicconsolestate.h \
+    $$PWD/../TTKConsole/musicconsoleserver.h \
+    $$PWD/musicconsoleservertest.h \
+    $$PWD/musicplaylisttest.h \
+    $$PWD/musicplaylistsnapshottest.h \
+    $$PWD/musicthreadpooltest.h \
+    $$PWD/musicaudiorecordertest.h \
+    $$PWD/musicaudiofingerprinttest.h \
+    $$PWD/musicconnecttransfertest.h \
+    $$PWD/musicnetworktesttest.h
+
+SOURCES += \
+    $$PWD/musictestmain.cpp \
+    $$PWD/../TTKConsole/musicconsolestate.cpp \
+    $$PWD/../TTKConsole/musicconsoleserver.cpp \
+    $$PWD/musicconsoleservertest.cpp \
+    $$PWD/musicplaylisttest.cpp \
+    $$PWD/musicplaylistsnapshottest.cpp \
+    $$PWD/musicthreadpooltest.cpp \
+    $$PWD/musicaudiorecordertest.cpp \
+    $$PWD/musicaudiofingerprinttest.cpp \
+    $$PWD/musicconnecttransfertest.cpp \
+    $$PWD/musicnetworktesttest.cpp
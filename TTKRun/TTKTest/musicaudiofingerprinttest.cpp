@@ -0,0 +1,175 @@
+#include "musicaudiofingerprinttest.h"
+#include "musicfileutils.h"
+
+#include <qmath.h>
+
+static constexpr int SAMPLE_RATE = 44100;
+static constexpr int SONG_COUNT = 3;
+static constexpr int SONG_SECONDS = 30;
+static constexpr int CLIP_SECONDS = 8;
+
+/*!
+ * Next value of the linear congruential generator, the tests are the same on every run.
+ */
+static quint32 nextRandom(quint32 &seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+/*!
+ * Mono 16 bit melody of decaying notes, a quarter second each, the seed picks the pitches.
+ */
+static QByteArray melody(quint32 seed, int seconds)
+{
+    const int count = SAMPLE_RATE * seconds;
+    const int note = SAMPLE_RATE / 4;
+
+    QByteArray data(count * sizeof(qint16), 0);
+    qint16 *samples = TTKReinterpretCast(qint16*, data.data());
+
+    double frequency = 0, phase = 0, overtone = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        if(i % note == 0)
+        {
+            frequency = 200 + nextRandom(seed) % 2800;
+        }
+
+        phase += 2 * M_PI * frequency / SAMPLE_RATE;
+        overtone += 2 * M_PI * frequency * 0.37 / SAMPLE_RATE;
+
+        const double envelope = std::exp(-3.0 * (i % note) / note);
+        samples[i] = qint16(12000 * envelope * (std::sin(phase) + 0.5 * std::sin(overtone)));
+    }
+    return data;
+}
+
+/*!
+ * Mono 16 bit white noise.
+ */
+static QByteArray whiteNoise(int seconds)
+{
+    const int count = SAMPLE_RATE * seconds;
+    QByteArray data(count * sizeof(qint16), 0);
+    qint16 *samples = TTKReinterpretCast(qint16*, data.data());
+
+    quint32 seed = 7;
+    for(int i = 0; i < count; ++i)
+    {
+        samples[i] = qint16(int(nextRandom(seed) % 20000) - 10000);
+    }
+    return data;
+}
+
+/*!
+ * Path of the generated song by index.
+ */
+static QString songPath(int index)
+{
+    return QString("song%1.wav").arg(index);
+}
+
+
+MusicAudioFingerprintTest::MusicAudioFingerprintTest(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+void MusicAudioFingerprintTest::initTestCase()
+{
+    m_dir = QDir::tempPath() + QString("/TTKTest-%1/").arg(QCoreApplication::applicationPid());
+    QVERIFY(QDir().mkpath(m_dir));
+
+    MusicFingerprintSongList songs;
+    QVector<MusicFingerprintIndex::Entry> entries;
+    for(int i = 0; i < SONG_COUNT; ++i)
+    {
+        for(const MusicFingerprintHash &hash : MusicAudioFingerprint::fromPcm(melody(i + 1, SONG_SECONDS), SAMPLE_RATE))
+        {
+            MusicFingerprintIndex::Entry entry;
+            entry.m_hash = hash.m_hash;
+            entry.m_song = i;
+            entry.m_time = hash.m_time;
+            entries << entry;
+        }
+
+        MusicFingerprintSong song;
+        song.m_path = songPath(i);
+        song.m_size = 0;
+        song.m_modified = 0;
+        songs << song;
+    }
+
+    const QString &path = m_dir + "fingerprint.ttk";
+    QVERIFY(MusicFingerprintIndex::save(path, songs, entries));
+    QVERIFY(m_index.load(path));
+    QCOMPARE(m_index.songs().count(), SONG_COUNT);
+}
+
+void MusicAudioFingerprintTest::cleanupTestCase()
+{
+    m_index.close();
+    TTK::File::removeRecursively(m_dir);
+}
+
+void MusicAudioFingerprintTest::identifySong_data()
+{
+    QTest::addColumn<int>("song");
+
+    for(int i = 0; i < SONG_COUNT; ++i)
+    {
+        QTest::newRow(qPrintable(songPath(i))) << i;
+    }
+}
+
+void MusicAudioFingerprintTest::identifySong()
+{
+    QFETCH(int, song);
+
+    MusicFingerprintMatch match;
+    QVERIFY(m_index.find(MusicAudioFingerprint::fromPcm(melody(song + 1, SONG_SECONDS), SAMPLE_RATE), &match));
+    QCOMPARE(match.m_path, songPath(song));
+    QCOMPARE(match.m_position, qint64(0));
+}
+
+void MusicAudioFingerprintTest::timeOffset_data()
+{
+    QTest::addColumn<int>("offset");
+
+    // the offsets are not multiples of the hash time unit
+    QTest::newRow("3s") << 3000;
+    QTest::newRow("7.3s") << 7300;
+    QTest::newRow("12.77s") << 12770;
+}
+
+void MusicAudioFingerprintTest::timeOffset()
+{
+    QFETCH(int, offset);
+
+    const int song = 1;
+    const int start = qint64(offset) * SAMPLE_RATE / TTK_DN_S2MS;
+    const QByteArray &clip = melody(song + 1, SONG_SECONDS).mid(start * sizeof(qint16), SAMPLE_RATE * CLIP_SECONDS * sizeof(qint16));
+
+    MusicFingerprintMatch match;
+    QVERIFY(m_index.find(MusicAudioFingerprint::fromPcm(clip, SAMPLE_RATE), &match));
+    QCOMPARE(match.m_path, songPath(song));
+    QVERIFY(qAbs(match.m_position - offset) <= 2 * MusicAudioFingerprint::timeUnit());
+}
+
+void MusicAudioFingerprintTest::noMatch_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("white noise") << whiteNoise(CLIP_SECONDS);
+    QTest::newRow("unknown melody") << melody(99, CLIP_SECONDS);
+}
+
+void MusicAudioFingerprintTest::noMatch()
+{
+    QFETCH(QByteArray, data);
+
+    MusicFingerprintMatch match;
+    QVERIFY(!m_index.find(MusicAudioFingerprint::fromPcm(data, SAMPLE_RATE), &match));
+}
@@ -0,0 +1,69 @@
+#ifndef MUSICAUDIOFINGERPRINTTEST_H
+#define MUSICAUDIOFINGERPRINTTEST_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QtTest>
+#include "musicfingerprintindex.h"
+
+/*! @brief The class of the audio fingerprint test, songs are generated melodies.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicAudioFingerprintTest : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicAudioFingerprintTest(QObject *parent = nullptr);
+
+private Q_SLOTS:
+    /*!
+     * Save and map the index of the generated songs.
+     */
+    void initTestCase();
+    /*!
+     * Unmap and remove the index.
+     */
+    void cleanupTestCase();
+
+    /*!
+     * A whole song is identified against its own index.
+     */
+    void identifySong_data();
+    void identifySong();
+    /*!
+     * A clip from the middle of a song votes for its time offset.
+     */
+    void timeOffset_data();
+    void timeOffset();
+    /*!
+     * Audio that is not indexed gives no match.
+     */
+    void noMatch_data();
+    void noMatch();
+
+private:
+    QString m_dir;
+    MusicFingerprintIndex m_index;
+
+};
+
+#endif // MUSICAUDIOFINGERPRINTTEST_H
@@ -0,0 +1,326 @@
+#include "musicaudiorecordertest.h"
+#include "musicaudiorecordermodule.h"
+#include "musicaudiorecorderwriter.h"
+#include "musicfileutils.h"
+
+#include <QtEndian>
+
+/*!
+ * Pcm format of the test input.
+ */
+static QAudioFormat makeFormat(int channels, int sampleSize, QAudioFormat::SampleType type, QAudioFormat::Endian order = QAudioFormat::LittleEndian, int sampleRate = 8000)
+{
+    QAudioFormat format;
+    format.setChannelCount(channels);
+    format.setSampleSize(sampleSize);
+    format.setSampleRate(sampleRate);
+    format.setSampleType(type);
+    format.setByteOrder(order);
+    format.setCodec("audio/pcm");
+    return format;
+}
+
+template <typename T>
+static void writeValue(QByteArray &data, T value, QAudioFormat::Endian order = QAudioFormat::LittleEndian)
+{
+    uchar buffer[sizeof(T)];
+    if(order == QAudioFormat::LittleEndian)
+    {
+        qToLittleEndian<T>(value, buffer);
+    }
+    else
+    {
+        qToBigEndian<T>(value, buffer);
+    }
+    data.append(TTKReinterpretCast(const char*, buffer), sizeof(T));
+}
+
+/*!
+ * Little endian float samples.
+ */
+static QByteArray floatSamples(const QVector<float> &samples)
+{
+    QByteArray data;
+    for(const float sample : samples)
+    {
+        quint32 value;
+        memcpy(&value, &sample, sizeof(float));
+        writeValue<quint32>(data, value);
+    }
+    return data;
+}
+
+/*!
+ * Integer samples by byte order.
+ */
+template <typename T>
+static QByteArray samples(const QVector<T> &values, QAudioFormat::Endian order = QAudioFormat::LittleEndian)
+{
+    QByteArray data;
+    for(const T value : values)
+    {
+        writeValue<T>(data, value, order);
+    }
+    return data;
+}
+
+/*! @brief The class of the input device stand-in that returns a few bytes per read.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicChunkDevice : public QIODevice
+{
+public:
+    MusicChunkDevice(const QByteArray &data, int chunk)
+        : m_data(data),
+          m_chunk(chunk),
+          m_pos(0)
+    {
+        open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    }
+
+private:
+    virtual qint64 readData(char *data, qint64 maxSize) override final
+    {
+        const qint64 size = qMin<qint64>(qMin<qint64>(maxSize, m_chunk), m_data.size() - m_pos);
+        memcpy(data, m_data.constData() + m_pos, size);
+        m_pos += size;
+        return size;
+    }
+
+    virtual qint64 writeData(const char *, qint64) override final
+    {
+        return -1;
+    }
+
+    QByteArray m_data;
+    int m_chunk;
+    int m_pos;
+
+};
+
+/*!
+ * Record all data of the device by format into the file.
+ */
+static void record(MusicAudioRecorderModule *module, QIODevice *device, const QAudioFormat &format)
+{
+    module->setInputDevice(device, format);
+    module->onRecordStart();
+    module->onRecordStop();
+}
+
+/*!
+ * Record all data of the buffer device by format into the file.
+ */
+static void record(MusicAudioRecorderModule *module, const QByteArray &data, const QAudioFormat &format)
+{
+    QByteArray bytes = data;
+    QBuffer device(&bytes);
+    device.open(QIODevice::ReadOnly);
+    record(module, &device, format);
+}
+
+
+MusicAudioRecorderTest::MusicAudioRecorderTest(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+void MusicAudioRecorderTest::initTestCase()
+{
+    m_dir = QDir::tempPath() + QString("/TTKTest-%1/").arg(QCoreApplication::applicationPid());
+    QVERIFY(QDir().mkpath(m_dir));
+}
+
+void MusicAudioRecorderTest::cleanupTestCase()
+{
+    TTK::File::removeRecursively(m_dir);
+}
+
+void MusicAudioRecorderTest::formatConversion_data()
+{
+    QTest::addColumn<int>("channels");
+    QTest::addColumn<int>("sampleSize");
+    QTest::addColumn<int>("type");
+    QTest::addColumn<int>("order");
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<QByteArray>("output");
+
+    QTest::newRow("mono s16le") << 1 << 16 << int(QAudioFormat::SignedInt) << int(QAudioFormat::LittleEndian)
+                                << samples<qint16>({100, -200, 32767, -32768}) << samples<qint16>({100, -200, 32767, -32768});
+    QTest::newRow("mono s16be") << 1 << 16 << int(QAudioFormat::SignedInt) << int(QAudioFormat::BigEndian)
+                                << samples<qint16>({1234, -4321}, QAudioFormat::BigEndian) << samples<qint16>({1234, -4321});
+    QTest::newRow("stereo s16le") << 2 << 16 << int(QAudioFormat::SignedInt) << int(QAudioFormat::LittleEndian)
+                                  << samples<qint16>({1000, 3000, -1000, -3000}) << samples<qint16>({2000, -2000});
+    QTest::newRow("mono u16le") << 1 << 16 << int(QAudioFormat::UnSignedInt) << int(QAudioFormat::LittleEndian)
+                                << samples<quint16>({0x8000, 0xFFFF, 0}) << samples<qint16>({0, 32767, -32768});
+    QTest::newRow("mono u8") << 1 << 8 << int(QAudioFormat::UnSignedInt) << int(QAudioFormat::LittleEndian)
+                             << samples<quint8>({0x80, 0x90, 0x00}) << samples<qint16>({0, 0x1000, -0x8000});
+    QTest::newRow("mono s8") << 1 << 8 << int(QAudioFormat::SignedInt) << int(QAudioFormat::LittleEndian)
+                             << samples<qint8>({0x10, -1}) << samples<qint16>({0x1000, -0x100});
+    QTest::newRow("mono s32le") << 1 << 32 << int(QAudioFormat::SignedInt) << int(QAudioFormat::LittleEndian)
+                                << samples<qint32>({0x12345678, -5 * 0x10000}) << samples<qint16>({0x1234, -5});
+    QTest::newRow("stereo float") << 2 << 32 << int(QAudioFormat::Float) << int(QAudioFormat::LittleEndian)
+                                  << floatSamples({0.5f, 0.5f, -1.0f, -2.0f, 1.0f, -1.0f}) << samples<qint16>({16384, -32767, 0});
+}
+
+void MusicAudioRecorderTest::formatConversion()
+{
+    QFETCH(int, channels);
+    QFETCH(int, sampleSize);
+    QFETCH(int, type);
+    QFETCH(int, order);
+    QFETCH(QByteArray, input);
+    QFETCH(QByteArray, output);
+
+    MusicAudioRecorderModule module;
+    module.setFileName(m_dir + "conversion.wav");
+    record(&module, input, makeFormat(channels, sampleSize, QAudioFormat::SampleType(type), QAudioFormat::Endian(order)));
+
+    QVERIFY(!module.error());
+    QCOMPARE(module.pcmData(), output);
+}
+
+void MusicAudioRecorderTest::waveHeader_data()
+{
+    QTest::addColumn<int>("sampleSize");
+    QTest::addColumn<int>("type");
+    QTest::addColumn<int>("tag");
+    QTest::addColumn<QByteArray>("input");
+
+    // one second of 44.1 kHz stereo at half of the full scale
+    QVector<qint16> values(44100 * 2);
+    QVector<float> floats(44100 * 2);
+    for(int i = 0; i < values.count(); ++i)
+    {
+        values[i] = i % 2 ? 16384 : -16384;
+        floats[i] = i % 2 ? 0.5f : -0.5f;
+    }
+
+    QTest::newRow("s16 pcm") << 16 << int(QAudioFormat::SignedInt) << 1 << samples<qint16>(values);
+    QTest::newRow("ieee float") << 32 << int(QAudioFormat::Float) << 3 << floatSamples(floats);
+}
+
+void MusicAudioRecorderTest::waveHeader()
+{
+    QFETCH(int, sampleSize);
+    QFETCH(int, type);
+    QFETCH(int, tag);
+    QFETCH(QByteArray, input);
+
+    const int frameBytes = 2 * sampleSize / 8;
+    MusicAudioRecorderModule module;
+    module.setFileName(m_dir + "header.wav");
+    QSignalSpy spy(&module, SIGNAL(levelChanged(float)));
+    record(&module, input, makeFormat(2, sampleSize, QAudioFormat::SampleType(type), QAudioFormat::LittleEndian, 44100));
+
+    QFile file(module.fileName());
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray &data = file.readAll();
+    QCOMPARE(data.size(), MusicAudioRecorderWriter::headerSize() + input.size());
+
+    const uchar *header = TTKReinterpretCast(const uchar*, data.constData());
+    QCOMPARE(data.left(4), QByteArray("RIFF"));
+    QCOMPARE(qFromLittleEndian<quint32>(header + 4), quint32(data.size() - 8));
+    QCOMPARE(data.mid(8, 8), QByteArray("WAVEfmt "));
+    QCOMPARE(qFromLittleEndian<quint16>(header + 20), quint16(tag));
+    QCOMPARE(qFromLittleEndian<quint16>(header + 22), quint16(2));
+    QCOMPARE(qFromLittleEndian<quint32>(header + 24), quint32(44100));
+    QCOMPARE(qFromLittleEndian<quint32>(header + 28), quint32(44100 * frameBytes));
+    QCOMPARE(qFromLittleEndian<quint16>(header + 32), quint16(frameBytes));
+    QCOMPARE(qFromLittleEndian<quint16>(header + 34), quint16(sampleSize));
+    QCOMPARE(data.mid(36, 4), QByteArray("data"));
+    QCOMPARE(qFromLittleEndian<quint32>(header + 40), quint32(input.size()));
+
+    QCOMPARE(module.pcmData(), QByteArray(44100 * 2, '\0'));
+    QVERIFY(!spy.isEmpty());
+    QCOMPARE(spy.first().first().toFloat(), 0.5f);
+}
+
+void MusicAudioRecorderTest::recordRestart()
+{
+    const QAudioFormat &format = makeFormat(1, 16, QAudioFormat::SignedInt);
+    MusicAudioRecorderModule module;
+    module.setFileName(m_dir + "restart.wav");
+
+    record(&module, samples<qint16>({1, 2, 3, 4, 5, 6}), format);
+    QCOMPARE(module.pcmData(), samples<qint16>({1, 2, 3, 4, 5, 6}));
+
+    record(&module, samples<qint16>({7, 8}), format);
+    QCOMPARE(module.pcmData(), samples<qint16>({7, 8}));
+}
+
+void MusicAudioRecorderTest::unsupportedFormat_data()
+{
+    QTest::addColumn<int>("sampleSize");
+    QTest::addColumn<QString>("codec");
+
+    QTest::newRow("24 bit") << 24 << QString("audio/pcm");
+    QTest::newRow("compressed") << 16 << QString("audio/mpeg");
+}
+
+void MusicAudioRecorderTest::unsupportedFormat()
+{
+    QFETCH(int, sampleSize);
+    QFETCH(QString, codec);
+
+    QAudioFormat format = makeFormat(1, sampleSize, QAudioFormat::SignedInt);
+    format.setCodec(codec);
+
+    MusicAudioRecorderModule module;
+    module.setFileName(m_dir + "unsupported.wav");
+    QFile::remove(module.fileName());
+    record(&module, QByteArray(sampleSize * 16, '\1'), format);
+
+    QVERIFY(module.error());
+    QVERIFY(!QFile::exists(module.fileName()));
+    QVERIFY(module.pcmData().isEmpty());
+}
+
+void MusicAudioRecorderTest::splitFrames()
+{
+    // three bytes per read, every stereo frame is split over two reads
+    QVector<qint16> values;
+    for(int i = 0; i < 1000; ++i)
+    {
+        values << qint16(i) << qint16(i + 2);
+    }
+
+    QVector<qint16> mono;
+    for(int i = 0; i < 1000; ++i)
+    {
+        mono << qint16(i + 1);
+    }
+
+    MusicChunkDevice device(samples<qint16>(values), 3);
+    MusicAudioRecorderModule module;
+    module.setFileName(m_dir + "split.wav");
+    record(&module, &device, makeFormat(2, 16, QAudioFormat::SignedInt));
+
+    QCOMPARE(module.pcmData(), samples<qint16>(mono));
+}
+
+void MusicAudioRecorderTest::bufferOverflow()
+{
+    // one hertz keeps the ring buffer at its minimum size, far less than the input
+    QVector<qint16> values;
+    for(int i = 0; i < 256 * 1024; ++i)
+    {
+        values << 1000 << 3000 << 5000;
+    }
+
+    MusicChunkDevice device(samples<qint16>(values), 4093);
+    MusicAudioRecorderModule module;
+    module.setFileName(m_dir + "overflow.wav");
+    record(&module, &device, makeFormat(3, 16, QAudioFormat::SignedInt, QAudioFormat::LittleEndian, 1));
+
+    // frames may be dropped, but every frame left must still be a whole one
+    const QByteArray &data = module.pcmData();
+    QVERIFY(!data.isEmpty());
+
+    const uchar *pcm = TTKReinterpretCast(const uchar*, data.constData());
+    for(int i = 0; i < data.size(); i += 2)
+    {
+        QCOMPARE(qFromLittleEndian<qint16>(pcm + i), qint16(3000));
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef MUSICAUDIORECORDERTEST_H
+#define MUSICAUDIORECORDERTEST_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QtTest>
+
+/*! @brief The class of the audio recorder test, samples come from a buffer device.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicAudioRecorderTest : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicAudioRecorderTest(QObject *parent = nullptr);
+
+private Q_SLOTS:
+    /*!
+     * Create the output directory.
+     */
+    void initTestCase();
+    /*!
+     * Remove the output directory.
+     */
+    void cleanupTestCase();
+
+    /*!
+     * Recorded samples are converted to mono 16 bit pcm.
+     */
+    void formatConversion_data();
+    void formatConversion();
+    /*!
+     * Wav header is patched by the input format and the written size.
+     */
+    void waveHeader_data();
+    void waveHeader();
+    /*!
+     * Record again truncates the previous samples.
+     */
+    void recordRestart();
+    /*!
+     * Formats that can not be converted are rejected.
+     */
+    void unsupportedFormat_data();
+    void unsupportedFormat();
+    /*!
+     * Frames split over reads of the device are kept whole.
+     */
+    void splitFrames();
+    /*!
+     * Overflow of the ring buffer drops whole frames only.
+     */
+    void bufferOverflow();
+
+private:
+    QString m_dir;
+
+};
+
+#endif // MUSICAUDIORECORDERTEST_H
@@ -0,0 +1,190 @@
+#include "musicconnecttransfertest.h"
+#include "musicconnecttransferthread.h"
+#include "musicfileutils.h"
+
+static constexpr const char *MANIFEST_NAME = ".ttkmanifest";
+
+/*! @brief The class of the transfer result.
+ * @author Greedysky <greedysky@163.com>
+ */
+struct MusicTransferResult
+{
+    int m_copied;
+    int m_skipped;
+    int m_removed;
+};
+
+/*!
+ * Run the transfer of the files to the device and wait until it finished.
+ */
+static MusicTransferResult transfer(const QString &device, const QStringList &files, bool removeOrphans = false)
+{
+    MusicConnectTransferThread thread;
+    thread.setFilePath(device, files);
+    thread.setRemoveOrphans(removeOrphans);
+
+    QSignalSpy spy(&thread, SIGNAL(transferFinished(int,int,int)));
+    thread.start();
+    thread.wait();
+
+    MusicTransferResult result = {-1, -1, -1};
+    if(spy.count() == 1)
+    {
+        const QList<QVariant> &arguments = spy.first();
+        result.m_copied = arguments[0].toInt();
+        result.m_skipped = arguments[1].toInt();
+        result.m_removed = arguments[2].toInt();
+    }
+    return result;
+}
+
+/*!
+ * Read all data of the file.
+ */
+static QByteArray readFile(const QString &path)
+{
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+/*!
+ * Write the data to the file.
+ */
+static bool writeFile(const QString &path, const QByteArray &data)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+
+MusicConnectTransferTest::MusicConnectTransferTest(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+void MusicConnectTransferTest::initTestCase()
+{
+    m_dir = QDir::tempPath() + QString("/TTKTest-%1/").arg(QCoreApplication::applicationPid());
+    m_device = m_dir + "device/";
+
+    const QString &source = m_dir + "source/";
+    QVERIFY(QDir().mkpath(source));
+
+    // the last one is larger than a copy chunk
+    const QList<int> sizes{1024, 64 * 1024, 3 * 1024 * 1024 / 2};
+    for(int i = 0; i < sizes.count(); ++i)
+    {
+        QByteArray data(sizes[i], 0);
+        for(int j = 0; j < data.size(); ++j)
+        {
+            data[j] = char((j * (i + 3)) & 0xFF);
+        }
+
+        const QString &path = source + QString("song%1.mp3").arg(i);
+        QVERIFY(writeFile(path, data));
+        m_files << path;
+    }
+}
+
+void MusicConnectTransferTest::cleanupTestCase()
+{
+    TTK::File::removeRecursively(m_dir);
+}
+
+void MusicConnectTransferTest::init()
+{
+    TTK::File::removeRecursively(m_device);
+    QVERIFY(QDir().mkpath(m_device));
+}
+
+void MusicConnectTransferTest::incrementalSkip()
+{
+    MusicTransferResult result = transfer(m_device, m_files);
+    QCOMPARE(result.m_copied, m_files.count());
+    QCOMPARE(result.m_skipped, 0);
+    QVERIFY(QFile::exists(m_device + MANIFEST_NAME));
+
+    for(const QString &path : qAsConst(m_files))
+    {
+        QCOMPARE(readFile(m_device + QFileInfo(path).fileName()), readFile(path));
+    }
+
+    // a same sized change on the device is not seen, so only the manifest can have skipped it
+    const QString &target = m_device + QFileInfo(m_files.first()).fileName();
+    QVERIFY(writeFile(target, QByteArray(QFileInfo(target).size(), 'x')));
+
+    result = transfer(m_device, m_files);
+    QCOMPARE(result.m_copied, 0);
+    QCOMPARE(result.m_skipped, m_files.count());
+    QCOMPARE(readFile(target), QByteArray(QFileInfo(target).size(), 'x'));
+
+    // without the manifest the files are compared by content
+    QVERIFY(QFile::remove(m_device + MANIFEST_NAME));
+    result = transfer(m_device, m_files);
+    QCOMPARE(result.m_copied, 1);
+    QCOMPARE(result.m_skipped, m_files.count() - 1);
+    QCOMPARE(readFile(target), readFile(m_files.first()));
+}
+
+void MusicConnectTransferTest::orphanRemoval_data()
+{
+    QTest::addColumn<bool>("remove");
+
+    QTest::newRow("keep") << false;
+    QTest::newRow("remove") << true;
+}
+
+void MusicConnectTransferTest::orphanRemoval()
+{
+    QFETCH(bool, remove);
+
+    QCOMPARE(transfer(m_device, m_files).m_copied, m_files.count());
+
+    // a file of the user on the device is never in the manifest
+    const QString &own = m_device + "own.mp3";
+    QVERIFY(writeFile(own, "own"));
+
+    QStringList files = m_files;
+    const QString &orphan = m_device + QFileInfo(files.takeLast()).fileName();
+
+    const MusicTransferResult &result = transfer(m_device, files, remove);
+    QCOMPARE(result.m_copied, 0);
+    QCOMPARE(result.m_skipped, files.count());
+    QCOMPARE(result.m_removed, remove ? 1 : 0);
+    QCOMPARE(QFile::exists(orphan), !remove);
+    QVERIFY(QFile::exists(own));
+
+    // a kept orphan stays in the manifest, so it is skipped when selected again
+    const MusicTransferResult &again = transfer(m_device, m_files);
+    QCOMPARE(again.m_copied, remove ? 1 : 0);
+    QCOMPARE(again.m_skipped, remove ? files.count() : m_files.count());
+}
+
+void MusicConnectTransferTest::resumePartialCopy()
+{
+    QCOMPARE(transfer(m_device, m_files).m_copied, m_files.count());
+
+    // the first copy was cut short on the device
+    const QString &cut = m_device + QFileInfo(m_files.first()).fileName();
+    QVERIFY(writeFile(cut, readFile(m_files.first()).left(100)));
+
+    // the last one never reached the device, an unsynced copy of its first half is left
+    const QString &half = m_device + QFileInfo(m_files.last()).fileName();
+    const QByteArray &data = readFile(m_files.last());
+    QVERIFY(writeFile(half, data.left(data.size() / 2)));
+    QVERIFY(QFile::remove(m_device + MANIFEST_NAME));
+
+    const MusicTransferResult &result = transfer(m_device, m_files);
+    QCOMPARE(result.m_copied, 2);
+    QCOMPARE(result.m_skipped, m_files.count() - 2);
+
+    for(const QString &path : qAsConst(m_files))
+    {
+        QCOMPARE(readFile(m_device + QFileInfo(path).fileName()), readFile(path));
+    }
+
+    // no temporary file is left beside the targets
+    const QStringList &names = QDir(m_device).entryList(QDir::Files | QDir::Hidden);
+    QCOMPARE(names.count(), m_files.count() + 1);
+}
@@ -0,0 +1,70 @@
+#ifndef MUSICCONNECTTRANSFERTEST_H
+#define MUSICCONNECTTRANSFERTEST_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QtTest>
+
+/*! @brief The class of the connect transfer thread test, a temp directory is the device.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicConnectTransferTest : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicConnectTransferTest(QObject *parent = nullptr);
+
+private Q_SLOTS:
+    /*!
+     * Create the source files.
+     */
+    void initTestCase();
+    /*!
+     * Remove the source files and the device.
+     */
+    void cleanupTestCase();
+    /*!
+     * Empty the device.
+     */
+    void init();
+
+    /*!
+     * Files listed in the manifest and unchanged are not copied again.
+     */
+    void incrementalSkip();
+    /*!
+     * Synced files no longer selected are removed only when asked.
+     */
+    void orphanRemoval_data();
+    void orphanRemoval();
+    /*!
+     * Files cut short by an interrupted copy are copied again.
+     */
+    void resumePartialCopy();
+
+private:
+    QString m_dir, m_device;
+    QStringList m_files;
+
+};
+
+#endif // MUSICCONNECTTRANSFERTEST_H
@@ -0,0 +1,183 @@
+#include "musicconsoleservertest.h"
+#include "musicconsoleserver.h"
+#include "musicconsolestate.h"
+#include "musicplayer.h"
+#include "musicplaylist.h"
+
+#include <QTcpSocket>
+
+static constexpr const char *TEST_TOKEN = "0123456789abcdef";
+static constexpr int REQUEST_TIMEOUT = 5 * TTK_DN_S2MS;
+
+/*!
+ * Check the response is complete, event streams are complete on the first event.
+ */
+static bool responseFinished(const QByteArray &data)
+{
+    const int index = data.indexOf("\r\n\r\n");
+    if(index == -1)
+    {
+        return false;
+    }
+
+    const QByteArray &head = data.left(index).toLower();
+    const int offset = head.indexOf("content-length:");
+    if(offset == -1)
+    {
+        return data.indexOf("\n\n", index + 4) != -1;
+    }
+
+    const int end = head.indexOf("\r\n", offset);
+    const int length = head.mid(offset + 15, end == -1 ? -1 : end - offset - 15).trimmed().toInt();
+    return data.size() - index - 4 >= length;
+}
+
+
+MusicConsoleServerTest::MusicConsoleServerTest(QObject *parent)
+    : QObject(parent),
+      m_player(nullptr),
+      m_playlist(nullptr),
+      m_state(nullptr),
+      m_server(nullptr)
+{
+
+}
+
+void MusicConsoleServerTest::initTestCase()
+{
+    m_playlist = new MusicPlaylist(this);
+    m_player = new MusicPlayer(this);
+    m_player->setPlaylist(m_playlist);
+    m_state = new MusicConsoleState(m_player, m_playlist, this);
+
+    m_server = new MusicConsoleServer(m_player, m_playlist, m_state, this);
+    m_server->setToken(TEST_TOKEN);
+    // any free port
+    QVERIFY(m_server->listen(0));
+    QVERIFY(m_server->port() != 0);
+}
+
+void MusicConsoleServerTest::cleanupTestCase()
+{
+    delete m_server;
+    m_server = nullptr;
+}
+
+void MusicConsoleServerTest::authorize_data()
+{
+    QTest::addColumn<QByteArray>("method");
+    QTest::addColumn<QByteArray>("path");
+    // %1 is replaced by the server port
+    QTest::addColumn<QByteArray>("headers");
+    QTest::addColumn<QByteArray>("body");
+    QTest::addColumn<int>("status");
+
+    const QByteArray bearer = QByteArray("Authorization: Bearer ") + TEST_TOKEN + "\r\n";
+    const QByteArray json = "Content-Type: application/json\r\n";
+    const QByteArray host = "Host: 127.0.0.1:%1\r\n";
+
+    QTest::newRow("state") << QByteArray("GET") << QByteArray("/api/state") << host + bearer << QByteArray() << 200;
+    QTest::newRow("query token") << QByteArray("GET") << QByteArray("/api/state?token=") + TEST_TOKEN << host << QByteArray() << 200;
+    QTest::newRow("no token") << QByteArray("GET") << QByteArray("/api/state") << host << QByteArray() << 401;
+    QTest::newRow("wrong token") << QByteArray("GET") << QByteArray("/api/state") << host + "Authorization: Bearer 0123456789abcdee\r\n" << QByteArray() << 401;
+    QTest::newRow("empty token") << QByteArray("GET") << QByteArray("/api/state?token=") << host + "Authorization: Bearer \r\n" << QByteArray() << 401;
+    QTest::newRow("basic scheme") << QByteArray("GET") << QByteArray("/api/state") << host + "Authorization: Basic " + TEST_TOKEN + "\r\n" << QByteArray() << 401;
+
+    QTest::newRow("local origin") << QByteArray("GET") << QByteArray("/api/state") << host + bearer + "Origin: http://127.0.0.1:%1\r\n" << QByteArray() << 200;
+    QTest::newRow("localhost") << QByteArray("GET") << QByteArray("/api/state") << "Host: localhost:%1\r\nOrigin: http://localhost:%1\r\n" + bearer << QByteArray() << 200;
+    QTest::newRow("foreign origin") << QByteArray("GET") << QByteArray("/api/state") << host + bearer + "Origin: http://example.com\r\n" << QByteArray() << 403;
+    QTest::newRow("null origin") << QByteArray("GET") << QByteArray("/api/state") << host + bearer + "Origin: null\r\n" << QByteArray() << 403;
+    QTest::newRow("other port origin") << QByteArray("GET") << QByteArray("/api/state") << host + bearer + "Origin: http://127.0.0.1:1\r\n" << QByteArray() << 403;
+    QTest::newRow("foreign host") << QByteArray("GET") << QByteArray("/api/state") << "Host: example.com:%1\r\n" + bearer << QByteArray() << 403;
+    QTest::newRow("no host") << QByteArray("GET") << QByteArray("/api/state") << bearer << QByteArray() << 403;
+
+    QTest::newRow("json post") << QByteArray("POST") << QByteArray("/api/volume") << host + bearer + json << QByteArray("{\"volume\":50}") << 200;
+    QTest::newRow("json charset post") << QByteArray("POST") << QByteArray("/api/volume") << host + bearer + "Content-Type: Application/JSON; charset=utf-8\r\n" << QByteArray("{\"volume\":40}") << 200;
+    QTest::newRow("text post") << QByteArray("POST") << QByteArray("/api/volume") << host + bearer + "Content-Type: text/plain\r\n" << QByteArray("{\"volume\":50}") << 415;
+    QTest::newRow("form post") << QByteArray("POST") << QByteArray("/api/pause") << host + bearer + "Content-Type: application/x-www-form-urlencoded\r\n" << QByteArray("a=b") << 415;
+    QTest::newRow("untyped post") << QByteArray("POST") << QByteArray("/api/pause") << host + bearer << QByteArray() << 415;
+    QTest::newRow("untyped get body") << QByteArray("GET") << QByteArray("/api/state") << host + bearer << QByteArray("{}") << 415;
+    QTest::newRow("json put") << QByteArray("PUT") << QByteArray("/api/playlist") << host + bearer + json << QByteArray("{\"paths\":[]}") << 400;
+    QTest::newRow("invalid json") << QByteArray("POST") << QByteArray("/api/seek") << host + bearer + json << QByteArray("{") << 400;
+    QTest::newRow("untyped delete") << QByteArray("DELETE") << QByteArray("/api/playlist/7") << host + bearer << QByteArray() << 404;
+    QTest::newRow("unknown command") << QByteArray("GET") << QByteArray("/api/unknown") << host + bearer << QByteArray() << 404;
+    QTest::newRow("unknown command without token") << QByteArray("GET") << QByteArray("/api/unknown") << host << QByteArray() << 401;
+}
+
+void MusicConsoleServerTest::authorize()
+{
+    QFETCH(QByteArray, method);
+    QFETCH(QByteArray, path);
+    QFETCH(QByteArray, headers);
+    QFETCH(QByteArray, body);
+    QFETCH(int, status);
+
+    headers.replace("%1", QByteArray::number(m_server->port()));
+
+    QByteArray data = method + " " + path + " HTTP/1.1\r\n" + headers;
+    if(!body.isEmpty())
+    {
+        data += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    }
+    data += "\r\n" + body;
+
+    QByteArray response;
+    QCOMPARE(request(data, &response), status);
+    QVERIFY(response.contains("application/json"));
+}
+
+void MusicConsoleServerTest::events()
+{
+    const QByteArray &port = QByteArray::number(m_server->port());
+
+    QByteArray response;
+    QCOMPARE(request("GET /api/events?token=" + QByteArray(TEST_TOKEN) + " HTTP/1.1\r\nHost: 127.0.0.1:" + port + "\r\n\r\n", &response), 200);
+    QVERIFY(response.contains("text/event-stream"));
+    QVERIFY(response.contains("event: state"));
+
+    QCOMPARE(request("GET /api/events HTTP/1.1\r\nHost: 127.0.0.1:" + port + "\r\n\r\n"), 401);
+}
+
+void MusicConsoleServerTest::generatedToken()
+{
+    MusicConsoleServer first(m_player, m_playlist, m_state);
+    MusicConsoleServer second(m_player, m_playlist, m_state);
+    QVERIFY(first.listen(0));
+    QVERIFY(second.listen(0));
+
+    QVERIFY(first.token().length() >= 32);
+    QVERIFY(first.token() != second.token());
+}
+
+int MusicConsoleServerTest::request(const QByteArray &data, QByteArray *response)
+{
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, m_server->port());
+
+    // the server runs on this thread, so the events are processed while waiting
+    QByteArray buffer;
+    bool written = false;
+    QElapsedTimer timer;
+    timer.start();
+
+    while(timer.elapsed() < REQUEST_TIMEOUT && !responseFinished(buffer))
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+        if(!written && socket.state() == QAbstractSocket::ConnectedState)
+        {
+            socket.write(data);
+            written = true;
+        }
+        buffer += socket.readAll();
+    }
+    socket.abort();
+
+    if(response)
+    {
+        *response = buffer;
+    }
+
+    // HTTP/1.1 200 OK
+    const int index = buffer.indexOf(' ');
+    return index == -1 ? -1 : buffer.mid(index + 1, 3).toInt();
+}
@@ -0,0 +1,79 @@
+#ifndef MUSICCONSOLESERVERTEST_H
+#define MUSICCONSOLESERVERTEST_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QtTest>
+
+class MusicPlayer;
+class MusicPlaylist;
+class MusicConsoleState;
+class MusicConsoleServer;
+
+/*! @brief The class of the console remote control server test.
+ * Raw http requests are sent over local host, so every header is under control.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicConsoleServerTest : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicConsoleServerTest(QObject *parent = nullptr);
+
+private Q_SLOTS:
+    /*!
+     * Start the server.
+     */
+    void initTestCase();
+    /*!
+     * Stop the server.
+     */
+    void cleanupTestCase();
+
+    /*!
+     * Requests are checked by host, origin, token and content type.
+     */
+    void authorize_data();
+    void authorize();
+    /*!
+     * Event stream takes the token as query item.
+     */
+    void events();
+    /*!
+     * Generated tokens differ for every session.
+     */
+    void generatedToken();
+
+private:
+    /*!
+     * Send the raw request and get the status code, the response head and body.
+     */
+    int request(const QByteArray &data, QByteArray *response = nullptr);
+
+    MusicPlayer *m_player;
+    MusicPlaylist *m_playlist;
+    MusicConsoleState *m_state;
+    MusicConsoleServer *m_server;
+
+};
+
+#endif // MUSICCONSOLESERVERTEST_H
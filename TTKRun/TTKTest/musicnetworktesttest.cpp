@@ -0,0 +1,105 @@
+#include "musicnetworktesttest.h"
+#include "musicnetworktestrequest.h"
+#include "musicnetworktestserver.h"
+
+static constexpr int WAIT_TIMEOUT = 30 * TTK_DN_S2MS;
+static constexpr int SAMPLE_COUNT = 3;
+// a local connection is not delayed by the server, the first byte may be late by some timer ticks
+static constexpr int CONNECT_LIMIT = 50;
+static constexpr int FIRST_BYTE_SLACK = 100;
+static constexpr int SPEED_TOLERANCE = 20;
+
+/*!
+ * Poll the condition with the event loop running, false on timeout.
+ */
+static bool waitFor(const std::function<bool()> &condition)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while(!condition())
+    {
+        if(timer.elapsed() > WAIT_TIMEOUT)
+        {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+
+MusicNetworkTestTest::MusicNetworkTestTest(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+void MusicNetworkTestTest::latencyAndBandwidth_data()
+{
+    QTest::addColumn<int>("latency");
+    QTest::addColumn<qint64>("bandwidth");
+    QTest::addColumn<int>("streams");
+
+    QTest::newRow("100ms 1MB/s") << 100 << qint64(1024 * 1024) << 1;
+    QTest::newRow("300ms 512KB/s") << 300 << qint64(512 * 1024) << 1;
+    QTest::newRow("50ms 1MB/s 2 streams") << 50 << qint64(1024 * 1024) << 2;
+}
+
+void MusicNetworkTestTest::latencyAndBandwidth()
+{
+    QFETCH(int, latency);
+    QFETCH(qint64, bandwidth);
+    QFETCH(int, streams);
+
+    MusicNetworkTestServer server;
+    server.setLatency(latency);
+    server.setBandwidth(bandwidth);
+    QVERIFY(server.listen());
+
+    // every stream lasts half a second
+    const qint64 size = bandwidth / 2;
+    MusicNetworkTestRequest request;
+    request.setUrl(server.url(size));
+    request.setSampleCount(SAMPLE_COUNT);
+    request.setStreamCount(streams);
+    request.setMaxSize(size);
+
+    QSignalSpy spy(&request, SIGNAL(networkConnectionTestChanged(bool)));
+    request.startToRequest();
+    QVERIFY(waitFor([&spy]() { return spy.count() > 0; }));
+    QCOMPARE(spy.first().first().toBool(), true);
+
+    const MusicNetworkTestResult &result = request.result();
+    QCOMPARE(result.m_samples, SAMPLE_COUNT);
+    QCOMPARE(result.m_failed, 0);
+    QVERIFY2(result.m_connect < CONNECT_LIMIT, qPrintable(QString::number(result.m_connect)));
+    QVERIFY2(result.m_firstByte >= latency && result.m_firstByte < latency + FIRST_BYTE_SLACK, qPrintable(QString::number(result.m_firstByte)));
+
+    // the server paces every response, so the streams add up
+    const qint64 expect = bandwidth * streams;
+    QVERIFY2(qAbs(result.m_speed - expect) * 100 <= expect * SPEED_TOLERANCE, qPrintable(QString::number(result.m_speed)));
+    QVERIFY(result.m_speedLow <= result.m_speed);
+}
+
+void MusicNetworkTestTest::unreachableServer()
+{
+    MusicNetworkTestServer server;
+    QVERIFY(server.listen());
+
+    const QString &url = server.url(1024);
+    server.close();
+
+    MusicNetworkTestRequest request;
+    request.setUrl(url);
+    request.setSampleCount(SAMPLE_COUNT);
+
+    QSignalSpy spy(&request, SIGNAL(networkConnectionTestChanged(bool)));
+    request.startToRequest();
+    QVERIFY(waitFor([&spy]() { return spy.count() > 0; }));
+    QCOMPARE(spy.first().first().toBool(), false);
+
+    const MusicNetworkTestResult &result = request.result();
+    QCOMPARE(result.m_samples, 0);
+    QCOMPARE(result.m_failed, SAMPLE_COUNT);
+}
@@ -0,0 +1,49 @@
+#ifndef MUSICNETWORKTESTTEST_H
+#define MUSICNETWORKTESTTEST_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QtTest>
+
+/*! @brief The class of the network test request test, it runs against the local test server.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicNetworkTestTest : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicNetworkTestTest(QObject *parent = nullptr);
+
+private Q_SLOTS:
+    /*!
+     * Measured first byte time and speed follow the latency and bandwidth of the server.
+     */
+    void latencyAndBandwidth_data();
+    void latencyAndBandwidth();
+    /*!
+     * Samples of a server that is gone all fail.
+     */
+    void unreachableServer();
+
+};
+
+#endif // MUSICNETWORKTESTTEST_H
@@ -0,0 +1,273 @@
+#include "musicplaylistsnapshottest.h"
+#include "musicplaylistsnapshot.h"
+#include "musicformats.h"
+#include "musicfileutils.h"
+
+#include <QtEndian>
+
+// magic, version, item count, checksum, payload size
+static constexpr int SNAPSHOT_HEADER_SIZE = 24;
+
+/*!
+ * Crc32 of the data, the same as the snapshot writer.
+ */
+static quint32 checksum(const QByteArray &data)
+{
+    quint32 crc = 0xFFFFFFFFU;
+    for(const char c : data)
+    {
+        crc ^= TTKStaticCast(uchar, c);
+        for(int k = 0; k < 8; ++k)
+        {
+            crc = (crc & 1) ? 0xEDB88320U ^ (crc >> 1) : crc >> 1;
+        }
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+template <typename T>
+static void writeValue(QByteArray &data, T value)
+{
+    uchar buffer[sizeof(T)];
+    qToLittleEndian<T>(value, buffer);
+    data.append(TTKReinterpretCast(const char*, buffer), sizeof(T));
+}
+
+template <typename T>
+static void setValue(QByteArray &data, int offset, T value)
+{
+    qToLittleEndian<T>(value, TTKReinterpretCast(uchar*, data.data() + offset));
+}
+
+/*!
+ * Snapshot of the item count and the payload with a valid checksum.
+ */
+static QByteArray makeSnapshot(qint32 count, const QByteArray &payload)
+{
+    QByteArray data("TKPS", 4);
+    writeValue<quint32>(data, 1);
+    writeValue<qint32>(data, count);
+    writeValue<quint32>(data, checksum(payload));
+    writeValue<qint64>(data, payload.size());
+    data.append(payload);
+    return data;
+}
+
+/*!
+ * Item record without the song records.
+ */
+static QByteArray makeItem(qint32 songCount)
+{
+    QByteArray data;
+    writeValue<qint32>(data, 0);
+    writeValue<qint32>(data, -1);
+    writeValue<qint32>(data, Qt::AscendingOrder);
+    writeValue<qint32>(data, 0);
+    writeValue<qint32>(data, songCount);
+    return data;
+}
+
+
+MusicPlaylistSnapshotTest::MusicPlaylistSnapshotTest(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+void MusicPlaylistSnapshotTest::initTestCase()
+{
+    m_dir = QDir::tempPath() + QString("/TTKTest-%1/").arg(QCoreApplication::applicationPid());
+    QVERIFY(QDir().mkpath(m_dir));
+
+    const QStringList files{"first.mp3", "second.flac", "album.cue"};
+    for(const QString &name : qAsConst(files))
+    {
+        QFile file(m_dir + name);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray(1024 + name.length(), 'x'));
+        file.close();
+    }
+
+    MusicSongItem item;
+    item.m_itemIndex = 0;
+    item.m_itemName = "Default";
+    item.m_sort.m_type = TTKStaticCast(int, MusicSong::Sort::ByDuration);
+    item.m_sort.m_order = Qt::DescendingOrder;
+
+    MusicSong song(m_dir + "first.mp3", "03:15", "Singer - First");
+    song.setPlayCount(7);
+    item.m_songs << song;
+    item.m_songs << MusicSong(m_dir + "second.flac", "04:01", QString::fromUtf8("\xe6\xad\x8c\xe6\x89\x8b - \xe7\xac\xac\xe4\xba\x8c"));
+    m_items << item;
+
+    item.m_itemIndex = 1;
+    item.m_itemName = "Empty";
+    item.m_sort = MusicSongSort();
+    item.m_songs.clear();
+    m_items << item;
+
+    const QString &track = "cue://" + m_dir + "album.cue#2";
+    item.m_itemIndex = 2;
+    item.m_itemName = "Tracks";
+    item.m_songs << MusicSong(track, "02:30", "Singer - Track", MusicFormats::isTrack(track));
+    item.m_songs << MusicSong(m_dir + "first.mp3", "03:15", "Singer - First");
+    m_items << item;
+}
+
+void MusicPlaylistSnapshotTest::cleanupTestCase()
+{
+    TTK::File::removeRecursively(m_dir);
+}
+
+void MusicPlaylistSnapshotTest::roundTrip()
+{
+    MusicSongItemList items;
+    QVERIFY(read(snapshot(), items));
+    QCOMPARE(items.count(), m_items.count());
+
+    for(int i = 0; i < items.count(); ++i)
+    {
+        const MusicSongItem &item = items[i];
+        const MusicSongItem &origin = m_items[i];
+        QCOMPARE(item.m_itemIndex, origin.m_itemIndex);
+        QCOMPARE(item.m_itemName, origin.m_itemName);
+        QCOMPARE(item.m_sort.m_type, origin.m_sort.m_type);
+        QCOMPARE(item.m_sort.m_order, origin.m_sort.m_order);
+        QCOMPARE(item.m_songs.count(), origin.m_songs.count());
+
+        for(int j = 0; j < item.m_songs.count(); ++j)
+        {
+            const MusicSong &song = item.m_songs[j];
+            const MusicSong &other = origin.m_songs[j];
+            QCOMPARE(song.path(), other.path());
+            QCOMPARE(song.name(), other.name());
+            QCOMPARE(song.duration(), other.duration());
+            QCOMPARE(song.format(), other.format());
+            QCOMPARE(song.playCount(), other.playCount());
+            QCOMPARE(song.size(), other.size());
+        }
+    }
+
+    // the snapshot of the read items is the same bytes
+    QCOMPARE(MusicPlaylistSnapshot::toByteArray(items), snapshot());
+}
+
+void MusicPlaylistSnapshotTest::trackRoundTrip()
+{
+    MusicSongItemList items;
+    QVERIFY(read(snapshot(), items));
+
+    for(int i = 0; i < items.count(); ++i)
+    {
+        for(int j = 0; j < items[i].m_songs.count(); ++j)
+        {
+            const MusicSong &song = items[i].m_songs[j];
+            QCOMPARE(song.isTrack(), m_items[i].m_songs[j].isTrack());
+            QCOMPARE(song.isTrack(), MusicFormats::isTrack(song.path()));
+        }
+    }
+
+    const MusicSong &track = items.back().m_songs.front();
+    QVERIFY(track.isTrack());
+    // tracks are stated by the cue sheet file
+    QCOMPARE(track.size(), QFileInfo(m_dir + "album.cue").size());
+}
+
+void MusicPlaylistSnapshotTest::corruption_data()
+{
+    const QByteArray &data = snapshot();
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("truncated header") << data.left(SNAPSHOT_HEADER_SIZE - 1);
+    QTest::newRow("truncated payload") << data.left(data.size() - 1);
+    QTest::newRow("trailing data") << data + QByteArray(1, '\0');
+
+    QByteArray v = data;
+    v[0] = 'X';
+    QTest::newRow("magic") << v;
+
+    v = data;
+    setValue<quint32>(v, 4, 2);
+    QTest::newRow("version") << v;
+
+    v = data;
+    setValue<qint32>(v, 8, -1);
+    QTest::newRow("negative count") << v;
+
+    v = data;
+    setValue<qint32>(v, 8, m_items.count() + 1);
+    QTest::newRow("count over records") << v;
+
+    v = data;
+    setValue<qint64>(v, 16, Q_INT64_C(0x7FFFFFFFFFFFFFFF));
+    QTest::newRow("payload size") << v;
+
+    v = data;
+    const int offset = SNAPSHOT_HEADER_SIZE + (v.size() - SNAPSHOT_HEADER_SIZE) / 2;
+    v[offset] = v[offset] ^ 0x01;
+    QTest::newRow("flipped payload") << v;
+
+    v = data;
+    v[v.size() - 1] = v[v.size() - 1] ^ 0x80;
+    QTest::newRow("flipped last byte") << v;
+}
+
+void MusicPlaylistSnapshotTest::corruption()
+{
+    QFETCH(QByteArray, data);
+
+    // the caller falls back to the tkpl file, so nothing may be appended on failure
+    MusicSongItemList items;
+    items << MusicSongItem();
+    QVERIFY(!read(data, items));
+    QCOMPARE(items.count(), 1);
+}
+
+void MusicPlaylistSnapshotTest::malformedPayload()
+{
+    MusicSongItemList items;
+
+    // string length over the payload
+    QByteArray payload;
+    writeValue<qint32>(payload, 0);
+    writeValue<qint32>(payload, -1);
+    writeValue<qint32>(payload, Qt::AscendingOrder);
+    writeValue<qint32>(payload, 0x7FFFFFFF);
+    QVERIFY(!read(makeSnapshot(1, payload), items));
+
+    // negative string length
+    payload = makeItem(1);
+    writeValue<qint32>(payload, 0);
+    writeValue<qint32>(payload, -2);
+    QVERIFY(!read(makeSnapshot(1, payload), items));
+
+    // negative song count
+    QVERIFY(!read(makeSnapshot(1, makeItem(-1)), items));
+
+    // song count over the payload
+    QVERIFY(!read(makeSnapshot(1, makeItem(0x7FFFFFFF)), items));
+    QVERIFY(items.isEmpty());
+
+    // the valid minimal snapshot is still read
+    QVERIFY(read(makeSnapshot(1, makeItem(0)), items));
+    QCOMPARE(items.count(), 1);
+    QVERIFY(items.front().m_songs.isEmpty());
+}
+
+QByteArray MusicPlaylistSnapshotTest::snapshot() const
+{
+    return MusicPlaylistSnapshot::toByteArray(m_items);
+}
+
+bool MusicPlaylistSnapshotTest::read(const QByteArray &data, MusicSongItemList &items) const
+{
+    const QString &path = m_dir + "playlist.tkps";
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly) || file.write(data) != data.size())
+    {
+        return false;
+    }
+    file.close();
+    return MusicPlaylistSnapshot::read(path, items);
+}
@@ -0,0 +1,80 @@
+#ifndef MUSICPLAYLISTSNAPSHOTTEST_H
+#define MUSICPLAYLISTSNAPSHOTTEST_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QtTest>
+#include "musicsong.h"
+
+/*! @brief The class of the playlist snapshot test.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicPlaylistSnapshotTest : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicPlaylistSnapshotTest(QObject *parent = nullptr);
+
+private Q_SLOTS:
+    /*!
+     * Create the song files.
+     */
+    void initTestCase();
+    /*!
+     * Remove the song files.
+     */
+    void cleanupTestCase();
+
+    /*!
+     * Items read back equal the written ones.
+     */
+    void roundTrip();
+    /*!
+     * Only cue sheet tracks are read back as tracks.
+     */
+    void trackRoundTrip();
+    /*!
+     * Corrupted files are rejected and leave the items untouched.
+     */
+    void corruption_data();
+    void corruption();
+    /*!
+     * Records out of the payload are rejected even with a valid checksum.
+     */
+    void malformedPayload();
+
+private:
+    /*!
+     * Get the snapshot data of the test items.
+     */
+    QByteArray snapshot() const;
+    /*!
+     * Write the data to the snapshot file and read it back.
+     */
+    bool read(const QByteArray &data, MusicSongItemList &items) const;
+
+    QString m_dir;
+    MusicSongItemList m_items;
+
+};
+
+#endif // MUSICPLAYLISTSNAPSHOTTEST_H
@@ -0,0 +1,386 @@
+#include "musicplaylisttest.h"
+#include "musicplaylistmanager.h"
+#include "musicfileutils.h"
+
+#include <thread>
+#include <QtEndian>
+
+static constexpr int THROUGHPUT_COUNT = 20000;
+static constexpr int STAT_THREAD_COUNT = 4;
+
+template <typename T>
+static void writeValue(QByteArray &data, T value)
+{
+    uchar buffer[sizeof(T)];
+    qToLittleEndian<T>(value, buffer);
+    data.append(TTKReinterpretCast(const char*, buffer), sizeof(T));
+}
+
+/*!
+ * Write the data to file.
+ */
+static bool writeFile(const QString &path, const QByteArray &data)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    const bool v = file.write(data) == data.size();
+    file.close();
+    return v;
+}
+
+/*!
+ * Foobar2000 playlist, paths are relative to the playlist file.
+ */
+static QByteArray fplData(const MusicSongList &songs, const QString &dir)
+{
+    // seven uints, the double duration, four floats and four uints
+    static constexpr int FPL_CHUNK_SIZE = 68;
+
+    QByteArray strings;
+    QList<quint32> offsets;
+    for(const MusicSong &song : qAsConst(songs))
+    {
+        offsets << strings.size();
+        strings.append("file://" + QString(song.path()).remove(dir).toUtf8());
+        strings.append('\0');
+    }
+
+    QByteArray data(16, '\0');
+    writeValue<quint32>(data, strings.size());
+    data.append(strings);
+    writeValue<quint32>(data, songs.count());
+
+    for(int i = 0; i < songs.count(); ++i)
+    {
+        QByteArray chunk(FPL_CHUNK_SIZE, '\0');
+        uchar *buffer = TTKReinterpretCast(uchar*, chunk.data());
+        qToLittleEndian<quint32>(offsets[i], buffer + 4);
+
+        const double duration = TTKTime::formatDuration(songs[i].duration()) / 1000.0;
+        memcpy(buffer + 28, &duration, sizeof(double));
+        // no keys follow the three counted by the chunk itself
+        qToLittleEndian<quint32>(3, buffer + 52);
+        data.append(chunk);
+    }
+    return data;
+}
+
+/*!
+ * Deadbeef playlist of version 1.2.
+ */
+static QByteArray dbplData(const MusicSongList &songs)
+{
+    QByteArray data("DBPL\x01\x02", 6);
+    writeValue<quint32>(data, songs.count());
+
+    for(const MusicSong &song : qAsConst(songs))
+    {
+        const QByteArray &path = song.path().toUtf8();
+        writeValue<quint16>(data, path.size());
+        data.append(path);
+        // decoder, track number, start and end sample
+        writeValue<quint8>(data, 0);
+        writeValue<quint16>(data, 0);
+        writeValue<quint32>(data, 0);
+        writeValue<quint32>(data, 0);
+
+        const float duration = TTKTime::formatDuration(song.duration()) / 1000.0f;
+        uchar buffer[sizeof(float)];
+        memcpy(buffer, &duration, sizeof(float));
+        data.append(TTKReinterpretCast(const char*, buffer), sizeof(float));
+        // file type, replay gain, flags and meta count
+        writeValue<quint8>(data, 0);
+        for(int i = 0; i < 5; ++i)
+        {
+            writeValue<quint32>(data, 0);
+        }
+        writeValue<quint16>(data, 0);
+    }
+    return data;
+}
+
+/*!
+ * Check the read songs against the written ones.
+ */
+static void compareSongs(const MusicSongItemList &items, const MusicSongList &songs, bool duration)
+{
+    QCOMPARE(items.count(), 1);
+
+    const MusicSongList &read = items.front().m_songs;
+    QCOMPARE(read.count(), songs.count());
+
+    for(int i = 0; i < read.count(); ++i)
+    {
+        QCOMPARE(read[i].path(), songs[i].path());
+        QCOMPARE(read[i].name(), songs[i].name());
+        if(duration)
+        {
+            QCOMPARE(read[i].duration(), songs[i].duration());
+        }
+    }
+}
+
+
+MusicPlaylistTest::MusicPlaylistTest(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+void MusicPlaylistTest::initTestCase()
+{
+    m_dir = QDir::tempPath() + QString("/TTKTest-%1-playlist/").arg(QCoreApplication::applicationPid());
+    QVERIFY(QDir().mkpath(m_dir + "Music"));
+
+    // names are the file base names, so every format reads them back
+    const QStringList names{"Singer 1 - Title 1", "Singer & Band - <Live>", QString::fromUtf8("\xe6\xad\x8c\xe6\x89\x8b - \xe6\xad\x8c\xe5\x90\x8d"), "Singer 4 - Title 4"};
+    const QStringList durations{"03:15", "04:01", "00:59", "12:34"};
+
+    m_item.m_itemIndex = 0;
+    m_item.m_itemName = "conformance";
+    for(int i = 0; i < names.count(); ++i)
+    {
+        const QString &path = m_dir + "Music/" + names[i] + ".mp3";
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray(1024 * (i + 1), 'x'));
+        file.close();
+
+        m_item.m_songs << MusicSong(path, durations[i], names[i]);
+    }
+}
+
+void MusicPlaylistTest::cleanupTestCase()
+{
+    TTK::File::removeRecursively(m_dir);
+}
+
+void MusicPlaylistTest::conformance_data()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<bool>("duration");
+
+    QTest::newRow(TPL_FILE_SUFFIX) << TPL_FILE_SUFFIX << true;
+    QTest::newRow(M3U_FILE_SUFFIX) << M3U_FILE_SUFFIX << true;
+    QTest::newRow(M3U8_FILE_SUFFIX) << M3U8_FILE_SUFFIX << true;
+    QTest::newRow(PLS_FILE_SUFFIX) << PLS_FILE_SUFFIX << true;
+    QTest::newRow(WPL_FILE_SUFFIX) << WPL_FILE_SUFFIX << false;
+    QTest::newRow(XSPF_FILE_SUFFIX) << XSPF_FILE_SUFFIX << true;
+    QTest::newRow(JSPF_FILE_SUFFIX) << JSPF_FILE_SUFFIX << true;
+    QTest::newRow(ASX_FILE_SUFFIX) << ASX_FILE_SUFFIX << true;
+    QTest::newRow(CSV_FILE_SUFFIX) << CSV_FILE_SUFFIX << true;
+    QTest::newRow(TXT_FILE_SUFFIX) << TXT_FILE_SUFFIX << true;
+}
+
+void MusicPlaylistTest::conformance()
+{
+    QFETCH(QString, format);
+    QFETCH(bool, duration);
+
+    const QString &path = filePath("conformance." + format);
+    MusicPlaylistManager manager;
+    manager.writeSongItem(path, m_item);
+    QVERIFY(QFile::exists(path));
+
+    MusicSongItemList items;
+    manager.readSongItems({path}, items);
+    compareSongs(items, m_item.m_songs, duration);
+}
+
+void MusicPlaylistTest::readOnly_data()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow(FPL_FILE_SUFFIX) << FPL_FILE_SUFFIX << fplData(m_item.m_songs, m_dir);
+    QTest::newRow(DBPL_FILE_SUFFIX) << DBPL_FILE_SUFFIX << dbplData(m_item.m_songs);
+}
+
+void MusicPlaylistTest::readOnly()
+{
+    QFETCH(QString, format);
+    QFETCH(QByteArray, data);
+
+    const QString &path = filePath("readonly." + format);
+    QVERIFY(writeFile(path, data));
+
+    MusicSongItemList items;
+    MusicPlaylistManager manager;
+    manager.readSongItems({path}, items);
+    compareSongs(items, m_item.m_songs, true);
+}
+
+void MusicPlaylistTest::malformed_data()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<QByteArray>("data");
+
+    const QStringList formats{TPL_FILE_SUFFIX, M3U_FILE_SUFFIX, PLS_FILE_SUFFIX, WPL_FILE_SUFFIX, XSPF_FILE_SUFFIX, JSPF_FILE_SUFFIX, ASX_FILE_SUFFIX, CSV_FILE_SUFFIX, TXT_FILE_SUFFIX};
+    for(const QString &format : qAsConst(formats))
+    {
+        const QString &path = filePath("malformed." + format);
+        MusicPlaylistManager().writeSongItem(path, m_item);
+
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        const QByteArray &data = file.readAll();
+        file.close();
+
+        QTest::newRow(qPrintable(format + " truncated")) << format << data.left(data.size() / 2);
+        QTest::newRow(qPrintable(format + " garbage")) << format << QByteArray("\x00\xff\x7f<\"[{:=,\n", 11).repeated(64);
+        QTest::newRow(qPrintable(format + " empty")) << format << QByteArray();
+    }
+
+    const QByteArray &fpl = fplData(m_item.m_songs, m_dir);
+    QTest::newRow("fpl truncated") << FPL_FILE_SUFFIX << fpl.left(fpl.size() / 2);
+    QTest::newRow("fpl garbage") << FPL_FILE_SUFFIX << QByteArray(64, '\xff');
+    QTest::newRow("fpl empty") << FPL_FILE_SUFFIX << QByteArray();
+
+    const QByteArray &dbpl = dbplData(m_item.m_songs);
+    QTest::newRow("dbpl truncated") << DBPL_FILE_SUFFIX << dbpl.left(dbpl.size() / 2);
+    QTest::newRow("dbpl garbage") << DBPL_FILE_SUFFIX << QByteArray("DBPL\x01\x02", 6) + QByteArray(64, '\xff');
+    QTest::newRow("dbpl empty") << DBPL_FILE_SUFFIX << QByteArray();
+}
+
+void MusicPlaylistTest::malformed()
+{
+    QFETCH(QString, format);
+    QFETCH(QByteArray, data);
+
+    const QString &path = filePath("broken." + format);
+    QVERIFY(writeFile(path, data));
+
+    // partial files may give partial songs, but never more than written
+    MusicSongItemList items;
+    MusicPlaylistManager manager;
+    manager.readSongItems({path}, items);
+
+    int count = 0;
+    for(const MusicSongItem &item : qAsConst(items))
+    {
+        count += item.m_songs.count();
+    }
+    QVERIFY(count <= m_item.m_songs.count());
+
+    if(format == TPL_FILE_SUFFIX)
+    {
+        // the native format is rejected as a whole
+        QCOMPARE(count, 0);
+    }
+}
+
+void MusicPlaylistTest::throughput_data()
+{
+    QTest::addColumn<QString>("format");
+
+    QTest::newRow(TPL_FILE_SUFFIX) << TPL_FILE_SUFFIX;
+    QTest::newRow(M3U_FILE_SUFFIX) << M3U_FILE_SUFFIX;
+    QTest::newRow(PLS_FILE_SUFFIX) << PLS_FILE_SUFFIX;
+    QTest::newRow(WPL_FILE_SUFFIX) << WPL_FILE_SUFFIX;
+    QTest::newRow(XSPF_FILE_SUFFIX) << XSPF_FILE_SUFFIX;
+    QTest::newRow(JSPF_FILE_SUFFIX) << JSPF_FILE_SUFFIX;
+    QTest::newRow(ASX_FILE_SUFFIX) << ASX_FILE_SUFFIX;
+    QTest::newRow(CSV_FILE_SUFFIX) << CSV_FILE_SUFFIX;
+    QTest::newRow(TXT_FILE_SUFFIX) << TXT_FILE_SUFFIX;
+    QTest::newRow(FPL_FILE_SUFFIX) << FPL_FILE_SUFFIX;
+    QTest::newRow(DBPL_FILE_SUFFIX) << DBPL_FILE_SUFFIX;
+}
+
+void MusicPlaylistTest::throughput()
+{
+    QFETCH(QString, format);
+
+    MusicSongItem item;
+    item.m_itemIndex = 0;
+    item.m_itemName = "throughput";
+    item.m_songs.reserve(THROUGHPUT_COUNT);
+    for(int i = 0; i < THROUGHPUT_COUNT; ++i)
+    {
+        const QString &name = QString("Singer %1 - Title %2").arg(i % 97).arg(i);
+        item.m_songs << MusicSong(m_dir + "Music/" + name + ".mp3", TTKTime::formatDuration((120 + i % 240) * TTK_DN_S2MS), name);
+    }
+
+    const QString &path = filePath("throughput." + format);
+    const bool writable = format != FPL_FILE_SUFFIX && format != DBPL_FILE_SUFFIX;
+    if(!writable)
+    {
+        QVERIFY(writeFile(path, format == FPL_FILE_SUFFIX ? fplData(item.m_songs, m_dir) : dbplData(item.m_songs)));
+    }
+
+    // songs are never stated on import, so this does not touch the song files
+    MusicSongItemList items;
+    MusicPlaylistManager manager;
+    QBENCHMARK_ONCE
+    {
+        if(writable)
+        {
+            manager.writeSongItem(path, item);
+        }
+        manager.readSongItems({path}, items);
+    }
+
+    QCOMPARE(items.count(), 1);
+    QCOMPARE(items.front().m_songs.count(), THROUGHPUT_COUNT);
+    QCOMPARE(items.front().m_songs.back().path(), item.m_songs.back().path());
+}
+
+void MusicPlaylistTest::sharedSongStat()
+{
+    MusicSongList songs;
+    for(int i = 0; i < m_item.m_songs.count(); ++i)
+    {
+        // fresh songs, the ones of the item may be stated already
+        songs << MusicSong(m_item.m_songs[i].path(), m_item.m_songs[i].duration());
+    }
+
+    QList<qint64> sizes;
+    for(const MusicSong &song : qAsConst(songs))
+    {
+        sizes << QFileInfo(song.path()).size();
+    }
+
+    // readers share the same objects, the copier races the first stat of every song
+    const MusicSongList &shared = songs;
+    std::atomic<int> errors(0);
+    std::vector<std::thread> threads;
+    for(int i = 0; i < STAT_THREAD_COUNT; ++i)
+    {
+        threads.emplace_back([&shared, &sizes, &errors]()
+        {
+            for(int j = 0; j < shared.count(); ++j)
+            {
+                if(shared[j].size() != sizes[j] || shared[j].sizeStr() == TTK_DEFAULT_STR)
+                {
+                    ++errors;
+                }
+            }
+        });
+    }
+
+    threads.emplace_back([&shared, &sizes, &errors]()
+    {
+        for(int j = 0; j < shared.count(); ++j)
+        {
+            const MusicSong song(shared[j]);
+            if(song.size() != sizes[j])
+            {
+                ++errors;
+            }
+        }
+    });
+
+    for(std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    QCOMPARE(errors.load(), 0);
+}
+
+QString MusicPlaylistTest::filePath(const QString &name) const
+{
+    return m_dir + name;
+}
@@ -0,0 +1,85 @@
+#ifndef MUSICPLAYLISTTEST_H
+#define MUSICPLAYLISTTEST_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QtTest>
+#include "musicsong.h"
+
+/*! @brief The class of the playlist format test.
+ * Every format is written and read back through the playlist manager.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicPlaylistTest : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicPlaylistTest(QObject *parent = nullptr);
+
+private Q_SLOTS:
+    /*!
+     * Create the song files.
+     */
+    void initTestCase();
+    /*!
+     * Remove the song files.
+     */
+    void cleanupTestCase();
+
+    /*!
+     * Songs written by the writable formats are read back.
+     */
+    void conformance_data();
+    void conformance();
+    /*!
+     * Songs of the read only formats are read.
+     */
+    void readOnly_data();
+    void readOnly();
+    /*!
+     * Broken files are read without crash.
+     */
+    void malformed_data();
+    void malformed();
+    /*!
+     * Large playlist write and read of every format.
+     */
+    void throughput_data();
+    void throughput();
+
+    /*!
+     * Songs are stated once while shared across threads.
+     */
+    void sharedSongStat();
+
+private:
+    /*!
+     * Get the file path by name.
+     */
+    QString filePath(const QString &name) const;
+
+    QString m_dir;
+    MusicSongItem m_item;
+
+};
+
+#endif // MUSICPLAYLISTTEST_H
@@ -0,0 +1,54 @@
+#include "musicplaylisttest.h"
+#include "musicconsoleservertest.h"
+#include "musicplaylistsnapshottest.h"
+#include "musicthreadpooltest.h"
+#include "musicaudiorecordertest.h"
+#include "musicaudiofingerprinttest.h"
+#include "musicconnecttransfertest.h"
+#include "musicnetworktesttest.h"
+#if TTK_QT_VERSION_CHECK(5,0,0)
+#  include <QGuiApplication>
+using TTKApplication = QGuiApplication;
+#else
+#  include <QApplication>
+using TTKApplication = QApplication;
+#endif
+
+/*!
+ * Run the test suite, the arguments are passed to the test library.
+ */
+template <typename T>
+static int runTest(const QStringList &arguments)
+{
+    T test;
+    return QTest::qExec(&test, arguments) != 0 ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if TTK_QT_VERSION_CHECK(5,0,0)
+    // tests run on build machines without a display
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty())
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+#endif
+    TTKApplication app(argc, argv);
+
+    QCoreApplication::setOrganizationName(TTK_APP_NAME);
+    QCoreApplication::setOrganizationDomain(TTK_APP_COME_NAME);
+    QCoreApplication::setApplicationName("TTKTest");
+
+    // every suite runs even after a failure, the exit code is the failed suite count
+    const QStringList &arguments = app.arguments();
+    int code = 0;
+    code += runTest<MusicPlaylistTest>(arguments);
+    code += runTest<MusicPlaylistSnapshotTest>(arguments);
+    code += runTest<MusicConsoleServerTest>(arguments);
+    code += runTest<MusicThreadPoolTest>(arguments);
+    code += runTest<MusicAudioRecorderTest>(arguments);
+    code += runTest<MusicAudioFingerprintTest>(arguments);
+    code += runTest<MusicConnectTransferTest>(arguments);
+    code += runTest<MusicNetworkTestTest>(arguments);
+    return code;
+}
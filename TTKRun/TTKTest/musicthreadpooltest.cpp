@@ -0,0 +1,308 @@
+#include "musicthreadpooltest.h"
+#include "ttkabstractthread.h"
+
+static constexpr int WAIT_TIMEOUT = 10 * TTK_DN_S2MS;
+
+/*!
+ * Poll the condition with the event loop running, false on timeout.
+ */
+static bool waitFor(const std::function<bool()> &condition)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while(!condition())
+    {
+        if(timer.elapsed() > WAIT_TIMEOUT)
+        {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+/*! @brief The class of the stress test thread, run touches its own members until stopped.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicStressThread : public TTKAbstractThread
+{
+public:
+    explicit MusicStressThread(std::atomic<int> *alive)
+        : m_alive(alive)
+    {
+        ++*m_alive;
+    }
+
+    ~MusicStressThread()
+    {
+        stop();
+        m_values.clear();
+        --*m_alive;
+    }
+
+private:
+    virtual void run() override final
+    {
+        while(m_running)
+        {
+            m_values.append(m_values.count());
+            if(m_values.count() > 1024)
+            {
+                m_values.clear();
+            }
+        }
+    }
+
+    std::atomic<int> *m_alive;
+    QVector<int> m_values;
+
+};
+
+/*!
+ * Spin until the flag is set, holds the worker like a long job does.
+ */
+static void block(const std::atomic<bool> &released)
+{
+    while(!released)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+
+MusicThreadPoolTest::MusicThreadPoolTest(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+void MusicThreadPoolTest::taskThroughput_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("priority");
+
+    QTest::newRow("high") << 100000 << TTKStaticCast(int, TTKThreadPool::Priority::High);
+    QTest::newRow("normal") << 100000 << TTKStaticCast(int, TTKThreadPool::Priority::Normal);
+    QTest::newRow("low") << 100000 << TTKStaticCast(int, TTKThreadPool::Priority::Low);
+}
+
+void MusicThreadPoolTest::taskThroughput()
+{
+    QFETCH(int, count);
+    QFETCH(int, priority);
+
+    TTKThreadPool *pool = TTKThreadPool::instance();
+    std::atomic<int> value(0);
+
+    for(int i = 0; i < count; ++i)
+    {
+        pool->run([&value]() { ++value; }, TTKStaticCast(TTKThreadPool::Priority, priority));
+    }
+
+    pool->waitForDone();
+    QCOMPARE(value.load(), count);
+}
+
+void MusicThreadPoolTest::nestedWait()
+{
+    static constexpr int PARENT_COUNT = 256;
+    static constexpr int CHILD_COUNT = 32;
+
+    TTKThreadPool *pool = TTKThreadPool::instance();
+    std::atomic<int> value(0);
+    std::vector<TTKFuture<int>> futures;
+
+    // many more parents than workers, every one of them waits on the pool
+    for(int i = 0; i < PARENT_COUNT; ++i)
+    {
+        futures.push_back(pool->run([pool, &value]()
+        {
+            std::vector<TTKFuture<void>> children;
+            for(int j = 0; j < CHILD_COUNT; ++j)
+            {
+                children.push_back(pool->run([&value]() { ++value; }));
+            }
+
+            for(const TTKFuture<void> &child : children)
+            {
+                child.waitForFinished();
+            }
+            return CHILD_COUNT;
+        }));
+    }
+
+    int total = 0;
+    for(const TTKFuture<int> &future : futures)
+    {
+        total += future.result();
+    }
+
+    QCOMPARE(total, PARENT_COUNT * CHILD_COUNT);
+    QCOMPARE(value.load(), PARENT_COUNT * CHILD_COUNT);
+}
+
+void MusicThreadPoolTest::cancelQueued()
+{
+    static constexpr int COUNT = 50000;
+
+    TTKThreadPool *pool = TTKThreadPool::instance();
+    TTKCancelToken canceled;
+    canceled.cancel();
+
+    std::atomic<bool> ran(false);
+    const TTKFuture<void> &future = pool->run([&ran]() { ran = true; }, TTKThreadPool::Priority::Normal, canceled);
+    future.waitForFinished();
+    QVERIFY(future.isFinished());
+    QVERIFY(!ran);
+
+    // canceled half way, every task either ran or was skipped and all are finished
+    TTKCancelToken token;
+    std::atomic<int> value(0);
+    std::vector<TTKFuture<void>> futures;
+    for(int i = 0; i < COUNT; ++i)
+    {
+        futures.push_back(pool->run([&value]() { ++value; }, TTKThreadPool::Priority::Low, token));
+        if(i == COUNT / 2)
+        {
+            token.cancel();
+        }
+    }
+
+    for(const TTKFuture<void> &future : futures)
+    {
+        future.waitForFinished();
+    }
+
+    pool->waitForDone();
+    QVERIFY(value.load() <= COUNT);
+}
+
+void MusicThreadPoolTest::blockingLimit()
+{
+    TTKThreadPool *pool = TTKThreadPool::instance();
+    QVERIFY(pool->blockingThreadCount() >= 1);
+    QVERIFY(pool->blockingThreadCount() < pool->threadCount());
+
+    std::atomic<bool> released(false);
+    std::atomic<int> running(0), peak(0);
+    std::vector<TTKFuture<void>> blockings;
+
+    for(int i = 0; i < pool->threadCount() * 2; ++i)
+    {
+        blockings.push_back(pool->runBlocking([&]()
+        {
+            const int value = ++running;
+            int current = peak;
+            while(value > current && !peak.compare_exchange_weak(current, value));
+
+            block(released);
+            --running;
+        }));
+    }
+
+    QVERIFY(waitFor([&]() { return running == pool->blockingThreadCount(); }));
+
+    // the other workers still take short tasks while the budget is used up
+    std::atomic<int> value(0);
+    std::vector<TTKFuture<void>> futures;
+    for(int i = 0; i < 10000; ++i)
+    {
+        futures.push_back(pool->run([&value]() { ++value; }));
+    }
+
+    const bool done = waitFor([&]() { return value == 10000; });
+    released = true;
+
+    for(const TTKFuture<void> &future : blockings)
+    {
+        future.waitForFinished();
+    }
+    pool->waitForDone();
+
+    QVERIFY(done);
+    QCOMPARE(peak.load(), pool->blockingThreadCount());
+}
+
+void MusicThreadPoolTest::blockingCanceled()
+{
+    TTKThreadPool *pool = TTKThreadPool::instance();
+
+    std::atomic<bool> released(false);
+    std::atomic<int> running(0);
+    std::vector<TTKFuture<void>> blockings;
+    for(int i = 0; i < pool->blockingThreadCount(); ++i)
+    {
+        blockings.push_back(pool->runBlocking([&]() { ++running; block(released); }));
+    }
+
+    QVERIFY(waitFor([&]() { return running == pool->blockingThreadCount(); }));
+
+    TTKCancelToken token;
+    std::atomic<bool> ran(false);
+    const TTKFuture<void> &future = pool->runBlocking([&ran]() { ran = true; }, TTKThreadPool::Priority::Normal, token);
+    token.cancel();
+
+    // finished while the budget is still used up
+    const bool done = waitFor([&]() { return future.isFinished(); });
+    released = true;
+
+    for(const TTKFuture<void> &blocking : blockings)
+    {
+        blocking.waitForFinished();
+    }
+    pool->waitForDone();
+
+    QVERIFY(done);
+    QVERIFY(!ran);
+}
+
+void MusicThreadPoolTest::threadDestroyRunning()
+{
+    static constexpr int COUNT = 200;
+    static constexpr int BATCH = 8;
+
+    std::atomic<int> alive(0);
+    for(int i = 0; i < COUNT; ++i)
+    {
+        std::vector<MusicStressThread*> threads;
+        for(int j = 0; j < BATCH; ++j)
+        {
+            MusicStressThread *thread = new MusicStressThread(&alive);
+            thread->start();
+            threads.push_back(thread);
+        }
+
+        // some are still queued, some are inside run
+        for(MusicStressThread *thread : threads)
+        {
+            delete thread;
+        }
+    }
+
+    QCOMPARE(alive.load(), 0);
+    TTKThreadPool::instance()->waitForDone();
+}
+
+void MusicThreadPoolTest::continuationContext()
+{
+    TTKThreadPool *pool = TTKThreadPool::instance();
+
+    bool called = false, skipped = false;
+    QObject *alive = new QObject;
+    QObject *destroyed = new QObject;
+
+    const TTKFuture<int> &future = pool->run([]() { return 7; });
+    int result = 0;
+    future.then(alive, [&](const int &value) { called = true; result = value; });
+    future.then(destroyed, [&](const int &) { skipped = true; });
+    delete destroyed;
+
+    QVERIFY(waitFor([&]() { return called; }));
+    QCOMPARE(result, 7);
+
+    // the posted events of the destroyed context have run by now
+    QCoreApplication::processEvents();
+    QVERIFY(!skipped);
+    delete alive;
+}
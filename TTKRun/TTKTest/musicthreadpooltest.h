@@ -0,0 +1,69 @@
+#ifndef MUSICTHREADPOOLTEST_H
+#define MUSICTHREADPOOLTEST_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QtTest>
+
+/*! @brief The class of the shared thread pool stress test.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicThreadPoolTest : public QObject
+{
+    Q_OBJECT
+public:
+    /*!
+     * Object constructor.
+     */
+    explicit MusicThreadPoolTest(QObject *parent = nullptr);
+
+private Q_SLOTS:
+    /*!
+     * Every posted task runs exactly once.
+     */
+    void taskThroughput_data();
+    void taskThroughput();
+    /*!
+     * Tasks waiting for their child tasks can not starve the pool.
+     */
+    void nestedWait();
+    /*!
+     * Queued tasks of a canceled token are skipped but finished.
+     */
+    void cancelQueued();
+    /*!
+     * Blocking tasks never take more than their workers, short tasks still run.
+     */
+    void blockingLimit();
+    /*!
+     * Blocking tasks canceled while waiting for the budget are finished.
+     */
+    void blockingCanceled();
+    /*!
+     * Threads destroyed while running stop before their members are gone.
+     */
+    void threadDestroyRunning();
+    /*!
+     * Continuations are skipped once their context is destroyed.
+     */
+    void continuationContext();
+
+};
+
+#endif // MUSICTHREADPOOLTEST_H
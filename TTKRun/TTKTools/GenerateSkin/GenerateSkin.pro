@@ -40,8 +40,8 @@ win32:msvc{
     }
 }
 
-LIBS += -L$$DESTDIR -lTTKCore
-unix:LIBS += -L$$DESTDIR -lTTKqmmp -lTTKLibrary -lTTKUi -lTTKExtras -lTTKWatcher -lTTKDumper -lTTKZip -lzlib
+LIBS += -L$$DESTDIR -lTTKCore -lTTKLibrary
+unix:LIBS += -L$$DESTDIR -lTTKqmmp -lTTKUi -lTTKExtras -lTTKWatcher -lTTKDumper -lTTKZip -lzlib
 
 INCLUDEPATH += \
     $$PWD/../../../TTKCommon \
@@ -2,10 +2,12 @@
 #include "musicapplication.h"
 #include "musicruntimemanager.h"
 #include "musicconfigobject.h"
+#include "musiccoremplayer.h"
 #include "ttkdumper.h"
+#include "ttktracer.h"
 #include "ttkglobalhelper.h"
-#include "ttkcommandline.h"
 #include "ttkplatformsystem.h"
+#include "ttkdeferredobject.h"
 
 #ifdef Q_OS_UNIX
 #  include <malloc.h>
@@ -54,81 +56,98 @@ static void loadAppScaledFactor(int argc, char *argv[])
 
 int main(int argc, char *argv[])
 {
+    // TTK_STARTUP_TRACE=<file> saves the startup phases as chrome trace json
+    const QByteArray &trace = qgetenv("TTK_STARTUP_TRACE");
+    if(!trace.isEmpty())
+    {
+        TTKTracer::start(QString::fromLocal8Bit(trace));
+    }
+
     loadAppScaledFactor(argc, argv);
 
     TTKRunApplication app(argc, argv);
+    // the tracer clock starts just before, so the instant is the construction time
+    TTK_TRACE_INSTANT("TTKRunApplication");
 
     QCoreApplication::setOrganizationName(TTK_APP_NAME);
     QCoreApplication::setOrganizationDomain(TTK_APP_COME_NAME);
     QCoreApplication::setApplicationName(TTK_APP_NAME);
 
+    // parse command line args
+    QStringList args;
+    for(int i = 0; i < argc; ++i)
+    {
+        const QString &&arg = QString::fromLocal8Bit(argv[i]);
+        if(!arg.endsWith(TTK_APP_RUN_NAME) && !arg.endsWith(TTK_SERVICE_RUN_NAME))
+        {
+            args << arg;
+        }
+    }
+
     if(app.isRunning())
     {
+        // hand the args over to the running instance before any heavy initialization
+        if(!args.isEmpty() && !app.sendMessage(args))
+        {
+            TTK_ERROR_STREAM("Send message to running app failed");
+        }
+
         TTK_INFO_STREAM("One app has already run");
         return -1;
     }
 
     MusicConfigObject config;
-    config.valid();
-
     TTKDumper dumper(std::bind(cleanupCache));
-    dumper.run();
-
     MusicRunTimeManager manager;
-    manager.run();
-
-    if(!manager.configVersionCheck())
     {
-        config.reset();
-    }
+        TTK_TRACE_SCOPE("MusicRunTimeManager");
+        config.valid();
+        dumper.run();
+        manager.run();
 
-    for(const QString &ts : manager.translator())
-    {
-        QTranslator *translator = new QTranslator(&app);
-        if(!translator->load(ts))
+        if(!manager.configVersionCheck())
         {
-            TTK_ERROR_STREAM("Load translation error: " << ts);
-            delete translator;
-            continue;
+            config.reset();
         }
-        app.installTranslator(translator);
     }
 
-    TTK::setApplicationFont();
-
-    MusicApplication w;
-    w.show();
-
-    // parse command line args
-    QStringList args;
-    for(int i = 0; i < argc; ++i)
     {
-        const QString &&arg = QString::fromLocal8Bit(argv[i]);
-        if(!arg.endsWith(TTK_APP_RUN_NAME) && !arg.endsWith(TTK_SERVICE_RUN_NAME))
+        TTK_TRACE_SCOPE("translator and font");
+        for(const QString &ts : manager.translator())
         {
-            args << arg;
+            QTranslator *translator = new QTranslator(&app);
+            if(!translator->load(ts))
+            {
+                TTK_ERROR_STREAM("Load translation error: " << ts);
+                delete translator;
+                continue;
+            }
+            app.installTranslator(translator);
         }
+
+        TTK::setApplicationFont();
     }
 
-    if(args.count() == 2)
+    // traced by the constructor itself, the window has to outlive any scope here
+    MusicApplication w;
     {
-        TTKCommandLineOption op1(MUSIC_OUTSIDE_OPEN);
-        TTKCommandLineOption op2(MUSIC_OUTSIDE_LIST);
-
-        TTKCommandLineParser parser;
-        parser.addOption(op1);
-        parser.addOption(op2);
-        parser.process(args);
+        TTK_TRACE_SCOPE("show");
+        w.show();
+    }
 
-        if(parser.isSet(op1))
-        {
-            w.importSongsOutsideMode(parser.value(op1), true);
-        }
-        else if(parser.isSet(op2))
-        {
-            w.importSongsOutsideMode(parser.value(op2), false);
-        }
+    // heavy widgets and warm ups run on idle, after the first paint
+    TTKIdleTaskQueue *queue = TTKIdleTaskQueue::instance();
+    // warm up the mplayer slaves, radio and mv switching reuse them
+    queue->append("mplayer prepare", std::bind(MusicCoreMPlayer::prepare));
+    if(TTKTracer::isEnabled())
+    {
+        queue->append("trace save", std::bind(TTKTracer::save));
     }
+    queue->start();
+
+    app.setActivationWindow(&w);
+    QObject::connect(&app, SIGNAL(messagesReceived(QList<QStringList>)), &w, SLOT(importSongsOutsideMode(QList<QStringList>)));
+    w.importSongsOutsideMode(QList<QStringList>() << args);
 
 #ifdef Q_OS_UNIX
     // unix mpris module
@@ -140,5 +159,7 @@ int main(int argc, char *argv[])
 #endif
     const int ret = app.exec();
     cleanupCache();
+    // write the pending records while every module is still loaded
+    TTKAsyncLogger::instance()->shutdown();
     return ret;
 }
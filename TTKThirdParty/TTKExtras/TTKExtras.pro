@@ -42,7 +42,7 @@ win32:msvc{
     }
 }
 
-LIBS += -L$$DESTDIR -lTTKUi
+LIBS += -L$$DESTDIR -lTTKLibrary -lTTKUi
 
 #load extra define
 include($$PWD/../TTKThirdParty.pri)
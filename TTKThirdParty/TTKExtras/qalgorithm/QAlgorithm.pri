@@ -24,6 +24,9 @@ HEADERS += \
     $$PWD/cbc128.h \
     $$PWD/base64.h \
     $$PWD/random.h \
+    $$PWD/parallel.h \
+    $$PWD/blurkernel.h \
+    $$PWD/pixelkernel.h \
     $$PWD/aeswrapper.h \
     $$PWD/deswrapper.h \
     $$PWD/imagewrapper.h
@@ -35,6 +38,9 @@ SOURCES += \
     $$PWD/cbc128.cpp \
     $$PWD/base64.cpp \
     $$PWD/random.cpp \
+    $$PWD/parallel.cpp \
+    $$PWD/blurkernel.cpp \
+    $$PWD/pixelkernel.cpp \
     $$PWD/aeswrapper.cpp \
     $$PWD/deswrapper.cpp \
     $$PWD/imagewrapper.cpp
@@ -0,0 +1,340 @@
+#include "blurkernel.h"
+#include "parallel.h"
+
+#include <vector>
+#include <qmath.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BLUR_USE_SSE2
+#  include <emmintrin.h>
+// avx2 is not a build flag, it is compiled for its own functions and chosen at runtime
+#  if defined(_MSC_VER)
+#    define BLUR_USE_AVX2
+#    define BLUR_TARGET_AVX2
+#    include <intrin.h>
+#    include <immintrin.h>
+#  elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#    define BLUR_USE_AVX2
+#    define BLUR_TARGET_AVX2 __attribute__((target("avx2")))
+#    include <immintrin.h>
+#  endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  define BLUR_USE_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace QAlgorithm
+{
+// scratch of images up to 1080p is kept on the calling thread, larger ones are released after the call
+static constexpr size_t ScratchCacheSize = 1920 * 1080;
+static constexpr quint32 OpaqueAlpha = 0xff000000;
+
+// the four channels of one pixel are accumulated in one vector lane
+#if defined(BLUR_USE_SSE2)
+typedef __m128i Lane;
+typedef __m128 Scale;
+
+static inline Scale makeScale(float value) { return _mm_set1_ps(value); }
+static inline Lane laneZero() { return _mm_setzero_si128(); }
+static inline Lane laneAdd(Lane a, Lane b) { return _mm_add_epi32(a, b); }
+static inline Lane laneSub(Lane a, Lane b) { return _mm_sub_epi32(a, b); }
+static inline Lane laneLoad(const qint32 *p) { return _mm_loadu_si128(TTKReinterpretCast(const __m128i*, p)); }
+static inline void laneStore(qint32 *p, Lane a) { _mm_storeu_si128(TTKReinterpretCast(__m128i*, p), a); }
+
+static inline Lane laneUnpack(quint32 pixel)
+{
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero);
+}
+
+static inline quint32 lanePack(Lane a, const Scale &scale)
+{
+    __m128i v = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(a), scale));
+    v = _mm_packs_epi32(v, v);
+    v = _mm_packus_epi16(v, v);
+    return _mm_cvtsi128_si32(v);
+}
+#elif defined(BLUR_USE_NEON)
+typedef int32x4_t Lane;
+typedef float32x4_t Scale;
+
+static inline Scale makeScale(float value) { return vdupq_n_f32(value); }
+static inline Lane laneZero() { return vdupq_n_s32(0); }
+static inline Lane laneAdd(Lane a, Lane b) { return vaddq_s32(a, b); }
+static inline Lane laneSub(Lane a, Lane b) { return vsubq_s32(a, b); }
+static inline Lane laneLoad(const qint32 *p) { return vld1q_s32(p); }
+static inline void laneStore(qint32 *p, Lane a) { vst1q_s32(p, a); }
+
+static inline Lane laneUnpack(quint32 pixel)
+{
+    const uint16x8_t v = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(pixel)));
+    return vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(v)));
+}
+
+static inline quint32 lanePack(Lane a, const Scale &scale)
+{
+    const float32x4_t f = vaddq_f32(vmulq_f32(vcvtq_f32_s32(a), scale), vdupq_n_f32(0.5f));
+    const uint16x4_t v = vmovn_u32(vcvtq_u32_f32(f));
+    return vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(v, v))), 0);
+}
+#else
+struct Lane
+{
+    qint32 v[4];
+};
+typedef float Scale;
+
+static inline Scale makeScale(float value) { return value; }
+static inline Lane laneZero() { return {{0, 0, 0, 0}}; }
+static inline Lane laneAdd(Lane a, const Lane &b) { for(int i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+static inline Lane laneSub(Lane a, const Lane &b) { for(int i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+static inline Lane laneLoad(const qint32 *p) { return {{p[0], p[1], p[2], p[3]}}; }
+static inline void laneStore(qint32 *p, const Lane &a) { for(int i = 0; i < 4; ++i) p[i] = a.v[i]; }
+
+static inline Lane laneUnpack(quint32 pixel)
+{
+    return {{qint32(pixel & 0xff), qint32((pixel >> 8) & 0xff), qint32((pixel >> 16) & 0xff), qint32(pixel >> 24)}};
+}
+
+static inline quint32 lanePack(const Lane &a, const Scale &scale)
+{
+    quint32 pixel = 0;
+    for(int i = 0; i < 4; ++i)
+    {
+        pixel |= quint32(qBound(0, int(a.v[i] * scale + 0.5f), 0xff)) << (i * 8);
+    }
+    return pixel;
+}
+#endif
+
+#if defined(BLUR_USE_AVX2)
+/*!
+ * Check the cpu and the system support avx2.
+ */
+static bool hasAvx2()
+{
+#  if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7)
+    {
+        return false;
+    }
+
+    // the system must save the ymm registers too
+    __cpuid(info, 1);
+    if(!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)) || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+#  else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#  endif
+}
+
+/*!
+ * One row of the vertical pass for pairs of columns, returns the count of columns done.
+ */
+BLUR_TARGET_AVX2 static int boxBlurColumnsAvx2(qint32 *acc, const quint32 *in, const quint32 *out, quint32 *line, int count, float value)
+{
+    const __m256 scale = _mm256_set1_ps(value);
+    const __m128i alpha = _mm_set1_epi32(OpaqueAlpha);
+
+    int x = 0;
+    for(; x + 2 <= count; x += 2)
+    {
+        __m256i a = _mm256_loadu_si256(TTKReinterpretCast(const __m256i*, acc + 4 * x));
+        const __m256i v = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(a), scale));
+        const __m128i p = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        _mm_storel_epi64(TTKReinterpretCast(__m128i*, line + x), _mm_or_si128(_mm_packus_epi16(p, p), alpha));
+
+        a = _mm256_add_epi32(a, _mm256_cvtepu8_epi32(_mm_loadl_epi64(TTKReinterpretCast(const __m128i*, in + x))));
+        a = _mm256_sub_epi32(a, _mm256_cvtepu8_epi32(_mm_loadl_epi64(TTKReinterpretCast(const __m128i*, out + x))));
+        _mm256_storeu_si256(TTKReinterpretCast(__m256i*, acc + 4 * x), a);
+    }
+    return x;
+}
+#endif
+
+
+/*!
+ * Compute box sizes of three passes approximating the gaussian of sigma.
+ */
+static void boxSizes(float sigma, int *radius)
+{
+    constexpr int passes = 3;
+    const float ideal = qSqrt(12.0f * sigma * sigma / passes + 1.0f);
+    int lower = qFloor(ideal);
+    if(lower % 2 == 0)
+    {
+        --lower;
+    }
+
+    const int upper = lower + 2;
+    const float medium = (12.0f * sigma * sigma - passes * lower * lower - 4.0f * passes * lower - 3.0f * passes) / (-4.0f * lower - 4.0f);
+    const int count = qRound(medium);
+
+    for(int i = 0; i < passes; ++i)
+    {
+        radius[i] = ((i < count ? lower : upper) - 1) / 2;
+    }
+}
+
+/*!
+ * Horizontal box pass on one row, edge pixels are extended.
+ */
+static void boxBlurRow(const quint32 *src, quint32 *dst, int width, int radius, const Scale &scale)
+{
+    const Lane first = laneUnpack(src[0]);
+    Lane acc = laneZero();
+    for(int i = 0; i <= radius; ++i)
+    {
+        acc = laneAdd(acc, first);
+    }
+
+    for(int i = 1; i <= radius; ++i)
+    {
+        acc = laneAdd(acc, laneUnpack(src[qMin(i, width - 1)]));
+    }
+
+    const int last = width - 1;
+    for(int x = 0; x < width; ++x)
+    {
+        dst[x] = lanePack(acc, scale);
+        acc = laneAdd(acc, laneUnpack(src[qMin(x + radius + 1, last)]));
+        acc = laneSub(acc, laneUnpack(src[qMax(x - radius, 0)]));
+    }
+}
+
+/*!
+ * Vertical box pass on columns [begin, end), one accumulator per column walks down the rows.
+ * Output alpha is always opaque.
+ */
+static void boxBlurColumns(const quint32 *src, int srcStride, quint32 *dst, int dstStride, int height, int begin, int end, int radius, float value)
+{
+    const int count = end - begin;
+    std::vector<qint32> buffer(count * 4, 0);
+    qint32 *acc = buffer.data();
+
+    const Scale scale = makeScale(value);
+#if defined(BLUR_USE_AVX2)
+    static const bool avx2 = hasAvx2();
+#endif
+    for(int i = -radius; i <= radius; ++i)
+    {
+        const quint32 *row = src + qBound(0, i, height - 1) * srcStride + begin;
+        for(int x = 0; x < count; ++x)
+        {
+            laneStore(acc + 4 * x, laneAdd(laneLoad(acc + 4 * x), laneUnpack(row[x])));
+        }
+    }
+
+    const int last = height - 1;
+    for(int y = 0; y < height; ++y)
+    {
+        const quint32 *in = src + qMin(y + radius + 1, last) * srcStride + begin;
+        const quint32 *out = src + qMax(y - radius, 0) * srcStride + begin;
+        quint32 *line = dst + y * dstStride + begin;
+
+        int x = 0;
+#if defined(BLUR_USE_AVX2)
+        if(avx2)
+        {
+            x = boxBlurColumnsAvx2(acc, in, out, line, count, value);
+        }
+#endif
+        for(; x < count; ++x)
+        {
+            Lane a = laneLoad(acc + 4 * x);
+            line[x] = lanePack(a, scale) | OpaqueAlpha;
+            a = laneAdd(a, laneUnpack(in[x]));
+            laneStore(acc + 4 * x, laneSub(a, laneUnpack(out[x])));
+        }
+    }
+}
+
+
+void gaussBlur(QImage &image, int radius)
+{
+    if(radius <= 0 || image.isNull())
+    {
+        return;
+    }
+
+    const QImage::Format format = image.format();
+    if(format != QImage::Format_RGB32 && format != QImage::Format_ARGB32 && format != QImage::Format_ARGB32_Premultiplied)
+    {
+        image = image.convertToFormat(QImage::Format_ARGB32);
+    }
+
+    const int width = image.width();
+    const int height = image.height();
+    const int stride = image.bytesPerLine() / 4;
+    const size_t size = size_t(width) * height;
+
+    thread_local std::vector<quint32> cache;
+    std::vector<quint32> buffer;
+    if(size <= ScratchCacheSize)
+    {
+        cache.resize(size);
+    }
+    else
+    {
+        buffer.resize(size);
+    }
+
+    quint32 *pixels = TTKReinterpretCast(quint32*, image.bits());
+    quint32 *scratch = size <= ScratchCacheSize ? cache.data() : buffer.data();
+
+    int radiuses[3];
+    boxSizes(radius / 2.57f, radiuses);
+
+    constexpr int rowGrain = 32;
+    constexpr int columnGrain = 64;
+
+    bool blurred = false;
+    for(int pass = 0; pass < 3; ++pass)
+    {
+        const int r = radiuses[pass];
+        if(r <= 0)
+        {
+            continue;
+        }
+
+        blurred = true;
+        const float value = 1.0f / (2 * r + 1);
+        parallelFor(height, rowGrain, [&](int begin, int end)
+        {
+            const Scale scale = makeScale(value);
+            for(int y = begin; y < end; ++y)
+            {
+                boxBlurRow(pixels + y * stride, scratch + y * width, width, r, scale);
+            }
+        });
+
+        parallelFor(width, columnGrain, [&](int begin, int end)
+        {
+            boxBlurColumns(scratch, width, pixels, stride, height, begin, end, r, value);
+        });
+    }
+
+    if(!blurred)
+    {
+        parallelFor(height, rowGrain, [&](int begin, int end)
+        {
+            for(int y = begin; y < end; ++y)
+            {
+                quint32 *line = pixels + y * stride;
+                for(int x = 0; x < width; ++x)
+                {
+                    line[x] |= OpaqueAlpha;
+                }
+            }
+        });
+    }
+}
+}
@@ -0,0 +1,40 @@
+#ifndef BLURKERNEL_H
+#define BLURKERNEL_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QImage>
+#include "ttkmoduleexport.h"
+
+/*! @brief The namespace of the algorithm.
+ * @author Greedysky <greedysky@163.com>
+ */
+namespace QAlgorithm
+{
+    /*!
+     * Blur image in place by gaussian approximation of three box passes.
+     * Radius is about 2.57 sigma, the cost per pixel does not depend on it.
+     * Color channels are blurred as stored and the result is opaque.
+     * Image is converted to argb32 format when it is not a 32 bit rgb format.
+     */
+    TTK_MODULE_EXPORT void gaussBlur(QImage &image, int radius);
+
+}
+
+#endif // BLURKERNEL_H
@@ -1,8 +1,20 @@
 #include "imagewrapper.h"
 #include "random.h"
+#include "parallel.h"
+#include "blurkernel.h"
+#include "pixelkernel.h"
 
+#include <vector>
 #include <qmath.h>
-#include <QPainter>
+#include <QPixmap>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define WAVE_USE_SSE2
+#  include <emmintrin.h>
+#endif
 
 namespace QAlgorithm
 {
@@ -57,111 +69,7 @@ QPixmap GaussBlur::render(const QPixmap &pixmap, int value)
 {
     TTK_D(SharpeImage);
     QImage image = pixmap.copy(d->m_rectangle).toImage();
-
-    const float sigma = 1.0 * value / 2.57;
-    const float deno = 1.0 / (sigma * sqrt(2.0 * M_PI));
-    const float nume = -1.0 / (2.0 * sigma * sigma);
-
-    float* gaussMatrix = (float*)malloc(sizeof(float)* (value + value + 1));
-    float gaussSum = 0.0;
-    for(int i = 0, x = -value; x <= value; ++x, ++i)
-    {
-        float g = deno * exp(1.0 * nume * x * x);
-
-        gaussMatrix[i] = g;
-        gaussSum += g;
-    }
-
-    const int len = value + value + 1;
-    for(int i = 0; i < len; ++i)
-    {
-        gaussMatrix[i] /= gaussSum;
-    }
-
-    const int width = image.width();
-    const int height = image.height();
-    int *pix = (int*)image.bits();
-    int *rowData = (int*)malloc(width * sizeof(int));
-    int *listData = (int*)malloc(height * sizeof(int));
-
-    for(int y = 0; y < height; ++y)
-    {
-        memcpy(rowData, pix + y * width, sizeof(int) *width);
-
-        for(int x = 0; x < width; ++x)
-        {
-            float r = 0, g = 0, b = 0;
-            gaussSum = 0;
-
-            for(int i = -value; i <= value; ++i)
-            {
-                int k = x + i;
-
-                if(0 <= k && k <= width)
-                {
-                    int color = rowData[k];
-                    int cr = (color & 0x00ff0000) >> 16;
-                    int cg = (color & 0x0000ff00) >> 8;
-                    int cb = (color & 0x000000ff);
-
-                    r += cr * gaussMatrix[i + value];
-                    g += cg * gaussMatrix[i + value];
-                    b += cb * gaussMatrix[i + value];
-
-                    gaussSum += gaussMatrix[i + value];
-                }
-            }
-
-            int cr = (int)(r / gaussSum);
-            int cg = (int)(g / gaussSum);
-            int cb = (int)(b / gaussSum);
-
-            pix[y * width + x] = cr << 16 | cg << 8 | cb | 0xff000000;
-        }
-    }
-
-    for(int x = 0; x < width; ++x)
-    {
-        for(int y = 0; y < height; ++y)
-        {
-            listData[y] = pix[y * width + x];
-        }
-
-        for(int y = 0; y < height; ++y)
-        {
-            float r = 0, g = 0, b = 0;
-            gaussSum = 0;
-
-            for(int j = -value; j <= value; ++j)
-            {
-                int k = y + j;
-
-                if(0 <= k && k <= height)
-                {
-                    int color = listData[k];
-                    int cr = (color & 0x00ff0000) >> 16;
-                    int cg = (color & 0x0000ff00) >> 8;
-                    int cb = (color & 0x000000ff);
-
-                    r += cr * gaussMatrix[j + value];
-                    g += cg * gaussMatrix[j + value];
-                    b += cb * gaussMatrix[j + value];
-
-                    gaussSum += gaussMatrix[j + value];
-                }
-            }
-
-            int cr = (int)(r / gaussSum);
-            int cg = (int)(g / gaussSum);
-            int cb = (int)(b / gaussSum);
-
-            pix[y * width + x] = cr << 16 | cg << 8 | cb | 0xff000000;
-        }
-    }
-
-    free(gaussMatrix);
-    free(rowData);
-    free(listData);
+    QAlgorithm::gaussBlur(image, value);
     return QPixmap::fromImage(image);
 }
 
@@ -176,6 +84,7 @@ public:
     CubeWavePrivate();
 
     void initialize(int width, int height);
+    const QImage &source(const QPixmap &pixmap);
 
     int count() const;
     bool isValid(int index, int value) const;
@@ -183,12 +92,17 @@ public:
     int m_row;
     int m_column;
     TTKIntList m_data;
+
+    qint64 m_cacheKey;
+    QImage m_source;
+    QImage m_image;
 };
 
 CubeWavePrivate::CubeWavePrivate()
     : SharpeImagePrivate(),
       m_row(0),
-      m_column(0)
+      m_column(0),
+      m_cacheKey(-1)
 {
     QAlgorithm::initRandom();
 }
@@ -199,9 +113,20 @@ void CubeWavePrivate::initialize(int width, int height)
     m_row = ceil(height * 1.0  / 8);
 }
 
+const QImage &CubeWavePrivate::source(const QPixmap &pixmap)
+{
+    // the same pixmap is passed on every frame, convert it once
+    if(m_cacheKey != pixmap.cacheKey())
+    {
+        m_cacheKey = pixmap.cacheKey();
+        m_source = pixmap.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+    return m_source;
+}
+
 bool CubeWavePrivate::isValid(int index, int value) const
 {
-    if(index < 0 || index > m_data.count())
+    if(index < 0 || index >= m_data.count())
     {
         return false;
     }
@@ -236,32 +161,58 @@ void CubeWave::input(const QRect &region)
 QPixmap CubeWave::render(const QPixmap &pixmap, int value)
 {
     TTK_D(CubeWave);
-    QPixmap pix(d->m_rectangle.size());
+    const QImage &source = d->source(pixmap);
 
-    pix.fill(Qt::transparent);
+    // output frame is kept across frames, area out of the source stays transparent
+    QImage &image = d->m_image;
+    if(image.size() != d->m_rectangle.size())
+    {
+        image = QImage(d->m_rectangle.size(), QImage::Format_ARGB32_Premultiplied);
+        image.fill(0);
+    }
+
+    if(d->m_row <= 0 || d->m_column <= 0)
+    {
+        return QPixmap::fromImage(image);
+    }
+
+    // tiles still covered fade in by value, the others are shown as they are
+    const int factor = 255 - qBound(0, TTKStaticCast(int, 255 - 2.55 * value), 255);
+    int factors[8 * 8];
     for(int index = 0; index < d->count(); ++index)
     {
-        QPainter painter(&pix);
+        factors[index] = d->isValid(index, value) ? factor : 255;
+    }
 
-        const int row = index / 8;
-        const int column = index % 8;
+    const int width = qMin(image.width(), source.width());
+    const int height = qMin(image.height(), source.height());
+    uchar *bits = image.bits();
+    const int stride = image.bytesPerLine();
 
-        QRect rect(QRect(row * d->m_column, column * d->m_row, d->m_column, d->m_row));
-        if(rect.y() + rect.height() > pixmap.height())
+    // tile index is column major, x by index / 8 and y by index % 8
+    QAlgorithm::parallelFor(height, 32, [&](int begin, int end)
+    {
+        for(int y = begin; y < end; ++y)
         {
-            rect.setHeight(pixmap.height() - rect.y());
-        }
+            const quint32 *src = TTKReinterpretCast(const quint32*, source.constScanLine(y));
+            quint32 *dst = TTKReinterpretCast(quint32*, bits + y * stride);
+            const int row = qMin(y / d->m_row, 7);
 
-        if(d->isValid(index, value))
-        {
-            painter.fillRect(rect, QColor(0xFF, 0xFF, 0xFF, 255 - 2.55 * value));
-        }
+            for(int column = 0; column < 8; ++column)
+            {
+                const int left = column * d->m_column;
+                const int right = qMin(left + d->m_column, width);
+                if(left >= right)
+                {
+                    break;
+                }
 
-        painter.setCompositionMode(QPainter::CompositionMode_SourceOut);
-        painter.drawPixmap(rect, pixmap.copy(rect));
-    }
+                QAlgorithm::multiplyRow(dst + left, src + left, right - left, factors[column * 8 + row]);
+            }
+        }
+    });
 
-    return pix;
+    return QPixmap::fromImage(image);
 }
 
 
@@ -275,27 +226,33 @@ public:
     WaterWavePrivate();
     ~WaterWavePrivate();
 
-    int* data();
-    void render();
+    const quint32 *frame();
+    void step();
     void initialize(const QImage &image, int radius);
 
     void setWaveSourcePower(int radius, int depth);
     void setWaveSourcePosition(int x, int y);
 
+    int m_width;
+    int m_height;
+    QImage m_image;
+
 private:
+    void wait();
     void spreedRipple();
-    void renderRipple();
+    void renderRipple(quint32 *pixels);
 
 private:
-    int *m_orginPixels;
-    int *m_newPixels;
-    short *m_buffer1;
-    short *m_buffer2;
-    int *m_sourcePower;
-    int *m_sourcePosition;
+    std::vector<quint32> m_orginPixels;
+    std::vector<quint32> m_frames[2];
+    std::vector<short> m_buffer1;
+    std::vector<short> m_buffer2;
+    std::vector<int> m_sourcePower;
+    std::vector<int> m_sourcePosition;
 
-    int m_width;
-    int m_height;
+    int m_front;
+    bool m_pending;
+    QSemaphore m_ready;
 
     int m_powerRate;
     float m_scale;
@@ -304,79 +261,101 @@ private:
     int m_sourceDepth;
 };
 
-WaterWavePrivate::WaterWavePrivate()
-    : SharpeImagePrivate()
-{
-
-}
-
-WaterWavePrivate::~WaterWavePrivate()
+/*! @brief The class of the water wave step task.
+ * @author Greedysky <greedysky@163.com>
+ */
+class WaterWaveTask : public QRunnable
 {
-    if(m_orginPixels)
+public:
+    explicit WaterWaveTask(WaterWavePrivate *wave)
+        : m_wave(wave)
     {
-        delete[] m_orginPixels;
-    }
 
-    if(m_newPixels)
-    {
-        delete[] m_newPixels;
     }
 
-    if(m_buffer1)
+    virtual void run() override final
     {
-        delete[] m_buffer1;
+        m_wave->step();
     }
 
-    if(m_buffer2)
-    {
-        delete[] m_buffer2;
-    }
+private:
+    WaterWavePrivate *m_wave;
 
-    if(m_sourcePower)
+};
+
+WaterWavePrivate::WaterWavePrivate()
+    : SharpeImagePrivate(),
+      m_width(0),
+      m_height(0),
+      m_front(0),
+      m_pending(false),
+      m_powerRate(2),
+      m_scale(1),
+      m_sourceRadius(0),
+      m_sourceDepth(0)
+{
+
+}
+
+WaterWavePrivate::~WaterWavePrivate()
+{
+    wait();
+}
+
+const quint32 *WaterWavePrivate::frame()
+{
+    // the back frame is stepped on the thread pool while the front one is on screen
+    if(m_pending)
     {
-        delete[] m_sourcePower;
+        m_ready.acquire();
     }
-
-    if(m_sourcePosition)
+    else
     {
-        delete[] m_sourcePosition;
+        spreedRipple();
+        renderRipple(m_frames[m_front ^ 1].data());
     }
+
+    m_front ^= 1;
+    m_pending = true;
+    QThreadPool::globalInstance()->start(new WaterWaveTask(this));
+    return m_frames[m_front].data();
 }
 
-int* WaterWavePrivate::data()
+void WaterWavePrivate::step()
 {
-    return m_newPixels;
+    spreedRipple();
+    renderRipple(m_frames[m_front ^ 1].data());
+    m_ready.release();
 }
 
-void WaterWavePrivate::render()
+void WaterWavePrivate::wait()
 {
-    spreedRipple();
-    renderRipple();
+    if(m_pending)
+    {
+        m_ready.acquire();
+        m_pending = false;
+    }
 }
 
 void WaterWavePrivate::initialize(const QImage &image, int radius)
 {
-    m_orginPixels = nullptr;
-    m_newPixels = nullptr;
-    m_buffer1 = nullptr;
-    m_buffer2 = nullptr;
-    m_sourcePower = nullptr;
-    m_sourcePosition = nullptr;
-
-    m_width = image.width();
-    m_height = image.height();
+    const QImage &source = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    m_width = source.width();
+    m_height = source.height();
 
-    m_orginPixels = new int[m_width * m_height]{};
-    memcpy(m_orginPixels, image.bits(), m_width * m_height * 4);
-
-    m_newPixels = new int[m_width * m_height]{};
-    memcpy(m_newPixels, image.bits(), m_width * m_height * sizeof(int));
+    const int size = m_width * m_height;
+    m_orginPixels.resize(size);
+    for(int y = 0; y < m_height; ++y)
+    {
+        memcpy(m_orginPixels.data() + y * m_width, source.constScanLine(y), m_width * sizeof(quint32));
+    }
 
-    m_buffer1 = new short[m_width * m_height]{};
-    m_buffer2 = new short[m_width * m_height]{};
+    // rows out of the ripple keep the origin pixels in both frames
+    m_frames[0] = m_orginPixels;
+    m_frames[1] = m_orginPixels;
 
-    m_powerRate = 2;
-    m_scale = 1;
+    m_buffer1.assign(size, 0);
+    m_buffer2.assign(size, 0);
 
     setWaveSourcePower(radius, 100);
 }
@@ -386,17 +365,24 @@ void WaterWavePrivate::setWaveSourcePower(int radius, int depth)
     m_sourceRadius = TTKStaticCast(int, radius / m_scale);
     m_sourceDepth = depth;
 
+    if(m_sourceRadius <= 0)
+    {
+        m_sourcePower.clear();
+        m_sourcePosition.clear();
+        return;
+    }
+
     const int value = m_sourceRadius * m_sourceRadius;
     const int diameter = (m_sourceRadius << 1) + 1;
     const int rate = m_sourceRadius / value;
     const int size = diameter * diameter;
 
-    m_sourcePower = new int[size]{};
-    m_sourcePosition = new int[size]{};
+    m_sourcePower.assign(size, 0);
+    m_sourcePosition.assign(size, 0);
 
-    for(int x = 0; x <= diameter; ++x)
+    for(int x = 0; x < diameter; ++x)
     {
-        for(int y = 0; y <= diameter; ++y)
+        for(int y = 0; y < diameter; ++y)
         {
             const int distanceSquare = (m_sourceRadius - x) * (m_sourceRadius - x) + (m_sourceRadius - y) * (m_sourceRadius - y);
             if(distanceSquare <= value)
@@ -413,13 +399,15 @@ void WaterWavePrivate::setWaveSourcePosition(int x, int y)
 {
     const int sourceX = TTKStaticCast(int, x / m_scale);
     const int sourceY = TTKStaticCast(int, y / m_scale);
-    if((sourceX + m_sourceRadius) >= m_width || (sourceY + m_sourceRadius) >= m_height || (sourceX - m_sourceRadius) <= 0 || (sourceY - m_sourceRadius) <= 0)
+    if(m_sourcePower.empty() || (sourceX + m_sourceRadius) >= m_width || (sourceY + m_sourceRadius) >= m_height || (sourceX - m_sourceRadius) <= 0 || (sourceY - m_sourceRadius) <= 0)
     {
         return;
     }
 
+    wait();
+
     const int distance = (sourceY - m_sourceRadius) * m_width + sourceX - m_sourceRadius;
-    const int size = ((m_sourceRadius << 1) + 1) * ((m_sourceRadius << 1) + 1);
+    const int size = TTKStaticCast(int, m_sourcePower.size());
     for(int i = 0; i < size; ++i)
     {
         m_buffer1[distance + m_sourcePosition[i]] = TTKStaticCast(short, m_sourcePower[i]);
@@ -428,36 +416,56 @@ void WaterWavePrivate::setWaveSourcePosition(int x, int y)
 
 void WaterWavePrivate::spreedRipple()
 {
+    if(m_height < 3)
+    {
+        return;
+    }
+
+    const short *b1 = m_buffer1.data();
+    short *b2 = m_buffer2.data();
+    const int width = m_width;
     const int length = m_width * (m_height - 1);
-    for(int i = m_width; i < length; ++i)
+
+    // amplitudes stay far below the short range, so lanes are summed in 16 bits
+    int i = m_width;
+#if defined(WAVE_USE_SSE2)
+    const __m128i rate = _mm_cvtsi32_si128(m_powerRate);
+    for(; i + 8 <= length; i += 8)
+    {
+        const __m128i left = _mm_loadu_si128(TTKReinterpretCast(const __m128i*, b1 + i - 1));
+        const __m128i right = _mm_loadu_si128(TTKReinterpretCast(const __m128i*, b1 + i + 1));
+        const __m128i top = _mm_loadu_si128(TTKReinterpretCast(const __m128i*, b1 + i - width));
+        const __m128i bottom = _mm_loadu_si128(TTKReinterpretCast(const __m128i*, b1 + i + width));
+        const __m128i previous = _mm_loadu_si128(TTKReinterpretCast(const __m128i*, b2 + i));
+
+        __m128i v = _mm_add_epi16(_mm_add_epi16(left, right), _mm_add_epi16(top, bottom));
+        v = _mm_sub_epi16(_mm_srai_epi16(v, 1), previous);
+        v = _mm_sub_epi16(v, _mm_sra_epi16(v, rate));
+        _mm_storeu_si128(TTKReinterpretCast(__m128i*, b2 + i), v);
+    }
+#endif
+    for(; i < length; ++i)
     {
-        m_buffer2[i] = ((m_buffer1[i - 1] + m_buffer1[i - m_width] + m_buffer1[i + 1] + m_buffer1[i + m_width]) >> 1) - m_buffer2[i];
-        m_buffer2[i] -= m_buffer2[i] >> m_powerRate;
+        const short v = ((b1[i - 1] + b1[i - width] + b1[i + 1] + b1[i + width]) >> 1) - b2[i];
+        b2[i] = v - (v >> m_powerRate);
     }
 
-    short* temp = m_buffer1;
-    m_buffer1 = m_buffer2;
-    m_buffer2 = temp;
+    m_buffer1.swap(m_buffer2);
 }
 
-void WaterWavePrivate::renderRipple()
+void WaterWavePrivate::renderRipple(quint32 *pixels)
 {
-    int offset;
-    int w = m_width;
-    for(int y = 1; y < m_height - 1; ++y)
+    const short *buffer = m_buffer1.data();
+    const quint32 *origin = m_orginPixels.data();
+    const int width = m_width;
+    const unsigned int size = m_width * m_height;
+
+    for(int w = m_width; w < m_width * (m_height - 1); ++w)
     {
-        for(int x = 0; x < m_width; ++x, ++w)
-        {
-            offset = (m_width * (m_buffer1[w - m_width] - m_buffer1[w + m_width])) + (m_buffer1[w - 1] - m_buffer1[w + 1]);
-            if(w + offset > 0 && w + offset < m_width * m_height)
-            {
-                m_newPixels[w] = m_orginPixels[w + offset];
-            }
-            else
-            {
-                m_newPixels[w] = m_orginPixels[w];
-            }
-        }
+        const int offset = (width * (buffer[w - width] - buffer[w + width])) + (buffer[w - 1] - buffer[w + 1]);
+        // select the displaced pixel when it is inside the image, without branch
+        const int valid = -TTKStaticCast(int, TTKStaticCast(unsigned int, w + offset - 1) < size - 1);
+        pixels[w] = origin[w + (offset & valid)];
     }
 }
 
@@ -479,19 +487,34 @@ void WaterWave::input(const QRect &region)
 
 QPixmap WaterWave::render(const QPixmap &pixmap, int value)
 {
+    Q_UNUSED(pixmap);
     TTK_D(WaterWave);
-    d->render();
+    const quint32 *frame = d->frame();
 
-    QImage image = pixmap.toImage();
-    memcpy(image.bits(), (const uchar*)d->data(), QtImageBytes(image));
+    QImage &image = d->m_image;
+    if(image.width() != d->m_width || image.height() != d->m_height)
+    {
+        image = QImage(d->m_width, d->m_height, QImage::Format_ARGB32_Premultiplied);
+    }
+
+    const int alpha = qMin(2.55 * 2 * value, 255.0);
+    const int width = d->m_width;
+    uchar *bits = image.bits();
+    const int stride = image.bytesPerLine();
 
-    QPixmap pix(d->m_rectangle.size());
-    pix.fill(Qt::transparent);
+    // fade in and copy out of the front frame in one pass
+    QAlgorithm::parallelFor(d->m_height, 32, [&](int begin, int end)
+    {
+        for(int y = begin; y < end; ++y)
+        {
+            QAlgorithm::multiplyRow(TTKReinterpretCast(quint32*, bits + y * stride), frame + y * width, width, alpha);
+        }
+    });
 
-    QPainter painter(&pix);
-    painter.fillRect(d->m_rectangle, QColor(0xFF, 0xFF, 0xFF, qMin(2.55 * 2 * value, 255.0)));
-    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
-    painter.drawPixmap(d->m_rectangle, QPixmap::fromImage(image));
-    return pix;
+    if(image.size() != d->m_rectangle.size())
+    {
+        return QPixmap::fromImage(image.scaled(d->m_rectangle.size()));
+    }
+    return QPixmap::fromImage(image);
 }
 }
@@ -0,0 +1,50 @@
+#include "parallel.h"
+
+#include "ttkthreadpool.h"
+
+#include <QList>
+
+namespace QAlgorithm
+{
+void parallelFor(int count, int grain, const std::function<void(int, int)> &task)
+{
+    if(count <= 0)
+    {
+        return;
+    }
+
+    TTKThreadPool *pool = TTKThreadPool::instance();
+    const int chunks = qBound(1, count / qMax(1, grain), pool->threadCount());
+    if(chunks == 1)
+    {
+        task(0, count);
+        return;
+    }
+
+    const int step = (count + chunks - 1) / chunks;
+
+    // the caller waits for the chunks, so they go ahead of the queued work
+    QList<TTKFuture<void>> futures;
+    for(int begin = step; begin < count; begin += step)
+    {
+        const int end = qMin(begin + step, count);
+        futures << pool->run([&task, begin, end]() { task(begin, end); }, TTKThreadPool::Priority::High);
+    }
+
+    task(0, qMin(step, count));
+
+    // a worker waiting here runs other tasks, nested calls do not starve the pool
+    for(int i = 0; i < futures.count(); ++i)
+    {
+        const TTKFuture<void> &future = futures[i];
+        future.waitForFinished();
+
+        if(future.isCanceled())
+        {
+            // skipped by a pool shut down, the range is still done
+            const int begin = (i + 1) * step;
+            task(begin, qMin(begin + step, count));
+        }
+    }
+}
+}
@@ -0,0 +1,38 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <functional>
+#include "ttkmoduleexport.h"
+
+/*! @brief The namespace of the algorithm.
+ * @author Greedysky <greedysky@163.com>
+ */
+namespace QAlgorithm
+{
+    /*!
+     * Split range [0, count) into chunks of at least grain items and run them on the shared TTKThreadPool.
+     * The caller thread runs the first chunk itself and returns when all chunks are finished.
+     */
+    TTK_MODULE_EXPORT void parallelFor(int count, int grain, const std::function<void(int, int)> &task);
+
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,254 @@
+#include "pixelkernel.h"
+#include "parallel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define PIXEL_USE_SSE2
+#  include <emmintrin.h>
+#endif
+
+namespace QAlgorithm
+{
+// rows are split over the thread pool, pixels of one row are walked in order
+static constexpr int RowGrain = 64;
+
+/*!
+ * Make sure image is 32 bit unpremultiplied pixels.
+ */
+static void toRgbFormat(QImage &image)
+{
+    if(image.format() != QImage::Format_ARGB32 && image.format() != QImage::Format_RGB32)
+    {
+        image = image.convertToFormat(QImage::Format_ARGB32);
+    }
+}
+
+/*!
+ * Multiply every byte of x by a / 255, rounded the same way as the vector paths.
+ */
+static inline quint32 byteMul(quint32 x, quint32 a)
+{
+    quint32 t = (x & 0xff00ff) * a + 0x800080;
+    t = (t + ((t >> 8) & 0xff00ff)) >> 8;
+    t &= 0xff00ff;
+
+    x = ((x >> 8) & 0xff00ff) * a + 0x800080;
+    x = (x + ((x >> 8) & 0xff00ff));
+    x &= 0xff00ff00;
+    return x | t;
+}
+
+static inline quint32 premultiplyPixel(quint32 pixel)
+{
+    const quint32 alpha = pixel >> 24;
+    return (alpha << 24) | (byteMul(pixel, alpha) & 0xffffff);
+}
+
+static inline quint32 unpremultiplyPixel(quint32 pixel)
+{
+    const quint32 alpha = pixel >> 24;
+    if(alpha == 0 || alpha == 0xff)
+    {
+        return alpha == 0 ? 0 : pixel;
+    }
+
+    const quint32 half = alpha / 2;
+    const quint32 r = qMin<quint32>((((pixel >> 16) & 0xff) * 0xff + half) / alpha, 0xff);
+    const quint32 g = qMin<quint32>((((pixel >> 8) & 0xff) * 0xff + half) / alpha, 0xff);
+    const quint32 b = qMin<quint32>(((pixel & 0xff) * 0xff + half) / alpha, 0xff);
+    return (alpha << 24) | (r << 16) | (g << 8) | b;
+}
+
+static inline quint32 grayPixel(quint32 pixel, int delta)
+{
+    // same weights as qGray
+    const int gray = qBound(0, int((((pixel >> 16) & 0xff) * 11 + ((pixel >> 8) & 0xff) * 16 + (pixel & 0xff) * 5) >> 5) + delta, 0xff);
+    return 0xff000000 | (gray << 16) | (gray << 8) | gray;
+}
+
+static void grayRow(quint32 *line, int width, int delta)
+{
+    int x = 0;
+#if defined(PIXEL_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weight = _mm_set_epi16(0, 11, 16, 5, 0, 11, 16, 5);
+    const __m128i offset = _mm_set1_epi32(delta);
+    const __m128i alpha = _mm_set1_epi32(0xff000000);
+    for(; x + 4 <= width; x += 4)
+    {
+        const __m128i pixel = _mm_loadu_si128(TTKReinterpretCast(const __m128i*, line + x));
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(pixel, zero), weight);
+        __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(pixel, zero), weight);
+        lo = _mm_shuffle_epi32(_mm_add_epi32(lo, _mm_srli_epi64(lo, 32)), _MM_SHUFFLE(3, 3, 2, 0));
+        hi = _mm_shuffle_epi32(_mm_add_epi32(hi, _mm_srli_epi64(hi, 32)), _MM_SHUFFLE(3, 3, 2, 0));
+
+        __m128i gray = _mm_add_epi32(_mm_srli_epi32(_mm_unpacklo_epi64(lo, hi), 5), offset);
+        gray = _mm_packs_epi32(gray, gray);
+        gray = _mm_packus_epi16(gray, gray);
+        gray = _mm_unpacklo_epi16(_mm_unpacklo_epi8(gray, zero), zero);
+        gray = _mm_or_si128(_mm_or_si128(gray, _mm_slli_epi32(gray, 8)), _mm_or_si128(_mm_slli_epi32(gray, 16), alpha));
+        _mm_storeu_si128(TTKReinterpretCast(__m128i*, line + x), gray);
+    }
+#endif
+    for(; x < width; ++x)
+    {
+        line[x] = grayPixel(line[x], delta);
+    }
+}
+
+static void sourceOverRow(quint32 *dst, const quint32 *src, int width)
+{
+    int x = 0;
+#if defined(PIXEL_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi32(0xff);
+    const __m128i half = _mm_set1_epi16(0x80);
+    for(; x + 4 <= width; x += 4)
+    {
+        const __m128i s = _mm_loadu_si128(TTKReinterpretCast(const __m128i*, src + x));
+        const __m128i d = _mm_loadu_si128(TTKReinterpretCast(const __m128i*, dst + x));
+
+        __m128i ia = _mm_sub_epi32(full, _mm_srli_epi32(s, 24));
+        ia = _mm_or_si128(ia, _mm_slli_epi32(ia, 16));
+
+        __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi32(ia, ia));
+        __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi32(ia, ia));
+        // divide by 255 with rounding
+        lo = _mm_add_epi16(lo, half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_add_epi16(hi, half);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+        _mm_storeu_si128(TTKReinterpretCast(__m128i*, dst + x), _mm_adds_epu8(s, _mm_packus_epi16(lo, hi)));
+    }
+#endif
+    for(; x < width; ++x)
+    {
+        const quint32 s = src[x];
+        dst[x] = s + byteMul(dst[x], 0xff - (s >> 24));
+    }
+}
+
+
+void multiplyRow(quint32 *dst, const quint32 *src, int width, int factor)
+{
+    int x = 0;
+#if defined(PIXEL_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i scale = _mm_set1_epi16(factor);
+    const __m128i half = _mm_set1_epi16(0x80);
+    for(; x + 4 <= width; x += 4)
+    {
+        const __m128i s = _mm_loadu_si128(TTKReinterpretCast(const __m128i*, src + x));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), scale), half);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), scale), half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128(TTKReinterpretCast(__m128i*, dst + x), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for(; x < width; ++x)
+    {
+        dst[x] = byteMul(src[x], factor);
+    }
+}
+
+void mapChannels(QImage &image, const uchar *table)
+{
+    if(image.isNull())
+    {
+        return;
+    }
+
+    toRgbFormat(image);
+
+    const int width = image.width();
+    uchar *bits = image.bits();
+    const int stride = image.bytesPerLine();
+
+    parallelFor(image.height(), RowGrain, [&](int begin, int end)
+    {
+        for(int y = begin; y < end; ++y)
+        {
+            quint32 *line = TTKReinterpretCast(quint32*, bits + y * stride);
+            for(int x = 0; x < width; ++x)
+            {
+                const quint32 pixel = line[x];
+                line[x] = 0xff000000 | (table[(pixel >> 16) & 0xff] << 16) | (table[(pixel >> 8) & 0xff] << 8) | table[pixel & 0xff];
+            }
+        }
+    });
+}
+
+void grayScale(QImage &image, int delta)
+{
+    if(image.isNull())
+    {
+        return;
+    }
+
+    toRgbFormat(image);
+
+    const int width = image.width();
+    uchar *bits = image.bits();
+    const int stride = image.bytesPerLine();
+
+    parallelFor(image.height(), RowGrain, [&](int begin, int end)
+    {
+        for(int y = begin; y < end; ++y)
+        {
+            grayRow(TTKReinterpretCast(quint32*, bits + y * stride), width, delta);
+        }
+    });
+}
+
+bool sourceOver(QImage &back, const QImage &front, const QPoint &pt)
+{
+    const QImage::Format format = back.format();
+    if(format != QImage::Format_ARGB32_Premultiplied && format != QImage::Format_RGB32 && format != QImage::Format_ARGB32)
+    {
+        return false;
+    }
+
+    const QImage &source = front.format() == QImage::Format_ARGB32_Premultiplied ? front : front.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const QRect &area = QRect(pt, source.size()) & back.rect();
+    if(area.isEmpty())
+    {
+        return true;
+    }
+
+    const int width = area.width();
+    const int left = area.x() - pt.x();
+    const int top = area.y() - pt.y();
+    uchar *bits = back.bits();
+    const int stride = back.bytesPerLine();
+
+    parallelFor(area.height(), RowGrain, [&](int begin, int end)
+    {
+        // unpremultiplied backs are blended in a premultiplied copy of the row, so the image keeps its format
+        QVector<quint32> row(format == QImage::Format_ARGB32 ? width : 0);
+        for(int y = begin; y < end; ++y)
+        {
+            quint32 *dst = TTKReinterpretCast(quint32*, bits + (area.y() + y) * stride) + area.x();
+            const quint32 *src = TTKReinterpretCast(const quint32*, source.constScanLine(top + y)) + left;
+            if(row.isEmpty())
+            {
+                sourceOverRow(dst, src, width);
+                continue;
+            }
+
+            for(int x = 0; x < width; ++x)
+            {
+                row[x] = premultiplyPixel(dst[x]);
+            }
+
+            sourceOverRow(row.data(), src, width);
+
+            for(int x = 0; x < width; ++x)
+            {
+                dst[x] = unpremultiplyPixel(row[x]);
+            }
+        }
+    });
+    return true;
+}
+}
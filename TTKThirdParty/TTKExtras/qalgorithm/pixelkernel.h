@@ -0,0 +1,52 @@
+#ifndef PIXELKERNEL_H
+#define PIXELKERNEL_H
+
+/***************************************************************************
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2024 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <QImage>
+#include "ttkmoduleexport.h"
+
+/*! @brief The namespace of the algorithm.
+ * @author Greedysky <greedysky@163.com>
+ */
+namespace QAlgorithm
+{
+    /*!
+     * Map red, green and blue channels through the 256 entries table, result is opaque.
+     * Image is converted to argb32 format when needed.
+     */
+    TTK_MODULE_EXPORT void mapChannels(QImage &image, const uchar *table);
+    /*!
+     * Convert image to opaque gray scale, delta is added to the luminance.
+     * Image is converted to argb32 format when needed.
+     */
+    TTK_MODULE_EXPORT void grayScale(QImage &image, int delta);
+    /*!
+     * Composite front over back at the position, back keeps its format.
+     * Return false when back format is not rgb32, argb32 or argb32 premultiplied.
+     */
+    TTK_MODULE_EXPORT bool sourceOver(QImage &back, const QImage &front, const QPoint &pt);
+    /*!
+     * Multiply premultiplied pixels of one row by factor / 255, dst may be src.
+     */
+    TTK_MODULE_EXPORT void multiplyRow(quint32 *dst, const quint32 *src, int width, int factor);
+
+}
+
+#endif // PIXELKERNEL_H
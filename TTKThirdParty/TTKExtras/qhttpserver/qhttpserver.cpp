@@ -153,3 +153,9 @@ void QHttpServer::close()
     TTK_D(QHttpServer);
     d->close();
 }
+
+quint16 QHttpServer::serverPort() const
+{
+    TTK_D(QHttpServer);
+    return d->m_tcpServer ? d->m_tcpServer->serverPort() : 0;
+}
@@ -60,6 +60,10 @@ public:
     /// Stop the server and listening for new connections.
     void close();
 
+    /// Port the server is listening on, useful when it was started on port 0.
+    /** @return The bound port, 0 if the server is not listening. */
+    quint16 serverPort() const;
+
 Q_SIGNALS:
     /// Emitted when a client makes a new request to the server.
     /** The slot should use the given @c request and @c response
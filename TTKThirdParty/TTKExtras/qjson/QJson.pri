@@ -28,8 +28,6 @@ HEADERS += \
 SOURCES += \
     $$PWD/parser.cpp \
     $$PWD/qobjecthelper.cpp \
-    $$PWD/json_scanner.cpp \
-    $$PWD/json_parser.cc \
     $$PWD/parserrunnable.cpp \
     $$PWD/serializer.cpp \
     $$PWD/serializerrunnable.cpp
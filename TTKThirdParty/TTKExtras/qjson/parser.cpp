@@ -21,26 +21,86 @@
 
 #include "parser.h"
 #include "parser_p.h"
-#include "json_parser.hh"
-#include "json_scanner.h"
 
-#include <QtCore/QBuffer>
+#include <QtCore/QIODevice>
 #include <QtCore/QStringList>
-#include <QtCore/QTextStream>
+
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define QJSON_USE_SSE2
+#  include <emmintrin.h>
+#endif
 
 using namespace QJson;
 
-ParserPrivate::ParserPrivate() :
-  m_scanner(0),
-  m_specialNumbersAllowed(false)
+// deeper documents are rejected instead of overflowing the stack
+static const int MaxDepth = 1024;
+
+/**
+ * Find the first quote or backslash, 16 bytes at once when sse2 is available.
+ */
+static inline const char *findStringEnd(const char *pos, const char *end)
 {
-  reset();
+#if defined(QJSON_USE_SSE2)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i escape = _mm_set1_epi8('\\');
+  for (; end - pos >= 16; pos += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+    int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, escape)));
+    if (mask != 0) {
+      while (!(mask & 1)) {
+        mask >>= 1;
+        ++pos;
+      }
+      return pos;
+    }
+  }
+#endif
+  while (pos < end && *pos != '"' && *pos != '\\')
+    ++pos;
+  return pos;
 }
 
-ParserPrivate::~ParserPrivate()
+static inline int hexValue(char c)
 {
-  if (m_scanner)
-    delete m_scanner;
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+/**
+ * The member paths below the key, an empty list when the whole member is wanted.
+ */
+static bool childPaths(const QStringList &paths, const QString &key, QStringList *children)
+{
+  bool found = false;
+  for (const QString &path : paths) {
+    if (path == key) {
+      children->clear();
+      return true;
+    }
+
+    if (path.length() > key.length() && path.at(key.length()) == QLatin1Char('.') && path.startsWith(key)) {
+      children->append(path.mid(key.length() + 1));
+      found = true;
+    }
+  }
+  return found;
+}
+
+
+ParserPrivate::ParserPrivate() :
+  m_specialNumbersAllowed(false),
+  m_begin(0),
+  m_pos(0),
+  m_end(0)
+{
+  reset();
 }
 
 void ParserPrivate::setError(const QString &errorMsg, int errorLine)
@@ -50,17 +110,436 @@ void ParserPrivate::setError(const QString &errorMsg, int errorLine)
   m_errorLine = errorLine;
 }
 
+void ParserPrivate::setError(const QString &errorMsg)
+{
+  if (m_error)
+    return;
+
+  // lines are only counted when something went wrong
+  int line = 1;
+  for (const char *pos = m_begin; pos < m_pos && pos < m_end; ++pos) {
+    if (*pos == '\n')
+      ++line;
+  }
+  setError(QString::fromLatin1("%1 at line %2, offset %3").arg(errorMsg).arg(line).arg(m_pos - m_begin), line);
+}
+
 void ParserPrivate::reset()
 {
   m_error = false;
   m_errorLine = 0;
   m_errorMsg.clear();
-  if (m_scanner) {
-    delete m_scanner;
-    m_scanner = 0;
+  m_result.clear();
+}
+
+QVariant ParserPrivate::parse(const QByteArray &data, const QStringList &paths)
+{
+  reset();
+
+  m_begin = data.constData();
+  m_pos = m_begin;
+  m_end = m_begin + data.size();
+
+  // utf-8 byte order mark
+  if (m_end - m_pos >= 3 && uchar(m_pos[0]) == 0xef && uchar(m_pos[1]) == 0xbb && uchar(m_pos[2]) == 0xbf)
+    m_pos += 3;
+
+  skipWhitespace();
+  if (m_pos == m_end) {
+    setError(QLatin1String("No data"), 0);
+    return QVariant();
+  }
+
+  QVariant result = parseValue(paths, 0);
+  if (!m_error) {
+    skipWhitespace();
+    if (m_pos != m_end)
+      setError(QLatin1String("Unexpected data after the root value"));
   }
+
+  m_begin = m_pos = m_end = 0;
+  if (m_error)
+    return QVariant();
+
+  m_result = result;
+  return result;
 }
 
+void ParserPrivate::skipWhitespace()
+{
+  while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t'))
+    ++m_pos;
+}
+
+QVariant ParserPrivate::parseValue(const QStringList &paths, int depth)
+{
+  if (m_pos == m_end) {
+    setError(QLatin1String("Unexpected end of data"));
+    return QVariant();
+  }
+
+  switch (*m_pos) {
+    case '{':
+      return parseObject(paths, depth);
+    case '[':
+      return parseArray(paths, depth);
+    case '"': {
+      QString value;
+      if (!parseString(&value))
+        return QVariant();
+      return QVariant(value);
+    }
+    case 't':
+      if (parseLiteral("true", 4))
+        return QVariant(true);
+      break;
+    case 'f':
+      if (parseLiteral("false", 5))
+        return QVariant(false);
+      break;
+    case 'n':
+      if (parseLiteral("null", 4))
+        return QVariant();
+      break;
+    case 'N':
+      if (m_specialNumbersAllowed && parseLiteral("NaN", 3))
+        return QVariant(std::numeric_limits<double>::quiet_NaN());
+      break;
+    case 'I':
+      if (m_specialNumbersAllowed && parseLiteral("Infinity", 8))
+        return QVariant(std::numeric_limits<double>::infinity());
+      break;
+    default:
+      if (*m_pos == '-' || (*m_pos >= '0' && *m_pos <= '9'))
+        return parseNumber();
+      setError(QLatin1String("Unexpected character"));
+      return QVariant();
+  }
+
+  setError(QLatin1String("Invalid literal"));
+  return QVariant();
+}
+
+QVariant ParserPrivate::parseObject(const QStringList &paths, int depth)
+{
+  if (++depth > MaxDepth) {
+    setError(QLatin1String("Maximum nesting depth exceeded"));
+    return QVariant();
+  }
+
+  ++m_pos;
+  QVariantMap map;
+  skipWhitespace();
+  if (m_pos < m_end && *m_pos == '}') {
+    ++m_pos;
+    return QVariant(map);
+  }
+
+  QString key;
+  QStringList children;
+  for (;;) {
+    skipWhitespace();
+    if (m_pos == m_end || *m_pos != '"') {
+      setError(QLatin1String("Expected string key"));
+      return QVariant();
+    }
+
+    if (!parseString(&key))
+      return QVariant();
+
+    skipWhitespace();
+    if (m_pos == m_end || *m_pos != ':') {
+      setError(QLatin1String("Expected ':'"));
+      return QVariant();
+    }
+    ++m_pos;
+    skipWhitespace();
+
+    if (paths.isEmpty()) {
+      map.insert(key, parseValue(paths, depth));
+    } else {
+      // members out of the paths are stepped over without building them
+      children.clear();
+      if (childPaths(paths, key, &children))
+        map.insert(key, parseValue(children, depth));
+      else
+        skipValue(depth);
+    }
+
+    if (m_error)
+      return QVariant();
+
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == ',') {
+      ++m_pos;
+      continue;
+    }
+
+    if (m_pos < m_end && *m_pos == '}') {
+      ++m_pos;
+      return QVariant(map);
+    }
+
+    setError(QLatin1String("Expected ',' or '}'"));
+    return QVariant();
+  }
+}
+
+QVariant ParserPrivate::parseArray(const QStringList &paths, int depth)
+{
+  if (++depth > MaxDepth) {
+    setError(QLatin1String("Maximum nesting depth exceeded"));
+    return QVariant();
+  }
+
+  ++m_pos;
+  QVariantList list;
+  skipWhitespace();
+  if (m_pos < m_end && *m_pos == ']') {
+    ++m_pos;
+    return QVariant(list);
+  }
+
+  for (;;) {
+    skipWhitespace();
+    // the paths apply to every element
+    list.append(parseValue(paths, depth));
+    if (m_error)
+      return QVariant();
+
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == ',') {
+      ++m_pos;
+      continue;
+    }
+
+    if (m_pos < m_end && *m_pos == ']') {
+      ++m_pos;
+      return QVariant(list);
+    }
+
+    setError(QLatin1String("Expected ',' or ']'"));
+    return QVariant();
+  }
+}
+
+QVariant ParserPrivate::parseNumber()
+{
+  const char *start = m_pos;
+  const bool negative = (*m_pos == '-');
+  if (negative)
+    ++m_pos;
+
+  if (negative && m_specialNumbersAllowed && m_end - m_pos >= 8 && qstrncmp(m_pos, "Infinity", 8) == 0) {
+    m_pos += 8;
+    return QVariant(-std::numeric_limits<double>::infinity());
+  }
+
+  // integer part, as unsigned value while it fits
+  const char *digits = m_pos;
+  quint64 value = 0;
+  bool overflow = false;
+  while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9') {
+    const int digit = *m_pos - '0';
+    if (value > (std::numeric_limits<quint64>::max() - digit) / 10)
+      overflow = true;
+    value = value * 10 + digit;
+    ++m_pos;
+  }
+
+  if (m_pos == digits || (*digits == '0' && m_pos - digits > 1)) {
+    setError(QLatin1String("Invalid number"));
+    return QVariant();
+  }
+
+  bool isDouble = false;
+  if (m_pos < m_end && *m_pos == '.') {
+    isDouble = true;
+    digits = ++m_pos;
+    while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9')
+      ++m_pos;
+
+    if (m_pos == digits) {
+      setError(QLatin1String("Invalid number"));
+      return QVariant();
+    }
+  }
+
+  if (m_pos < m_end && (*m_pos == 'e' || *m_pos == 'E')) {
+    isDouble = true;
+    ++m_pos;
+    if (m_pos < m_end && (*m_pos == '+' || *m_pos == '-'))
+      ++m_pos;
+
+    digits = m_pos;
+    while (m_pos < m_end && *m_pos >= '0' && *m_pos <= '9')
+      ++m_pos;
+
+    if (m_pos == digits) {
+      setError(QLatin1String("Invalid number"));
+      return QVariant();
+    }
+  }
+
+  if (isDouble) {
+    bool ok = false;
+    // locale independent conversion
+    const double number = QByteArray::fromRawData(start, m_pos - start).toDouble(&ok);
+    if (!ok) {
+      setError(QLatin1String("Number is out of range"));
+      return QVariant();
+    }
+    return QVariant(number);
+  }
+
+  // same types as before, positive integers are unsigned
+  if (overflow || (negative && value > quint64(std::numeric_limits<qint64>::max()) + 1)) {
+    setError(QLatin1String("Number is out of range"));
+    return QVariant();
+  }
+
+  if (negative)
+    return QVariant(qlonglong(0 - value));
+  return QVariant(qulonglong(value));
+}
+
+bool ParserPrivate::parseString(QString *value)
+{
+  ++m_pos;
+  value->clear();
+
+  for (;;) {
+    const char *end = findStringEnd(m_pos, m_end);
+    if (end == m_end) {
+      m_pos = end;
+      setError(QLatin1String("Unterminated string"));
+      return false;
+    }
+
+    if (end > m_pos) {
+      // most strings have no escape and are decoded at once
+      if (value->isEmpty() && *end == '"')
+        *value = QString::fromUtf8(m_pos, int(end - m_pos));
+      else
+        value->append(QString::fromUtf8(m_pos, int(end - m_pos)));
+    }
+
+    m_pos = end + 1;
+    if (*end == '"')
+      return true;
+
+    if (m_pos == m_end) {
+      setError(QLatin1String("Unterminated string"));
+      return false;
+    }
+
+    switch (*m_pos++) {
+      case '"': value->append(QLatin1Char('"')); break;
+      case '\\': value->append(QLatin1Char('\\')); break;
+      case '/': value->append(QLatin1Char('/')); break;
+      case 'b': value->append(QLatin1Char('\b')); break;
+      case 'f': value->append(QLatin1Char('\f')); break;
+      case 'n': value->append(QLatin1Char('\n')); break;
+      case 'r': value->append(QLatin1Char('\r')); break;
+      case 't': value->append(QLatin1Char('\t')); break;
+      case 'u': {
+        // one utf-16 unit, surrogate pairs come as two escapes
+        ushort code = 0;
+        for (int i = 0; i < 4; ++i) {
+          const int digit = m_pos < m_end ? hexValue(*m_pos) : -1;
+          if (digit < 0) {
+            setError(QLatin1String("Invalid hex string"));
+            return false;
+          }
+          code = (code << 4) | digit;
+          ++m_pos;
+        }
+        value->append(QChar(code));
+        break;
+      }
+      default:
+        // unknown escapes are dropped
+        break;
+    }
+  }
+}
+
+bool ParserPrivate::parseLiteral(const char *literal, int length)
+{
+  if (m_end - m_pos < length || qstrncmp(m_pos, literal, length) != 0)
+    return false;
+
+  m_pos += length;
+  return true;
+}
+
+bool ParserPrivate::skipString()
+{
+  ++m_pos;
+  for (;;) {
+    const char *end = findStringEnd(m_pos, m_end);
+    if (end == m_end || (*end == '\\' && end + 1 == m_end)) {
+      m_pos = m_end;
+      setError(QLatin1String("Unterminated string"));
+      return false;
+    }
+
+    if (*end == '"') {
+      m_pos = end + 1;
+      return true;
+    }
+    m_pos = end + 2;
+  }
+}
+
+bool ParserPrivate::skipValue(int depth)
+{
+  if (m_pos == m_end) {
+    setError(QLatin1String("Unexpected end of data"));
+    return false;
+  }
+
+  if (*m_pos == '"')
+    return skipString();
+
+  if (*m_pos != '{' && *m_pos != '[') {
+    parseValue(QStringList(), depth);
+    return !m_error;
+  }
+
+  // containers are matched by brackets, the content is checked only for strings
+  int level = 0;
+  while (m_pos < m_end) {
+    switch (*m_pos) {
+      case '"':
+        if (!skipString())
+          return false;
+        continue;
+      case '{':
+      case '[':
+        if (depth + ++level > MaxDepth) {
+          setError(QLatin1String("Maximum nesting depth exceeded"));
+          return false;
+        }
+        break;
+      case '}':
+      case ']':
+        if (--level == 0) {
+          ++m_pos;
+          return true;
+        }
+        break;
+      default:
+        break;
+    }
+    ++m_pos;
+  }
+
+  setError(QLatin1String("Unexpected end of data"));
+  return false;
+}
+
+
 Parser::Parser()
 {
   TTK_INIT_PRIVATE(Parser);
@@ -88,36 +567,23 @@ QVariant Parser::parse(QIODevice* io, bool* ok)
     return QVariant();
   }
 
-  if (io->atEnd()) {
-    if (ok != 0)
-      *ok = false;
-    d->setError(QLatin1String("No data"), 0);
-    io->close();
-    return QVariant();
-  }
-
-  d->m_scanner = new JSonScanner (io);
-  d->m_scanner->allowSpecialNumbers(d->m_specialNumbersAllowed);
-  yy::json_parser parser(d);
-  parser.parse();
-
-  delete d->m_scanner;
-  d->m_scanner = 0;
-
-  if (ok != 0)
-    *ok = !d->m_error;
-
+  const QByteArray &data = io->readAll();
   io->close();
-  return d->m_result;
+  return parse(data, ok);
 }
 
 QVariant Parser::parse(const QByteArray &jsonString, bool* ok)
 {
-  QBuffer buffer;
-  buffer.open(QIODevice::ReadWrite | QIODevice::Text);
-  buffer.write(jsonString);
-  buffer.seek(0);
-  return parse (&buffer, ok);
+  return parse(jsonString, QStringList(), ok);
+}
+
+QVariant Parser::parse(const QByteArray &jsonString, const QStringList &paths, bool* ok)
+{
+  TTK_D(Parser);
+  const QVariant &result = d->parse(jsonString, paths);
+  if (ok != 0)
+    *ok = !d->m_error;
+  return result;
 }
 
 QString Parser::errorString() const
@@ -26,6 +26,7 @@
 QT_BEGIN_NAMESPACE
 class QIODevice;
 class QVariant;
+class QStringList;
 QT_END_NAMESPACE
 
 /**
@@ -60,6 +61,16 @@ namespace QJson {
       */
       QVariant parse(const QByteArray &jsonData, bool* ok = 0);
 
+      /**
+      * Parse only the members on the given paths, the others are skipped without building them.
+      * A path is a list of object keys joined by dots like "data.info", arrays pass it on to every element.
+      * @param jsonData data containing the JSON object representation
+      * @param paths member paths to keep, an empty list keeps the whole document
+      * @param ok if a conversion error occurs, *ok is set to false; otherwise *ok is set to true.
+      * @returns a QVariant object generated from the JSON string
+      */
+      QVariant parse(const QByteArray &jsonData, const QStringList &paths, bool* ok = 0);
+
       /**
       * This method returns the error message
       * @returns a QString object containing the error message of the last parse operation
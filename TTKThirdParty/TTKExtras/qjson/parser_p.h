@@ -25,36 +25,48 @@
 #include "parser.h"
 
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 #include <QtCore/QVariant>
 
-class JSonScanner;
-
-namespace yy {
-  class json_parser;
-}
-
 namespace QJson {
 
   /**
    * @brief Main class used to convert JSON data to QVariant objects private
+   *
+   * A single pass recursive descent reader working on the raw utf-8 bytes.
    */
   class ParserPrivate : public TTKPrivate<Parser>
   {
     public:
       ParserPrivate();
-      ~ParserPrivate();
 
       void reset();
 
       void setError(const QString &errorMsg, int line);
+      void setError(const QString &errorMsg);
+
+      QVariant parse(const QByteArray &data, const QStringList &paths);
+
+      QVariant parseValue(const QStringList &paths, int depth);
+      QVariant parseObject(const QStringList &paths, int depth);
+      QVariant parseArray(const QStringList &paths, int depth);
+      QVariant parseNumber();
+      bool parseString(QString *value);
+      bool parseLiteral(const char *literal, int length);
+      bool skipValue(int depth);
+      bool skipString();
+      void skipWhitespace();
 
-      JSonScanner* m_scanner;
       bool m_error;
       int m_errorLine;
       QString m_errorMsg;
       QVariant m_result;
       bool m_specialNumbersAllowed;
+
+      const char *m_begin;
+      const char *m_pos;
+      const char *m_end;
   };
 }
 
-#endif // QJSON_PARSER_H
+#endif // QJSON_PARSER_P_H
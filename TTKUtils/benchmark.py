@@ -0,0 +1,76 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#Author : Greedysky
+
+import sys
+import json
+import argparse
+
+def _load_results(path):
+    with open(path, "r") as f:
+        data = json.load(f)
+
+    results = {}
+    for result in data.get("results", []):
+        results[result["name"]] = result
+    return data, results
+
+
+class BenchmarkCompareModule():
+    def __init__(self, base, current, threshold):
+        self._base_path = base
+        self._current_path = current
+        self._threshold = threshold
+
+    def run(self):
+        base_data, base = _load_results(self._base_path)
+        current_data, current = _load_results(self._current_path)
+
+        print ("base: %s, qt %s, %s" % (base_data.get("version"), base_data.get("qt"), base_data.get("date")))
+        print ("current: %s, qt %s, %s" % (current_data.get("version"), current_data.get("qt"), current_data.get("date")))
+        print ("%-56s %14s %14s %9s" % ("benchmark", "base", "current", "change"))
+
+        regressions = []
+        for name in sorted(set(base) | set(current)):
+            if name not in base or name not in current:
+                print ("%-56s %s" % (name, "only in base" if name in base else "only in current"))
+                continue
+
+            old = base[name]["value"]
+            new = current[name]["value"]
+            # results of other metrics can not be compared
+            if base[name]["metric"] != current[name]["metric"] or old <= 0:
+                print ("%-56s %s" % (name, "not comparable"))
+                continue
+
+            # every metric of the test library is lower is better
+            change = (new - old) * 100.0 / old
+            mark = ""
+            if change > self._threshold:
+                mark = " <- regression"
+                regressions.append(name)
+            elif change < -self._threshold:
+                mark = " <- improvement"
+
+            print ("%-56s %14.6g %14.6g %+8.2f%%%s" % (name, old, new, change, mark))
+
+        return regressions
+
+if __name__ == "__main__":
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-b', help = "基准结果文件", required = True)
+    parser.add_argument('-c', help = "当前结果文件", required = True)
+    parser.add_argument('-t', help = "回归阈值百分比", type = float, default = 5.0)
+
+    args = parser.parse_args()
+
+    module = BenchmarkCompareModule(args.b, args.c, args.t)
+    regressions = module.run()
+
+    print ("=============================================================================")
+    if regressions:
+        print ("%d regression(s) over %.1f%%" % (len(regressions), args.t))
+        sys.exit(1)
+
+    print ("no regression over %.1f%%" % args.t)